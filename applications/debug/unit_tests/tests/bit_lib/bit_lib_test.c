@@ -2,6 +2,12 @@
 #include "../test.h" // IWYU pragma: keep
 #include <bit_lib/bit_lib.h>
 
+#define TAG "BitLibTest"
+
+#define BIT_LIB_TEST_FUZZ_ROUNDS  2000
+#define BIT_LIB_TEST_BUFFER_SIZE  48
+#define BIT_LIB_TEST_BENCH_ROUNDS 200
+
 MU_TEST(test_bit_lib_increment_index) {
     uint32_t index = 0;
 
@@ -708,6 +714,285 @@ MU_TEST(test_bit_lib_bytes_to_num_bcd) {
     mu_assert_int_eq(false, is_bcd_res);
 }
 
+// Bit at a time implementations, the library must give the same results
+
+static uint64_t bit_lib_reference_get_bits(const uint8_t* data, size_t position, uint8_t length) {
+    uint64_t value = 0;
+    for(uint8_t i = 0; i < length; ++i) {
+        value = (value << 1) | bit_lib_get_bit(data, position + i);
+    }
+    return value;
+}
+
+static void
+    bit_lib_reference_set_bits(uint8_t* data, size_t position, uint8_t byte, uint8_t length) {
+    for(uint8_t i = 0; i < length; ++i) {
+        bit_lib_set_bit(data, position + i, (byte >> (length - 1 - i)) & 1);
+    }
+}
+
+static void bit_lib_reference_copy_bits(
+    uint8_t* data,
+    size_t position,
+    size_t length,
+    const uint8_t* source,
+    size_t source_position) {
+    for(size_t i = 0; i < length; ++i) {
+        bit_lib_set_bit(data, position + i, bit_lib_get_bit(source, source_position + i));
+    }
+}
+
+static void bit_lib_reference_reverse_bits(uint8_t* data, size_t position, uint8_t length) {
+    size_t i = 0;
+    size_t j = length - 1;
+
+    while(i < j) {
+        bool tmp = bit_lib_get_bit(data, position + i);
+        bit_lib_set_bit(data, position + i, bit_lib_get_bit(data, position + j));
+        bit_lib_set_bit(data, position + j, tmp);
+        i++;
+        j--;
+    }
+}
+
+static size_t bit_lib_reference_remove_bit_every_nth(
+    uint8_t* data,
+    size_t position,
+    uint8_t length,
+    uint8_t n) {
+    size_t result_counter = 0;
+    for(size_t counter = 0; counter < length; counter++) {
+        if((counter + 1) % n != 0) {
+            bit_lib_set_bit(
+                data, position + result_counter++, bit_lib_get_bit(data, position + counter));
+        }
+    }
+    return result_counter;
+}
+
+static size_t bit_lib_reference_add_parity(
+    const uint8_t* data,
+    size_t position,
+    uint8_t* dest,
+    size_t dest_position,
+    uint8_t source_length,
+    uint8_t parity_length,
+    BitLibParity parity) {
+    size_t j = 0;
+    for(int word = 0; word < source_length; word += parity_length - 1) {
+        uint32_t parity_word = 0;
+        for(int bit = 0; bit < parity_length - 1; bit++) {
+            bool value = bit_lib_get_bit(data, position + word + bit);
+            parity_word = (parity_word << 1) | value;
+            bit_lib_set_bit(dest, dest_position + j++, value);
+        }
+        switch(parity) {
+        case BitLibParityAlways0:
+            bit_lib_set_bit(dest, dest_position + j++, 0);
+            break;
+        case BitLibParityAlways1:
+            bit_lib_set_bit(dest, dest_position + j++, 1);
+            break;
+        default:
+            bit_lib_set_bit(
+                dest,
+                dest_position + j++,
+                (bit_lib_test_parity_32(parity_word, BitLibParityOdd) ^ parity) ^ 1);
+            break;
+        }
+    }
+    return j;
+}
+
+static uint16_t bit_lib_reference_crc16(
+    uint8_t const* data,
+    size_t data_size,
+    uint16_t polynom,
+    uint16_t init,
+    bool ref_in,
+    bool ref_out,
+    uint16_t xor_out) {
+    uint16_t crc = init;
+
+    for(size_t i = 0; i < data_size; ++i) {
+        uint8_t byte = data[i];
+        if(ref_in) byte = bit_lib_reverse_16_fast(byte) >> 8;
+
+        for(size_t j = 0; j < 8; ++j) {
+            bool c15 = (crc >> 15 & 1);
+            bool bit = (byte >> (7 - j) & 1);
+            crc <<= 1;
+            if(c15 ^ bit) crc ^= polynom;
+        }
+    }
+
+    if(ref_out) crc = bit_lib_reverse_16_fast(crc);
+    crc ^= xor_out;
+
+    return crc;
+}
+
+// Fixed seed, a failure is reproduced by the same round
+static uint32_t bit_lib_test_random(uint32_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+static void bit_lib_test_random_fill(uint32_t* state, uint8_t* data, size_t size) {
+    for(size_t i = 0; i < size; i++) {
+        data[i] = bit_lib_test_random(state);
+    }
+}
+
+MU_TEST(test_bit_lib_differential) {
+    const size_t bits = BIT_LIB_TEST_BUFFER_SIZE * 8;
+    uint8_t source[BIT_LIB_TEST_BUFFER_SIZE];
+    uint8_t expected[BIT_LIB_TEST_BUFFER_SIZE];
+    uint8_t actual[BIT_LIB_TEST_BUFFER_SIZE];
+    uint32_t state = 0x2545F491;
+
+    for(size_t round = 0; round < BIT_LIB_TEST_FUZZ_ROUNDS; round++) {
+        bit_lib_test_random_fill(&state, source, sizeof(source));
+        bit_lib_test_random_fill(&state, expected, sizeof(expected));
+        memcpy(actual, expected, sizeof(actual));
+
+        // Reads, up to the last bit of the buffer
+        uint8_t length = 1 + bit_lib_test_random(&state) % 64;
+        size_t position = bit_lib_test_random(&state) % (bits - length + 1);
+        uint64_t value = bit_lib_reference_get_bits(source, position, length);
+        if(length <= 8) {
+            mu_assert_int_eq(value, bit_lib_get_bits(source, position, length));
+        }
+        if(length <= 16) {
+            mu_assert_int_eq(value, bit_lib_get_bits_16(source, position, length));
+        }
+        if(length <= 32) {
+            mu_assert_int_eq(value, bit_lib_get_bits_32(source, position, length));
+        }
+        mu_assert(
+            value == bit_lib_get_bits_64(source, position, length), "get_bits_64 mismatch");
+
+        // Writes
+        length = 1 + bit_lib_test_random(&state) % 8;
+        position = bit_lib_test_random(&state) % (bits - length + 1);
+        uint8_t byte = bit_lib_test_random(&state);
+        bit_lib_reference_set_bits(expected, position, byte, length);
+        bit_lib_set_bits(actual, position, byte, length);
+        mu_assert_mem_eq(expected, actual, sizeof(actual));
+
+        // Copy from another buffer, aligned in a quarter of the rounds
+        size_t copy_length = bit_lib_test_random(&state) % (bits / 2);
+        position = bit_lib_test_random(&state) % (bits - copy_length + 1);
+        size_t source_position = bit_lib_test_random(&state) % (bits - copy_length + 1);
+        if(round % 4 == 0) {
+            position &= ~7U;
+            source_position &= ~7U;
+        }
+        bit_lib_reference_copy_bits(expected, position, copy_length, source, source_position);
+        bit_lib_copy_bits(actual, position, copy_length, source, source_position);
+        mu_assert_mem_eq(expected, actual, sizeof(actual));
+
+        // Reverse
+        length = 1 + bit_lib_test_random(&state) % 255;
+        position = bit_lib_test_random(&state) % (bits - length + 1);
+        bit_lib_reference_reverse_bits(expected, position, length);
+        bit_lib_reverse_bits(actual, position, length);
+        mu_assert_mem_eq(expected, actual, sizeof(actual));
+
+        // Remove bits in place
+        length = bit_lib_test_random(&state) % 255;
+        position = bit_lib_test_random(&state) % (bits - length + 1);
+        uint8_t n = 2 + bit_lib_test_random(&state) % 20;
+        mu_assert_int_eq(
+            bit_lib_reference_remove_bit_every_nth(expected, position, length, n),
+            bit_lib_remove_bit_every_nth(actual, position, length, n));
+        mu_assert_mem_eq(expected, actual, sizeof(actual));
+
+        // Add parity, the result is up to twice as long as the source plus a word
+        length = bit_lib_test_random(&state) % 128;
+        position = bit_lib_test_random(&state) % (bits - 2 * length - 64);
+        uint8_t parity_length = 2 + bit_lib_test_random(&state) % 31;
+        BitLibParity parity = bit_lib_test_random(&state) % 4;
+        source_position = bit_lib_test_random(&state) % (bits / 2 - parity_length);
+        mu_assert_int_eq(
+            bit_lib_reference_add_parity(
+                source, source_position, expected, position, length, parity_length, parity),
+            bit_lib_add_parity(
+                source, source_position, actual, position, length, parity_length, parity));
+        mu_assert_mem_eq(expected, actual, sizeof(actual));
+
+        // CRC of any polynomial
+        size_t size = bit_lib_test_random(&state) % sizeof(source);
+        uint16_t polynom = bit_lib_test_random(&state);
+        uint16_t init = bit_lib_test_random(&state);
+        uint16_t xor_out = bit_lib_test_random(&state);
+        bool ref_in = round & 1;
+        bool ref_out = round & 2;
+        mu_assert_int_eq(
+            bit_lib_reference_crc16(source, size, polynom, init, ref_in, ref_out, xor_out),
+            bit_lib_crc16(source, size, polynom, init, ref_in, ref_out, xor_out));
+    }
+}
+
+MU_TEST(test_bit_lib_benchmark) {
+    uint8_t source[BIT_LIB_TEST_BUFFER_SIZE];
+    uint8_t data[BIT_LIB_TEST_BUFFER_SIZE];
+    uint32_t state = 0x2545F491;
+    bit_lib_test_random_fill(&state, source, sizeof(source));
+    bit_lib_test_random_fill(&state, data, sizeof(data));
+
+    // Unaligned copy of 256 bits, typical for card dumps
+    uint32_t start = furi_hal_cortex_timer_get(0).start;
+    for(size_t i = 0; i < BIT_LIB_TEST_BENCH_ROUNDS; i++) {
+        bit_lib_reference_copy_bits(data, 3, 256, source, 13);
+    }
+    const uint32_t copy_reference = furi_hal_cortex_timer_get(0).start - start;
+    start = furi_hal_cortex_timer_get(0).start;
+    for(size_t i = 0; i < BIT_LIB_TEST_BENCH_ROUNDS; i++) {
+        bit_lib_copy_bits(data, 3, 256, source, 13);
+    }
+    const uint32_t copy_fast = furi_hal_cortex_timer_get(0).start - start;
+
+    start = furi_hal_cortex_timer_get(0).start;
+    for(size_t i = 0; i < BIT_LIB_TEST_BENCH_ROUNDS; i++) {
+        bit_lib_reference_reverse_bits(data, 5, 200);
+    }
+    const uint32_t reverse_reference = furi_hal_cortex_timer_get(0).start - start;
+    start = furi_hal_cortex_timer_get(0).start;
+    for(size_t i = 0; i < BIT_LIB_TEST_BENCH_ROUNDS; i++) {
+        bit_lib_reverse_bits(data, 5, 200);
+    }
+    const uint32_t reverse_fast = furi_hal_cortex_timer_get(0).start - start;
+
+    uint16_t crc = 0;
+    start = furi_hal_cortex_timer_get(0).start;
+    for(size_t i = 0; i < BIT_LIB_TEST_BENCH_ROUNDS; i++) {
+        crc ^= bit_lib_reference_crc16(source, sizeof(source), 0x1021, crc, true, true, 0);
+    }
+    const uint32_t crc_reference = furi_hal_cortex_timer_get(0).start - start;
+    start = furi_hal_cortex_timer_get(0).start;
+    for(size_t i = 0; i < BIT_LIB_TEST_BENCH_ROUNDS; i++) {
+        crc ^= bit_lib_crc16(source, sizeof(source), 0x1021, crc, true, true, 0);
+    }
+    const uint32_t crc_fast = furi_hal_cortex_timer_get(0).start - start;
+
+    const uint32_t cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+    FURI_LOG_I(
+        TAG,
+        "copy %luus/%luus, reverse %luus/%luus, crc16 %luus/%luus (reference/library)",
+        copy_reference / cycles_per_us,
+        copy_fast / cycles_per_us,
+        reverse_reference / cycles_per_us,
+        reverse_fast / cycles_per_us,
+        crc_reference / cycles_per_us,
+        crc_fast / cycles_per_us);
+    mu_assert(copy_fast < copy_reference, "copy_bits is slower than reference");
+    mu_assert(reverse_fast < reverse_reference, "reverse_bits is slower than reference");
+    mu_assert(crc_fast < crc_reference, "crc16 is slower than reference");
+}
+
 MU_TEST_SUITE(test_bit_lib) {
     MU_RUN_TEST(test_bit_lib_increment_index);
     MU_RUN_TEST(test_bit_lib_is_set);
@@ -732,6 +1017,8 @@ MU_TEST_SUITE(test_bit_lib) {
     MU_RUN_TEST(test_bit_lib_bytes_to_num_be);
     MU_RUN_TEST(test_bit_lib_bytes_to_num_le);
     MU_RUN_TEST(test_bit_lib_bytes_to_num_bcd);
+    MU_RUN_TEST(test_bit_lib_differential);
+    MU_RUN_TEST(test_bit_lib_benchmark);
 }
 
 int run_minunit_test_bit_lib(void) {
@@ -0,0 +1,149 @@
+#include "../test.h" // IWYU pragma: keep
+
+#include <furi.h>
+#include <furi_hal.h>
+#include <furi_hal_random.h>
+#include <gui/canvas_i.h>
+#include <u8g2_glue.h>
+#include <assets_icons.h>
+
+#define TAG "CanvasTest"
+
+#define CANVAS_TEST_BUFFER_SIZE (128 * 64 / 8)
+#define CANVAS_TEST_ITERATIONS  2000
+#define CANVAS_TEST_BITMAP_MAX  40
+
+typedef void (*CanvasTestDrawBitmap)(
+    u8g2_t* u8g2,
+    int32_t x,
+    int32_t y,
+    size_t width,
+    size_t height,
+    const uint8_t* bitmap,
+    IconRotation rotation);
+
+static void canvas_test_u8g2_setup(u8g2_t* u8g2) {
+    // Only display info and buffer geometry are set up, display is never touched
+    u8g2_Setup_st756x_flipper(u8g2, U8G2_R0, NULL, NULL);
+}
+
+MU_TEST(canvas_test_blit_random) {
+    u8g2_t u8g2;
+    canvas_test_u8g2_setup(&u8g2);
+
+    uint8_t* expected = malloc(CANVAS_TEST_BUFFER_SIZE);
+    uint8_t* actual = malloc(CANVAS_TEST_BUFFER_SIZE);
+    const size_t bitmap_size = CANVAS_TEST_BITMAP_MAX * ((CANVAS_TEST_BITMAP_MAX + 7) / 8);
+    uint8_t* bitmap = malloc(bitmap_size);
+
+    for(size_t i = 0; i < CANVAS_TEST_ITERATIONS; i++) {
+        const size_t width = 1 + furi_hal_random_get() % CANVAS_TEST_BITMAP_MAX;
+        const size_t height = 1 + furi_hal_random_get() % CANVAS_TEST_BITMAP_MAX;
+        // Cover partially visible bitmaps on every side
+        const int32_t x = (int32_t)(furi_hal_random_get() % 180) - CANVAS_TEST_BITMAP_MAX;
+        const int32_t y = (int32_t)(furi_hal_random_get() % 120) - CANVAS_TEST_BITMAP_MAX;
+        const IconRotation rotation = furi_hal_random_get() % 4;
+        u8g2.draw_color = furi_hal_random_get() % 3;
+        u8g2.bitmap_transparency = furi_hal_random_get() % 2;
+
+        furi_hal_random_fill_buf(bitmap, bitmap_size);
+        furi_hal_random_fill_buf(expected, CANVAS_TEST_BUFFER_SIZE);
+        memcpy(actual, expected, CANVAS_TEST_BUFFER_SIZE);
+
+        u8g2.tile_buf_ptr = expected;
+        canvas_draw_u8g2_bitmap_generic(&u8g2, x, y, width, height, bitmap, rotation);
+        u8g2.tile_buf_ptr = actual;
+        canvas_draw_u8g2_bitmap(&u8g2, x, y, width, height, bitmap, rotation);
+
+        if(memcmp(expected, actual, CANVAS_TEST_BUFFER_SIZE) != 0) {
+            FURI_LOG_E(
+                TAG,
+                "Mismatch: %zux%zu at %ld,%ld, rotation %d, color %d, transparency %d",
+                width,
+                height,
+                x,
+                y,
+                rotation,
+                u8g2.draw_color,
+                u8g2.bitmap_transparency);
+            mu_fail("Blitter output differs from reference");
+        }
+    }
+
+    free(bitmap);
+    free(actual);
+    free(expected);
+}
+
+static uint32_t canvas_test_render_animation(
+    u8g2_t* u8g2,
+    CanvasTestDrawBitmap draw,
+    const Icon* icon,
+    CompressIcon* compress_icon) {
+    const uint32_t frame_count = icon_get_frame_count(icon);
+    uint32_t cycles = 0;
+
+    for(uint32_t frame = 0; frame < frame_count; frame++) {
+        uint8_t* frame_data = NULL;
+        compress_icon_decode(compress_icon, icon_get_frame_data(icon, frame), &frame_data);
+
+        const uint32_t start = furi_hal_cortex_timer_get(0).start;
+        draw(
+            u8g2,
+            0,
+            0,
+            icon_get_width(icon),
+            icon_get_height(icon),
+            frame_data,
+            IconRotation0);
+        cycles += furi_hal_cortex_timer_get(0).start - start;
+    }
+
+    return cycles / frame_count;
+}
+
+MU_TEST(canvas_test_blit_benchmark) {
+    u8g2_t u8g2;
+    canvas_test_u8g2_setup(&u8g2);
+    u8g2.draw_color = 1;
+    u8g2.bitmap_transparency = 0;
+
+    uint8_t* expected = malloc(CANVAS_TEST_BUFFER_SIZE);
+    uint8_t* actual = malloc(CANVAS_TEST_BUFFER_SIZE);
+    CompressIcon* compress_icon = compress_icon_alloc(ICON_DECOMPRESSOR_BUFFER_SIZE);
+    const Icon* icon = &A_Levelup_128x64;
+
+    u8g2.tile_buf_ptr = expected;
+    const uint32_t generic_cycles = canvas_test_render_animation(
+        &u8g2, canvas_draw_u8g2_bitmap_generic, icon, compress_icon);
+    u8g2.tile_buf_ptr = actual;
+    const uint32_t fast_cycles =
+        canvas_test_render_animation(&u8g2, canvas_draw_u8g2_bitmap, icon, compress_icon);
+
+    // Last frame of the animation is left in both buffers
+    mu_assert_mem_eq(expected, actual, CANVAS_TEST_BUFFER_SIZE);
+
+    const uint32_t cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+    FURI_LOG_I(
+        TAG,
+        "Levelup frame: generic %luus, blitter %luus",
+        generic_cycles / cycles_per_us,
+        fast_cycles / cycles_per_us);
+    mu_assert(fast_cycles < generic_cycles, "Blitter is slower than generic path");
+
+    compress_icon_free(compress_icon);
+    free(actual);
+    free(expected);
+}
+
+MU_TEST_SUITE(test_canvas) {
+    MU_RUN_TEST(canvas_test_blit_random);
+    MU_RUN_TEST(canvas_test_blit_benchmark);
+}
+
+int run_minunit_test_canvas(void) {
+    MU_RUN_SUITE(test_canvas);
+    return MU_EXIT_CODE;
+}
+
+TEST_API_DEFINE(run_minunit_test_canvas)
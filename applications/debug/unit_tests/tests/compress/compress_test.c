@@ -149,6 +149,59 @@ static void compress_test_random_comp_decomp() {
     compress_free(comp);
 }
 
+static void compress_test_icon_cache() {
+    static const size_t icon_size = 128;
+    static const size_t encoded_buffer_size = 256;
+
+    Compress* comp = compress_alloc(CompressTypeHeatshrink, &compress_config_heatshrink_default);
+    CompressIcon* compress_icon = compress_icon_alloc(icon_size);
+    compress_icon_set_cache_budget(compress_icon, 1024);
+
+    uint8_t* src_buff = malloc(icon_size);
+    uint8_t* encoded_buff = malloc(encoded_buffer_size);
+    uint8_t* decoded = NULL;
+    size_t encoded_size = 0;
+
+    memset(src_buff, 0xAA, icon_size);
+    mu_assert(
+        compress_encode(
+            comp, src_buff, icon_size, encoded_buff, encoded_buffer_size, &encoded_size),
+        "Compress failed");
+
+    compress_icon_decode(compress_icon, encoded_buff, &decoded);
+    mu_assert(memcmp(decoded, src_buff, icon_size) == 0, "Decoded data mismatch");
+    compress_icon_decode(compress_icon, encoded_buff, &decoded);
+    mu_assert(memcmp(decoded, src_buff, icon_size) == 0, "Cached data mismatch");
+
+    CompressIconCacheStats stats;
+    compress_icon_get_cache_stats(compress_icon, &stats);
+    mu_assert_int_eq(1, stats.misses);
+    mu_assert_int_eq(1, stats.hits);
+    mu_assert(stats.used > icon_size, "Cache is empty");
+
+    // Same pointer, new content: cached frame must not be served
+    memset(src_buff, 0x55, icon_size / 2);
+    mu_assert(
+        compress_encode(
+            comp, src_buff, icon_size, encoded_buff, encoded_buffer_size, &encoded_size),
+        "Compress failed");
+    compress_icon_decode(compress_icon, encoded_buff, &decoded);
+    mu_assert(memcmp(decoded, src_buff, icon_size) == 0, "Stale data served from cache");
+
+    compress_icon_get_cache_stats(compress_icon, &stats);
+    mu_assert_int_eq(2, stats.misses);
+    mu_assert_int_eq(1, stats.hits);
+
+    compress_icon_reset_cache_stats(compress_icon);
+    compress_icon_get_cache_stats(compress_icon, &stats);
+    mu_assert_int_eq(0, stats.misses + stats.hits);
+
+    free(encoded_buff);
+    free(src_buff);
+    compress_icon_free(compress_icon);
+    compress_free(comp);
+}
+
 static int32_t hs_unpacker_file_read(void* context, uint8_t* buffer, size_t size) {
     File* file = (File*)context;
     return storage_file_read(file, buffer, size);
@@ -239,6 +292,120 @@ static void compress_test_heatshrink_stream() {
     furi_record_close(RECORD_STORAGE);
 }
 
+typedef struct {
+    const uint8_t* data;
+    size_t size;
+    size_t position;
+} SeekTestStream;
+
+static int32_t seek_test_stream_read(void* context, uint8_t* buffer, size_t size) {
+    SeekTestStream* stream = context;
+    size = MIN(size, stream->size - stream->position);
+    memcpy(buffer, &stream->data[stream->position], size);
+    stream->position += size;
+    return size;
+}
+
+static bool seek_test_stream_seek(void* context, size_t position) {
+    SeekTestStream* stream = context;
+    if(position > stream->size) return false;
+    stream->position = position;
+    return true;
+}
+
+static void compress_test_heatshrink_seek_index() {
+    static const size_t src_data_size = 2000;
+    static const uint32_t segment_size = 256;
+    static const uint32_t segment_count = (src_data_size + segment_size - 1) / segment_size;
+    // Compress header of compress_encode output, stripped to get a raw stream
+    static const size_t compress_header_size = 4;
+
+    uint8_t* src_buff = malloc(src_data_size);
+    uint8_t* encoded_buff = malloc(src_data_size * 2);
+    uint8_t* segment_buff = malloc(segment_size * 2);
+    uint8_t* decoded_buff = malloc(src_data_size);
+    uint32_t* offsets = malloc(sizeof(uint32_t) * (segment_count + 1));
+
+    // Compressible, but not repeating with segment period
+    for(size_t i = 0; i < src_data_size; i++) {
+        src_buff[i] = (i / 7) % 29 + 'A';
+    }
+
+    // Build segmented stream: each segment is an independent heatshrink stream
+    Compress* comp = compress_alloc(CompressTypeHeatshrink, &compress_config_heatshrink_default);
+    size_t encoded_size = 0;
+    for(uint32_t segment = 0; segment < segment_count; segment++) {
+        size_t start = segment * segment_size;
+        size_t size = MIN(segment_size, src_data_size - start);
+        size_t segment_encoded_size = 0;
+        mu_assert(
+            compress_encode(
+                comp,
+                &src_buff[start],
+                size,
+                segment_buff,
+                segment_size * 2,
+                &segment_encoded_size),
+            "Compress failed");
+        mu_assert(segment_buff[0] == 1, "Segment is not compressed");
+
+        offsets[segment] = encoded_size;
+        segment_encoded_size -= compress_header_size;
+        memcpy(
+            &encoded_buff[encoded_size],
+            &segment_buff[compress_header_size],
+            segment_encoded_size);
+        encoded_size += segment_encoded_size;
+    }
+    offsets[segment_count] = encoded_size;
+    compress_free(comp);
+
+    SeekTestStream stream = {.data = encoded_buff, .size = encoded_size, .position = 0};
+    CompressStreamDecoder* decoder = compress_stream_decoder_alloc(
+        CompressTypeHeatshrink,
+        &compress_config_heatshrink_default,
+        seek_test_stream_read,
+        &stream);
+
+    CompressSeekIndex index = {
+        .segment_size = segment_size,
+        .segment_count = segment_count,
+        .offsets = offsets,
+    };
+    mu_assert(
+        compress_stream_decoder_set_seek_index(decoder, &index, seek_test_stream_seek),
+        "Failed to set seek index");
+
+    // Sequential read across segment boundaries
+    mu_assert(
+        compress_stream_decoder_read(decoder, decoded_buff, src_data_size), "Read failed");
+    mu_assert(memcmp(decoded_buff, src_buff, src_data_size) == 0, "Sequential data mismatch");
+
+    // Random access in both directions
+    static const size_t positions[] = {1500, 10, 700, 256, 1999, 255, 0, 1024, 1000};
+    for(size_t i = 0; i < COUNT_OF(positions); i++) {
+        size_t position = positions[i];
+        size_t size = MIN((size_t)100, src_data_size - position);
+        mu_assert(compress_stream_decoder_seek(decoder, position), "Seek failed");
+        mu_assert_int_eq(position, compress_stream_decoder_tell(decoder));
+        mu_assert(compress_stream_decoder_read(decoder, decoded_buff, size), "Read failed");
+        mu_assert(
+            memcmp(decoded_buff, &src_buff[position], size) == 0, "Data mismatch after seek");
+    }
+
+    // Rewind restarts from the first segment
+    mu_assert(compress_stream_decoder_rewind(decoder), "Rewind failed");
+    mu_assert(compress_stream_decoder_read(decoder, decoded_buff, 300), "Read failed");
+    mu_assert(memcmp(decoded_buff, src_buff, 300) == 0, "Data mismatch after rewind");
+
+    compress_stream_decoder_free(decoder);
+    free(offsets);
+    free(decoded_buff);
+    free(segment_buff);
+    free(encoded_buff);
+    free(src_buff);
+}
+
 #define HS_TAR_PATH         COMPRESS_UNIT_TESTS_PATH("test.ths")
 #define HS_TAR_EXTRACT_PATH COMPRESS_UNIT_TESTS_PATH("tar_out")
 
@@ -341,7 +508,9 @@ static void compress_test_heatshrink_tar() {
 MU_TEST_SUITE(test_compress) {
     MU_RUN_TEST(compress_test_random_comp_decomp);
     MU_RUN_TEST(compress_test_reference_comp_decomp);
+    MU_RUN_TEST(compress_test_icon_cache);
     MU_RUN_TEST(compress_test_heatshrink_stream);
+    MU_RUN_TEST(compress_test_heatshrink_seek_index);
     MU_RUN_TEST(compress_test_heatshrink_tar);
 }
 
@@ -0,0 +1,156 @@
+#include "../test.h" // IWYU pragma: keep
+#include <furi.h>
+#include <strings.h>
+#include <storage/storage.h>
+#include <toolbox/dir_index.h>
+
+#define DIR_INDEX_TEST_DIR       EXT_PATH(".tmp/unit_tests/dir_index")
+#define DIR_INDEX_TEST_FILES     600
+#define DIR_INDEX_TEST_DIRS      40
+#define DIR_INDEX_TEST_JOURNAL   DIR_INDEX_TEST_DIR "/" DIR_INDEX_JOURNAL_FILE_NAME
+#define DIR_INDEX_TEST_NEW_FILE  DIR_INDEX_TEST_DIR "/AAA_new.txt"
+#define DIR_INDEX_TEST_GONE_FILE DIR_INDEX_TEST_DIR "/file_0100.txt"
+
+static void dir_index_test_scan(Storage* storage, uint32_t* count, uint32_t* checksum) {
+    File* dir = storage_file_alloc(storage);
+    FileInfo fileinfo;
+    char name[STORAGE_DIR_ENTRY_NAME_SIZE];
+
+    *count = 0;
+    *checksum = 0;
+
+    mu_check(storage_dir_open(dir, DIR_INDEX_TEST_DIR));
+    while(storage_dir_read(dir, &fileinfo, name, sizeof(name))) {
+        // Storage service hides the index
+        mu_check(!dir_index_is_service_file(name));
+        (*count)++;
+        *checksum = dir_index_checksum_add(*checksum, name, file_info_is_dir(&fileinfo));
+    }
+    storage_dir_close(dir);
+    storage_file_free(dir);
+}
+
+// Read whole index, checking the order and looking for a name
+static uint32_t dir_index_test_read_all(
+    DirIndex* dir_index,
+    bool dirs_first,
+    const char* lookup,
+    bool* found) {
+    FuriString* name = furi_string_alloc();
+    FuriString* prev = furi_string_alloc();
+    bool is_dir;
+    bool prev_is_dir = true;
+    uint32_t count = 0;
+    *found = false;
+
+    mu_check(dir_index_rewind(dir_index));
+    while(dir_index_read(dir_index, name, &is_dir)) {
+        if(count) {
+            // Directories first if requested, then case insensitive order
+            if(dirs_first) {
+                mu_check(prev_is_dir || !is_dir);
+            }
+            if(!dirs_first || prev_is_dir == is_dir) {
+                mu_check(strcasecmp(furi_string_get_cstr(prev), furi_string_get_cstr(name)) < 0);
+            }
+        }
+        if(furi_string_cmp_str(name, lookup) == 0) {
+            *found = true;
+        }
+        furi_string_set(prev, name);
+        prev_is_dir = is_dir;
+        count++;
+    }
+
+    furi_string_free(prev);
+    furi_string_free(name);
+    return count;
+}
+
+static void dir_index_test_setup(Storage* storage) {
+    FuriString* path = furi_string_alloc();
+
+    storage_simply_remove_recursive(storage, DIR_INDEX_TEST_DIR);
+    mu_check(storage_simply_mkdir(storage, DIR_INDEX_TEST_DIR));
+
+    File* file = storage_file_alloc(storage);
+    // Reverse order, so that the directory is not sorted already
+    for(int32_t i = DIR_INDEX_TEST_FILES - 1; i >= 0; i--) {
+        furi_string_printf(
+            path, "%s/%s_%04ld.txt", DIR_INDEX_TEST_DIR, i % 2 ? "File" : "file", i);
+        mu_check(storage_file_open(file, furi_string_get_cstr(path), FSAM_WRITE, FSOM_CREATE_NEW));
+        storage_file_close(file);
+    }
+    storage_file_free(file);
+
+    for(int32_t i = DIR_INDEX_TEST_DIRS - 1; i >= 0; i--) {
+        furi_string_printf(path, "%s/zdir_%02ld", DIR_INDEX_TEST_DIR, i);
+        mu_check(storage_simply_mkdir(storage, furi_string_get_cstr(path)));
+    }
+
+    furi_string_free(path);
+}
+
+MU_TEST(dir_index_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    DirIndex* dir_index = dir_index_alloc(storage);
+    uint32_t count, checksum;
+    bool found;
+
+    // Only the index files themselves are hidden
+    mu_check(dir_index_is_service_file(DIR_INDEX_FILE_NAME));
+    mu_check(dir_index_is_service_file(DIR_INDEX_PENDING_JOURNAL_FILE_NAME));
+    mu_check(!dir_index_is_service_file(DIR_INDEX_FILE_NAME ".bak"));
+    mu_check(!dir_index_is_service_file(".dirindexes"));
+
+    dir_index_test_setup(storage);
+
+    // Initial build
+    dir_index_test_scan(storage, &count, &checksum);
+    mu_assert_int_eq(DIR_INDEX_TEST_FILES + DIR_INDEX_TEST_DIRS, count);
+    mu_check(dir_index_open(dir_index, DIR_INDEX_TEST_DIR, true, count, checksum));
+    mu_assert_int_eq(count, dir_index_test_read_all(dir_index, true, "zdir_00", &found));
+    mu_check(found);
+    dir_index_close(dir_index);
+
+    // Changes made through storage are journaled and merged on the next open
+    File* file = storage_file_alloc(storage);
+    mu_check(storage_file_open(file, DIR_INDEX_TEST_NEW_FILE, FSAM_WRITE, FSOM_CREATE_NEW));
+    storage_file_close(file);
+    storage_file_free(file);
+    mu_check(storage_simply_remove(storage, DIR_INDEX_TEST_GONE_FILE));
+    mu_check(storage_file_exists(storage, DIR_INDEX_TEST_JOURNAL));
+
+    dir_index_test_scan(storage, &count, &checksum);
+    mu_check(dir_index_open(dir_index, DIR_INDEX_TEST_DIR, true, count, checksum));
+    mu_check(!storage_file_exists(storage, DIR_INDEX_TEST_JOURNAL));
+    mu_assert_int_eq(count, dir_index_test_read_all(dir_index, true, "AAA_new.txt", &found));
+    mu_check(found);
+    dir_index_test_read_all(dir_index, true, "file_0100.txt", &found);
+    mu_check(!found);
+    dir_index_close(dir_index);
+
+    // Different sorting forces a rebuild
+    mu_check(dir_index_open(dir_index, DIR_INDEX_TEST_DIR, false, count, checksum));
+    mu_assert_int_eq(count, dir_index_test_read_all(dir_index, false, "zdir_39", &found));
+    mu_check(found);
+    dir_index_close(dir_index);
+
+    dir_index_free(dir_index);
+
+    // Hidden index doesn't keep the directory from being removed
+    mu_check(storage_simply_remove_recursive(storage, DIR_INDEX_TEST_DIR));
+    mu_check(!storage_dir_exists(storage, DIR_INDEX_TEST_DIR));
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST_SUITE(test_dir_index_suite) {
+    MU_RUN_TEST(dir_index_test);
+}
+
+int run_minunit_test_dir_index(void) {
+    MU_RUN_SUITE(test_dir_index_suite);
+    return MU_EXIT_CODE;
+}
+
+TEST_API_DEFINE(run_minunit_test_dir_index)
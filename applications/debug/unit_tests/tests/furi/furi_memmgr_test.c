@@ -1,4 +1,5 @@
 #include "../test.h" // IWYU pragma: keep
+#include <furi.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
@@ -37,3 +38,121 @@ void test_furi_memmgr(void) {
     }
     free(ptr);
 }
+
+static int32_t test_furi_memmgr_arena_thread(void* context) {
+    UNUSED(context);
+    MemmgrHeapArena* arena = furi_thread_get_arena();
+    furi_check(arena == furi_thread_get_arena());
+    for(size_t i = 0; i < 64; i++) {
+        memmgr_heap_arena_malloc(arena, 100);
+    }
+    return 0;
+}
+
+void test_furi_memmgr_pools(void) {
+    MemmgrHeapStats before, after;
+    void* blocks[MEMMGR_HEAP_POOL_COUNT];
+    const size_t sizes[MEMMGR_HEAP_POOL_COUNT] = {1, 17, 33, 64, 65, 128};
+
+    memmgr_heap_get_stats(&before);
+    for(size_t i = 0; i < MEMMGR_HEAP_POOL_COUNT; i++) {
+        blocks[i] = malloc(sizes[i]);
+        mu_assert_int_eq(0, (uintptr_t)blocks[i] & 7);
+        for(size_t j = 0; j < sizes[i]; j++) {
+            mu_assert_int_eq(0, ((uint8_t*)blocks[i])[j]);
+        }
+        memset(blocks[i], 0xA5, sizes[i]);
+    }
+    memmgr_heap_get_stats(&after);
+
+    // One block from every size class, other threads may allocate too
+    for(size_t i = 0; i < MEMMGR_HEAP_POOL_COUNT; i++) {
+        mu_check(after.pools[i].used >= 1);
+        mu_check(after.pools[i].used <= after.pools[i].total);
+    }
+    mu_check(after.pool_malloc.count >= before.pool_malloc.count + MEMMGR_HEAP_POOL_COUNT);
+
+    // Freed slots are zeroed before reuse
+    free(blocks[0]);
+    blocks[0] = malloc(sizes[0]);
+    mu_assert_int_eq(0, ((uint8_t*)blocks[0])[0]);
+
+    for(size_t i = 0; i < MEMMGR_HEAP_POOL_COUNT; i++) {
+        free(blocks[i]);
+    }
+    memmgr_heap_get_stats(&after);
+    for(size_t i = 0; i < MEMMGR_HEAP_POOL_COUNT; i++) {
+        mu_check(after.pools[i].used <= after.pools[i].total);
+    }
+    mu_check(after.fragmentation <= 100);
+    mu_check(after.max_free_block <= after.free_bytes);
+}
+
+void test_furi_memmgr_arena(void) {
+    MemmgrHeapArena* arena = memmgr_heap_arena_alloc(256);
+
+    uint8_t* small = memmgr_heap_arena_malloc(arena, 3);
+    uint8_t* next = memmgr_heap_arena_malloc(arena, 8);
+    mu_assert_int_eq(0, (uintptr_t)small & 7);
+    mu_assert_pointers_eq(small + 8, next);
+
+    // Larger than a chunk, gets its own
+    uint8_t* large = memmgr_heap_arena_malloc(arena, 1000);
+    for(size_t i = 0; i < 1000; i++) {
+        mu_assert_int_eq(0, large[i]);
+    }
+    mu_assert_pointers_eq(small + 16, memmgr_heap_arena_malloc(arena, 8));
+    mu_assert_int_eq(8 + 8 + 1000 + 8, memmgr_heap_arena_get_used(arena));
+
+    memmgr_heap_arena_free(arena);
+
+    // Thread arena is released when the thread returns
+    FuriThread* thread =
+        furi_thread_alloc_ex("MemmgrArena", 1024, test_furi_memmgr_arena_thread, NULL);
+    const size_t heap_before = memmgr_get_free_heap();
+    furi_thread_start(thread);
+    furi_thread_join(thread);
+    furi_thread_free(thread);
+    mu_check(memmgr_get_free_heap() + 512 > heap_before);
+}
+
+static bool test_furi_memmgr_trace_find(void* pointer, MemmgrHeapTraceRecord* record) {
+    MemmgrHeapTraceRecord records[64];
+    const size_t live = memmgr_heap_trace_get_records(records, COUNT_OF(records), NULL);
+    for(size_t i = 0; i < MIN(live, COUNT_OF(records)); i++) {
+        if(records[i].pointer == pointer) {
+            *record = records[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+void test_furi_memmgr_trace(void) {
+    // Don't interfere with a trace started from the CLI
+    if(!memmgr_heap_trace_start(64)) return;
+    mu_check(memmgr_heap_trace_is_running());
+
+    void* blocks[2];
+    for(size_t i = 0; i < COUNT_OF(blocks); i++) {
+        blocks[i] = malloc(100 + i);
+    }
+
+    MemmgrHeapTraceRecord first, second;
+    mu_check(test_furi_memmgr_trace_find(blocks[0], &first));
+    mu_check(test_furi_memmgr_trace_find(blocks[1], &second));
+    mu_assert_int_eq(100, first.size);
+    mu_assert_int_eq(101, second.size);
+    // Same call site
+    mu_check(first.caller != NULL);
+    mu_assert_pointers_eq(first.caller, second.caller);
+
+    free(blocks[0]);
+    mu_check(!test_furi_memmgr_trace_find(blocks[0], &first));
+    mu_check(test_furi_memmgr_trace_find(blocks[1], &second));
+    free(blocks[1]);
+
+    memmgr_heap_trace_stop();
+    mu_check(!memmgr_heap_trace_is_running());
+    mu_assert_int_eq(0, memmgr_heap_trace_get_records(NULL, 0, NULL));
+}
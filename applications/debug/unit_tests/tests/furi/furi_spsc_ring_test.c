@@ -0,0 +1,198 @@
+#include "../test.h" // IWYU pragma: keep
+#include <furi.h>
+#include <furi_hal.h>
+
+#define TAG "TestFuriSpscRing"
+
+#define SPSC_RING_TEST_CAPACITY    (64u)
+#define SPSC_RING_TEST_ITEM_COUNT  (10000u)
+#define SPSC_RING_TEST_BATCH       (16u)
+#define SPSC_RING_BENCH_ITEM_COUNT (256u)
+#define SPSC_RING_BENCH_ROUNDS     (16u)
+
+typedef struct {
+    FuriSpscRing* ring;
+    uint32_t pushed;
+} TestFuriSpscRingData;
+
+typedef struct {
+    FuriEventLoop* event_loop;
+    size_t popped;
+    uint32_t items[4];
+} TestFuriSpscRingEventLoopData;
+
+static void test_furi_spsc_ring_basic(void) {
+    FuriSpscRing* ring = furi_spsc_ring_alloc(sizeof(uint32_t), 8);
+    uint32_t items[16];
+    for(size_t i = 0; i < COUNT_OF(items); i++) {
+        items[i] = i;
+    }
+
+    mu_assert_int_eq(0, furi_spsc_ring_get_count(ring));
+    mu_assert_int_eq(8, furi_spsc_ring_get_space(ring));
+    mu_assert_int_eq(0, furi_spsc_ring_pop(ring, items, 1, 0));
+
+    mu_check(furi_spsc_ring_push(ring, items, 5));
+    mu_assert_int_eq(5, furi_spsc_ring_get_count(ring));
+    mu_assert_int_eq(3, furi_spsc_ring_get_space(ring));
+
+    // All or nothing
+    mu_check(!furi_spsc_ring_push(ring, &items[5], 4));
+    mu_assert_int_eq(5, furi_spsc_ring_get_count(ring));
+
+    uint32_t popped[16] = {0};
+    mu_assert_int_eq(3, furi_spsc_ring_pop(ring, popped, 3, 0));
+    mu_assert_int_eq(0, popped[0]);
+    mu_assert_int_eq(2, popped[2]);
+
+    // Wraps around the end of the storage
+    mu_check(furi_spsc_ring_push(ring, &items[5], 6));
+    mu_assert_int_eq(0, furi_spsc_ring_get_space(ring));
+    mu_check(!furi_spsc_ring_push(ring, &items[11], 1));
+
+    mu_assert_int_eq(8, furi_spsc_ring_pop(ring, popped, COUNT_OF(popped), 0));
+    for(size_t i = 0; i < 8; i++) {
+        mu_assert_int_eq(i + 3, popped[i]);
+    }
+
+    mu_check(furi_spsc_ring_push(ring, items, 4));
+    furi_spsc_ring_reset(ring);
+    mu_assert_int_eq(0, furi_spsc_ring_get_count(ring));
+    mu_assert_int_eq(8, furi_spsc_ring_get_space(ring));
+
+    // Waits for the whole timeout when nothing is pushed
+    const uint32_t start = furi_get_tick();
+    mu_assert_int_eq(0, furi_spsc_ring_pop(ring, popped, 1, 10));
+    mu_check(furi_get_tick() - start >= 10);
+
+    furi_spsc_ring_free(ring);
+}
+
+static int32_t test_furi_spsc_ring_producer(void* context) {
+    TestFuriSpscRingData* data = context;
+
+    while(data->pushed < SPSC_RING_TEST_ITEM_COUNT) {
+        if(furi_spsc_ring_push(data->ring, &data->pushed, 1)) {
+            data->pushed++;
+            // Let the consumer find both an empty and a full ring
+            if((data->pushed % 1000) == 0) furi_delay_ms(2);
+        } else {
+            furi_thread_yield();
+        }
+    }
+
+    return 0;
+}
+
+static void test_furi_spsc_ring_threads(void) {
+    TestFuriSpscRingData data = {
+        .ring = furi_spsc_ring_alloc(sizeof(uint32_t), SPSC_RING_TEST_CAPACITY),
+    };
+
+    FuriThread* producer =
+        furi_thread_alloc_ex("SpscRingProducer", 1024, test_furi_spsc_ring_producer, &data);
+    furi_thread_start(producer);
+
+    uint32_t batch[SPSC_RING_TEST_BATCH];
+    uint32_t expected = 0;
+    bool in_order = true;
+    while(in_order && expected < SPSC_RING_TEST_ITEM_COUNT) {
+        size_t count = furi_spsc_ring_pop(data.ring, batch, COUNT_OF(batch), 1000);
+        if(count == 0) break;
+        for(size_t i = 0; i < count; i++) {
+            if(batch[i] != expected++) in_order = false;
+        }
+    }
+
+    furi_thread_join(producer);
+    furi_thread_free(producer);
+
+    mu_check(in_order);
+    mu_assert_int_eq(SPSC_RING_TEST_ITEM_COUNT, expected);
+    mu_assert_int_eq(0, furi_spsc_ring_get_count(data.ring));
+    furi_spsc_ring_free(data.ring);
+}
+
+static bool test_furi_spsc_ring_event_loop_callback(FuriEventLoopObject* object, void* context) {
+    TestFuriSpscRingEventLoopData* data = context;
+
+    data->popped = furi_spsc_ring_pop(object, data->items, COUNT_OF(data->items), 0);
+    furi_event_loop_stop(data->event_loop);
+
+    return true;
+}
+
+static void test_furi_spsc_ring_event_loop(void) {
+    FuriSpscRing* ring = furi_spsc_ring_alloc(sizeof(uint32_t), 4);
+    TestFuriSpscRingEventLoopData data = {
+        .event_loop = furi_event_loop_alloc(),
+    };
+
+    furi_event_loop_subscribe_spsc_ring(
+        data.event_loop,
+        ring,
+        FuriEventLoopEventIn,
+        test_furi_spsc_ring_event_loop_callback,
+        &data);
+
+    const uint32_t items[] = {1, 2, 0xC0FFEE};
+    mu_check(furi_spsc_ring_push(ring, items, COUNT_OF(items)));
+    furi_event_loop_run(data.event_loop);
+
+    furi_event_loop_unsubscribe(data.event_loop, ring);
+    furi_event_loop_free(data.event_loop);
+    furi_spsc_ring_free(ring);
+
+    mu_assert_int_eq(3, data.popped);
+    mu_assert_int_eq(0xC0FFEE, data.items[2]);
+}
+
+static void test_furi_spsc_ring_benchmark(void) {
+    // Same traffic as the Sub-GHz worker: one duration per capture interrupt
+    FuriSpscRing* ring = furi_spsc_ring_alloc(sizeof(uint32_t), SPSC_RING_BENCH_ITEM_COUNT);
+    FuriStreamBuffer* stream = furi_stream_buffer_alloc(
+        sizeof(uint32_t) * SPSC_RING_BENCH_ITEM_COUNT, sizeof(uint32_t));
+    uint32_t* batch = malloc(sizeof(uint32_t) * SPSC_RING_BENCH_ITEM_COUNT);
+
+    uint32_t start = furi_hal_cortex_timer_get(0).start;
+    for(size_t round = 0; round < SPSC_RING_BENCH_ROUNDS; round++) {
+        for(uint32_t i = 0; i < SPSC_RING_BENCH_ITEM_COUNT; i++) {
+            furi_stream_buffer_send(stream, &i, sizeof(uint32_t), 0);
+        }
+        furi_stream_buffer_receive(
+            stream, batch, sizeof(uint32_t) * SPSC_RING_BENCH_ITEM_COUNT, 0);
+    }
+    const uint32_t stream_cycles = furi_hal_cortex_timer_get(0).start - start;
+    mu_assert_int_eq(SPSC_RING_BENCH_ITEM_COUNT - 1, batch[SPSC_RING_BENCH_ITEM_COUNT - 1]);
+
+    start = furi_hal_cortex_timer_get(0).start;
+    for(size_t round = 0; round < SPSC_RING_BENCH_ROUNDS; round++) {
+        for(uint32_t i = 0; i < SPSC_RING_BENCH_ITEM_COUNT; i++) {
+            furi_spsc_ring_push(ring, &i, 1);
+        }
+        furi_spsc_ring_pop(ring, batch, SPSC_RING_BENCH_ITEM_COUNT, 0);
+    }
+    const uint32_t ring_cycles = furi_hal_cortex_timer_get(0).start - start;
+    mu_assert_int_eq(SPSC_RING_BENCH_ITEM_COUNT - 1, batch[SPSC_RING_BENCH_ITEM_COUNT - 1]);
+
+    const uint32_t items = SPSC_RING_BENCH_ITEM_COUNT * SPSC_RING_BENCH_ROUNDS;
+    FURI_LOG_I(
+        TAG,
+        "%lu items: stream buffer %lu cycles/item, ring %lu cycles/item",
+        items,
+        stream_cycles / items,
+        ring_cycles / items);
+
+    free(batch);
+    furi_stream_buffer_free(stream);
+    furi_spsc_ring_free(ring);
+
+    mu_assert(ring_cycles < stream_cycles, "ring is slower than stream buffer");
+}
+
+void test_furi_spsc_ring(void) {
+    test_furi_spsc_ring_basic();
+    test_furi_spsc_ring_threads();
+    test_furi_spsc_ring_event_loop();
+    test_furi_spsc_ring_benchmark();
+}
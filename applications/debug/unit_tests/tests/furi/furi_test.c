@@ -7,7 +7,12 @@ void test_furi_create_open(void);
 void test_furi_concurrent_access(void);
 void test_furi_pubsub(void);
 void test_furi_memmgr(void);
+void test_furi_memmgr_pools(void);
+void test_furi_memmgr_arena(void);
+void test_furi_memmgr_trace(void);
 void test_furi_event_loop(void);
+void test_furi_spsc_ring(void);
+void test_furi_thread_trace(void);
 void test_errno_saving(void);
 
 static int foo = 0;
@@ -39,10 +44,30 @@ MU_TEST(mu_test_furi_memmgr) {
     test_furi_memmgr();
 }
 
+MU_TEST(mu_test_furi_memmgr_pools) {
+    test_furi_memmgr_pools();
+}
+
+MU_TEST(mu_test_furi_memmgr_arena) {
+    test_furi_memmgr_arena();
+}
+
+MU_TEST(mu_test_furi_memmgr_trace) {
+    test_furi_memmgr_trace();
+}
+
 MU_TEST(mu_test_furi_event_loop) {
     test_furi_event_loop();
 }
 
+MU_TEST(mu_test_furi_spsc_ring) {
+    test_furi_spsc_ring();
+}
+
+MU_TEST(mu_test_furi_thread_trace) {
+    test_furi_thread_trace();
+}
+
 MU_TEST(mu_test_errno_saving) {
     test_errno_saving();
 }
@@ -55,7 +80,12 @@ MU_TEST_SUITE(test_suite) {
     MU_RUN_TEST(mu_test_furi_create_open);
     MU_RUN_TEST(mu_test_furi_pubsub);
     MU_RUN_TEST(mu_test_furi_memmgr);
+    MU_RUN_TEST(mu_test_furi_memmgr_pools);
+    MU_RUN_TEST(mu_test_furi_memmgr_arena);
+    MU_RUN_TEST(mu_test_furi_memmgr_trace);
     MU_RUN_TEST(mu_test_furi_event_loop);
+    MU_RUN_TEST(mu_test_furi_spsc_ring);
+    MU_RUN_TEST(mu_test_furi_thread_trace);
     MU_RUN_TEST(mu_test_errno_saving);
 }
 
@@ -0,0 +1,114 @@
+#include "../test.h" // IWYU pragma: keep
+#include <furi.h>
+#include <furi_hal.h>
+
+#define THREAD_TRACE_TEST_EVENTS   (1024u)
+#define THREAD_TRACE_TEST_DELAY_MS (20u)
+
+typedef struct {
+    FuriEventFlag* flag;
+    FuriThreadId thread_id;
+} TestFuriThreadTraceData;
+
+static int32_t test_furi_thread_trace_waiter(void* context) {
+    TestFuriThreadTraceData* data = context;
+    data->thread_id = furi_thread_get_current_id();
+
+    furi_event_flag_wait(data->flag, 1, FuriFlagWaitAny, FuriWaitForever);
+    furi_delay_ms(THREAD_TRACE_TEST_DELAY_MS);
+
+    return 0;
+}
+
+static size_t test_furi_thread_trace_find(
+    const FuriThreadTraceThread* threads,
+    size_t count,
+    FuriThreadId thread_id) {
+    // Latest index, task memory may have been used by an exited thread before
+    size_t found = count;
+    for(size_t i = 0; i < count; i++) {
+        if(threads[i].thread_id == thread_id) found = i;
+    }
+    return found;
+}
+
+void test_furi_thread_trace(void) {
+    mu_check(furi_thread_trace_start(THREAD_TRACE_TEST_EVENTS));
+    mu_check(furi_thread_trace_is_running());
+    mu_check(!furi_thread_trace_start(THREAD_TRACE_TEST_EVENTS));
+
+    TestFuriThreadTraceData data = {
+        .flag = furi_event_flag_alloc(),
+    };
+    FuriThread* waiter =
+        furi_thread_alloc_ex("TraceWaiter", 1024, test_furi_thread_trace_waiter, &data);
+    furi_thread_start(waiter);
+
+    // Waiter blocks on the flag meanwhile
+    furi_delay_ms(THREAD_TRACE_TEST_DELAY_MS);
+    furi_event_flag_set(data.flag, 1);
+    furi_thread_join(waiter);
+
+    FuriThreadTraceThread* threads =
+        malloc(sizeof(FuriThreadTraceThread) * FURI_THREAD_TRACE_THREADS_MAX);
+    FuriThreadTraceEvent* events = malloc(sizeof(FuriThreadTraceEvent) * THREAD_TRACE_TEST_EVENTS);
+    FuriThreadTraceInfo info;
+    const size_t count = MIN(
+        furi_thread_trace_get_threads(threads, FURI_THREAD_TRACE_THREADS_MAX, &info),
+        (size_t)FURI_THREAD_TRACE_THREADS_MAX);
+    const size_t events_count = furi_thread_trace_get_events(events, THREAD_TRACE_TEST_EVENTS);
+    furi_thread_trace_stop();
+    mu_check(!furi_thread_trace_is_running());
+
+    const uint64_t cycles_per_ms = furi_hal_cortex_instructions_per_microsecond() * 1000ULL;
+    const size_t self = test_furi_thread_trace_find(threads, count, furi_thread_get_current_id());
+    const size_t index = test_furi_thread_trace_find(threads, count, data.thread_id);
+
+    mu_check(info.cycles >= cycles_per_ms * THREAD_TRACE_TEST_DELAY_MS * 2);
+    mu_check(info.events > 0);
+    mu_check(self < count);
+    mu_assert(index < count, "waiter not traced");
+    mu_assert_string_eq("TraceWaiter", threads[index].name);
+    mu_check(threads[index].exited);
+    mu_check(threads[index].switches >= 2);
+    mu_check(threads[index].run_cycles > 0);
+    mu_check(threads[index].run_cycles < info.cycles);
+
+    // Wait times are known within a tick
+    const FuriThreadTraceThread* thread = &threads[index];
+    mu_check(thread->blocked_count[FuriThreadTraceBlockEventFlag] >= 1);
+    mu_check(
+        thread->blocked_cycles[FuriThreadTraceBlockEventFlag] >=
+        cycles_per_ms * (THREAD_TRACE_TEST_DELAY_MS - 2));
+    mu_check(thread->blocked_count[FuriThreadTraceBlockDelay] >= 1);
+    mu_check(
+        thread->blocked_cycles[FuriThreadTraceBlockDelay] >=
+        cycles_per_ms * (THREAD_TRACE_TEST_DELAY_MS - 2));
+
+    uint32_t latencies = 0;
+    for(size_t bucket = 0; bucket < FURI_THREAD_TRACE_HISTOGRAM_SIZE; bucket++) {
+        latencies += thread->latency_histogram[bucket];
+    }
+    mu_check(latencies >= 2);
+    mu_check(thread->latency_total >= thread->latency_max);
+
+    // The flag was set by this thread
+    bool woken_by_self = false;
+    for(size_t i = 0; i < events_count; i++) {
+        if(events[i].type == FuriThreadTraceEventReady && events[i].thread == index &&
+           events[i].arg == self) {
+            woken_by_self = true;
+        }
+    }
+    mu_check(woken_by_self);
+
+    mu_assert_string_eq(
+        "event flag", furi_thread_trace_get_block_name(FuriThreadTraceBlockEventFlag));
+    mu_assert_int_eq(0, furi_thread_trace_get_bucket_start(0));
+    mu_assert_int_eq(256, furi_thread_trace_get_bucket_start(1));
+
+    free(events);
+    free(threads);
+    furi_thread_free(waiter);
+    furi_event_flag_free(data.flag);
+}
@@ -187,6 +187,84 @@ MU_TEST_SUITE(storage_file_64k) {
     MU_RUN_TEST(storage_file_read_write_64k);
 }
 
+#define STORAGE_ASYNC_TEST_FILE       UNIT_TESTS_PATH("async.test")
+#define STORAGE_ASYNC_TEST_CHUNK      200
+#define STORAGE_ASYNC_TEST_CHUNK_LAST 50
+#define STORAGE_ASYNC_TEST_CHUNKS     6
+
+typedef struct {
+    FuriSemaphore* done;
+    size_t bytes[STORAGE_ASYNC_TEST_CHUNKS];
+    size_t completed;
+} StorageAsyncTest;
+
+static void storage_async_test_callback(void* context, size_t bytes) {
+    StorageAsyncTest* test = context;
+    test->bytes[test->completed++] = bytes;
+    furi_semaphore_release(test->done);
+}
+
+MU_TEST(storage_file_async_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    const size_t size = STORAGE_ASYNC_TEST_CHUNK * (STORAGE_ASYNC_TEST_CHUNKS - 1) +
+                        STORAGE_ASYNC_TEST_CHUNK_LAST;
+    uint8_t* data = malloc(size);
+    uint8_t* read_data = malloc(STORAGE_ASYNC_TEST_CHUNK * STORAGE_ASYNC_TEST_CHUNKS);
+    StorageAsyncTest test = {
+        .done = furi_semaphore_alloc(STORAGE_ASYNC_TEST_CHUNKS, 0),
+    };
+
+    for(size_t i = 0; i < size; i++) {
+        data[i] = i % 113;
+    }
+
+    // Writes are served in submission order
+    mu_check(storage_file_open(file, STORAGE_ASYNC_TEST_FILE, FSAM_WRITE, FSOM_CREATE_ALWAYS));
+    mu_check(storage_file_write_async(file, data, size / 2, storage_async_test_callback, &test));
+    mu_check(storage_file_write_async(
+        file, data + size / 2, size - size / 2, storage_async_test_callback, &test));
+    for(size_t i = 0; i < 2; i++) {
+        mu_assert_int_eq(FuriStatusOk, furi_semaphore_acquire(test.done, 1000));
+    }
+    mu_assert_int_eq(size / 2, test.bytes[0]);
+    mu_assert_int_eq(size - size / 2, test.bytes[1]);
+    storage_file_close(file);
+
+    // Sequential reads may be coalesced, last one hits the end of file
+    test.completed = 0;
+    storage_file_set_priority(file, StoragePriorityBackground);
+    mu_check(storage_file_open(file, STORAGE_ASYNC_TEST_FILE, FSAM_READ, FSOM_OPEN_EXISTING));
+    for(size_t i = 0; i < STORAGE_ASYNC_TEST_CHUNKS; i++) {
+        mu_check(storage_file_read_async(
+            file,
+            read_data + i * STORAGE_ASYNC_TEST_CHUNK,
+            STORAGE_ASYNC_TEST_CHUNK,
+            storage_async_test_callback,
+            &test));
+    }
+    for(size_t i = 0; i < STORAGE_ASYNC_TEST_CHUNKS; i++) {
+        mu_assert_int_eq(FuriStatusOk, furi_semaphore_acquire(test.done, 1000));
+    }
+    for(size_t i = 0; i < STORAGE_ASYNC_TEST_CHUNKS - 1; i++) {
+        mu_assert_int_eq(STORAGE_ASYNC_TEST_CHUNK, test.bytes[i]);
+    }
+    mu_assert_int_eq(STORAGE_ASYNC_TEST_CHUNK_LAST, test.bytes[STORAGE_ASYNC_TEST_CHUNKS - 1]);
+    mu_assert_mem_eq(data, read_data, size);
+    storage_file_close(file);
+
+    storage_simply_remove(storage, STORAGE_ASYNC_TEST_FILE);
+    furi_semaphore_free(test.done);
+    free(read_data);
+    free(data);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST_SUITE(storage_file_async) {
+    MU_RUN_TEST(storage_file_async_test);
+}
+
 MU_TEST(storage_dir_open_close) {
     Storage* storage = furi_record_open(RECORD_STORAGE);
     File* file;
@@ -265,6 +343,94 @@ MU_TEST_SUITE(storage_dir) {
     MU_RUN_TEST(storage_dir_exists_test);
 }
 
+#define STORAGE_BATCH_TEST_DIR         UNIT_TESTS_PATH("batch_dir")
+#define STORAGE_BATCH_TEST_ENTRY_COUNT 5000
+
+static void storage_dir_read_batch_setup(void) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    FuriString* path = furi_string_alloc();
+
+    storage_simply_remove_recursive(storage, STORAGE_BATCH_TEST_DIR);
+    mu_assert_int_eq(FSE_OK, storage_common_mkdir(storage, STORAGE_BATCH_TEST_DIR));
+
+    for(size_t i = 0; i < STORAGE_BATCH_TEST_ENTRY_COUNT; i++) {
+        furi_string_printf(path, STORAGE_BATCH_TEST_DIR "/%04zu.sub", i);
+        furi_check(
+            storage_file_open(file, furi_string_get_cstr(path), FSAM_WRITE, FSOM_CREATE_NEW));
+        storage_file_close(file);
+    }
+
+    furi_string_free(path);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
+
+static void storage_dir_read_batch_teardown(void) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    mu_check(storage_simply_remove_recursive(storage, STORAGE_BATCH_TEST_DIR));
+    mu_check(!storage_dir_exists(storage, STORAGE_BATCH_TEST_DIR));
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(storage_dir_read_batch_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* dir = storage_file_alloc(storage);
+
+    // Per-entry reads
+    FileInfo fileinfo;
+    char name[STORAGE_DIR_ENTRY_NAME_SIZE];
+    size_t single_count = 0;
+    uint32_t single_start = furi_get_tick();
+    mu_check(storage_dir_open(dir, STORAGE_BATCH_TEST_DIR));
+    while(storage_dir_read(dir, &fileinfo, name, sizeof(name))) {
+        single_count++;
+    }
+    mu_assert_int_eq(FSE_NOT_EXIST, storage_file_get_error(dir));
+    storage_dir_close(dir);
+    uint32_t single_time = furi_get_tick() - single_start;
+
+    // Batched reads
+    StorageDirEntry* entries = malloc(sizeof(StorageDirEntry) * STORAGE_DIR_READ_BATCH_SIZE);
+    size_t batch_count = 0;
+    size_t entries_cnt;
+    uint32_t batch_start = furi_get_tick();
+    mu_check(storage_dir_open(dir, STORAGE_BATCH_TEST_DIR));
+    do {
+        entries_cnt = storage_dir_read_batch(dir, entries, STORAGE_DIR_READ_BATCH_SIZE);
+        for(size_t i = 0; i < entries_cnt; i++) {
+            mu_check(!file_info_is_dir(&entries[i].fileinfo));
+            mu_assert_int_eq(0, entries[i].fileinfo.size);
+            mu_assert_int_eq(8, strlen(entries[i].name));
+        }
+        batch_count += entries_cnt;
+    } while(entries_cnt == STORAGE_DIR_READ_BATCH_SIZE);
+    mu_assert_int_eq(FSE_NOT_EXIST, storage_file_get_error(dir));
+    storage_dir_close(dir);
+    uint32_t batch_time = furi_get_tick() - batch_start;
+    free(entries);
+
+    mu_assert_int_eq(STORAGE_BATCH_TEST_ENTRY_COUNT, single_count);
+    mu_assert_int_eq(STORAGE_BATCH_TEST_ENTRY_COUNT, batch_count);
+
+    FURI_LOG_I(
+        "StorageTest",
+        "Listing %d entries: %lums one by one, %lums in batches of %d",
+        STORAGE_BATCH_TEST_ENTRY_COUNT,
+        single_time,
+        batch_time,
+        STORAGE_DIR_READ_BATCH_SIZE);
+
+    storage_file_free(dir);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST_SUITE(storage_dir_batch) {
+    storage_dir_read_batch_setup();
+    MU_RUN_TEST(storage_dir_read_batch_test);
+    storage_dir_read_batch_teardown();
+}
+
 static const char* const storage_copy_test_paths[] = {
     "1",
     "11",
@@ -754,7 +920,9 @@ MU_TEST_SUITE(test_md5_calc_suite) {
 int run_minunit_test_storage(void) {
     MU_RUN_SUITE(storage_file);
     MU_RUN_SUITE(storage_file_64k);
+    MU_RUN_SUITE(storage_file_async);
     MU_RUN_SUITE(storage_dir);
+    MU_RUN_SUITE(storage_dir_batch);
     MU_RUN_SUITE(storage_rename);
     MU_RUN_SUITE(test_data_path);
     MU_RUN_SUITE(test_storage_common);
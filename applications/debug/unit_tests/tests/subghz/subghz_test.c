@@ -5,6 +5,9 @@
 #include <lib/subghz/transmitter.h>
 #include <lib/subghz/subghz_keystore.h>
 #include <lib/subghz/subghz_file_encoder_worker.h>
+#include <lib/subghz/subghz_raw_binary.h>
+#include <lib/subghz/subghz_hopper_scheduler.h>
+#include <lib/subghz/subghz_raw_analyzer.h>
 #include <lib/subghz/protocols/protocol_items.h>
 #include <flipper_format/flipper_format_i.h>
 #include <lib/subghz/devices/devices.h>
@@ -19,6 +22,7 @@
 #define TEST_RANDOM_DIR_NAME    EXT_PATH("unit_tests/subghz/test_random_raw.sub")
 #define TEST_RANDOM_COUNT_PARSE 329
 #define TEST_TIMEOUT            10000
+#define TEST_RAW_BINARY_DIR     EXT_PATH(".tmp/unit_tests/subghz")
 
 static SubGhzEnvironment* environment_handler;
 static SubGhzReceiver* receiver_handler;
@@ -63,7 +67,10 @@ static void subghz_test_deinit(void) {
     subghz_environment_free(environment_handler);
 }
 
-static bool subghz_decoder_test(const char* path, const char* name_decoder) {
+static bool subghz_decoder_playlist_test(
+    const char* const* paths,
+    size_t path_count,
+    const char* name_decoder) {
     subghz_test_decoder_count = 0;
     uint32_t test_start = furi_get_tick();
 
@@ -72,7 +79,10 @@ static bool subghz_decoder_test(const char* path, const char* name_decoder) {
 
     if(decoder) {
         file_worker_encoder_handler = subghz_file_encoder_worker_alloc();
-        if(subghz_file_encoder_worker_start(file_worker_encoder_handler, path, NULL)) {
+        for(size_t i = 0; i < path_count; i++) {
+            subghz_file_encoder_worker_add_file(file_worker_encoder_handler, paths[i]);
+        }
+        if(subghz_file_encoder_worker_start(file_worker_encoder_handler, NULL, NULL)) {
             // the worker needs a file in order to open and read part of the file
             furi_delay_ms(100);
 
@@ -106,6 +116,10 @@ static bool subghz_decoder_test(const char* path, const char* name_decoder) {
     }
 }
 
+static bool subghz_decoder_test(const char* path, const char* name_decoder) {
+    return subghz_decoder_playlist_test(&path, 1, name_decoder);
+}
+
 static bool subghz_decode_random_test(const char* path) {
     subghz_test_decoder_count = 0;
     subghz_receiver_reset(receiver_handler);
@@ -868,6 +882,242 @@ MU_TEST(subghz_encoder_dickert_test) {
         "Test encoder " SUBGHZ_PROTOCOL_DICKERT_MAHS_NAME " error\r\n");
 }
 
+static bool subghz_test_files_equal(Storage* storage, const char* path_a, const char* path_b) {
+    File* file_a = storage_file_alloc(storage);
+    File* file_b = storage_file_alloc(storage);
+    uint8_t* buffer_a = malloc(256);
+    uint8_t* buffer_b = malloc(256);
+    bool equal = false;
+
+    if(storage_file_open(file_a, path_a, FSAM_READ, FSOM_OPEN_EXISTING) &&
+       storage_file_open(file_b, path_b, FSAM_READ, FSOM_OPEN_EXISTING) &&
+       storage_file_size(file_a) == storage_file_size(file_b)) {
+        equal = true;
+        size_t read_a;
+        do {
+            read_a = storage_file_read(file_a, buffer_a, 256);
+            size_t read_b = storage_file_read(file_b, buffer_b, 256);
+            if(read_a != read_b || memcmp(buffer_a, buffer_b, read_a) != 0) {
+                equal = false;
+                break;
+            }
+        } while(read_a);
+    }
+
+    free(buffer_a);
+    free(buffer_b);
+    storage_file_free(file_a);
+    storage_file_free(file_b);
+    return equal;
+}
+
+static bool subghz_raw_binary_convert_test(Storage* storage, const char* path) {
+    const char* binary_path = TEST_RAW_BINARY_DIR "/binary.sub";
+    const char* text_path = TEST_RAW_BINARY_DIR "/text.sub";
+    const char* binary_again_path = TEST_RAW_BINARY_DIR "/binary_again.sub";
+
+    uint32_t convert_start = furi_get_tick();
+    if(!subghz_raw_binary_from_text(storage, path, binary_path)) return false;
+    uint32_t convert_time = furi_get_tick() - convert_start;
+
+    // Text and binary forms must carry the same samples
+    if(!subghz_raw_binary_to_text(storage, binary_path, text_path)) return false;
+    if(!subghz_raw_binary_from_text(storage, text_path, binary_again_path)) return false;
+    if(!subghz_test_files_equal(storage, binary_path, binary_again_path)) return false;
+
+    FileInfo text_info, binary_info;
+    if(storage_common_stat(storage, path, &text_info) != FSE_OK) return false;
+    if(storage_common_stat(storage, binary_path, &binary_info) != FSE_OK) return false;
+    FURI_LOG_I(
+        TAG,
+        "%s: text %lu bytes, binary %lu bytes, converted in %lums",
+        path,
+        (uint32_t)text_info.size,
+        (uint32_t)binary_info.size,
+        convert_time);
+
+    return binary_info.size < text_info.size;
+}
+
+MU_TEST(subghz_raw_binary_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove_recursive(storage, TEST_RAW_BINARY_DIR);
+    mu_assert(storage_simply_mkdir(storage, TEST_RAW_BINARY_DIR), "Cannot create test dir\r\n");
+
+    mu_assert(
+        subghz_raw_binary_convert_test(storage, TEST_RANDOM_DIR_NAME),
+        "Test binary RAW convert error\r\n");
+    mu_assert(
+        subghz_raw_binary_convert_test(storage, EXT_PATH("unit_tests/subghz/came_raw.sub")),
+        "Test binary RAW convert error\r\n");
+
+    // Playback of the binary form feeds the decoders exactly as the text one
+    uint32_t playback_start = furi_get_tick();
+    mu_assert(
+        subghz_decoder_test(TEST_RAW_BINARY_DIR "/binary.sub", SUBGHZ_PROTOCOL_CAME_NAME),
+        "Test binary RAW decoder " SUBGHZ_PROTOCOL_CAME_NAME " error\r\n");
+    FURI_LOG_I(TAG, "Binary RAW playback %lums", furi_get_tick() - playback_start);
+
+    storage_simply_remove_recursive(storage, TEST_RAW_BINARY_DIR);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(subghz_file_encoder_playlist_test) {
+    const char* path = EXT_PATH("unit_tests/subghz/came_raw.sub");
+    mu_assert(
+        subghz_decoder_test(path, SUBGHZ_PROTOCOL_CAME_NAME),
+        "Test decoder " SUBGHZ_PROTOCOL_CAME_NAME " error\r\n");
+    uint16_t single_count = subghz_test_decoder_count;
+
+    // Files are played back to back, each one is decoded
+    const char* paths[] = {path, path, path};
+    mu_assert(
+        subghz_decoder_playlist_test(paths, COUNT_OF(paths), SUBGHZ_PROTOCOL_CAME_NAME),
+        "Test playlist decoder " SUBGHZ_PROTOCOL_CAME_NAME " error\r\n");
+    mu_assert(
+        subghz_test_decoder_count > single_count * (COUNT_OF(paths) - 1),
+        "Test playlist file skipped\r\n");
+}
+
+#define HOPPER_TEST_CHANNELS 6
+#define HOPPER_TEST_REVISIT  24
+#define HOPPER_TEST_TICKS    5000
+#define HOPPER_TEST_BUSY     2
+#define HOPPER_TEST_HITS     4
+
+MU_TEST(subghz_hopper_scheduler_test) {
+    SubGhzHopperScheduler* scheduler =
+        subghz_hopper_scheduler_alloc(HOPPER_TEST_CHANNELS, HOPPER_TEST_REVISIT);
+    uint32_t last_visit[HOPPER_TEST_CHANNELS] = {0};
+    uint32_t max_gap = 0;
+    uint32_t hits_ticks = 0;
+
+    // Simulated trace: noise floor everywhere, a strong carrier on one channel
+    // and decodable signals without much RSSI on another one
+    for(uint32_t tick = 1; tick <= HOPPER_TEST_TICKS; tick++) {
+        size_t channel = subghz_hopper_scheduler_get_channel(scheduler);
+        float rssi = -100.0f + (float)(tick % 3);
+        if(channel == HOPPER_TEST_BUSY) rssi = -60.0f + (float)(tick % 5);
+        if(channel == HOPPER_TEST_HITS && (hits_ticks++ % 2) == 0) {
+            subghz_hopper_scheduler_add_hit(scheduler);
+        }
+        subghz_hopper_scheduler_add_rssi(scheduler, rssi);
+
+        if(subghz_hopper_scheduler_tick(scheduler)) {
+            channel = subghz_hopper_scheduler_next(scheduler);
+            max_gap = MAX(max_gap, tick - last_visit[channel]);
+            last_visit[channel] = tick;
+        }
+    }
+
+    mu_assert(max_gap <= HOPPER_TEST_REVISIT, "Revisit time exceeded");
+
+    SubGhzHopperSchedulerStats busy, hits, quiet;
+    subghz_hopper_scheduler_get_stats(scheduler, HOPPER_TEST_BUSY, &busy);
+    subghz_hopper_scheduler_get_stats(scheduler, HOPPER_TEST_HITS, &hits);
+    subghz_hopper_scheduler_get_stats(scheduler, 0, &quiet);
+    mu_assert(busy.ticks > quiet.ticks * 2, "Busy channel dwell too short");
+    mu_assert(hits.ticks > quiet.ticks * 2, "Decode hits ignored");
+    mu_assert_int_eq(quiet.visits, quiet.ticks);
+    mu_assert(hits.hits > 0, "Hits not counted");
+
+    // Quiet bands share the cycle evenly, as the plain round-robin did
+    subghz_hopper_scheduler_reset(scheduler);
+    for(uint32_t tick = 0; tick < HOPPER_TEST_CHANNELS * 10; tick++) {
+        subghz_hopper_scheduler_add_rssi(scheduler, -100.0f);
+        mu_assert(subghz_hopper_scheduler_tick(scheduler), "Quiet channel not left");
+        subghz_hopper_scheduler_next(scheduler);
+    }
+
+    subghz_hopper_scheduler_free(scheduler);
+}
+
+typedef struct {
+    SubGhzRawAnalyzer* analyzer;
+    uint16_t count_came;
+    uint32_t time_last;
+    bool time_ordered;
+} SubGhzRawAnalyzerTest;
+
+static void subghz_raw_analyzer_test_callback(
+    SubGhzReceiver* receiver,
+    SubGhzProtocolDecoderBase* decoder_base,
+    void* context) {
+    UNUSED(receiver);
+    SubGhzRawAnalyzerTest* test = context;
+    uint32_t time = subghz_raw_analyzer_get_time(test->analyzer);
+    if(time < test->time_last) test->time_ordered = false;
+    test->time_last = time;
+    if(!strcmp(decoder_base->protocol->name, SUBGHZ_PROTOCOL_CAME_NAME)) test->count_came++;
+}
+
+MU_TEST(subghz_raw_analyzer_test) {
+    const char* path = EXT_PATH("unit_tests/subghz/came_raw.sub");
+
+    // Decoders split between two threads, results still come in the order of time
+    SubGhzRadioPreset preset = {.name = furi_string_alloc_set("AM650"), .frequency = 433920000};
+    SubGhzRawAnalyzerTest test = {.time_ordered = true};
+    test.analyzer = subghz_raw_analyzer_alloc(environment_handler, 2);
+    subghz_raw_analyzer_set_rx_callback(test.analyzer, subghz_raw_analyzer_test_callback, &test);
+    mu_assert(subghz_raw_analyzer_start(test.analyzer, path, &preset), "Analyzer start error");
+
+    uint32_t test_start = furi_get_tick();
+    while(!subghz_raw_analyzer_is_finished(test.analyzer) &&
+          furi_get_tick() - test_start < TEST_TIMEOUT) {
+        furi_delay_ms(10);
+    }
+    bool finished = subghz_raw_analyzer_is_finished(test.analyzer);
+    subghz_raw_analyzer_stop(test.analyzer);
+    subghz_raw_analyzer_free(test.analyzer);
+    furi_string_free(preset.name);
+
+    mu_assert(finished, "Analyzer timeout");
+    mu_assert(test.count_came > 0, "Analyzer missed " SUBGHZ_PROTOCOL_CAME_NAME);
+    mu_assert(test.time_ordered, "Analyzer results out of order");
+}
+
+MU_TEST(subghz_key_cache_test) {
+    SubGhzKeyCache* cache = subghz_key_cache_alloc();
+    SubGhzKeyCacheStats stats;
+    uint16_t key_index = 0;
+    // Protocols are told apart by the name pointer
+    const char* keeloq = SUBGHZ_PROTOCOL_KEELOQ_NAME;
+    const char* star_line = SUBGHZ_PROTOCOL_STAR_LINE_NAME;
+
+    mu_assert(!subghz_key_cache_get(cache, keeloq, 0x1234567, &key_index), "Empty cache hit");
+    subghz_key_cache_put(cache, keeloq, 0x1234567, 42);
+    mu_assert(subghz_key_cache_get(cache, keeloq, 0x1234567, &key_index), "Remote not cached");
+    mu_assert_int_eq(42, key_index);
+    mu_assert(!subghz_key_cache_get(cache, star_line, 0x1234567, &key_index), "Protocol ignored");
+
+    // Full cache replaces old remotes, the latest one is always found
+    for(uint32_t serial = 0; serial < 1000; serial++) {
+        subghz_key_cache_put(cache, keeloq, serial, serial & 0xFF);
+        mu_assert(subghz_key_cache_get(cache, keeloq, serial, &key_index), "Latest remote lost");
+        mu_assert_int_eq(serial & 0xFF, key_index);
+    }
+    subghz_key_cache_get_stats(cache, &stats);
+    mu_assert_int_eq(1001, stats.hits);
+    mu_assert_int_eq(2, stats.misses);
+    mu_assert(stats.entries <= 64, "Cache overflow");
+
+    subghz_key_cache_reset(cache);
+    subghz_key_cache_get_stats(cache, &stats);
+    mu_assert_int_eq(0, stats.entries);
+    subghz_key_cache_free(cache);
+
+    // Repeated presses of one remote take the key from the cache
+    SubGhzKeyCache* environment_cache = subghz_environment_get_key_cache(environment_handler);
+    subghz_key_cache_reset(environment_cache);
+    mu_assert(
+        subghz_decoder_test(
+            EXT_PATH("unit_tests/subghz/doorhan_raw.sub"), SUBGHZ_PROTOCOL_KEELOQ_NAME),
+        "Test decoder " SUBGHZ_PROTOCOL_KEELOQ_NAME " error\r\n");
+    subghz_key_cache_get_stats(environment_cache, &stats);
+    mu_assert(stats.entries > 0, "Key not cached");
+    mu_assert(stats.hits > 0, "Cached key not used");
+}
+
 MU_TEST(subghz_random_test) {
     mu_assert(subghz_decode_random_test(TEST_RANDOM_DIR_NAME), "Random test error\r\n");
 }
@@ -954,6 +1204,11 @@ MU_TEST_SUITE(subghz) {
     MU_RUN_TEST(subghz_decoder_acurite_592txr_test);
     MU_RUN_TEST(subghz_encoder_dickert_test);
 
+    MU_RUN_TEST(subghz_raw_binary_test);
+    MU_RUN_TEST(subghz_file_encoder_playlist_test);
+    MU_RUN_TEST(subghz_hopper_scheduler_test);
+    MU_RUN_TEST(subghz_raw_analyzer_test);
+    MU_RUN_TEST(subghz_key_cache_test);
     MU_RUN_TEST(subghz_random_test);
     subghz_test_deinit();
 }
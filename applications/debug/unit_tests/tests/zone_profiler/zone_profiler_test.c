@@ -0,0 +1,114 @@
+#include "../test.h" // IWYU pragma: keep
+#include <furi.h>
+#include <furi_hal.h>
+#include <toolbox/zone_profiler.h>
+
+#define ZONE_PROFILER_TEST_ZONE       ZoneProfilerIdNfcListenerRx
+#define ZONE_PROFILER_TEST_ITERATIONS (20000u)
+
+static bool zone_profiler_test_was_enabled;
+
+static void zone_profiler_test_setup(void) {
+    zone_profiler_test_was_enabled = zone_profiler_is_enabled();
+    zone_profiler_set_enabled(true);
+    zone_profiler_reset();
+}
+
+static void zone_profiler_test_teardown(void) {
+    zone_profiler_set_enabled(zone_profiler_test_was_enabled);
+    zone_profiler_reset();
+}
+
+static uint32_t zone_profiler_test_histogram_sum(const ZoneProfilerStats* stats) {
+    uint32_t sum = 0;
+    for(size_t i = 0; i < ZONE_PROFILER_HISTOGRAM_SIZE; i++) {
+        sum += stats->histogram[i];
+    }
+    return sum;
+}
+
+MU_TEST(test_zone_profiler_timing) {
+    ZoneProfilerStats stats;
+    zone_profiler_get_stats(ZONE_PROFILER_TEST_ZONE, &stats);
+    mu_assert_int_eq(0, stats.count);
+    mu_assert_int_eq(0, stats.min);
+    mu_check(stats.name != NULL);
+
+    for(size_t i = 0; i < 4; i++) {
+        const uint32_t start = zone_profiler_begin();
+        mu_check(start != 0);
+        furi_delay_us(100 * (i + 1));
+        zone_profiler_end(ZONE_PROFILER_TEST_ZONE, start);
+    }
+
+    zone_profiler_get_stats(ZONE_PROFILER_TEST_ZONE, &stats);
+    const uint32_t cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+    mu_assert_int_eq(4, stats.count);
+    mu_check(stats.min >= 100 * cycles_per_us);
+    mu_check(stats.min < 200 * cycles_per_us);
+    mu_check(stats.max >= 400 * cycles_per_us);
+    mu_check(stats.total >= 1000ULL * cycles_per_us);
+    mu_assert_int_eq(4, zone_profiler_test_histogram_sum(&stats));
+
+    // Bucket of the shortest call
+    size_t bucket = 1;
+    while(bucket + 1 < ZONE_PROFILER_HISTOGRAM_SIZE &&
+          zone_profiler_get_bucket_start(bucket + 1) <= stats.min) {
+        bucket++;
+    }
+    mu_check(stats.histogram[bucket] >= 1);
+}
+
+MU_TEST(test_zone_profiler_disabled) {
+    zone_profiler_set_enabled(false);
+    const uint32_t start = zone_profiler_begin();
+    mu_assert_int_eq(0, start);
+    zone_profiler_end(ZONE_PROFILER_TEST_ZONE, start);
+
+    // Enabled in between, the zone started while disabled is not counted
+    zone_profiler_set_enabled(true);
+    zone_profiler_end(ZONE_PROFILER_TEST_ZONE, start);
+
+    ZoneProfilerStats stats;
+    zone_profiler_get_stats(ZONE_PROFILER_TEST_ZONE, &stats);
+    mu_assert_int_eq(0, stats.count);
+}
+
+static int32_t zone_profiler_test_worker(void* context) {
+    UNUSED(context);
+    for(size_t i = 0; i < ZONE_PROFILER_TEST_ITERATIONS; i++) {
+        zone_profiler_end(ZONE_PROFILER_TEST_ZONE, zone_profiler_begin());
+    }
+    return 0;
+}
+
+MU_TEST(test_zone_profiler_concurrent) {
+    FuriThread* thread =
+        furi_thread_alloc_ex("ZoneProfilerTest", 1024, zone_profiler_test_worker, NULL);
+    furi_thread_set_priority(thread, furi_thread_get_priority(furi_thread_get_current()));
+    furi_thread_start(thread);
+    zone_profiler_test_worker(NULL);
+    furi_thread_join(thread);
+    furi_thread_free(thread);
+
+    ZoneProfilerStats stats;
+    zone_profiler_get_stats(ZONE_PROFILER_TEST_ZONE, &stats);
+    mu_assert_int_eq(ZONE_PROFILER_TEST_ITERATIONS * 2, stats.count);
+    mu_assert_int_eq(ZONE_PROFILER_TEST_ITERATIONS * 2, zone_profiler_test_histogram_sum(&stats));
+    mu_check(stats.min <= stats.max);
+    mu_check(stats.total >= (uint64_t)stats.min * stats.count);
+}
+
+MU_TEST_SUITE(test_zone_profiler_suite) {
+    MU_SUITE_CONFIGURE(&zone_profiler_test_setup, &zone_profiler_test_teardown);
+    MU_RUN_TEST(test_zone_profiler_timing);
+    MU_RUN_TEST(test_zone_profiler_disabled);
+    MU_RUN_TEST(test_zone_profiler_concurrent);
+}
+
+int run_minunit_test_zone_profiler(void) {
+    MU_RUN_SUITE(test_zone_profiler_suite);
+    return MU_EXIT_CODE;
+}
+
+TEST_API_DEFINE(run_minunit_test_zone_profiler)
@@ -8,6 +8,8 @@
 #include <rpc/rpc_i.h>
 #include <flipper.pb.h>
 #include <applications/system/js_app/js_thread.h>
+#include <gui/canvas_i.h>
+#include <u8g2_glue.h>
 
 static constexpr auto unit_tests_api_table = sort(create_array_t<sym_entry>(
     API_METHOD(resource_manifest_reader_alloc, ResourceManifestReader*, (Storage*)),
@@ -38,4 +40,17 @@ static constexpr auto unit_tests_api_table = sort(create_array_t<sym_entry>(
         JsThread*,
         (const char* script_path, JsThreadCallback callback, void* context)),
     API_METHOD(js_thread_stop, void, (JsThread * worker)),
+    API_METHOD(
+        canvas_draw_u8g2_bitmap,
+        void,
+        (u8g2_t*, int32_t, int32_t, size_t, size_t, const uint8_t*, IconRotation)),
+    API_METHOD(
+        canvas_draw_u8g2_bitmap_generic,
+        void,
+        (u8g2_t*, int32_t, int32_t, size_t, size_t, const uint8_t*, IconRotation)),
+    API_METHOD(
+        u8g2_Setup_st756x_flipper,
+        void,
+        (u8g2_t*, const u8g2_cb_t*, u8x8_msg_cb, u8x8_msg_cb)),
+    API_VARIABLE(u8g2_cb_r0, const u8g2_cb_t),
     API_VARIABLE(PB_Main_msg, PB_Main_msg_t)));
@@ -226,6 +226,67 @@ bool ble_profile_hid_kb_release(FuriHalBleProfileBase* profile, uint16_t button)
         sizeof(FuriHalBtHidKbReport));
 }
 
+bool ble_profile_hid_kb_press_multiple(
+    FuriHalBleProfileBase* profile,
+    const uint16_t* buttons,
+    size_t count) {
+    furi_check(profile);
+    furi_check(profile->config == ble_profile_hid);
+    furi_check(buttons);
+
+    BleProfileHid* hid_profile = (BleProfileHid*)profile;
+    FuriHalBtHidKbReport* kb_report = hid_profile->kb_report;
+    for(size_t i = 0; i < count; i++) {
+        uint8_t key = buttons[i] & 0xFF;
+        uint8_t free_nb = BLE_PROFILE_HID_KB_MAX_KEYS;
+        bool pressed = false;
+        for(uint8_t key_nb = 0; key_nb < BLE_PROFILE_HID_KB_MAX_KEYS; key_nb++) {
+            if(kb_report->key[key_nb] == key) {
+                pressed = true;
+                break;
+            }
+            if(kb_report->key[key_nb] == 0 && free_nb == BLE_PROFILE_HID_KB_MAX_KEYS) {
+                free_nb = key_nb;
+            }
+        }
+        if(key != 0 && !pressed && free_nb < BLE_PROFILE_HID_KB_MAX_KEYS) {
+            kb_report->key[free_nb] = key;
+        }
+        kb_report->mods |= (buttons[i] >> 8);
+    }
+    return ble_svc_hid_update_input_report(
+        hid_profile->hid_svc,
+        ReportNumberKeyboard,
+        (uint8_t*)kb_report,
+        sizeof(FuriHalBtHidKbReport));
+}
+
+bool ble_profile_hid_kb_release_multiple(
+    FuriHalBleProfileBase* profile,
+    const uint16_t* buttons,
+    size_t count) {
+    furi_check(profile);
+    furi_check(profile->config == ble_profile_hid);
+    furi_check(buttons);
+
+    BleProfileHid* hid_profile = (BleProfileHid*)profile;
+    FuriHalBtHidKbReport* kb_report = hid_profile->kb_report;
+    for(size_t i = 0; i < count; i++) {
+        for(uint8_t key_nb = 0; key_nb < BLE_PROFILE_HID_KB_MAX_KEYS; key_nb++) {
+            if(kb_report->key[key_nb] == (buttons[i] & 0xFF)) {
+                kb_report->key[key_nb] = 0;
+                break;
+            }
+        }
+        kb_report->mods &= ~(buttons[i] >> 8);
+    }
+    return ble_svc_hid_update_input_report(
+        hid_profile->hid_svc,
+        ReportNumberKeyboard,
+        (uint8_t*)kb_report,
+        sizeof(FuriHalBtHidKbReport));
+}
+
 bool ble_profile_hid_kb_release_all(FuriHalBleProfileBase* profile) {
     furi_check(profile);
     furi_check(profile->config == ble_profile_hid);
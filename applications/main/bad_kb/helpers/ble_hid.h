@@ -38,6 +38,35 @@ bool ble_profile_hid_kb_press(FuriHalBleProfileBase* profile, uint16_t button);
  */
 bool ble_profile_hid_kb_release(FuriHalBleProfileBase* profile, uint16_t button);
 
+/** Press several keyboard buttons with one report
+ *
+ * Buttons already pressed are left as they are, so a failed update can be
+ * sent again by repeating the call.
+ *
+ * @param profile   profile instance
+ * @param buttons   button codes from HID specification
+ * @param count     number of buttons
+ *
+ * @return          true on success
+ */
+bool ble_profile_hid_kb_press_multiple(
+    FuriHalBleProfileBase* profile,
+    const uint16_t* buttons,
+    size_t count);
+
+/** Release several keyboard buttons with one report
+ *
+ * @param profile   profile instance
+ * @param buttons   button codes from HID specification
+ * @param count     number of buttons
+ *
+ * @return          true on success
+ */
+bool ble_profile_hid_kb_release_multiple(
+    FuriHalBleProfileBase* profile,
+    const uint16_t* buttons,
+    size_t count);
+
 /** Release all keyboard buttons
  *
  * @param profile   profile instance
@@ -20,6 +20,12 @@
 #define BADKB_ASCII_TO_KEY(script, x) \
     (((uint8_t)x < 128) ? (script->layout[(uint8_t)x]) : HID_KEYBOARD_NONE)
 
+/** Keycodes converted from an interpreted string at a time */
+#define DUCKY_STRING_CHUNK_SIZE 32
+/** Attempts to send a report refused by the transport */
+#define DUCKY_REPORT_RETRY_COUNT 10
+#define DUCKY_REPORT_RETRY_MS    5
+
 // Delays for waiting between HID key press and key release
 const uint8_t bt_hid_delays[LevelRssiNum] = {
     60, // LevelRssi122_100
@@ -82,6 +88,15 @@ uint32_t ducky_get_command_len(const char* line) {
     return 0;
 }
 
+uint32_t ducky_hash(const char* str, size_t len) {
+    // FNV-1a
+    uint32_t hash = 2166136261UL;
+    for(size_t i = 0; i < len; i++) {
+        hash = (hash ^ (uint8_t)str[i]) * 16777619UL;
+    }
+    return hash;
+}
+
 bool ducky_is_line_end(const char chr) {
     return ((chr == ' ') || (chr == '\0') || (chr == '\r') || (chr == '\n'));
 }
@@ -127,6 +142,75 @@ void ducky_numlock_on(BadKbScript* bad_kb) {
     }
 }
 
+void ducky_press_key(BadKbScript* bad_kb, uint16_t keycode) {
+    if(bad_kb->bt) {
+        ble_profile_hid_kb_press(bad_kb->app->ble_hid, keycode);
+        furi_delay_ms(bt_timeout);
+        ble_profile_hid_kb_release(bad_kb->app->ble_hid, keycode);
+    } else {
+        furi_hal_hid_kb_press(keycode);
+        furi_hal_hid_kb_release(keycode);
+    }
+}
+
+static bool ducky_send_keys(BadKbScript* bad_kb, const uint16_t* keys, size_t count, bool press) {
+    // USB waits for the previous report to be taken by the host, BLE refuses updates
+    // while the stack has no free buffers. Pressing and releasing is safe to repeat.
+    for(uint32_t i = 0; i < DUCKY_REPORT_RETRY_COUNT; i++) {
+        bool sent;
+        if(bad_kb->bt) {
+            sent = press ? ble_profile_hid_kb_press_multiple(bad_kb->app->ble_hid, keys, count) :
+                           ble_profile_hid_kb_release_multiple(bad_kb->app->ble_hid, keys, count);
+        } else {
+            if(!furi_hal_hid_is_connected()) return false;
+            sent = press ? furi_hal_hid_kb_press_multiple(keys, count) :
+                           furi_hal_hid_kb_release_multiple(keys, count);
+        }
+        if(sent) {
+            bad_kb->string_reports_sent++;
+            return true;
+        }
+        furi_delay_ms(DUCKY_REPORT_RETRY_MS);
+    }
+    return false;
+}
+
+static size_t ducky_batch_len(const uint16_t* keys, size_t count, size_t max) {
+    // Hosts type the keys of a report in report order. Modifiers apply to the
+    // whole report, and a key repeated needs a release in between.
+    size_t len = 1;
+    if((keys[0] & 0xFF) == 0) return len;
+    while(len < count && len < max) {
+        uint16_t key = keys[len];
+        if((key & 0xFF00) != (keys[0] & 0xFF00) || (key & 0xFF) == 0) break;
+        size_t i = 0;
+        while(i < len && (keys[i] & 0xFF) != (key & 0xFF)) {
+            i++;
+        }
+        if(i < len) break;
+        len++;
+    }
+    return len;
+}
+
+bool ducky_type_keys(BadKbScript* bad_kb, const uint16_t* keys, size_t count) {
+    // Batching is opt-in with STRING_BATCH, held keys take report slots
+    size_t batch_max = HID_KB_MAX_KEYS - MIN(bad_kb->key_hold_nb, HID_KB_MAX_KEYS - 1);
+    batch_max = MAX(MIN(batch_max, bad_kb->string_batch), 1U);
+    size_t pos = 0;
+    while(pos < count) {
+        size_t batch = ducky_batch_len(&keys[pos], count - pos, batch_max);
+        if(!ducky_send_keys(bad_kb, &keys[pos], batch, true)) break;
+        if(bad_kb->bt) furi_delay_ms(bt_timeout);
+        // Release is attempted even if it fails, so keys are not left pressed
+        bool released = ducky_send_keys(bad_kb, &keys[pos], batch, false);
+        bad_kb->string_keys_typed += batch;
+        pos += batch;
+        if(!released) break;
+    }
+    return pos == count;
+}
+
 bool ducky_numpad_press(BadKbScript* bad_kb, const char num) {
     if((num < '0') || (num > '9')) return false;
 
@@ -198,38 +282,42 @@ int32_t ducky_error(BadKbScript* bad_kb, const char* text, ...) {
 }
 
 bool ducky_string(BadKbScript* bad_kb, const char* param) {
-    uint32_t i = 0;
+    uint16_t keys[DUCKY_STRING_CHUNK_SIZE];
+    size_t count = 0;
 
-    while(param[i] != '\0') {
-        if(param[i] != '\n') {
-            uint16_t keycode = BADKB_ASCII_TO_KEY(bad_kb, param[i]);
-            if(keycode != HID_KEYBOARD_NONE) {
-                if(bad_kb->bt) {
-                    ble_profile_hid_kb_press(bad_kb->app->ble_hid, keycode);
-                    furi_delay_ms(bt_timeout);
-                    ble_profile_hid_kb_release(bad_kb->app->ble_hid, keycode);
-                } else {
-                    furi_hal_hid_kb_press(keycode);
-                    furi_hal_hid_kb_release(keycode);
-                }
-            }
-        } else {
-            if(bad_kb->bt) {
-                ble_profile_hid_kb_press(bad_kb->app->ble_hid, HID_KEYBOARD_RETURN);
-                furi_delay_ms(bt_timeout);
-                ble_profile_hid_kb_release(bad_kb->app->ble_hid, HID_KEYBOARD_RETURN);
-            } else {
-                furi_hal_hid_kb_press(HID_KEYBOARD_RETURN);
-                furi_hal_hid_kb_release(HID_KEYBOARD_RETURN);
-            }
+    for(uint32_t i = 0; param[i] != '\0'; i++) {
+        uint16_t keycode = (param[i] != '\n') ? BADKB_ASCII_TO_KEY(bad_kb, param[i]) :
+                                                 HID_KEYBOARD_RETURN;
+        if(keycode != HID_KEYBOARD_NONE) {
+            keys[count++] = keycode;
         }
-        i++;
+        if(count == DUCKY_STRING_CHUNK_SIZE) {
+            if(!ducky_type_keys(bad_kb, keys, count)) return false;
+            count = 0;
+        }
+    }
+    if(count > 0) {
+        if(!ducky_type_keys(bad_kb, keys, count)) return false;
     }
     bad_kb->stringdelay = 0;
     return true;
 }
 
 static bool ducky_string_next(BadKbScript* bad_kb) {
+    if(bad_kb->string_keys) {
+        // Compiled script, keycodes are ready
+        if(bad_kb->string_print_pos >= bad_kb->string_keys_len) {
+            // Done, a STRING interpreted from a line must not type these again
+            bad_kb->string_keys = NULL;
+            bad_kb->string_keys_len = 0;
+            return true;
+        }
+        ducky_press_key(bad_kb, bad_kb->string_keys[bad_kb->string_print_pos++]);
+        bad_kb->string_keys_typed++;
+        bad_kb->string_reports_sent += 2;
+        return false;
+    }
+
     if(bad_kb->string_print_pos >= furi_string_size(bad_kb->string_print)) {
         return true;
     }
@@ -260,11 +348,13 @@ static bool ducky_string_next(BadKbScript* bad_kb) {
     }
 
     bad_kb->string_print_pos++;
+    bad_kb->string_keys_typed++;
+    bad_kb->string_reports_sent += 2;
 
     return false;
 }
 
-static int32_t ducky_parse_line(BadKbScript* bad_kb, FuriString* line) {
+int32_t ducky_parse_line(BadKbScript* bad_kb, FuriString* line) {
     uint32_t line_len = furi_string_size(line);
     const char* line_tmp = furi_string_get_cstr(line);
 
@@ -401,25 +491,41 @@ static void ducky_script_preload(BadKbScript* bad_kb, File* script_file) {
     furi_string_reset(bad_kb->line);
 }
 
+static int32_t ducky_script_line_result(BadKbScript* bad_kb, int32_t delay_val, size_t line) {
+    if(delay_val == SCRIPT_STATE_NEXT_LINE) { // Empty line
+        return 0;
+    } else if(delay_val == SCRIPT_STATE_STRING_START) { // Print string with delays
+        return delay_val;
+    } else if(delay_val == SCRIPT_STATE_WAIT_FOR_BTN) { // wait for button
+        return delay_val;
+    } else if(delay_val < 0) { // Script error
+        bad_kb->st.error_line = line;
+        FURI_LOG_E(WORKER_TAG, "Unknown command at line %zu", line);
+        return SCRIPT_STATE_ERROR;
+    } else {
+        return (delay_val + bad_kb->defdelay);
+    }
+}
+
 static int32_t ducky_script_execute_next(BadKbScript* bad_kb, File* script_file) {
     int32_t delay_val = 0;
 
     if(bad_kb->repeat_cnt > 0) {
         bad_kb->repeat_cnt--;
-        delay_val = ducky_parse_line(bad_kb, bad_kb->line_prev);
-        if(delay_val == SCRIPT_STATE_NEXT_LINE) { // Empty line
-            return 0;
-        } else if(delay_val == SCRIPT_STATE_STRING_START) { // Print string with delays
-            return delay_val;
-        } else if(delay_val == SCRIPT_STATE_WAIT_FOR_BTN) { // wait for button
-            return delay_val;
-        } else if(delay_val < 0) { // Script error
-            bad_kb->st.error_line = bad_kb->st.line_cur - 1;
-            FURI_LOG_E(WORKER_TAG, "Unknown command at line %zu", bad_kb->st.line_cur - 1U);
-            return SCRIPT_STATE_ERROR;
+        if(bad_kb->program) {
+            delay_val = ducky_script_execute_op(bad_kb, bad_kb->program_prev);
         } else {
-            return (delay_val + bad_kb->defdelay);
+            delay_val = ducky_parse_line(bad_kb, bad_kb->line_prev);
         }
+        return ducky_script_line_result(bad_kb, delay_val, bad_kb->st.line_cur - 1);
+    }
+
+    if(bad_kb->program) {
+        bad_kb->program_prev = bad_kb->program_cur;
+        bad_kb->program_cur = ducky_script_next_op(bad_kb);
+        if(bad_kb->program_cur == SIZE_MAX) return SCRIPT_STATE_END;
+        delay_val = ducky_script_execute_op(bad_kb, bad_kb->program_cur);
+        return ducky_script_line_result(bad_kb, delay_val, bad_kb->st.line_cur);
     }
 
     furi_string_set(bad_kb->line_prev, bad_kb->line);
@@ -446,19 +552,7 @@ static int32_t ducky_script_execute_next(BadKbScript* bad_kb, File* script_file)
                 bad_kb->buf_start = i + 1;
                 furi_string_trim(bad_kb->line);
                 delay_val = ducky_parse_line(bad_kb, bad_kb->line);
-                if(delay_val == SCRIPT_STATE_NEXT_LINE) { // Empty line
-                    return 0;
-                } else if(delay_val == SCRIPT_STATE_STRING_START) { // Print string with delays
-                    return delay_val;
-                } else if(delay_val == SCRIPT_STATE_WAIT_FOR_BTN) { // wait for button
-                    return delay_val;
-                } else if(delay_val < 0) {
-                    bad_kb->st.error_line = bad_kb->st.line_cur;
-                    FURI_LOG_E(WORKER_TAG, "Unknown command at line %zu", bad_kb->st.line_cur);
-                    return SCRIPT_STATE_ERROR;
-                } else {
-                    return (delay_val + bad_kb->defdelay);
-                }
+                return ducky_script_line_result(bad_kb, delay_val, bad_kb->st.line_cur);
             } else {
                 furi_string_push_back(bad_kb->line, bad_kb->file_buf[i]);
             }
@@ -470,6 +564,14 @@ static int32_t ducky_script_execute_next(BadKbScript* bad_kb, File* script_file)
     return 0;
 }
 
+static void ducky_script_run_prepare(BadKbScript* bad_kb, File* script_file) {
+    bad_kb->string_keys_typed = 0;
+    bad_kb->string_reports_sent = 0;
+    if(!ducky_script_compile(bad_kb, script_file)) {
+        FURI_LOG_W(WORKER_TAG, "Script is too big to compile, interpreting");
+    }
+}
+
 void bad_kb_bt_hid_state_callback(BtStatus status, void* context) {
     furi_assert(context);
     BadKbScript* bad_kb = context;
@@ -583,11 +685,13 @@ static int32_t bad_kb_worker(void* context) {
                 bad_kb->defdelay = 0;
                 bad_kb->stringdelay = 0;
                 bad_kb->defstringdelay = 0;
+                bad_kb->string_batch = 1;
                 bad_kb->repeat_cnt = 0;
                 bad_kb->key_hold_nb = 0;
                 bad_kb->file_end = false;
                 storage_file_seek(script_file, 0, true);
                 bad_kb_script_set_keyboard_layout(bad_kb, bad_kb->keyboard_layout);
+                ducky_script_run_prepare(bad_kb, script_file);
                 worker_state = BadKbStateRunning;
                 bad_kb->st.elapsed = 0;
             } else if(flags & WorkerEvtDisconnect) {
@@ -613,6 +717,7 @@ static int32_t bad_kb_worker(void* context) {
                 bad_kb->defdelay = 0;
                 bad_kb->stringdelay = 0;
                 bad_kb->defstringdelay = 0;
+                bad_kb->string_batch = 1;
                 bad_kb->repeat_cnt = 0;
                 bad_kb->file_end = false;
                 storage_file_seek(script_file, 0, true);
@@ -633,6 +738,7 @@ static int32_t bad_kb_worker(void* context) {
                     update_bt_timeout(bad_kb->bt);
                 }
                 bad_kb_script_set_keyboard_layout(bad_kb, bad_kb->keyboard_layout);
+                ducky_script_run_prepare(bad_kb, script_file);
             } else if(flags & WorkerEvtStartStop) { // Cancel scheduled execution
                 worker_state = BadKbStateNotConnected;
             }
@@ -702,6 +808,13 @@ static int32_t bad_kb_worker(void* context) {
                         furi_hal_hid_kb_release_all();
                     }
                     bad_kb->st.elapsed += (furi_get_tick() - start);
+                    FURI_LOG_I(
+                        WORKER_TAG,
+                        "Typed %lu keys in %lu reports, %lums, %lu keys/s",
+                        bad_kb->string_keys_typed,
+                        bad_kb->string_reports_sent,
+                        bad_kb->st.elapsed,
+                        bad_kb->string_keys_typed * 1000 / MAX(bad_kb->st.elapsed, 1UL));
                     continue;
                 } else if(delay_val == SCRIPT_STATE_STRING_START) { // Start printing string with delays
                     delay_val = bad_kb->defdelay;
@@ -857,6 +970,7 @@ static int32_t bad_kb_worker(void* context) {
 
     storage_file_close(script_file);
     storage_file_free(script_file);
+    ducky_script_program_free(bad_kb);
     furi_string_free(bad_kb->line);
     furi_string_free(bad_kb->line_prev);
     furi_string_free(bad_kb->string_print);
@@ -48,6 +48,17 @@ static int32_t ducky_fnc_strdelay(BadKbScript* bad_kb, const char* line, int32_t
     return 0;
 }
 
+static int32_t ducky_fnc_strbatch(BadKbScript* bad_kb, const char* line, int32_t param) {
+    UNUSED(param);
+
+    line = &line[ducky_get_command_len(line) + 1];
+    bool state = ducky_get_number(line, &bad_kb->string_batch);
+    if(!state) {
+        return ducky_error(bad_kb, "Invalid number %s", line);
+    }
+    return 0;
+}
+
 static int32_t ducky_fnc_defstrdelay(BadKbScript* bad_kb, const char* line, int32_t param) {
     UNUSED(param);
 
@@ -237,6 +248,7 @@ static const DuckyCmd ducky_commands[] = {
     {"STRING_DELAY", ducky_fnc_strdelay, -1},
     {"DEFAULT_STRING_DELAY", ducky_fnc_defstrdelay, -1},
     {"DEFAULTSTRINGDELAY", ducky_fnc_defstrdelay, -1},
+    {"STRING_BATCH", ducky_fnc_strbatch, -1},
     {"REPEAT", ducky_fnc_repeat, -1},
     {"SYSRQ", ducky_fnc_sysrq, -1},
     {"ALTCHAR", ducky_fnc_altchar, -1},
@@ -253,23 +265,59 @@ static const DuckyCmd ducky_commands[] = {
 
 #define WORKER_TAG TAG "Worker"
 
-int32_t ducky_execute_cmd(BadKbScript* bad_kb, const char* line) {
-    size_t cmd_word_len = strcspn(line, " ");
-    for(size_t i = 0; i < COUNT_OF(ducky_commands); i++) {
-        size_t cmd_compare_len = strlen(ducky_commands[i].name);
+/** Command index + 1 by hash of the name, 0 for an empty slot */
+static uint8_t ducky_commands_index[64];
+static bool ducky_commands_index_ready = false;
 
-        if(cmd_compare_len != cmd_word_len) {
-            continue;
+static void ducky_commands_index_build(void) {
+    if(ducky_commands_index_ready) return;
+    for(size_t i = 0; i < COUNT_OF(ducky_commands); i++) {
+        const char* name = ducky_commands[i].name;
+        size_t slot = ducky_hash(name, strlen(name)) % COUNT_OF(ducky_commands_index);
+        while(ducky_commands_index[slot]) {
+            slot = (slot + 1) % COUNT_OF(ducky_commands_index);
         }
+        ducky_commands_index[slot] = i + 1;
+    }
+    ducky_commands_index_ready = true;
+}
+
+int32_t ducky_find_cmd(const char* line) {
+    ducky_commands_index_build();
 
-        if(strncmp(line, ducky_commands[i].name, cmd_compare_len) == 0) {
-            if(ducky_commands[i].callback == NULL) {
-                return 0;
-            } else {
-                return ((ducky_commands[i].callback)(bad_kb, line, ducky_commands[i].param));
-            }
+    size_t cmd_word_len = strcspn(line, " ");
+    size_t slot = ducky_hash(line, cmd_word_len) % COUNT_OF(ducky_commands_index);
+    while(ducky_commands_index[slot]) {
+        const DuckyCmd* cmd = &ducky_commands[ducky_commands_index[slot] - 1];
+        if((strlen(cmd->name) == cmd_word_len) &&
+           (strncmp(line, cmd->name, cmd_word_len) == 0)) {
+            return ducky_commands_index[slot] - 1;
         }
+        slot = (slot + 1) % COUNT_OF(ducky_commands_index);
     }
 
-    return SCRIPT_STATE_CMD_UNKNOWN;
+    return -1;
+}
+
+DuckyCmdType ducky_get_cmd_type(int32_t cmd) {
+    furi_check(cmd >= 0 && cmd < (int32_t)COUNT_OF(ducky_commands));
+    if(ducky_commands[cmd].callback == NULL) {
+        return DuckyCmdTypeNop;
+    } else if(ducky_commands[cmd].callback == ducky_fnc_string) {
+        return (ducky_commands[cmd].param == 1) ? DuckyCmdTypeStringLn : DuckyCmdTypeString;
+    }
+    return DuckyCmdTypeOther;
+}
+
+int32_t ducky_execute_cmd(BadKbScript* bad_kb, const char* line) {
+    int32_t cmd = ducky_find_cmd(line);
+    if(cmd < 0) {
+        return SCRIPT_STATE_CMD_UNKNOWN;
+    }
+
+    if(ducky_commands[cmd].callback == NULL) {
+        return 0;
+    } else {
+        return ((ducky_commands[cmd].callback)(bad_kb, line, ducky_commands[cmd].param));
+    }
 }
@@ -0,0 +1,251 @@
+#include "../bad_kb_app_i.h"
+#include "ducky_script.h"
+#include "ducky_script_i.h"
+
+#define TAG "BadKb"
+
+#define WORKER_TAG TAG "Worker"
+
+/** Script is read in blocks of this size while compiling */
+#define DUCKY_READ_BLOCK_SIZE 512
+#define DUCKY_PROGRAM_ALIGN(x) (((x) + 3U) & ~3U)
+
+typedef enum {
+    DuckyOpSkip, /**< Whitespace only line */
+    DuckyOpNop, /**< Comment or ID, no action */
+    DuckyOpKey, /**< Key with modifiers, payload is the keycode */
+    DuckyOpString, /**< STRING and STRINGLN, payload is keycodes in the script layout */
+    DuckyOpLine, /**< Other commands, payload is the line interpreted on execution */
+} DuckyOp;
+
+typedef struct {
+    uint8_t op;
+    uint8_t reserved;
+    uint16_t size; /**< Payload size, the next op is 4-byte aligned */
+    uint32_t line; /**< Script line number */
+} DuckyOpHeader;
+
+static uint8_t* ducky_program_append(BadKbScript* bad_kb, size_t* capacity, size_t size) {
+    size_t new_size = bad_kb->program_size + DUCKY_PROGRAM_ALIGN(size);
+    if(new_size > DUCKY_PROGRAM_MAX_SIZE) return NULL;
+    if(new_size > *capacity) {
+        while(*capacity < new_size) {
+            *capacity *= 2;
+        }
+        bad_kb->program = realloc(bad_kb->program, *capacity); //-V701
+    }
+    uint8_t* data = &bad_kb->program[bad_kb->program_size];
+    bad_kb->program_size = new_size;
+    return data;
+}
+
+static bool ducky_program_emit(
+    BadKbScript* bad_kb,
+    size_t* capacity,
+    DuckyOp op,
+    uint32_t line,
+    const void* payload,
+    size_t size) {
+    if(size > UINT16_MAX) return false;
+    uint8_t* data = ducky_program_append(bad_kb, capacity, sizeof(DuckyOpHeader) + size);
+    if(!data) return false;
+
+    DuckyOpHeader header = {.op = op, .size = size, .line = line};
+    memcpy(data, &header, sizeof(header));
+    if(size) memcpy(data + sizeof(header), payload, size);
+    return true;
+}
+
+static bool ducky_program_emit_string(
+    BadKbScript* bad_kb,
+    size_t* capacity,
+    uint32_t line,
+    const char* text,
+    bool newline) {
+    // Keycodes are written in place, the payload is shrunk to what was typed
+    size_t max_size = (strlen(text) + 1) * sizeof(uint16_t);
+    if(max_size > UINT16_MAX) return false;
+    size_t op_pos = bad_kb->program_size;
+    if(!ducky_program_append(bad_kb, capacity, sizeof(DuckyOpHeader) + max_size)) return false;
+
+    uint16_t* keys = (uint16_t*)&bad_kb->program[op_pos + sizeof(DuckyOpHeader)];
+    size_t count = 0;
+    for(size_t i = 0; text[i] != '\0'; i++) {
+        if(text[i] == '\n') {
+            keys[count++] = HID_KEYBOARD_RETURN;
+        } else if((uint8_t)text[i] < 128) {
+            uint16_t keycode = bad_kb->layout[(uint8_t)text[i]];
+            if(keycode != HID_KEYBOARD_NONE) keys[count++] = keycode;
+        }
+    }
+    if(newline) keys[count++] = HID_KEYBOARD_RETURN;
+
+    DuckyOpHeader header = {
+        .op = DuckyOpString,
+        .size = count * sizeof(uint16_t),
+        .line = line,
+    };
+    memcpy(&bad_kb->program[op_pos], &header, sizeof(header));
+    bad_kb->program_size = op_pos + sizeof(header) + DUCKY_PROGRAM_ALIGN(header.size);
+    return true;
+}
+
+static bool ducky_compile_line(
+    BadKbScript* bad_kb,
+    size_t* capacity,
+    uint32_t line_nb,
+    FuriString* line) {
+    size_t line_len = furi_string_size(line);
+    const char* line_tmp = furi_string_get_cstr(line);
+
+    if(line_len == 0) {
+        return ducky_program_emit(bad_kb, capacity, DuckyOpSkip, line_nb, NULL, 0);
+    }
+
+    // Same decisions as ducky_parse_line, taken once
+    int32_t cmd = ducky_find_cmd(line_tmp);
+    if(cmd >= 0) {
+        DuckyCmdType type = ducky_get_cmd_type(cmd);
+        if(type == DuckyCmdTypeNop) {
+            return ducky_program_emit(bad_kb, capacity, DuckyOpNop, line_nb, NULL, 0);
+        } else if(
+            (type == DuckyCmdTypeString || type == DuckyCmdTypeStringLn) &&
+            ducky_program_emit_string(
+                bad_kb,
+                capacity,
+                line_nb,
+                &line_tmp[ducky_get_command_len(line_tmp) + 1],
+                type == DuckyCmdTypeStringLn)) {
+            return true;
+        }
+    } else {
+        uint16_t key = ducky_get_keycode(bad_kb, line_tmp, false);
+        if(key != HID_KEYBOARD_NONE) {
+            if((key & 0xFF00) != 0) {
+                uint32_t offset = ducky_get_command_len(line_tmp) + 1;
+                if(offset != 1 && line_len > offset) {
+                    key |= ducky_get_keycode(bad_kb, line_tmp + offset, true);
+                }
+            }
+            return ducky_program_emit(bad_kb, capacity, DuckyOpKey, line_nb, &key, sizeof(key));
+        }
+    }
+
+    // Commands with side effects on parsing, and errors reported when reached
+    return ducky_program_emit(bad_kb, capacity, DuckyOpLine, line_nb, line_tmp, line_len + 1);
+}
+
+bool ducky_script_compile(BadKbScript* bad_kb, File* script_file) {
+    ducky_script_program_free(bad_kb);
+
+    size_t capacity = 1024;
+    bad_kb->program = malloc(capacity);
+    bad_kb->program_size = 0;
+
+    uint8_t* block = malloc(DUCKY_READ_BLOCK_SIZE);
+    uint32_t line_nb = 0;
+    bool success = true;
+    size_t read = 0;
+
+    storage_file_seek(script_file, 0, true);
+    furi_string_reset(bad_kb->line);
+
+    // Lines are split the same way as by ducky_script_execute_next
+    do {
+        read = storage_file_read(script_file, block, DUCKY_READ_BLOCK_SIZE);
+        for(size_t i = 0; (i < read) && success; i++) {
+            if(block[i] == '\n' && furi_string_size(bad_kb->line) > 0) {
+                line_nb++;
+                furi_string_trim(bad_kb->line);
+                success = ducky_compile_line(bad_kb, &capacity, line_nb, bad_kb->line);
+                furi_string_reset(bad_kb->line);
+            } else {
+                furi_string_push_back(bad_kb->line, block[i]);
+            }
+        }
+    } while((read > 0) && success);
+
+    if(success && furi_string_size(bad_kb->line) > 0) {
+        line_nb++;
+        furi_string_trim(bad_kb->line);
+        success = ducky_compile_line(bad_kb, &capacity, line_nb, bad_kb->line);
+    }
+
+    free(block);
+    furi_string_reset(bad_kb->line);
+    storage_file_seek(script_file, 0, true);
+
+    if(success) {
+        FURI_LOG_I(
+            WORKER_TAG, "Compiled %lu lines to %zu bytes", line_nb, bad_kb->program_size);
+        bad_kb->program_pos = 0;
+        bad_kb->program_cur = SIZE_MAX;
+        bad_kb->program_prev = SIZE_MAX;
+    } else {
+        ducky_script_program_free(bad_kb);
+    }
+
+    return success;
+}
+
+void ducky_script_program_free(BadKbScript* bad_kb) {
+    free(bad_kb->program);
+    bad_kb->program = NULL;
+    bad_kb->program_size = 0;
+    bad_kb->string_keys = NULL;
+    bad_kb->string_keys_len = 0;
+}
+
+size_t ducky_script_next_op(BadKbScript* bad_kb) {
+    if(bad_kb->program_pos >= bad_kb->program_size) return SIZE_MAX;
+
+    size_t op_pos = bad_kb->program_pos;
+    DuckyOpHeader header;
+    memcpy(&header, &bad_kb->program[op_pos], sizeof(header));
+    bad_kb->program_pos += sizeof(header) + DUCKY_PROGRAM_ALIGN(header.size);
+    bad_kb->st.line_cur = header.line;
+    return op_pos;
+}
+
+int32_t ducky_script_execute_op(BadKbScript* bad_kb, size_t op_pos) {
+    // REPEAT at the first line repeats nothing
+    if(op_pos == SIZE_MAX) return SCRIPT_STATE_NEXT_LINE;
+
+    DuckyOpHeader header;
+    memcpy(&header, &bad_kb->program[op_pos], sizeof(header));
+    const uint8_t* payload = &bad_kb->program[op_pos + sizeof(header)];
+
+    switch(header.op) {
+    case DuckyOpSkip:
+        return SCRIPT_STATE_NEXT_LINE;
+    case DuckyOpNop:
+        return 0;
+    case DuckyOpKey: {
+        uint16_t key;
+        memcpy(&key, payload, sizeof(key));
+        ducky_press_key(bad_kb, key);
+        return 0;
+    }
+    case DuckyOpString: {
+        const uint16_t* keys = (const uint16_t*)payload;
+        size_t count = header.size / sizeof(uint16_t);
+        if(bad_kb->stringdelay == 0 && bad_kb->defstringdelay == 0) {
+            if(!ducky_type_keys(bad_kb, keys, count)) {
+                return ducky_error(bad_kb, "Keyboard report not sent");
+            }
+            return 0;
+        }
+        bad_kb->string_keys = keys;
+        bad_kb->string_keys_len = count;
+        return SCRIPT_STATE_STRING_START;
+    }
+    case DuckyOpLine:
+        // Delayed STRING started from the line types its own text
+        bad_kb->string_keys = NULL;
+        bad_kb->string_keys_len = 0;
+        furi_string_set_str(bad_kb->line, (const char*)payload);
+        return ducky_parse_line(bad_kb, bad_kb->line);
+    default:
+        furi_crash();
+    }
+}
@@ -6,6 +6,7 @@ extern "C" {
 
 #include <furi.h>
 #include <furi_hal.h>
+#include <storage/storage.h>
 #include "ducky_script.h"
 
 #define SCRIPT_STATE_ERROR        (-1)
@@ -17,6 +18,16 @@ extern "C" {
 
 #define FILE_BUFFER_LEN 16
 
+/** Largest compiled script, bigger scripts are interpreted line by line */
+#define DUCKY_PROGRAM_MAX_SIZE (32 * 1024)
+
+typedef enum {
+    DuckyCmdTypeNop,
+    DuckyCmdTypeString,
+    DuckyCmdTypeStringLn,
+    DuckyCmdTypeOther,
+} DuckyCmdType;
+
 struct BadKbScript {
     FuriThread* thread;
     BadKbState st;
@@ -31,6 +42,7 @@ struct BadKbScript {
     uint32_t defdelay;
     uint32_t stringdelay;
     uint32_t defstringdelay;
+    uint32_t string_batch;
     uint16_t layout[128];
 
     FuriString* line;
@@ -40,11 +52,23 @@ struct BadKbScript {
 
     FuriString* string_print;
     size_t string_print_pos;
+    const uint16_t* string_keys;
+    size_t string_keys_len;
+    uint32_t string_keys_typed;
+    uint32_t string_reports_sent;
+
+    uint8_t* program;
+    size_t program_size;
+    size_t program_pos;
+    size_t program_cur;
+    size_t program_prev;
 
     Bt* bt;
     BadKbApp* app;
 };
 
+uint32_t ducky_hash(const char* str, size_t len);
+
 uint16_t ducky_get_keycode(BadKbScript* bad_kb, const char* param, bool accept_chars);
 
 uint32_t ducky_get_command_len(const char* line);
@@ -67,8 +91,26 @@ bool ducky_altstring(BadKbScript* bad_kb, const char* param);
 
 bool ducky_string(BadKbScript* bad_kb, const char* param);
 
+int32_t ducky_find_cmd(const char* line);
+
+DuckyCmdType ducky_get_cmd_type(int32_t cmd);
+
 int32_t ducky_execute_cmd(BadKbScript* bad_kb, const char* line);
 
+int32_t ducky_parse_line(BadKbScript* bad_kb, FuriString* line);
+
+void ducky_press_key(BadKbScript* bad_kb, uint16_t keycode);
+
+bool ducky_type_keys(BadKbScript* bad_kb, const uint16_t* keys, size_t count);
+
+bool ducky_script_compile(BadKbScript* bad_kb, File* script_file);
+
+void ducky_script_program_free(BadKbScript* bad_kb);
+
+int32_t ducky_script_execute_op(BadKbScript* bad_kb, size_t op_pos);
+
+size_t ducky_script_next_op(BadKbScript* bad_kb);
+
 int32_t ducky_error(BadKbScript* bad_kb, const char* text, ...);
 
 #ifdef __cplusplus
@@ -108,26 +108,57 @@ static const DuckyKey ducky_media_keys[] = {
     {"BRIGHT_DOWN", HID_CONSUMER_BRIGHTNESS_DECREMENT},
 };
 
-uint16_t ducky_get_keycode_by_name(const char* param) {
-    for(size_t i = 0; i < COUNT_OF(ducky_keys); i++) {
-        size_t key_cmd_len = strlen(ducky_keys[i].name);
-        if((strncmp(param, ducky_keys[i].name, key_cmd_len) == 0) &&
-           (ducky_is_line_end(param[key_cmd_len]))) {
-            return ducky_keys[i].keycode;
+/** Key index + 1 by hash of the name, 0 for an empty slot */
+typedef struct {
+    uint8_t slots[128];
+    bool ready;
+} DuckyKeyIndex;
+
+static DuckyKeyIndex ducky_keys_index;
+static DuckyKeyIndex ducky_media_keys_index;
+
+static const DuckyKey* ducky_find_key(
+    DuckyKeyIndex* index,
+    const DuckyKey* keys,
+    size_t keys_count,
+    const char* param) {
+    if(!index->ready) {
+        for(size_t i = 0; i < keys_count; i++) {
+            const char* name = keys[i].name;
+            size_t slot = ducky_hash(name, strlen(name)) % COUNT_OF(index->slots);
+            while(index->slots[slot]) {
+                slot = (slot + 1) % COUNT_OF(index->slots);
+            }
+            index->slots[slot] = i + 1;
         }
+        index->ready = true;
     }
 
-    return HID_KEYBOARD_NONE;
-}
+    size_t key_len = 0;
+    while(!ducky_is_line_end(param[key_len])) {
+        key_len++;
+    }
 
-uint16_t ducky_get_media_keycode_by_name(const char* param) {
-    for(size_t i = 0; i < COUNT_OF(ducky_media_keys); i++) {
-        size_t key_cmd_len = strlen(ducky_media_keys[i].name);
-        if((strncmp(param, ducky_media_keys[i].name, key_cmd_len) == 0) &&
-           (ducky_is_line_end(param[key_cmd_len]))) {
-            return ducky_media_keys[i].keycode;
+    size_t slot = ducky_hash(param, key_len) % COUNT_OF(index->slots);
+    while(index->slots[slot]) {
+        const DuckyKey* key = &keys[index->slots[slot] - 1];
+        if((strlen(key->name) == key_len) && (strncmp(param, key->name, key_len) == 0)) {
+            return key;
         }
+        slot = (slot + 1) % COUNT_OF(index->slots);
     }
 
-    return HID_CONSUMER_UNASSIGNED;
+    return NULL;
+}
+
+uint16_t ducky_get_keycode_by_name(const char* param) {
+    const DuckyKey* key =
+        ducky_find_key(&ducky_keys_index, ducky_keys, COUNT_OF(ducky_keys), param);
+    return key ? key->keycode : HID_KEYBOARD_NONE;
+}
+
+uint16_t ducky_get_media_keycode_by_name(const char* param) {
+    const DuckyKey* key = ducky_find_key(
+        &ducky_media_keys_index, ducky_media_keys, COUNT_OF(ducky_media_keys), param);
+    return key ? key->keycode : HID_CONSUMER_UNASSIGNED;
 }
@@ -8,6 +8,9 @@
 #include <flipper_application/plugins/composite_resolver.h>
 #include <loader/firmware_api/firmware_api.h>
 
+#include <nfc/protocols/iso14443_3a/iso14443_3a.h>
+#include <bit_lib/bit_lib.h>
+
 #include <furi.h>
 #include <path.h>
 #include <m-array.h>
@@ -27,6 +30,9 @@ typedef struct {
     FuriString* name;
     NfcProtocol protocol;
     NfcSupportedCardsPluginFeature feature;
+    NfcSupportedCardPluginMatch match;
+    uint32_t load_time; /**< Duration of the last plugin load, ms */
+    uint32_t verify_time; /**< Duration of the last verify() call, ms */
 } NfcSupportedCardsPluginCache;
 
 ARRAY_DEF(NfcSupportedCardsPluginCache, NfcSupportedCardsPluginCache, M_POD_OPLIST);
@@ -191,6 +197,7 @@ void nfc_supported_cards_load_cache(NfcSupportedCards* instance) {
             NfcSupportedCardsPluginCache plugin_cache = {}; //-V779
             plugin_cache.name = furi_string_alloc_set(instance->load_context->file_name);
             plugin_cache.protocol = plugin->protocol;
+            plugin_cache.match = plugin->match;
             if(plugin->verify) {
                 plugin_cache.feature |= NfcSupportedCardsPluginFeatureHasVerify;
             }
@@ -217,12 +224,99 @@ void nfc_supported_cards_load_cache(NfcSupportedCards* instance) {
     } while(false);
 }
 
+static bool nfc_supported_cards_match_keys(
+    const NfcSupportedCardPluginMatch* match,
+    const NfcDevice* device,
+    bool data_complete) {
+    const MfClassicData* data = nfc_device_get_data(device, NfcProtocolMfClassic);
+    if(match->key_sector >= mf_classic_get_total_sectors_num(data->type)) return false;
+
+    // Live data is incomplete, so only keys which were already found can rule the plugin out
+    if(!mf_classic_is_key_found(data, match->key_sector, match->key_type)) return !data_complete;
+
+    const MfClassicSectorTrailer* sec_tr =
+        mf_classic_get_sector_trailer_by_sector(data, match->key_sector);
+    const MfClassicKey* key = (match->key_type == MfClassicKeyTypeA) ? &sec_tr->key_a :
+                                                                       &sec_tr->key_b;
+    const uint64_t key_value = bit_lib_bytes_to_num_be(key->data, COUNT_OF(key->data));
+
+    bool key_matched = false;
+    for(size_t i = 0; i < match->key_count; i++) {
+        if(match->keys[i] == key_value) {
+            key_matched = true;
+            break;
+        }
+    }
+
+    return key_matched;
+}
+
+static bool nfc_supported_cards_match(
+    const NfcSupportedCardPluginMatch* match,
+    const NfcDevice* device,
+    bool data_complete) {
+    bool matched = false;
+    const NfcProtocol protocol = nfc_device_get_protocol(device);
+
+    do {
+        if(match->uid_prefix_len) {
+            size_t uid_len = 0;
+            const uint8_t* uid = nfc_device_get_uid(device, &uid_len);
+            if(uid_len < match->uid_prefix_len) break;
+            if(memcmp(uid, match->uid_prefix, match->uid_prefix_len) != 0) break;
+        }
+
+        if((match->sak_mask || match->atqa_mask) &&
+           ((protocol == NfcProtocolIso14443_3a) ||
+            nfc_protocol_has_parent(protocol, NfcProtocolIso14443_3a))) {
+            const Iso14443_3aData* iso14443_3a_data =
+                nfc_device_get_data(device, NfcProtocolIso14443_3a);
+
+            const uint8_t sak = iso14443_3a_get_sak(iso14443_3a_data);
+            if((sak & match->sak_mask) != (match->sak & match->sak_mask)) break;
+
+            uint8_t atqa[2] = {};
+            iso14443_3a_get_atqa(iso14443_3a_data, atqa);
+            const uint16_t atqa_value = (atqa[0] << 8) | atqa[1];
+            if((atqa_value & match->atqa_mask) != (match->atqa & match->atqa_mask)) break;
+        }
+
+        if(match->key_count && (protocol == NfcProtocolMfClassic)) {
+            if(!nfc_supported_cards_match_keys(match, device, data_complete)) break;
+        }
+
+        matched = true;
+    } while(false);
+
+    return matched;
+}
+
+static const NfcSupportedCardsPlugin* nfc_supported_cards_load_plugin(
+    NfcSupportedCards* instance,
+    NfcSupportedCardsPluginCache* plugin_cache) {
+    const ElfApiInterface* api_interface = composite_api_resolver_get(instance->api_resolver);
+
+    const uint32_t start = furi_get_tick();
+    const NfcSupportedCardsPlugin* plugin = nfc_supported_cards_get_plugin(
+        instance->load_context, furi_string_get_cstr(plugin_cache->name), api_interface);
+    plugin_cache->load_time = furi_get_tick() - start;
+
+    FURI_LOG_D(
+        TAG,
+        "Plugin %s loaded in %lums",
+        furi_string_get_cstr(plugin_cache->name),
+        plugin_cache->load_time);
+
+    return plugin;
+}
+
 bool nfc_supported_cards_read(NfcSupportedCards* instance, NfcDevice* device, Nfc* nfc) {
     furi_assert(instance);
     furi_assert(device);
     furi_assert(nfc);
 
     bool card_read = false;
+    size_t candidates = 0;
     NfcProtocol protocol = nfc_device_get_protocol(device);
 
     do {
@@ -237,15 +331,24 @@ bool nfc_supported_cards_read(NfcSupportedCards* instance, NfcDevice* device, Nf
             NfcSupportedCardsPluginCache* plugin_cache = NfcSupportedCardsPluginCache_ref(iter);
             if(plugin_cache->protocol != protocol) continue;
             if((plugin_cache->feature & NfcSupportedCardsPluginFeatureHasRead) == 0) continue;
+            if(!nfc_supported_cards_match(&plugin_cache->match, device, false)) continue;
+            candidates++;
 
-            const ElfApiInterface* api_interface =
-                composite_api_resolver_get(instance->api_resolver);
-            const NfcSupportedCardsPlugin* plugin = nfc_supported_cards_get_plugin(
-                instance->load_context, furi_string_get_cstr(plugin_cache->name), api_interface);
+            const NfcSupportedCardsPlugin* plugin =
+                nfc_supported_cards_load_plugin(instance, plugin_cache);
             if(plugin == NULL) continue;
 
             if(plugin->verify) {
-                if(!plugin->verify(nfc)) continue;
+                const uint32_t start = furi_get_tick();
+                const bool verified = plugin->verify(nfc);
+                plugin_cache->verify_time = furi_get_tick() - start;
+                FURI_LOG_D(
+                    TAG,
+                    "Plugin %s verified in %lums: %s",
+                    furi_string_get_cstr(plugin_cache->name),
+                    plugin_cache->verify_time,
+                    verified ? "ok" : "fail");
+                if(!verified) continue;
             }
 
             if(plugin->read) {
@@ -256,6 +359,7 @@ bool nfc_supported_cards_read(NfcSupportedCards* instance, NfcDevice* device, Nf
             }
         }
 
+        FURI_LOG_D(TAG, "Read: %zu plugin(s) matched", candidates);
         nfc_supported_cards_load_context_free(instance->load_context);
     } while(false);
 
@@ -271,6 +375,7 @@ bool nfc_supported_cards_parse(
     furi_assert(parsed_data);
 
     bool card_parsed = false;
+    size_t candidates = 0;
     NfcProtocol protocol = nfc_device_get_protocol(device);
 
     do {
@@ -285,11 +390,11 @@ bool nfc_supported_cards_parse(
             NfcSupportedCardsPluginCache* plugin_cache = NfcSupportedCardsPluginCache_ref(iter);
             if(plugin_cache->protocol != protocol) continue;
             if((plugin_cache->feature & NfcSupportedCardsPluginFeatureHasParse) == 0) continue;
+            if(!nfc_supported_cards_match(&plugin_cache->match, device, true)) continue;
+            candidates++;
 
-            const ElfApiInterface* api_interface =
-                composite_api_resolver_get(instance->api_resolver);
-            const NfcSupportedCardsPlugin* plugin = nfc_supported_cards_get_plugin(
-                instance->load_context, furi_string_get_cstr(plugin_cache->name), api_interface);
+            const NfcSupportedCardsPlugin* plugin =
+                nfc_supported_cards_load_plugin(instance, plugin_cache);
             if(plugin == NULL) continue;
 
             if(plugin->parse) {
@@ -300,6 +405,7 @@ bool nfc_supported_cards_parse(
             }
         }
 
+        FURI_LOG_D(TAG, "Parse: %zu plugin(s) matched", candidates);
         nfc_supported_cards_load_context_free(instance->load_context);
     } while(false);
 
@@ -153,6 +153,13 @@ static const NfcSupportedCardsPlugin aime_plugin = {
     .verify = aime_verify,
     .read = aime_read,
     .parse = aime_parse,
+    .match =
+        {
+            .key_sector = 0,
+            .key_type = MfClassicKeyTypeA,
+            .key_count = 1,
+            .keys = {0x574343467632},
+        },
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
@@ -332,6 +332,13 @@ static const NfcSupportedCardsPlugin bip_plugin = {
     .verify = bip_verify,
     .read = bip_read,
     .parse = bip_parse,
+    .match =
+        {
+            .key_sector = 0,
+            .key_type = MfClassicKeyTypeA,
+            .key_count = 1,
+            .keys = {0x3a42f33af429},
+        },
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
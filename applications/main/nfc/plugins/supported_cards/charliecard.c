@@ -1261,6 +1261,13 @@ static const NfcSupportedCardsPlugin charliecard_plugin = {
     .verify = charliecard_verify,
     .read = charliecard_read,
     .parse = charliecard_parse,
+    .match =
+        {
+            .key_sector = 3,
+            .key_type = MfClassicKeyTypeA,
+            .key_count = 1,
+            .keys = {0x5EC39B022F2B},
+        },
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
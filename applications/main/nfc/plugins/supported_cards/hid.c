@@ -137,6 +137,13 @@ static const NfcSupportedCardsPlugin hid_plugin = {
     .verify = hid_verify,
     .read = hid_read,
     .parse = hid_parse,
+    .match =
+        {
+            .key_sector = 1,
+            .key_type = MfClassicKeyTypeA,
+            .key_count = 1,
+            .keys = {0x484944204953},
+        },
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
@@ -399,6 +399,13 @@ static const NfcSupportedCardsPlugin kazan_plugin = {
     .verify = kazan_verify,
     .read = kazan_read,
     .parse = kazan_parse,
+    .match =
+        {
+            .key_sector = 8,
+            .key_type = MfClassicKeyTypeA,
+            .key_count = 2,
+            .keys = {0xE954024EE754, 0x2058EAEE8446},
+        },
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
@@ -175,6 +175,13 @@ static const NfcSupportedCardsPlugin metromoney_plugin = {
     .verify = metromoney_verify,
     .read = metromoney_read,
     .parse = metromoney_parse,
+    .match =
+        {
+            .key_sector = 1,
+            .key_type = MfClassicKeyTypeA,
+            .key_count = 1,
+            .keys = {0x9C616585E26D},
+        },
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
@@ -13,6 +13,8 @@
  *
  * To add a new plugin, create a uniquely-named .c file in the `supported_cards` directory
  * and implement at least the parse() function in the NfcSupportedCardsPlugin structure.
+ * If the card can be recognised by static properties (SAK, UID prefix, known sector keys),
+ * describe them in the match field, so the plugin is not even loaded for unrelated cards.
  * Then, register the plugin in the `application.fam` file in the `nfc` directory. Use the existing
  * entries as an example. After being registered, the plugin will be automatically deployed with the application.
  *
@@ -27,6 +29,7 @@
 
 #include <nfc/nfc.h>
 #include <nfc/nfc_device.h>
+#include <nfc/protocols/mf_classic/mf_classic.h>
 
 /**
  * @brief Unique string identifier for supported card plugins.
@@ -36,7 +39,41 @@
 /**
  * @brief Currently supported plugin API version.
  */
-#define NFC_SUPPORTED_CARD_PLUGIN_API_VERSION 1
+#define NFC_SUPPORTED_CARD_PLUGIN_API_VERSION 2
+
+/**
+ * @brief Maximum length of the UID prefix in a match descriptor.
+ */
+#define NFC_SUPPORTED_CARD_PLUGIN_MATCH_UID_PREFIX_MAX 4
+
+/**
+ * @brief Maximum number of alternative sector keys in a match descriptor.
+ */
+#define NFC_SUPPORTED_CARD_PLUGIN_MATCH_KEYS_MAX 4
+
+/**
+ * @brief Static match descriptor.
+ *
+ * Describes cheap properties the card must have for the plugin to be applicable.
+ * The descriptor is copied when plugins are enumerated, so that candidates can be
+ * filtered out before their code is loaded into memory. Every criterion is optional
+ * and is disabled when its mask, length or count is zero, so a zero-initialised
+ * descriptor matches any card of the plugin protocol.
+ *
+ * The criteria are only used as a prefilter: the plugin must still perform its own checks.
+ */
+typedef struct {
+    uint8_t sak; /**< Expected ISO14443-3A SAK value, compared under sak_mask. */
+    uint8_t sak_mask; /**< Mask of significant SAK bits, 0 to skip the check. */
+    uint16_t atqa; /**< Expected ISO14443-3A ATQA value (atqa[0] << 8 | atqa[1]). */
+    uint16_t atqa_mask; /**< Mask of significant ATQA bits, 0 to skip the check. */
+    uint8_t uid_prefix[NFC_SUPPORTED_CARD_PLUGIN_MATCH_UID_PREFIX_MAX]; /**< Leading UID bytes. */
+    uint8_t uid_prefix_len; /**< Number of significant bytes in uid_prefix, 0 to skip the check. */
+    uint8_t key_sector; /**< MIFARE Classic sector, which trailer holds one of keys. */
+    MfClassicKeyType key_type; /**< MIFARE Classic key type to check. */
+    uint8_t key_count; /**< Number of alternative keys, 0 to skip the check. */
+    uint64_t keys[NFC_SUPPORTED_CARD_PLUGIN_MATCH_KEYS_MAX]; /**< Alternative sector keys. */
+} NfcSupportedCardPluginMatch;
 
 /**
  * @brief Verify that the card is of a supported type.
@@ -91,4 +128,5 @@ typedef struct {
     NfcSupportedCardPluginVerify verify; /**< Pointer to the verify() function. */
     NfcSupportedCardPluginRead read; /**< Pointer to the read() function. */
     NfcSupportedCardPluginParse parse; /**< Pointer to the parse() function. */
+    NfcSupportedCardPluginMatch match; /**< Static match descriptor, may be left empty. */
 } NfcSupportedCardsPlugin;
@@ -443,6 +443,13 @@ static const NfcSupportedCardsPlugin saflok_plugin = {
     .verify = saflok_verify,
     .read = saflok_read,
     .parse = saflok_parse,
+    .match =
+        {
+            .key_sector = 1,
+            .key_type = MfClassicKeyTypeA,
+            .key_count = 1,
+            .keys = {0x2a2c13cc242a},
+        },
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
@@ -161,6 +161,13 @@ static const NfcSupportedCardsPlugin skylanders_plugin = {
     .verify = skylanders_verify,
     .read = skylanders_read,
     .parse = skylanders_parse,
+    .match =
+        {
+            .key_sector = 0,
+            .key_type = MfClassicKeyTypeA,
+            .key_count = 1,
+            .keys = {0x4b0b20107ccb},
+        },
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
@@ -320,6 +320,13 @@ static const NfcSupportedCardsPlugin smartrider_plugin = {
     .verify = smartrider_verify,
     .read = smartrider_read,
     .parse = smartrider_parse,
+    .match =
+        {
+            .key_sector = 0,
+            .key_type = MfClassicKeyTypeA,
+            .key_count = 1,
+            .keys = {0x2031D1E57A3B},
+        },
 };
 
 __attribute__((used)) const FlipperAppPluginDescriptor* smartrider_plugin_ep() {
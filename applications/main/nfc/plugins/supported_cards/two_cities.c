@@ -175,6 +175,13 @@ static const NfcSupportedCardsPlugin two_cities_plugin = {
     .verify = two_cities_verify,
     .read = two_cities_read,
     .parse = two_cities_parse,
+    .match =
+        {
+            .key_sector = 4,
+            .key_type = MfClassicKeyTypeA,
+            .key_count = 1,
+            .keys = {0xe56ac127dd45},
+        },
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
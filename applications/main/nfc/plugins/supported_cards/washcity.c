@@ -180,6 +180,13 @@ static const NfcSupportedCardsPlugin washcity_plugin = {
     .verify = washcity_verify,
     .read = washcity_read,
     .parse = washcity_parse,
+    .match =
+        {
+            .key_sector = 1,
+            .key_type = MfClassicKeyTypeA,
+            .key_count = 1,
+            .keys = {0xC78A3D0E1BCD},
+        },
 };
 
 /* Plugin descriptor to comply with basic plugin specification */
@@ -28,6 +28,7 @@ typedef enum {
     SubGhzCustomEventSceneSettingRemoveDuplicates,
     SubGhzCustomEventSceneSettingLock,
     SubGhzCustomEventSceneSettingResetToDefault,
+    SubGhzCustomEventSceneDecodeRawResults,
 
     SubGhzCustomEventSceneExit,
     SubGhzCustomEventSceneStay,
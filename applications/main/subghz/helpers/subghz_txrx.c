@@ -7,6 +7,9 @@
 
 #define TAG "SubGhzTxRx"
 
+// Maximum hopper cycle, in hopper updates per frequency
+#define SUBGHZ_TXRX_HOPPER_REVISIT_FACTOR 4
+
 static void subghz_txrx_radio_device_power_on(SubGhzTxRx* instance) {
     UNUSED(instance);
     uint8_t attempts = 0;
@@ -33,6 +36,9 @@ SubGhzTxRx* subghz_txrx_alloc(void) {
 
     instance->txrx_state = SubGhzTxRxStateSleep;
 
+    size_t hopper_count = subghz_setting_get_hopper_frequency_count(instance->setting);
+    instance->hopper = subghz_hopper_scheduler_alloc(
+        hopper_count, hopper_count * SUBGHZ_TXRX_HOPPER_REVISIT_FACTOR);
     subghz_txrx_hopper_set_state(instance, SubGhzHopperStateOFF);
     subghz_txrx_speaker_set_state(instance, SubGhzSpeakerStateDisable);
     subghz_txrx_set_debug_pin_state(instance, false);
@@ -83,6 +89,7 @@ void subghz_txrx_free(SubGhzTxRx* instance) {
     flipper_format_free(instance->fff_data);
     furi_string_free(instance->preset->name);
     subghz_setting_free(instance->setting);
+    subghz_hopper_scheduler_free(instance->hopper);
 
     free(instance->preset);
     free(instance);
@@ -398,6 +405,7 @@ void subghz_txrx_hopper_update(SubGhzTxRx* instance, float stay_threshold) {
     if(instance->hopper_state != SubGhzHopperStateRSSITimeOut) {
         // See RSSI Calculation timings in CC1101 17.3 RSSI
         float rssi = subghz_devices_get_rssi(instance->radio_device);
+        subghz_hopper_scheduler_add_rssi(instance->hopper, rssi);
 
         // Stay if RSSI is high enough
         if(rssi > stay_threshold) {
@@ -405,16 +413,14 @@ void subghz_txrx_hopper_update(SubGhzTxRx* instance, float stay_threshold) {
             instance->hopper_state = SubGhzHopperStateRSSITimeOut;
             return;
         }
+
+        // Stay for the share of hopping cycle earned by the frequency activity
+        if(!subghz_hopper_scheduler_tick(instance->hopper)) return;
     } else {
         instance->hopper_state = SubGhzHopperStateRunning;
     }
     // Select next frequency
-    if(instance->hopper_idx_frequency <
-       subghz_setting_get_hopper_frequency_count(instance->setting) - 1) {
-        instance->hopper_idx_frequency++;
-    } else {
-        instance->hopper_idx_frequency = 0;
-    }
+    instance->hopper_idx_frequency = subghz_hopper_scheduler_next(instance->hopper);
 
     if(instance->txrx_state == SubGhzTxRxStateRx) {
         subghz_txrx_rx_end(instance);
@@ -434,6 +440,11 @@ SubGhzHopperState subghz_txrx_hopper_get_state(SubGhzTxRx* instance) {
 
 void subghz_txrx_hopper_set_state(SubGhzTxRx* instance, SubGhzHopperState state) {
     furi_assert(instance);
+    if(instance->hopper_state == SubGhzHopperStateOFF && state != SubGhzHopperStateOFF) {
+        // Hopping starts over from the first frequency with fresh statistics
+        subghz_hopper_scheduler_reset(instance->hopper);
+        instance->hopper_idx_frequency = 0;
+    }
     instance->hopper_state = state;
 }
 
@@ -451,6 +462,14 @@ void subghz_txrx_hopper_pause(SubGhzTxRx* instance) {
     }
 }
 
+void subghz_txrx_hopper_get_stats(
+    SubGhzTxRx* instance,
+    size_t idx,
+    SubGhzHopperSchedulerStats* stats) {
+    furi_assert(instance);
+    subghz_hopper_scheduler_get_stats(instance->hopper, idx, stats);
+}
+
 void subghz_txrx_speaker_on(SubGhzTxRx* instance) {
     furi_assert(instance);
     if(instance->debug_pin_state) {
@@ -569,11 +588,26 @@ void subghz_txrx_receiver_set_ignore_filter(
     subghz_receiver_set_ignore_filter(instance->receiver, ignore_filter);
 }
 
+static void subghz_txrx_rx_callback(
+    SubGhzReceiver* receiver,
+    SubGhzProtocolDecoderBase* decoder_base,
+    void* context) {
+    SubGhzTxRx* instance = context;
+    if(instance->hopper_state != SubGhzHopperStateOFF) {
+        subghz_hopper_scheduler_add_hit(instance->hopper);
+    }
+    if(instance->rx_callback) {
+        instance->rx_callback(receiver, decoder_base, instance->rx_context);
+    }
+}
+
 void subghz_txrx_set_rx_callback(
     SubGhzTxRx* instance,
     SubGhzReceiverCallback callback,
     void* context) {
-    subghz_receiver_set_rx_callback(instance->receiver, callback, context);
+    instance->rx_callback = callback;
+    instance->rx_context = context;
+    subghz_receiver_set_rx_callback(instance->receiver, subghz_txrx_rx_callback, instance);
 }
 
 void subghz_txrx_set_raw_file_encoder_worker_callback_end(
@@ -673,9 +707,9 @@ void subghz_txrx_reset_dynamic_and_custom_btns(SubGhzTxRx* instance) {
     subghz_custom_btns_reset();
 }
 
-SubGhzReceiver* subghz_txrx_get_receiver(SubGhzTxRx* instance) {
+SubGhzEnvironment* subghz_txrx_get_environment(SubGhzTxRx* instance) {
     furi_assert(instance);
-    return instance->receiver;
+    return instance->environment;
 }
 
 void subghz_txrx_set_default_preset(SubGhzTxRx* instance, uint32_t frequency) {
@@ -4,6 +4,7 @@
 
 #include <lib/subghz/subghz_worker.h>
 #include <lib/subghz/subghz_setting.h>
+#include <lib/subghz/subghz_hopper_scheduler.h>
 #include <lib/subghz/receiver.h>
 #include <lib/subghz/transmitter.h>
 #include <lib/subghz/protocols/raw.h>
@@ -175,6 +176,18 @@ void subghz_txrx_hopper_unpause(SubGhzTxRx* instance);
  */
 void subghz_txrx_hopper_pause(SubGhzTxRx* instance);
 
+/**
+ * Get hopper channel statistics, channels follow the hopper frequency list
+ * 
+ * @param instance Pointer to a SubGhzTxRx
+ * @param idx Index of the hopper frequency
+ * @param stats Output statistics
+ */
+void subghz_txrx_hopper_get_stats(
+    SubGhzTxRx* instance,
+    size_t idx,
+    SubGhzHopperSchedulerStats* stats);
+
 /**
  * Speaker on
  * 
@@ -374,7 +387,7 @@ bool subghz_txrx_get_debug_pin_state(SubGhzTxRx* instance);
 
 void subghz_txrx_reset_dynamic_and_custom_btns(SubGhzTxRx* instance);
 
-SubGhzReceiver* subghz_txrx_get_receiver(SubGhzTxRx* instance); // TODO use only in DecodeRaw
+SubGhzEnvironment* subghz_txrx_get_environment(SubGhzTxRx* instance); // Used only in DecodeRaw
 
 /**
  * @brief Set current preset AM650 without additional params
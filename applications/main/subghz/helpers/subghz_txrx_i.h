@@ -16,6 +16,7 @@ struct SubGhzTxRx {
 
     uint8_t hopper_timeout;
     uint8_t hopper_idx_frequency;
+    SubGhzHopperScheduler* hopper;
     bool is_database_loaded;
     SubGhzHopperState hopper_state;
 
@@ -24,6 +25,9 @@ struct SubGhzTxRx {
     const SubGhzDevice* radio_device;
     SubGhzRadioDeviceType radio_device_type;
 
+    SubGhzReceiverCallback rx_callback;
+    void* rx_context;
+
     SubGhzTxRxNeedSaveCallback need_save_callback;
     void* need_save_context;
 
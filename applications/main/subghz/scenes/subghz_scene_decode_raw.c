@@ -2,7 +2,7 @@
 
 #define TAG "SubGhzDecodeRaw"
 
-#define SAMPLES_TO_READ_PER_TICK 400
+#define DECODE_RAW_THREADS 1
 
 static void subghz_scene_receiver_update_statusbar(void* context) {
     SubGhz* subghz = context;
@@ -52,6 +52,14 @@ void subghz_scene_decode_raw_callback(SubGhzCustomEvent event, void* context) {
     view_dispatcher_send_custom_event(subghz->view_dispatcher, event);
 }
 
+static void subghz_scene_decode_raw_results_callback(void* context) {
+    furi_assert(context);
+    SubGhz* subghz = context;
+    // History and receiver view belong to the GUI thread, results are added there
+    view_dispatcher_send_custom_event(
+        subghz->view_dispatcher, SubGhzCustomEventSceneDecodeRawResults);
+}
+
 static void subghz_scene_add_to_history_callback(
     SubGhzReceiver* receiver,
     SubGhzProtocolDecoderBase* decoder_base,
@@ -90,7 +98,8 @@ static void subghz_scene_add_to_history_callback(
 
         subghz->state_notifications = SubGhzNotificationStateRxDone;
 
-        if(subghz->remove_duplicates) {
+        // Non-zero repeat count means the same signal is already in history
+        if(subghz->remove_duplicates && subghz_history_get_repeats(subghz->history, idx)) {
             // Look in history for signal hash
             uint32_t hash_data = subghz_protocol_decoder_base_get_hash_data_long(decoder_base);
             subghz_view_receiver_disable_draw_callback(subghz->subghz_receiver);
@@ -145,59 +154,62 @@ bool subghz_scene_decode_raw_start(SubGhz* subghz) {
     } while(false);
 
     if(success) {
-        //FURI_LOG_I(TAG, "Listening at \033[0;33m%s\033[0m.", furi_string_get_cstr(file_name));
-
-        subghz->decode_raw_file_worker_encoder = subghz_file_encoder_worker_alloc();
-        if(subghz_file_encoder_worker_start(
-               subghz->decode_raw_file_worker_encoder,
+        // Decoding runs in the background, results are added to history on events and ticks
+        subghz->decode_raw_preset = subghz_txrx_get_preset(subghz->txrx);
+        subghz->decode_raw_analyzer = subghz_raw_analyzer_alloc(
+            subghz_txrx_get_environment(subghz->txrx), DECODE_RAW_THREADS);
+        subghz_raw_analyzer_set_filter(subghz->decode_raw_analyzer, SubGhzProtocolFlag_Decodable);
+        subghz_raw_analyzer_set_ignore_filter(subghz->decode_raw_analyzer, subghz->ignore_filter);
+        subghz_raw_analyzer_set_rx_callback(
+            subghz->decode_raw_analyzer, subghz_scene_add_to_history_callback, subghz);
+        subghz_raw_analyzer_set_results_callback(
+            subghz->decode_raw_analyzer, subghz_scene_decode_raw_results_callback, subghz);
+
+        if(!subghz_raw_analyzer_start(
+               subghz->decode_raw_analyzer,
                furi_string_get_cstr(file_name),
-               subghz_txrx_radio_device_get_name(subghz->txrx))) {
-            //the worker needs a file in order to open and read part of the file
-            furi_delay_ms(100);
-        } else {
+               &subghz->decode_raw_preset)) {
+            subghz_raw_analyzer_free(subghz->decode_raw_analyzer);
+            subghz->decode_raw_analyzer = NULL;
             success = false;
         }
-
-        if(!success) {
-            subghz_file_encoder_worker_free(subghz->decode_raw_file_worker_encoder);
-        }
     }
 
     furi_string_free(file_name);
     return success;
 }
 
-bool subghz_scene_decode_raw_next(SubGhz* subghz) {
-    LevelDuration level_duration;
-    SubGhzReceiver* receiver = subghz_txrx_get_receiver(subghz->txrx);
-    for(uint32_t read = SAMPLES_TO_READ_PER_TICK; read > 0; --read) {
-        level_duration =
-            subghz_file_encoder_worker_get_level_duration(subghz->decode_raw_file_worker_encoder);
-        if(!level_duration_is_reset(level_duration)) {
-            bool level = level_duration_get_level(level_duration);
-            uint32_t duration = level_duration_get_duration(level_duration);
-            subghz_receiver_decode(receiver, level, duration);
-        } else {
-            scene_manager_set_scene_state(
-                subghz->scene_manager, SubGhzSceneDecodeRAW, SubGhzDecodeRawStateLoaded);
-            subghz->state_notifications = SubGhzNotificationStateIDLE;
+static void subghz_scene_decode_raw_update(SubGhz* subghz) {
+    // Results of the last chunk are left before the analyzer finishes
+    const bool finished = subghz_raw_analyzer_is_finished(subghz->decode_raw_analyzer);
+    subghz_raw_analyzer_process_results(subghz->decode_raw_analyzer);
 
-            subghz_view_receiver_add_data_progress(subghz->subghz_receiver, "Done!");
-            return false; // No more samples available
-        }
+    if(finished) {
+        scene_manager_set_scene_state(
+            subghz->scene_manager, SubGhzSceneDecodeRAW, SubGhzDecodeRawStateLoaded);
+        subghz->state_notifications = SubGhzNotificationStateIDLE;
+
+        subghz_view_receiver_add_data_progress(subghz->subghz_receiver, "Done!");
+        return;
     }
 
     // Update progress info
     FuriString* progress_str = furi_string_alloc();
-    subghz_file_encoder_worker_get_text_progress(
-        subghz->decode_raw_file_worker_encoder, progress_str);
+    subghz_raw_analyzer_get_text_progress(subghz->decode_raw_analyzer, progress_str);
 
     subghz_view_receiver_add_data_progress(
         subghz->subghz_receiver, furi_string_get_cstr(progress_str));
 
     furi_string_free(progress_str);
+}
 
-    return true; // More samples available
+void subghz_scene_decode_raw_stop(SubGhz* subghz) {
+    if(!subghz->decode_raw_analyzer) return;
+    if(subghz_raw_analyzer_is_running(subghz->decode_raw_analyzer)) {
+        subghz_raw_analyzer_stop(subghz->decode_raw_analyzer);
+    }
+    subghz_raw_analyzer_free(subghz->decode_raw_analyzer);
+    subghz->decode_raw_analyzer = NULL;
 }
 
 void subghz_scene_decode_raw_on_enter(void* context) {
@@ -210,10 +222,6 @@ void subghz_scene_decode_raw_on_enter(void* context) {
     subghz_view_receiver_set_callback(
         subghz->subghz_receiver, subghz_scene_decode_raw_callback, subghz);
 
-    subghz_txrx_set_rx_callback(subghz->txrx, subghz_scene_add_to_history_callback, subghz);
-
-    subghz_txrx_receiver_set_filter(subghz->txrx, SubGhzProtocolFlag_Decodable);
-
     if(scene_manager_get_scene_state(subghz->scene_manager, SubGhzSceneDecodeRAW) ==
        SubGhzDecodeRawStateStart) {
         //Decode RAW to history
@@ -239,6 +247,11 @@ void subghz_scene_decode_raw_on_enter(void* context) {
                 subghz_history_get_repeats(subghz->history, i));
         }
         subghz_view_receiver_set_idx_menu(subghz->subghz_receiver, subghz->idx_menu_chosen);
+
+        if(scene_manager_get_scene_state(subghz->scene_manager, SubGhzSceneDecodeRAW) ==
+           SubGhzDecodeRawStateLoading) {
+            subghz_raw_analyzer_pause(subghz->decode_raw_analyzer, false);
+        }
     }
 
     furi_string_free(item_name);
@@ -259,12 +272,7 @@ bool subghz_scene_decode_raw_on_event(void* context, SceneManagerEvent event) {
                 subghz->scene_manager, SubGhzSceneDecodeRAW, SubGhzDecodeRawStateStart);
             subghz->idx_menu_chosen = 0;
 
-            subghz_txrx_set_rx_callback(subghz->txrx, NULL, subghz);
-
-            if(subghz_file_encoder_worker_is_running(subghz->decode_raw_file_worker_encoder)) {
-                subghz_file_encoder_worker_stop(subghz->decode_raw_file_worker_encoder);
-            }
-            subghz_file_encoder_worker_free(subghz->decode_raw_file_worker_encoder);
+            subghz_scene_decode_raw_stop(subghz);
 
             subghz->state_notifications = SubGhzNotificationStateIDLE;
             scene_manager_set_scene_state(
@@ -283,6 +291,13 @@ bool subghz_scene_decode_raw_on_event(void* context, SceneManagerEvent event) {
             FURI_LOG_W(TAG, "No config options");
             consumed = true;
             break;
+        case SubGhzCustomEventSceneDecodeRawResults:
+            if(scene_manager_get_scene_state(subghz->scene_manager, SubGhzSceneDecodeRAW) ==
+               SubGhzDecodeRawStateLoading) {
+                subghz_raw_analyzer_process_results(subghz->decode_raw_analyzer);
+            }
+            consumed = true;
+            break;
         case SubGhzCustomEventViewReceiverOffDisplay:
             notification_message(subghz->notifications, &sequence_display_backlight_off);
             consumed = true;
@@ -291,6 +306,7 @@ bool subghz_scene_decode_raw_on_event(void* context, SceneManagerEvent event) {
             break;
         }
     } else if(event.type == SceneManagerEventTypeTick) {
+        subghz_history_spill(subghz->history);
         switch(subghz->state_notifications) {
         case SubGhzNotificationStateRx:
             notification_message(subghz->notifications, &sequence_blink_cyan_10);
@@ -305,7 +321,7 @@ bool subghz_scene_decode_raw_on_event(void* context, SceneManagerEvent event) {
 
         switch(scene_manager_get_scene_state(subghz->scene_manager, SubGhzSceneDecodeRAW)) {
         case SubGhzDecodeRawStateLoading:
-            subghz_scene_decode_raw_next(subghz);
+            subghz_scene_decode_raw_update(subghz);
             break;
         default:
             break;
@@ -315,5 +331,10 @@ bool subghz_scene_decode_raw_on_event(void* context, SceneManagerEvent event) {
 }
 
 void subghz_scene_decode_raw_on_exit(void* context) {
-    UNUSED(context);
+    SubGhz* subghz = context;
+    // Keep history untouched while another scene shows it
+    if(scene_manager_get_scene_state(subghz->scene_manager, SubGhzSceneDecodeRAW) ==
+       SubGhzDecodeRawStateLoading) {
+        subghz_raw_analyzer_pause(subghz->decode_raw_analyzer, true);
+    }
 }
@@ -171,7 +171,8 @@ static void subghz_scene_add_to_history_callback(
         } else {
             subghz->state_notifications = SubGhzNotificationStateRxDone;
 
-            if(subghz->remove_duplicates) {
+            // Non-zero repeat count means the same signal is already in history
+            if(subghz->remove_duplicates && subghz_history_get_repeats(history, idx)) {
                 // Look in history for signal hash
                 uint32_t hash_data = subghz_protocol_decoder_base_get_hash_data_long(decoder_base);
                 subghz_view_receiver_disable_draw_callback(subghz->subghz_receiver);
@@ -225,8 +226,13 @@ static void subghz_scene_add_to_history_callback(
                 furi_record_close(RECORD_STORAGE);
                 free(dir);
                 // Save
-                subghz_save_protocol_to_file(
-                    subghz, subghz_history_get_raw_data(history, idx), furi_string_get_cstr(path));
+                FlipperFormat* raw_data = flipper_format_string_alloc();
+                if(subghz_history_get_raw_data(history, idx, raw_data)) {
+                    subghz_save_protocol_to_file(subghz, raw_data, furi_string_get_cstr(path));
+                } else {
+                    FURI_LOG_E(TAG, "Autosave skipped, record data is not available");
+                }
+                flipper_format_free(raw_data);
                 furi_string_free(path);
             }
 
@@ -413,17 +419,23 @@ bool subghz_scene_receiver_on_event(void* context, SceneManagerEvent event) {
             subghz_txrx_stop(subghz->txrx);
             subghz_txrx_hopper_pause(subghz->txrx);
 
-            FlipperFormat* key_repeat_data = subghz_history_get_raw_data(
-                subghz->history, subghz_history_get_last_index(subghz->history) - 1);
+            FlipperFormat* key_repeat_data = flipper_format_string_alloc();
+            const bool key_repeat_loaded = subghz_history_get_raw_data(
+                subghz->history,
+                subghz_history_get_last_index(subghz->history) - 1,
+                key_repeat_data);
 
             uint32_t tmpTe = 300;
-            if(!flipper_format_rewind(key_repeat_data)) {
+            if(!key_repeat_loaded) {
+                FURI_LOG_E(TAG, "Record data is not available");
+            } else if(!flipper_format_rewind(key_repeat_data)) {
                 FURI_LOG_E(TAG, "Rewind error");
             } else if(!flipper_format_read_uint32(key_repeat_data, "TE", (uint32_t*)&tmpTe, 1)) {
                 FURI_LOG_E(TAG, "Missing TE");
             }
 
-            if(subghz_txrx_tx_start(subghz->txrx, key_repeat_data) != SubGhzTxRxStartTxStateOk) {
+            if(!key_repeat_loaded ||
+               subghz_txrx_tx_start(subghz->txrx, key_repeat_data) != SubGhzTxRxStartTxStateOk) {
                 view_dispatcher_send_custom_event(
                     subghz->view_dispatcher, SubGhzCustomEventViewRepeaterStop);
             } else {
@@ -438,6 +450,7 @@ bool subghz_scene_receiver_on_event(void* context, SceneManagerEvent event) {
                                            repeatnormal * tmpTe;
                 furi_timer_start(subghz->timer, repeat_time);
             }
+            flipper_format_free(key_repeat_data);
             subghz_rx_key_state_set(subghz, SubGhzRxKeyStateTX);
             break;
         case SubGhzCustomEventViewRepeaterStop:
@@ -452,18 +465,19 @@ bool subghz_scene_receiver_on_event(void* context, SceneManagerEvent event) {
         case SubGhzCustomEventViewReceiverOKLong:
             subghz_txrx_stop(subghz->txrx);
             subghz_txrx_hopper_pause(subghz->txrx);
-            if(subghz_txrx_tx_start(
-                   subghz->txrx,
-                   subghz_history_get_raw_data(
-                       subghz->history,
-                       subghz_view_receiver_get_idx_menu(subghz->subghz_receiver))) !=
-               SubGhzTxRxStartTxStateOk) {
+            FlipperFormat* key_data = flipper_format_string_alloc();
+            if(!subghz_history_get_raw_data(
+                   subghz->history,
+                   subghz_view_receiver_get_idx_menu(subghz->subghz_receiver),
+                   key_data) ||
+               subghz_txrx_tx_start(subghz->txrx, key_data) != SubGhzTxRxStartTxStateOk) {
                 view_dispatcher_send_custom_event(
                     subghz->view_dispatcher, SubGhzCustomEventViewReceiverOKRelease);
             } else {
                 subghz->state_notifications = SubGhzNotificationStateTx;
                 notification_message(subghz->notifications, &subghz_sequence_tx_beep);
             }
+            flipper_format_free(key_data);
             subghz_rx_key_state_set(subghz, SubGhzRxKeyStateTX);
             break;
         case SubGhzCustomEventViewReceiverOKRelease:
@@ -480,6 +494,7 @@ bool subghz_scene_receiver_on_event(void* context, SceneManagerEvent event) {
             break;
         }
     } else if(event.type == SceneManagerEventTypeTick) {
+        subghz_history_spill(subghz->history);
         if(subghz_rx_key_state_get(subghz) != SubGhzRxKeyStateTX) {
             if(subghz_txrx_hopper_get_state(subghz->txrx) != SubGhzHopperStateOFF) {
                 subghz_txrx_hopper_update(subghz->txrx, subghz->last_settings->hopping_threshold);
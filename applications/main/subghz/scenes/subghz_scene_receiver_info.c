@@ -26,13 +26,18 @@ void subghz_scene_receiver_info_callback(GuiButtonType result, InputType type, v
 static bool subghz_scene_receiver_info_update_parser(void* context) {
     SubGhz* subghz = context;
 
-    if(subghz_txrx_load_decoder_by_name_protocol(
-           subghz->txrx,
-           subghz_history_get_protocol_name(subghz->history, subghz->idx_menu_chosen))) {
+    FlipperFormat* raw_data = flipper_format_string_alloc();
+    bool loaded = subghz_history_get_raw_data(subghz->history, subghz->idx_menu_chosen, raw_data);
+    if(!loaded) {
+        FURI_LOG_E(TAG, "Record data is not available");
+    }
+
+    if(loaded && subghz_txrx_load_decoder_by_name_protocol(
+                     subghz->txrx,
+                     subghz_history_get_protocol_name(subghz->history, subghz->idx_menu_chosen))) {
         // we are trying to deserialize without checking for errors, since it is assumed that we just received this chignal
-        subghz_protocol_decoder_base_deserialize(
-            subghz_txrx_get_decoder(subghz->txrx),
-            subghz_history_get_raw_data(subghz->history, subghz->idx_menu_chosen));
+        subghz_protocol_decoder_base_deserialize(subghz_txrx_get_decoder(subghz->txrx), raw_data);
+        flipper_format_free(raw_data);
 
         SubGhzRadioPreset* preset =
             subghz_history_get_radio_preset(subghz->history, subghz->idx_menu_chosen);
@@ -47,6 +52,7 @@ static bool subghz_scene_receiver_info_update_parser(void* context) {
 
         return true;
     }
+    flipper_format_free(raw_data);
     return false;
 }
 
@@ -75,7 +81,18 @@ void subghz_scene_receiver_info_draw_widget(SubGhz* subghz) {
             AlignTop,
             FontSecondary,
             furi_string_get_cstr(modulation_str));
+        SubGhzKeyCache* key_cache =
+            subghz_environment_get_key_cache(subghz_txrx_get_environment(subghz->txrx));
+        SubGhzKeyCacheStats stats_before;
+        subghz_key_cache_get_stats(key_cache, &stats_before);
         subghz_protocol_decoder_base_get_string(subghz_txrx_get_decoder(subghz->txrx), text);
+
+        // Rolling code decoders look up their manufacturer key in the cache, hits/misses
+        SubGhzKeyCacheStats stats;
+        subghz_key_cache_get_stats(key_cache, &stats);
+        if(stats.hits + stats.misses != stats_before.hits + stats_before.misses) {
+            furi_string_cat_printf(text, "KC %lu/%lu\r\n", stats.hits, stats.misses);
+        }
         widget_add_string_multiline_element(
             subghz->widget, 0, 0, AlignLeft, AlignTop, FontSecondary, furi_string_get_cstr(text));
 
@@ -140,9 +157,12 @@ bool subghz_scene_receiver_info_on_event(void* context, SceneManagerEvent event)
             }
             //CC1101 Stop RX -> Start TX
             subghz_txrx_hopper_pause(subghz->txrx);
-            if(!subghz_tx_start(
-                   subghz,
-                   subghz_history_get_raw_data(subghz->history, subghz->idx_menu_chosen))) {
+            FlipperFormat* raw_data = flipper_format_string_alloc();
+            bool started =
+                subghz_history_get_raw_data(subghz->history, subghz->idx_menu_chosen, raw_data) &&
+                subghz_tx_start(subghz, raw_data);
+            flipper_format_free(raw_data);
+            if(!started) {
                 subghz_txrx_rx_start(subghz->txrx);
                 subghz_txrx_hopper_unpause(subghz->txrx);
                 subghz->state_notifications = SubGhzNotificationStateRx;
@@ -196,6 +216,7 @@ bool subghz_scene_receiver_info_on_event(void* context, SceneManagerEvent event)
             }
         }
     } else if(event.type == SceneManagerEventTypeTick) {
+        subghz_history_spill(subghz->history);
         if(subghz_txrx_hopper_get_state(subghz->txrx) != SubGhzHopperStateOFF) {
             subghz_txrx_hopper_update(subghz->txrx, subghz->last_settings->hopping_threshold);
         }
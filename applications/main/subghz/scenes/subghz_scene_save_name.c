@@ -127,10 +127,19 @@ bool subghz_scene_save_name_on_event(void* context, SceneManagerEvent event) {
                             SubGhzSceneSetType,
                             SubGhzCustomEventManagerNoSet);
                     } else {
-                        subghz_save_protocol_to_file(
-                            subghz,
-                            subghz_history_get_raw_data(subghz->history, subghz->idx_menu_chosen),
-                            furi_string_get_cstr(subghz->file_path));
+                        FlipperFormat* raw_data = flipper_format_string_alloc();
+                        bool loaded = subghz_history_get_raw_data(
+                            subghz->history, subghz->idx_menu_chosen, raw_data);
+                        if(loaded) {
+                            subghz_save_protocol_to_file(
+                                subghz, raw_data, furi_string_get_cstr(subghz->file_path));
+                        } else {
+                            dialog_message_show_storage_error(
+                                subghz->dialogs, "Cannot read
+signal data");
+                        }
+                        flipper_format_free(raw_data);
+                        if(!loaded) return false;
                     }
                 }
 
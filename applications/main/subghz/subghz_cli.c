@@ -8,7 +8,7 @@
 #include <lib/subghz/subghz_keystore.h>
 #include <lib/subghz/receiver.h>
 #include <lib/subghz/transmitter.h>
-#include <lib/subghz/subghz_file_encoder_worker.h>
+#include <lib/subghz/subghz_raw_analyzer.h>
 #include <lib/subghz/protocols/protocol_items.h>
 #include <lib/subghz/devices/cc1101_int/cc1101_int_interconnect.h>
 #include <lib/subghz/devices/devices.h>
@@ -21,6 +21,7 @@
 
 #include <notification/notification_messages.h>
 #include <flipper_format/flipper_format_i.h>
+#include <m-array.h>
 
 #include <lib/subghz/blocks/custom_btn.h>
 
@@ -466,30 +467,44 @@ void subghz_cli_command_rx_raw(Cli* cli, FuriString* args, void* context) {
     free(instance);
 }
 
-void subghz_cli_command_decode_raw(Cli* cli, FuriString* args, void* context) {
-    UNUSED(context);
-    FuriString* file_name = furi_string_alloc();
-    furi_string_set(file_name, EXT_PATH("subghz/test.sub"));
+ARRAY_DEF(SubGhzCliFileArray, FuriString*, FURI_STRING_OPLIST)
 
-    Storage* storage = furi_record_open(RECORD_STORAGE);
+typedef struct {
+    SubGhzRawAnalyzer* analyzer;
+    size_t packet_count;
+} SubGhzCliCommandDecodeRaw;
+
+static void subghz_cli_command_decode_raw_callback(
+    SubGhzReceiver* receiver,
+    SubGhzProtocolDecoderBase* decoder_base,
+    void* context) {
+    SubGhzCliCommandDecodeRaw* instance = context;
+    instance->packet_count++;
+
+    FuriString* text = furi_string_alloc();
+    subghz_protocol_decoder_base_get_string(decoder_base, text);
+    subghz_receiver_reset(receiver);
+    uint32_t time_ms = subghz_raw_analyzer_get_time(instance->analyzer);
+    printf(
+        "\033[0;33m%lu.%03lus\033[0m %s",
+        time_ms / 1000,
+        time_ms % 1000,
+        furi_string_get_cstr(text));
+    furi_string_free(text);
+}
+
+static bool subghz_cli_command_decode_raw_load_preset(
+    Storage* storage,
+    const char* file_name,
+    SubGhzRadioPreset* preset) {
     FlipperFormat* fff_data_file = flipper_format_file_alloc(storage);
     FuriString* temp_str = furi_string_alloc();
     uint32_t temp_data32;
     bool check_file = false;
 
     do {
-        if(furi_string_size(args)) {
-            if(!args_read_string_and_trim(args, file_name)) {
-                cli_print_usage(
-                    "subghz decode_raw", "<file_name: path_RAW_file>", furi_string_get_cstr(args));
-                break;
-            }
-        }
-
-        if(!flipper_format_file_open_existing(fff_data_file, furi_string_get_cstr(file_name))) {
-            printf(
-                "subghz decode_raw \033[0;31mError open file\033[0m %s\r\n",
-                furi_string_get_cstr(file_name));
+        if(!flipper_format_file_open_existing(fff_data_file, file_name)) {
+            printf("subghz decode_raw \033[0;31mError open file\033[0m %s\r\n", file_name);
             break;
         }
 
@@ -505,59 +520,139 @@ void subghz_cli_command_decode_raw(Cli* cli, FuriString* args, void* context) {
             break;
         }
 
+        // Saved with decoded signals only, missing values are not fatal
+        if(!flipper_format_read_uint32(fff_data_file, "Frequency", &preset->frequency, 1)) {
+            preset->frequency = 0;
+        }
+        if(!flipper_format_read_string(fff_data_file, "Preset", preset->name)) {
+            furi_string_set(preset->name, "FuriHalSubGhzPresetOok650Async");
+        }
+
         check_file = true;
     } while(false);
 
     furi_string_free(temp_str);
     flipper_format_free(fff_data_file);
-    furi_record_close(RECORD_STORAGE);
+    return check_file;
+}
 
-    if(check_file) {
-        // Allocate context
-        SubGhzCliCommandRx* instance = malloc(sizeof(SubGhzCliCommandRx));
+static bool subghz_cli_command_decode_raw_file(
+    Cli* cli,
+    Storage* storage,
+    SubGhzCliCommandDecodeRaw* instance,
+    const char* file_name) {
+    SubGhzRadioPreset preset = {.name = furi_string_alloc()};
+    bool interrupted = false;
+
+    if(subghz_cli_command_decode_raw_load_preset(storage, file_name, &preset)) {
+        size_t packet_count = instance->packet_count;
+        printf("Decoding \033[0;33m%s\033[0m\r\n", file_name);
+
+        if(subghz_raw_analyzer_start(instance->analyzer, file_name, &preset)) {
+            while(!subghz_raw_analyzer_is_finished(instance->analyzer)) {
+                if(cli_cmd_interrupt_received(cli)) {
+                    interrupted = true;
+                    break;
+                }
+                furi_delay_ms(50);
+            }
+            subghz_raw_analyzer_stop(instance->analyzer);
+        }
 
-        SubGhzEnvironment* environment = subghz_cli_environment_init();
+        printf(
+            "Packets in file \033[0;32m%zu\033[0m\r\n\r\n",
+            instance->packet_count - packet_count);
+    }
 
-        SubGhzReceiver* receiver = subghz_receiver_alloc_init(environment);
-        subghz_receiver_set_filter(receiver, SubGhzProtocolFlag_Decodable);
-        subghz_receiver_set_rx_callback(receiver, subghz_cli_command_rx_callback, instance);
+    furi_string_free(preset.name);
+    return !interrupted;
+}
 
-        SubGhzFileEncoderWorker* file_worker_encoder = subghz_file_encoder_worker_alloc();
-        if(subghz_file_encoder_worker_start(
-               file_worker_encoder, furi_string_get_cstr(file_name), NULL)) {
-            //the worker needs a file in order to open and read part of the file
-            furi_delay_ms(100);
+static bool subghz_cli_command_decode_raw_dir(
+    Cli* cli,
+    Storage* storage,
+    SubGhzCliCommandDecodeRaw* instance,
+    const char* dir_name) {
+    // Collect names first, the directory is not kept open while decoding
+    SubGhzCliFileArray_t files;
+    SubGhzCliFileArray_init(files);
+
+    File* dir = storage_file_alloc(storage);
+    char name[128];
+    FileInfo fileinfo;
+    if(storage_dir_open(dir, dir_name)) {
+        while(storage_dir_read(dir, &fileinfo, name, sizeof(name))) {
+            if(file_info_is_dir(&fileinfo)) continue;
+            FuriString* file_name = furi_string_alloc_printf("%s/%s", dir_name, name);
+            if(furi_string_end_withi_str(file_name, SUBGHZ_APP_FILENAME_EXTENSION)) {
+                SubGhzCliFileArray_push_back(files, file_name);
+            }
+            furi_string_free(file_name);
+        }
+    } else {
+        printf("subghz decode_raw \033[0;31mError open directory\033[0m %s\r\n", dir_name);
+    }
+    storage_dir_close(dir);
+    storage_file_free(dir);
+
+    bool result = true;
+    for
+        M_EACH(file_name, files, SubGhzCliFileArray_t) {
+            result = subghz_cli_command_decode_raw_file(
+                cli, storage, instance, furi_string_get_cstr(*file_name));
+            if(!result) break;
         }
 
-        printf(
-            "Listening at \033[0;33m%s\033[0m.\r\n\r\nPress CTRL+C to stop\r\n\r\n",
-            furi_string_get_cstr(file_name));
+    SubGhzCliFileArray_clear(files);
+    return result;
+}
 
-        LevelDuration level_duration;
-        while(!cli_cmd_interrupt_received(cli)) {
-            furi_delay_us(500); //you need to have time to read from the file from the SD card
-            level_duration = subghz_file_encoder_worker_get_level_duration(file_worker_encoder);
-            if(!level_duration_is_reset(level_duration)) {
-                bool level = level_duration_get_level(level_duration);
-                uint32_t duration = level_duration_get_duration(level_duration);
-                subghz_receiver_decode(receiver, level, duration);
-            } else {
+void subghz_cli_command_decode_raw(Cli* cli, FuriString* args, void* context) {
+    UNUSED(context);
+    FuriString* file_name = furi_string_alloc();
+    furi_string_set(file_name, EXT_PATH("subghz/test.sub"));
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    SubGhzCliCommandDecodeRaw* instance = malloc(sizeof(SubGhzCliCommandDecodeRaw));
+    SubGhzEnvironment* environment = subghz_cli_environment_init();
+    instance->analyzer = subghz_raw_analyzer_alloc(environment, 1);
+    subghz_raw_analyzer_set_filter(instance->analyzer, SubGhzProtocolFlag_Decodable);
+    subghz_raw_analyzer_set_rx_callback(
+        instance->analyzer, subghz_cli_command_decode_raw_callback, instance);
+
+    printf("Press CTRL+C to stop\r\n\r\n");
+
+    // Files and directories are processed in the order of arguments
+    bool next = true;
+    do {
+        if(furi_string_size(args)) {
+            if(!args_read_probably_quoted_string_and_trim(args, file_name)) {
+                cli_print_usage(
+                    "subghz decode_raw",
+                    "<file_name: path_RAW_file or directory> ...",
+                    furi_string_get_cstr(args));
                 break;
             }
         }
 
-        printf("\r\nPackets received \033[0;32m%zu\033[0m\r\n", instance->packet_count);
+        if(storage_dir_exists(storage, furi_string_get_cstr(file_name))) {
+            next = subghz_cli_command_decode_raw_dir(
+                cli, storage, instance, furi_string_get_cstr(file_name));
+        } else {
+            next = subghz_cli_command_decode_raw_file(
+                cli, storage, instance, furi_string_get_cstr(file_name));
+        }
+    } while(next && furi_string_size(args));
 
-        // Cleanup
-        subghz_receiver_free(receiver);
-        subghz_environment_free(environment);
+    printf("Packets received \033[0;32m%zu\033[0m\r\n", instance->packet_count);
 
-        if(subghz_file_encoder_worker_is_running(file_worker_encoder)) {
-            subghz_file_encoder_worker_stop(file_worker_encoder);
-        }
-        subghz_file_encoder_worker_free(file_worker_encoder);
-        free(instance);
-    }
+    // Cleanup
+    subghz_raw_analyzer_free(instance->analyzer);
+    subghz_environment_free(environment);
+    free(instance);
+
+    furi_record_close(RECORD_STORAGE);
     furi_string_free(file_name);
 }
 
@@ -835,7 +930,8 @@ static void subghz_cli_command_print_usage(void) {
         "\ttx <3 byte Key: in hex> <frequency: in Hz> <te: us> <repeat: count> <device: 0 - CC1101_INT, 1 - CC1101_EXT>\t - Transmitting key\r\n");
     printf("\trx <frequency:in Hz> <device: 0 - CC1101_INT, 1 - CC1101_EXT>\t - Receive\r\n");
     printf("\trx_raw <frequency:in Hz>\t - Receive RAW\r\n");
-    printf("\tdecode_raw <file_name: path_RAW_file>\t - Testing\r\n");
+    printf(
+        "\tdecode_raw <file_name: path_RAW_file or directory> ...\t - Decode RAW files\r\n");
     printf(
         "\ttx_from_file <file_name: path_file> <repeat: count> <device: 0 - CC1101_INT, 1 - CC1101_EXT>\t - Transmitting from file\r\n");
 
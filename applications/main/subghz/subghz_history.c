@@ -1,147 +1,420 @@
 #include "subghz_history.h"
 #include <lib/subghz/receiver.h>
+#include <flipper_format/flipper_format_i.h>
+#include <storage/storage.h>
 #include <rpc/rpc.h>
 
 #include <furi.h>
+#include <m-array.h>
+#include <m-dict.h>
 
 #define SUBGHZ_HISTORY_MAX       65535 // uint16_t index max, ram limit below
 #define SUBGHZ_HISTORY_FREE_HEAP (10240 * (3 - MIN(rpc_get_sessions_count(instance->rpc), 2U)))
 
+// Serialized data of the newest items is kept in RAM, older items are moved to the spill file
+#define SUBGHZ_HISTORY_RAM_ITEMS       16
+#define SUBGHZ_HISTORY_SPILL_DIR       EXT_PATH(".tmp")
+#define SUBGHZ_HISTORY_SPILL_PATH      SUBGHZ_HISTORY_SPILL_DIR "/subghz_history.tmp"
+#define SUBGHZ_HISTORY_SPILL_FILE_SIZE (1024 * 1024)
+
 #define TAG "SubGhzHistory"
 
+/**
+ * History record
+ *
+ * Serialized item data is stored as menu string, terminating zero and
+ * FlipperFormat text of the decoder. It is either held in RAM or in the spill
+ * file at data_offset, which is a position in the ring before wrapping.
+ *
+ * Records are added from the receiver thread, the spill file is only written
+ * by subghz_history_spill() from the GUI thread, so receiving never waits for
+ * the SD card.
+ */
 typedef struct {
-    FuriString* item_str;
-    FlipperFormat* flipper_string;
-    uint8_t type;
-    SubGhzRadioPreset* preset;
-    DateTime datetime;
-    uint32_t hash_data;
     const SubGhzProtocol* protocol;
-    uint16_t repeats;
+    uint32_t hash_data;
+    uint32_t timestamp;
+    uint32_t frequency;
     float latitude;
     float longitude;
+    uint8_t* data;
+    uint32_t data_offset;
+    uint16_t data_size;
+    uint16_t repeats;
+    uint8_t preset_index;
+    uint8_t type;
 } SubGhzHistoryItem;
 
 ARRAY_DEF(SubGhzHistoryItemArray, SubGhzHistoryItem, M_POD_OPLIST)
 
-#define M_OPL_SubGhzHistoryItemArray_t() ARRAY_OPLIST(SubGhzHistoryItemArray, M_POD_OPLIST)
+typedef struct {
+    FuriString* name;
+    uint8_t* data;
+    size_t data_size;
+} SubGhzHistoryPreset;
+
+ARRAY_DEF(SubGhzHistoryPresetArray, SubGhzHistoryPreset, M_POD_OPLIST)
 
 typedef struct {
-    SubGhzHistoryItemArray_t data;
-} SubGhzHistoryStruct;
+    uint16_t count;
+    uint16_t repeats;
+} SubGhzHistoryHashEntry;
+
+DICT_DEF2(SubGhzHistoryHashDict, uint64_t, M_DEFAULT_OPLIST, SubGhzHistoryHashEntry, M_POD_OPLIST)
 
 struct SubGhzHistory {
     uint32_t last_update_timestamp;
     uint16_t last_index_write;
     uint32_t code_last_hash_data;
     FuriString* tmp_string;
-    SubGhzHistoryStruct* history;
+    SubGhzHistoryItemArray_t items;
+    SubGhzHistoryPresetArray_t presets;
+    SubGhzHistoryHashDict_t hashes;
+    SubGhzRadioPreset radio_preset;
+    FlipperFormat* raw_data;
     Rpc* rpc;
+    FuriMutex* mutex; // Records, held only for memory access
+
+    Storage* storage;
+    FuriMutex* spill_mutex; // Spill file, taken before the records mutex
+    File* spill_file;
+    bool spill_disabled;
+    uint32_t spill_head;
+    uint16_t spill_count;
+    const uint8_t* spill_data; // Data being written, cleared if its record is deleted meanwhile
 };
 
+static inline uint64_t subghz_history_hash_key(const SubGhzHistoryItem* item) {
+    return ((uint64_t)(uintptr_t)item->protocol << 32) | item->hash_data;
+}
+
+static void subghz_history_hash_remove(SubGhzHistory* instance, const SubGhzHistoryItem* item) {
+    const uint64_t key = subghz_history_hash_key(item);
+    SubGhzHistoryHashEntry* entry = SubGhzHistoryHashDict_get(instance->hashes, key);
+    if(entry && --entry->count == 0) {
+        SubGhzHistoryHashDict_erase(instance->hashes, key);
+    }
+}
+
+static uint8_t subghz_history_preset_index(SubGhzHistory* instance, SubGhzRadioPreset* preset) {
+    size_t index = 0;
+    for
+        M_EACH(item, instance->presets, SubGhzHistoryPresetArray_t) {
+            if(item->data == preset->data && furi_string_equal(item->name, preset->name)) {
+                return index;
+            }
+            index++;
+        }
+
+    if(index > UINT8_MAX) {
+        FURI_LOG_W(TAG, "Too many presets");
+        return 0;
+    }
+
+    SubGhzHistoryPreset* item = SubGhzHistoryPresetArray_push_raw(instance->presets);
+    item->name = furi_string_alloc_set(preset->name);
+    item->data = preset->data;
+    item->data_size = preset->data_size;
+    return index;
+}
+
+static void subghz_history_spill_close(SubGhzHistory* instance) {
+    if(instance->spill_file) {
+        storage_file_free(instance->spill_file);
+        instance->spill_file = NULL;
+        storage_simply_remove(instance->storage, SUBGHZ_HISTORY_SPILL_PATH);
+    }
+    instance->spill_disabled = false;
+    instance->spill_head = 0;
+    instance->spill_count = 0;
+    instance->spill_data = NULL;
+}
+
+static bool subghz_history_spill_io(
+    SubGhzHistory* instance,
+    uint32_t offset,
+    uint8_t* data,
+    uint16_t size,
+    bool write) {
+    bool success = true;
+    while(success && size) {
+        const uint32_t position = offset % SUBGHZ_HISTORY_SPILL_FILE_SIZE;
+        const uint16_t chunk = MIN(size, SUBGHZ_HISTORY_SPILL_FILE_SIZE - position);
+        success = storage_file_seek(instance->spill_file, position, true);
+        if(success) {
+            success = (write ? storage_file_write(instance->spill_file, data, chunk) :
+                               storage_file_read(instance->spill_file, data, chunk)) == chunk;
+        }
+        offset += chunk;
+        data += chunk;
+        size -= chunk;
+    }
+    return success;
+}
+
+static bool subghz_history_spill_open(SubGhzHistory* instance) {
+    if(instance->spill_file) return true;
+    if(instance->spill_disabled) return false;
+
+    storage_simply_mkdir(instance->storage, SUBGHZ_HISTORY_SPILL_DIR);
+    instance->spill_file = storage_file_alloc(instance->storage);
+    if(!storage_file_open(
+           instance->spill_file, SUBGHZ_HISTORY_SPILL_PATH, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS)) {
+        FURI_LOG_W(TAG, "Spill file is not available, keeping history in RAM");
+        storage_file_free(instance->spill_file);
+        instance->spill_file = NULL;
+        instance->spill_disabled = true;
+        return false;
+    }
+
+    return true;
+}
+
+// Move serialized data of the oldest RAM item to the spill file, false if nothing was moved
+static bool subghz_history_spill_item(SubGhzHistory* instance) {
+    uint8_t* data = NULL;
+    uint16_t data_size = 0;
+    uint32_t offset = 0;
+
+    furi_mutex_acquire(instance->spill_mutex, FuriWaitForever);
+    // Item is copied, so that the receiver can continue while it is written
+    furi_mutex_acquire(instance->mutex, FuriWaitForever);
+    const size_t size = SubGhzHistoryItemArray_size(instance->items);
+    if(!instance->spill_disabled && size - instance->spill_count > SUBGHZ_HISTORY_RAM_ITEMS) {
+        SubGhzHistoryItem* item =
+            SubGhzHistoryItemArray_get(instance->items, instance->spill_count);
+
+        // Spilled items are the oldest ones, so the first item marks the ring tail
+        const uint32_t tail = instance->spill_count ?
+                                  SubGhzHistoryItemArray_get(instance->items, 0)->data_offset :
+                                  instance->spill_head;
+        if(instance->spill_head - tail + item->data_size <= SUBGHZ_HISTORY_SPILL_FILE_SIZE) {
+            data_size = item->data_size;
+            data = malloc(data_size);
+            memcpy(data, item->data, data_size);
+            offset = instance->spill_head;
+            instance->spill_data = item->data;
+        }
+    }
+    furi_mutex_release(instance->mutex);
+
+    if(!data) {
+        furi_mutex_release(instance->spill_mutex);
+        return false;
+    }
+
+    bool success = subghz_history_spill_open(instance);
+    if(success) {
+        success = subghz_history_spill_io(instance, offset, data, data_size, true);
+        if(!success) FURI_LOG_E(TAG, "Spill write error");
+    }
+    free(data);
+
+    furi_mutex_acquire(instance->mutex, FuriWaitForever);
+    // Deleting earlier items moves spill_count along, so the item is still at that index
+    if(success && instance->spill_data) {
+        SubGhzHistoryItem* item =
+            SubGhzHistoryItemArray_get(instance->items, instance->spill_count);
+        free(item->data);
+        item->data = NULL;
+        item->data_offset = offset;
+        instance->spill_head += data_size;
+        instance->spill_count++;
+    }
+    instance->spill_data = NULL;
+    furi_mutex_release(instance->mutex);
+    furi_mutex_release(instance->spill_mutex);
+
+    return success;
+}
+
+// Copy item data out, spilled data is read without holding the records mutex
+static bool subghz_history_item_read(
+    SubGhzHistory* instance,
+    uint16_t idx,
+    FuriString* menu,
+    FlipperFormat* raw_data) {
+    bool success = false;
+    uint8_t* data = NULL;
+    uint32_t data_offset = 0;
+    uint16_t data_size = 0;
+
+    furi_mutex_acquire(instance->mutex, FuriWaitForever);
+    if(idx < SubGhzHistoryItemArray_size(instance->items)) {
+        SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->items, idx);
+        data_size = item->data_size;
+        data_offset = item->data_offset;
+        data = malloc(data_size);
+        if(item->data) {
+            memcpy(data, item->data, data_size);
+            success = true;
+        }
+    }
+    furi_mutex_release(instance->mutex);
+
+    if(data && !success) {
+        furi_mutex_acquire(instance->spill_mutex, FuriWaitForever);
+        success = instance->spill_file &&
+                  subghz_history_spill_io(instance, data_offset, data, data_size, false);
+        furi_mutex_release(instance->spill_mutex);
+        if(!success) FURI_LOG_E(TAG, "Spill read error");
+    }
+
+    if(success) {
+        const size_t menu_size = strnlen((const char*)data, data_size - 1) + 1;
+        if(menu) {
+            furi_string_set_strn(menu, (const char*)data, menu_size - 1);
+        }
+        if(raw_data) {
+            Stream* stream = flipper_format_get_raw_stream(raw_data);
+            stream_clean(stream);
+            stream_write(stream, data + menu_size, data_size - menu_size);
+            flipper_format_rewind(raw_data);
+        }
+    }
+
+    free(data);
+    return success;
+}
+
+static void subghz_history_item_free(SubGhzHistory* instance, SubGhzHistoryItem* item) {
+    if(item->data && item->data == instance->spill_data) {
+        instance->spill_data = NULL;
+    }
+    free(item->data);
+    item->data = NULL;
+}
+
 SubGhzHistory* subghz_history_alloc(void) {
     SubGhzHistory* instance = malloc(sizeof(SubGhzHistory));
     instance->tmp_string = furi_string_alloc();
-    instance->history = malloc(sizeof(SubGhzHistoryStruct));
-    SubGhzHistoryItemArray_init(instance->history->data);
+    SubGhzHistoryItemArray_init(instance->items);
+    SubGhzHistoryPresetArray_init(instance->presets);
+    SubGhzHistoryHashDict_init(instance->hashes);
+    instance->raw_data = flipper_format_string_alloc();
     instance->rpc = furi_record_open(RECORD_RPC);
+    instance->mutex = furi_mutex_alloc(FuriMutexTypeRecursive);
+    instance->spill_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    instance->storage = furi_record_open(RECORD_STORAGE);
     return instance;
 }
 
 void subghz_history_free(SubGhzHistory* instance) {
     furi_assert(instance);
+    subghz_history_reset(instance);
     furi_string_free(instance->tmp_string);
-    for
-        M_EACH(item, instance->history->data, SubGhzHistoryItemArray_t) {
-            furi_string_free(item->item_str);
-            furi_string_free(item->preset->name);
-            free(item->preset);
-            flipper_format_free(item->flipper_string);
-            item->type = 0;
-        }
-    SubGhzHistoryItemArray_clear(instance->history->data);
-    free(instance->history);
+    SubGhzHistoryItemArray_clear(instance->items);
+    SubGhzHistoryPresetArray_clear(instance->presets);
+    SubGhzHistoryHashDict_clear(instance->hashes);
+    flipper_format_free(instance->raw_data);
+    furi_mutex_free(instance->spill_mutex);
+    furi_mutex_free(instance->mutex);
+    furi_record_close(RECORD_STORAGE);
     furi_record_close(RECORD_RPC);
     free(instance);
 }
 
+// Copy of the record, the receiver thread may add records meanwhile
+static SubGhzHistoryItem subghz_history_item_get(SubGhzHistory* instance, uint16_t idx) {
+    furi_mutex_acquire(instance->mutex, FuriWaitForever);
+    SubGhzHistoryItem item = *SubGhzHistoryItemArray_get(instance->items, idx);
+    furi_mutex_release(instance->mutex);
+    return item;
+}
+
 uint32_t subghz_history_get_hash_data(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return item->hash_data;
+    return subghz_history_item_get(instance, idx).hash_data;
 }
 
 const SubGhzProtocol* subghz_history_get_protocol(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return item->protocol;
+    return subghz_history_item_get(instance, idx).protocol;
 }
 
 uint16_t subghz_history_get_repeats(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return item->repeats;
+    return subghz_history_item_get(instance, idx).repeats;
 }
 
 uint32_t subghz_history_get_frequency(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return item->preset->frequency;
+    return subghz_history_item_get(instance, idx).frequency;
 }
 
 SubGhzRadioPreset* subghz_history_get_radio_preset(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return item->preset;
+    furi_mutex_acquire(instance->mutex, FuriWaitForever);
+    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->items, idx);
+    SubGhzHistoryPreset* preset =
+        SubGhzHistoryPresetArray_get(instance->presets, item->preset_index);
+    instance->radio_preset.name = preset->name;
+    instance->radio_preset.frequency = item->frequency;
+    instance->radio_preset.data = preset->data;
+    instance->radio_preset.data_size = preset->data_size;
+    instance->radio_preset.latitude = item->latitude;
+    instance->radio_preset.longitude = item->longitude;
+    furi_mutex_release(instance->mutex);
+    return &instance->radio_preset;
 }
 
 const char* subghz_history_get_preset(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return furi_string_get_cstr(item->preset->name);
+    furi_mutex_acquire(instance->mutex, FuriWaitForever);
+    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->items, idx);
+    SubGhzHistoryPreset* preset =
+        SubGhzHistoryPresetArray_get(instance->presets, item->preset_index);
+    furi_mutex_release(instance->mutex);
+    // Preset names live until the history is reset
+    return furi_string_get_cstr(preset->name);
 }
 
 float subghz_history_get_latitude(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return item->latitude;
+    return subghz_history_item_get(instance, idx).latitude;
 }
 
 float subghz_history_get_longitude(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return item->longitude;
+    return subghz_history_item_get(instance, idx).longitude;
 }
 
 void subghz_history_reset(SubGhzHistory* instance) {
     furi_assert(instance);
+    furi_mutex_acquire(instance->spill_mutex, FuriWaitForever);
+    furi_mutex_acquire(instance->mutex, FuriWaitForever);
     furi_string_reset(instance->tmp_string);
     for
-        M_EACH(item, instance->history->data, SubGhzHistoryItemArray_t) {
-            furi_string_free(item->item_str);
-            furi_string_free(item->preset->name);
-            free(item->preset);
-            flipper_format_free(item->flipper_string);
-            item->type = 0;
+        M_EACH(item, instance->items, SubGhzHistoryItemArray_t) {
+            subghz_history_item_free(instance, item);
+        }
+    SubGhzHistoryItemArray_reset(instance->items);
+    for
+        M_EACH(preset, instance->presets, SubGhzHistoryPresetArray_t) {
+            furi_string_free(preset->name);
         }
-    SubGhzHistoryItemArray_reset(instance->history->data);
+    SubGhzHistoryPresetArray_reset(instance->presets);
+    SubGhzHistoryHashDict_reset(instance->hashes);
+    subghz_history_spill_close(instance);
     instance->last_index_write = 0;
     instance->code_last_hash_data = 0;
+    furi_mutex_release(instance->mutex);
+    furi_mutex_release(instance->spill_mutex);
 }
 
 void subghz_history_delete_item(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
 
-    if(idx < SubGhzHistoryItemArray_size(instance->history->data)) {
-        SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-        furi_string_free(item->item_str);
-        furi_string_free(item->preset->name);
-        free(item->preset);
-        flipper_format_free(item->flipper_string);
-        item->type = 0;
-        SubGhzHistoryItemArray_remove_v(instance->history->data, idx, idx + 1);
+    furi_mutex_acquire(instance->mutex, FuriWaitForever);
+    if(idx < SubGhzHistoryItemArray_size(instance->items)) {
+        SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->items, idx);
+        subghz_history_hash_remove(instance, item);
+        subghz_history_item_free(instance, item);
+        if(idx < instance->spill_count) instance->spill_count--;
+        SubGhzHistoryItemArray_remove_v(instance->items, idx, idx + 1);
         instance->last_index_write--;
     }
+    furi_mutex_release(instance->mutex);
 }
 
 uint16_t subghz_history_get_item(SubGhzHistory* instance) {
@@ -151,45 +424,27 @@ uint16_t subghz_history_get_item(SubGhzHistory* instance) {
 
 uint8_t subghz_history_get_type_protocol(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    return item->type;
+    return subghz_history_item_get(instance, idx).type;
 }
 
 const char* subghz_history_get_protocol_name(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    if(!item || !item->flipper_string) {
-        FURI_LOG_E(TAG, "Missing Item");
-        furi_string_reset(instance->tmp_string);
-        return furi_string_get_cstr(instance->tmp_string);
-    }
-    flipper_format_rewind(item->flipper_string);
-    if(!flipper_format_read_string(item->flipper_string, "Protocol", instance->tmp_string)) {
-        FURI_LOG_E(TAG, "Missing Protocol");
-        furi_string_reset(instance->tmp_string);
-    }
-    return furi_string_get_cstr(instance->tmp_string);
+    return subghz_history_item_get(instance, idx).protocol->name;
 }
 
 DateTime subghz_history_get_datetime(SubGhzHistory* instance, uint16_t idx) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    if(item) {
-        return item->datetime;
-    } else {
-        return (DateTime){};
-    }
+    DateTime datetime = {};
+    datetime_timestamp_to_datetime(subghz_history_item_get(instance, idx).timestamp, &datetime);
+    return datetime;
 }
 
-FlipperFormat* subghz_history_get_raw_data(SubGhzHistory* instance, uint16_t idx) {
+bool subghz_history_get_raw_data(SubGhzHistory* instance, uint16_t idx, FlipperFormat* output) {
     furi_assert(instance);
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    if(item->flipper_string) {
-        return item->flipper_string;
-    } else {
-        return NULL;
-    }
+    furi_assert(output);
+    return subghz_history_item_read(instance, idx, NULL, output);
 }
+
 bool subghz_history_get_text_space_left(
     SubGhzHistory* instance,
     FuriString* output,
@@ -221,111 +476,50 @@ uint16_t subghz_history_get_last_index(SubGhzHistory* instance) {
     return instance->last_index_write;
 }
 void subghz_history_get_text_item_menu(SubGhzHistory* instance, FuriString* output, uint16_t idx) {
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    furi_string_set(output, item->item_str);
+    if(!subghz_history_item_read(instance, idx, output, NULL)) {
+        furi_string_reset(output);
+    }
 }
 
 void subghz_history_get_time_item_menu(SubGhzHistory* instance, FuriString* output, uint16_t idx) {
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->history->data, idx);
-    DateTime* t = &item->datetime;
-    furi_string_printf(output, "%.2d:%.2d:%.2d ", t->hour, t->minute, t->second);
+    DateTime t = subghz_history_get_datetime(instance, idx);
+    furi_string_printf(output, "%.2d:%.2d:%.2d ", t.hour, t.minute, t.second);
 }
 
-bool subghz_history_add_to_history(
-    SubGhzHistory* instance,
-    void* context,
-    SubGhzRadioPreset* preset) {
-    furi_assert(instance);
-    furi_assert(context);
-
-    if(subghz_history_full(instance)) return false;
-
-    SubGhzProtocolDecoderBase* decoder_base = context;
-    uint32_t hash_data = subghz_protocol_decoder_base_get_hash_data_long(decoder_base);
-    if((instance->code_last_hash_data == hash_data) &&
-       ((furi_get_tick() - instance->last_update_timestamp) < 600)) {
-        instance->last_update_timestamp = furi_get_tick();
-        return false;
-    }
-
-    uint16_t repeats = 0;
-    SubGhzHistoryItemArray_it_t it;
-    SubGhzHistoryItemArray_it_last(it, instance->history->data);
-    while(!SubGhzHistoryItemArray_end_p(it)) {
-        SubGhzHistoryItem* search = SubGhzHistoryItemArray_ref(it);
-        if(search->hash_data == hash_data && search->protocol == decoder_base->protocol) {
-            repeats = search->repeats + 1;
-            break;
-        }
-        SubGhzHistoryItemArray_previous(it);
-    }
-
-    instance->code_last_hash_data = hash_data;
-    instance->last_update_timestamp = furi_get_tick();
-
-    SubGhzHistoryItem* item = SubGhzHistoryItemArray_push_raw(instance->history->data);
-    item->preset = malloc(sizeof(SubGhzRadioPreset));
-    item->type = decoder_base->protocol->type;
-    if(decoder_base->protocol->filter & SubGhzProtocolFilter_Weather) {
-        // Other code uses protocol type to check if signal is usable
-        // so we can't change the actual protocol type, we fake it here
-        item->type = SubGhzProtocolWeatherStation;
-    }
-    item->preset->frequency = preset->frequency;
-    item->preset->name = furi_string_alloc();
-    furi_string_set(item->preset->name, preset->name);
-    item->preset->data = preset->data;
-    item->preset->data_size = preset->data_size;
-    furi_hal_rtc_get_datetime(&item->datetime);
-    item->hash_data = hash_data;
-    item->protocol = decoder_base->protocol;
-    item->repeats = repeats;
-    item->latitude = preset->latitude;
-    item->longitude = preset->longitude;
-
-    item->item_str = furi_string_alloc();
-    item->flipper_string = flipper_format_string_alloc();
-    subghz_protocol_decoder_base_serialize(decoder_base, item->flipper_string, preset);
-
-    if(decoder_base->protocol && decoder_base->protocol->decoder &&
-       decoder_base->protocol->decoder->get_string_brief) {
-        decoder_base->protocol->decoder->get_string_brief(decoder_base, item->item_str);
-        instance->last_index_write++;
-        return true;
-    }
-
+static void subghz_history_item_format_menu(SubGhzHistory* instance, FuriString* item_str) {
+    FlipperFormat* flipper_string = instance->raw_data;
     FuriString* text = furi_string_alloc();
 
     do {
-        if(!flipper_format_rewind(item->flipper_string)) {
+        if(!flipper_format_rewind(flipper_string)) {
             FURI_LOG_E(TAG, "Rewind error");
             break;
         }
-        if(!flipper_format_read_string(item->flipper_string, "Protocol", instance->tmp_string)) {
+        if(!flipper_format_read_string(flipper_string, "Protocol", instance->tmp_string)) {
             FURI_LOG_E(TAG, "Missing Protocol");
             break;
         }
         if(!strcmp(furi_string_get_cstr(instance->tmp_string), "KeeLoq")) {
             furi_string_set(instance->tmp_string, "KL ");
-            if(!flipper_format_read_string(item->flipper_string, "Manufacture", text)) {
+            if(!flipper_format_read_string(flipper_string, "Manufacture", text)) {
                 FURI_LOG_E(TAG, "Missing Protocol");
                 break;
             }
             furi_string_cat(instance->tmp_string, text);
         } else if(!strcmp(furi_string_get_cstr(instance->tmp_string), "Star Line")) {
             furi_string_set(instance->tmp_string, "SL ");
-            if(!flipper_format_read_string(item->flipper_string, "Manufacture", text)) {
+            if(!flipper_format_read_string(flipper_string, "Manufacture", text)) {
                 FURI_LOG_E(TAG, "Missing Protocol");
                 break;
             }
             furi_string_cat(instance->tmp_string, text);
         }
-        if(!flipper_format_rewind(item->flipper_string)) {
+        if(!flipper_format_rewind(flipper_string)) {
             FURI_LOG_E(TAG, "Rewind error");
             break;
         }
         uint8_t key_data[sizeof(uint64_t)] = {0};
-        if(!flipper_format_read_hex(item->flipper_string, "Key", key_data, sizeof(uint64_t))) {
+        if(!flipper_format_read_hex(flipper_string, "Key", key_data, sizeof(uint64_t))) {
             FURI_LOG_D(TAG, "No Key");
         }
         uint64_t data = 0;
@@ -335,50 +529,157 @@ bool subghz_history_add_to_history(
         if(data != 0) {
             if(!(uint32_t)(data >> 32)) {
                 furi_string_printf(
-                    item->item_str,
+                    item_str,
                     "%s %lX",
                     furi_string_get_cstr(instance->tmp_string),
                     (uint32_t)(data & 0xFFFFFFFF));
             } else {
                 furi_string_printf(
-                    item->item_str,
+                    item_str,
                     "%s %lX%08lX",
                     furi_string_get_cstr(instance->tmp_string),
                     (uint32_t)(data >> 32),
                     (uint32_t)(data & 0xFFFFFFFF));
             }
         } else {
-            furi_string_printf(item->item_str, "%s", furi_string_get_cstr(instance->tmp_string));
+            furi_string_printf(item_str, "%s", furi_string_get_cstr(instance->tmp_string));
         }
 
     } while(false);
 
     furi_string_free(text);
+}
+
+static bool subghz_history_add_to_history_locked(
+    SubGhzHistory* instance,
+    void* context,
+    SubGhzRadioPreset* preset) {
+    if(subghz_history_full(instance)) return false;
+
+    SubGhzProtocolDecoderBase* decoder_base = context;
+    uint32_t hash_data = subghz_protocol_decoder_base_get_hash_data_long(decoder_base);
+    if((instance->code_last_hash_data == hash_data) &&
+       ((furi_get_tick() - instance->last_update_timestamp) < 600)) {
+        instance->last_update_timestamp = furi_get_tick();
+        return false;
+    }
+
+    instance->code_last_hash_data = hash_data;
+    instance->last_update_timestamp = furi_get_tick();
+
+    // Serialize first, so the record is only added when it is complete
+    Stream* stream = flipper_format_get_raw_stream(instance->raw_data);
+    stream_clean(stream);
+    subghz_protocol_decoder_base_serialize(decoder_base, instance->raw_data, preset);
+
+    FuriString* item_str = furi_string_alloc();
+    if(decoder_base->protocol && decoder_base->protocol->decoder &&
+       decoder_base->protocol->decoder->get_string_brief) {
+        decoder_base->protocol->decoder->get_string_brief(decoder_base, item_str);
+    } else {
+        subghz_history_item_format_menu(instance, item_str);
+    }
+
+    const size_t menu_size = furi_string_size(item_str) + 1;
+    const size_t raw_size = stream_size(stream);
+    if(menu_size + raw_size > UINT16_MAX) {
+        FURI_LOG_E(TAG, "Item is too big");
+        furi_string_free(item_str);
+        return false;
+    }
+
+    SubGhzHistoryItem* item = SubGhzHistoryItemArray_push_raw(instance->items);
+    item->protocol = decoder_base->protocol;
+    item->hash_data = hash_data;
+    item->type = decoder_base->protocol->type;
+    if(decoder_base->protocol->filter & SubGhzProtocolFilter_Weather) {
+        // Other code uses protocol type to check if signal is usable
+        // so we can't change the actual protocol type, we fake it here
+        item->type = SubGhzProtocolWeatherStation;
+    }
+    item->frequency = preset->frequency;
+    item->preset_index = subghz_history_preset_index(instance, preset);
+    DateTime datetime;
+    furi_hal_rtc_get_datetime(&datetime);
+    item->timestamp = datetime_datetime_to_timestamp(&datetime);
+    item->latitude = preset->latitude;
+    item->longitude = preset->longitude;
+
+    item->data_size = menu_size + raw_size;
+    item->data_offset = 0;
+    item->data = malloc(item->data_size);
+    memcpy(item->data, furi_string_get_cstr(item_str), menu_size);
+    stream_rewind(stream);
+    stream_read(stream, item->data + menu_size, raw_size);
+    furi_string_free(item_str);
+
+    // Repeat counter continues from the latest record of the same signal
+    const uint64_t key = subghz_history_hash_key(item);
+    SubGhzHistoryHashEntry* entry = SubGhzHistoryHashDict_get(instance->hashes, key);
+    if(entry) {
+        entry->count++;
+        entry->repeats++;
+        item->repeats = entry->repeats;
+    } else {
+        SubGhzHistoryHashDict_set_at(
+            instance->hashes, key, (SubGhzHistoryHashEntry){.count = 1, .repeats = 0});
+        item->repeats = 0;
+    }
+
     instance->last_index_write++;
     return true;
 }
 
-void subghz_history_remove_duplicates(SubGhzHistory* instance) {
+bool subghz_history_add_to_history(
+    SubGhzHistory* instance,
+    void* context,
+    SubGhzRadioPreset* preset) {
+    furi_assert(instance);
+    furi_assert(context);
+
+    furi_mutex_acquire(instance->mutex, FuriWaitForever);
+    bool added = subghz_history_add_to_history_locked(instance, context, preset);
+    furi_mutex_release(instance->mutex);
+    return added;
+}
+
+void subghz_history_spill(SubGhzHistory* instance) {
     furi_assert(instance);
+    while(subghz_history_spill_item(instance)) {
+    }
+}
 
-    SubGhzHistoryItemArray_it_t it;
-    SubGhzHistoryItemArray_it_last(it, instance->history->data);
-    while(!SubGhzHistoryItemArray_end_p(it)) {
-        SubGhzHistoryItem* i = SubGhzHistoryItemArray_ref(it);
+void subghz_history_remove_duplicates(SubGhzHistory* instance) {
+    furi_assert(instance);
 
-        SubGhzHistoryItemArray_it_t jt;
-        SubGhzHistoryItemArray_it_set(jt, it);
-        SubGhzHistoryItemArray_previous(jt);
-        while(!SubGhzHistoryItemArray_end_p(jt)) {
-            SubGhzHistoryItem* j = SubGhzHistoryItemArray_ref(jt);
+    furi_mutex_acquire(instance->mutex, FuriWaitForever);
+
+    // Keep the latest record of every signal, compacting the array in a single pass
+    size_t write = 0;
+    uint16_t spill_count = 0;
+    const size_t size = SubGhzHistoryItemArray_size(instance->items);
+    for(size_t read = 0; read < size; read++) {
+        SubGhzHistoryItem* item = SubGhzHistoryItemArray_get(instance->items, read);
+        SubGhzHistoryHashEntry* entry =
+            SubGhzHistoryHashDict_get(instance->hashes, subghz_history_hash_key(item));
+
+        if(entry && entry->count > 1) {
+            entry->count--;
+            subghz_history_item_free(instance, item);
+            continue;
+        }
 
-            if(j->hash_data == i->hash_data && j->protocol == i->protocol) {
-                subghz_history_delete_item(instance, jt->index);
-            }
-            SubGhzHistoryItemArray_previous(jt);
+        if(read < instance->spill_count) spill_count++;
+        if(write != read) {
+            *SubGhzHistoryItemArray_get(instance->items, write) = *item;
         }
-        SubGhzHistoryItemArray_previous(it);
+        write++;
     }
+
+    SubGhzHistoryItemArray_resize(instance->items, write);
+    instance->spill_count = spill_count;
+    instance->last_index_write = write;
+    furi_mutex_release(instance->mutex);
 }
 
 bool subghz_history_full(SubGhzHistory* instance) {
@@ -153,13 +153,20 @@ bool subghz_history_add_to_history(
     void* context,
     SubGhzRadioPreset* preset);
 
-/** Get SubGhzProtocolCommonLoad to load into the protocol decoder bin data
+/** Move older records to the spill file, call from the GUI thread
+ * 
+ * @param instance  - SubGhzHistory instance
+ */
+void subghz_history_spill(SubGhzHistory* instance);
+
+/** Get serialized record data to load into the protocol decoder
  * 
  * @param instance  - SubGhzHistory instance
  * @param idx       - record index
- * @return SubGhzProtocolCommonLoad*
+ * @param output    - FlipperFormat to fill, owned by the caller
+ * @return bool     - false if the record data could not be read
  */
-FlipperFormat* subghz_history_get_raw_data(SubGhzHistory* instance, uint16_t idx);
+bool subghz_history_get_raw_data(SubGhzHistory* instance, uint16_t idx, FlipperFormat* output);
 
 /** Get latitude to history[idx]
  * 
@@ -23,6 +23,7 @@
 #include <subghz/scenes/subghz_scene.h>
 #include <lib/subghz/subghz_worker.h>
 #include <lib/subghz/subghz_file_encoder_worker.h>
+#include <lib/subghz/subghz_raw_analyzer.h>
 #include <lib/subghz/subghz_setting.h>
 #include <lib/subghz/receiver.h>
 #include <lib/subghz/transmitter.h>
@@ -91,7 +92,8 @@ struct SubGhz {
 
     SecureData* secure_data;
 
-    SubGhzFileEncoderWorker* decode_raw_file_worker_encoder;
+    SubGhzRawAnalyzer* decode_raw_analyzer;
+    SubGhzRadioPreset decode_raw_preset;
 
     SubGhzThresholdRssi* threshold_rssi;
     SubGhzRxKeyState rx_key_state;
@@ -137,5 +139,7 @@ bool subghz_is_locked(SubGhz* subghz);
 void subghz_rx_key_state_set(SubGhz* subghz, SubGhzRxKeyState state);
 SubGhzRxKeyState subghz_rx_key_state_get(SubGhz* subghz);
 
+void subghz_scene_decode_raw_stop(SubGhz* subghz);
+
 extern const NotificationSequence subghz_sequence_rx;
 extern const NotificationSequence subghz_sequence_rx_locked;
@@ -15,6 +15,9 @@
 #define CLI_PROMPT          ">: " // qFlipper does not recognize us if we use escape sequences :(
 #define CLI_PROMPT_LENGTH   3 // printable characters
 
+// Reached from job stdout, which has no context
+static Cli* cli_jobs_owner = NULL;
+
 Cli* cli_alloc(void) {
     Cli* cli = malloc(sizeof(Cli));
 
@@ -29,12 +32,27 @@ Cli* cli_alloc(void) {
 
     cli->idle_sem = furi_semaphore_alloc(1, 0);
 
+    cli_jobs_owner = cli;
+
     return cli;
 }
 
+static CliJob* cli_job_current(Cli* cli) {
+    FuriThreadId thread_id = furi_thread_get_current_id();
+    for(size_t i = 0; i < CLI_JOBS_MAX; i++) {
+        if(cli->jobs[i].thread_id == thread_id) return &cli->jobs[i];
+    }
+    return NULL;
+}
+
+static bool cli_job_muted(Cli* cli) {
+    CliJob* job = cli_job_current(cli);
+    return job && job->muted;
+}
+
 void cli_putc(Cli* cli, char c) {
     furi_check(cli);
-    if(cli->session != NULL) {
+    if(cli->session != NULL && !cli_job_muted(cli)) {
         cli->session->tx((uint8_t*)&c, 1);
     }
 }
@@ -42,7 +60,10 @@ void cli_putc(Cli* cli, char c) {
 char cli_getc(Cli* cli) {
     furi_check(cli);
     char c = 0;
-    if(cli->session != NULL) {
+    if(cli_job_current(cli)) {
+        // Input belongs to the foreground
+        c = CliKeyETX;
+    } else if(cli->session != NULL) {
         if(cli->session->rx((uint8_t*)&c, 1, FuriWaitForever) == 0) {
             cli_reset(cli);
             furi_delay_tick(10);
@@ -56,14 +77,14 @@ char cli_getc(Cli* cli) {
 
 void cli_write(Cli* cli, const uint8_t* buffer, size_t size) {
     furi_check(cli);
-    if(cli->session != NULL) {
+    if(cli->session != NULL && !cli_job_muted(cli)) {
         cli->session->tx(buffer, size);
     }
 }
 
 size_t cli_read(Cli* cli, uint8_t* buffer, size_t size) {
     furi_check(cli);
-    if(cli->session != NULL) {
+    if(cli->session != NULL && !cli_job_current(cli)) {
         return cli->session->rx(buffer, size, FuriWaitForever);
     } else {
         return 0;
@@ -72,7 +93,7 @@ size_t cli_read(Cli* cli, uint8_t* buffer, size_t size) {
 
 size_t cli_read_timeout(Cli* cli, uint8_t* buffer, size_t size, uint32_t timeout) {
     furi_check(cli);
-    if(cli->session != NULL) {
+    if(cli->session != NULL && !cli_job_current(cli)) {
         return cli->session->rx(buffer, size, timeout);
     } else {
         return 0;
@@ -90,7 +111,10 @@ bool cli_is_connected(Cli* cli) {
 bool cli_cmd_interrupt_received(Cli* cli) {
     furi_check(cli);
     char c = '\0';
-    if(cli_is_connected(cli)) {
+    CliJob* job = cli_job_current(cli);
+    if(job) {
+        return job->stop || !cli_is_connected(cli);
+    } else if(cli_is_connected(cli)) {
         if(cli->session->rx((uint8_t*)&c, 1, 0) == 1) {
             return c == CliKeyETX;
         }
@@ -208,8 +232,97 @@ static void cli_execute_command(Cli* cli, CliCommand* command, FuriString* args)
     }
 }
 
+/* Job output goes to the session open at the moment, unless the job is muted */
+static void cli_job_stdout(const char* data, size_t size) {
+    Cli* cli = cli_jobs_owner;
+    // Transmit outside of the cli mutex, session serializes output on its own
+    furi_check(furi_mutex_acquire(cli->mutex, FuriWaitForever) == FuriStatusOk);
+    CliSession* session = cli_job_muted(cli) ? NULL : cli->session;
+    furi_check(furi_mutex_release(cli->mutex) == FuriStatusOk);
+
+    if(session != NULL) {
+        session->tx_stdout(data, size);
+    }
+}
+
+static int32_t cli_job_thread(void* context) {
+    CliJob* job = context;
+    Cli* cli = job->cli;
+    job->thread_id = furi_thread_get_current_id();
+    furi_thread_set_stdout_callback(cli_job_stdout);
+
+    cli_execute_command(cli, &job->command, job->args);
+
+    printf(
+        "\r\n[%zu] Done: %s\r\n",
+        (size_t)(job - cli->jobs) + 1,
+        furi_string_get_cstr(job->line));
+    fflush(stdout);
+    return 0;
+}
+
+static void cli_job_start(Cli* cli, CliCommand* command, FuriString* args) {
+    furi_check(furi_mutex_acquire(cli->mutex, FuriWaitForever) == FuriStatusOk);
+    CliJob* job = NULL;
+    for(size_t i = 0; i < CLI_JOBS_MAX; i++) {
+        if(cli->jobs[i].thread == NULL) {
+            job = &cli->jobs[i];
+            break;
+        }
+    }
+
+    if(job) {
+        job->cli = cli;
+        job->command = *command;
+        job->line = furi_string_alloc_set(cli->line);
+        job->args = furi_string_alloc_set(args);
+        job->stop = false;
+        job->muted = false;
+        job->thread = furi_thread_alloc_ex("CliJob", CLI_JOB_STACK_SIZE, cli_job_thread, job);
+        printf("[%zu] %s", (size_t)(job - cli->jobs) + 1, furi_string_get_cstr(job->line));
+        furi_thread_start(job->thread);
+    } else {
+        printf("Too many jobs, wait for one to finish or `kill` it");
+    }
+    furi_check(furi_mutex_release(cli->mutex) == FuriStatusOk);
+}
+
+static void cli_jobs_stop_locked(Cli* cli) {
+    for(size_t i = 0; i < CLI_JOBS_MAX; i++) {
+        CliJob* job = &cli->jobs[i];
+        if(job->thread) {
+            job->stop = true;
+            job->muted = true;
+        }
+    }
+}
+
+void cli_jobs_stop(Cli* cli) {
+    furi_check(cli);
+    furi_check(furi_mutex_acquire(cli->mutex, FuriWaitForever) == FuriStatusOk);
+    cli_jobs_stop_locked(cli);
+    furi_check(furi_mutex_release(cli->mutex) == FuriStatusOk);
+}
+
+void cli_jobs_reap(Cli* cli) {
+    furi_check(cli);
+    furi_check(furi_mutex_acquire(cli->mutex, FuriWaitForever) == FuriStatusOk);
+    for(size_t i = 0; i < CLI_JOBS_MAX; i++) {
+        CliJob* job = &cli->jobs[i];
+        if(job->thread && furi_thread_get_state(job->thread) == FuriThreadStateStopped) {
+            furi_thread_join(job->thread);
+            furi_thread_free(job->thread);
+            furi_string_free(job->line);
+            furi_string_free(job->args);
+            memset(job, 0, sizeof(CliJob));
+        }
+    }
+    furi_check(furi_mutex_release(cli->mutex) == FuriStatusOk);
+}
+
 static void cli_handle_enter(Cli* cli) {
     cli_normalize_line(cli);
+    cli_jobs_reap(cli);
 
     if(furi_string_size(cli->line) == 0) {
         cli_prompt(cli);
@@ -232,6 +345,14 @@ static void cli_handle_enter(Cli* cli) {
         furi_string_trim(args);
     }
 
+    // Trailing `&` runs the command in its own thread
+    FuriString* last_arg = furi_string_size(args) ? args : command;
+    bool background = furi_string_end_with_str(last_arg, "&");
+    if(background) {
+        furi_string_left(last_arg, furi_string_size(last_arg) - 1);
+        furi_string_trim(last_arg);
+    }
+
     // Search for command
     furi_check(furi_mutex_acquire(cli->mutex, FuriWaitForever) == FuriStatusOk);
     CliCommand* cli_command_ptr = CliCommandTree_get(cli->commands, command);
@@ -241,7 +362,11 @@ static void cli_handle_enter(Cli* cli) {
         memcpy(&cli_command, cli_command_ptr, sizeof(CliCommand));
         furi_check(furi_mutex_release(cli->mutex) == FuriStatusOk);
         cli_nl(cli);
-        cli_execute_command(cli, &cli_command, args);
+        if(background) {
+            cli_job_start(cli, &cli_command, args);
+        } else {
+            cli_execute_command(cli, &cli_command, args);
+        }
     } else {
         furi_check(furi_mutex_release(cli->mutex) == FuriStatusOk);
         cli_nl(cli);
@@ -530,6 +655,8 @@ void cli_session_open(Cli* cli, void* session) {
     furi_check(cli);
 
     furi_check(furi_mutex_acquire(cli->mutex, FuriWaitForever) == FuriStatusOk);
+    // Jobs belong to the terminal of the previous session
+    cli_jobs_stop_locked(cli);
     cli->session = session;
     if(cli->session != NULL) {
         cli->session->init();
@@ -545,6 +672,7 @@ void cli_session_close(Cli* cli) {
     furi_check(cli);
 
     furi_check(furi_mutex_acquire(cli->mutex, FuriWaitForever) == FuriStatusOk);
+    cli_jobs_stop_locked(cli);
     if(cli->session != NULL) {
         cli->session->deinit();
     }
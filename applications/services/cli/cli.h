@@ -115,6 +115,15 @@ void cli_session_close(Cli* cli);
 
 bool cli_is_connected(Cli* cli);
 
+/** Stop background jobs and drop their further output
+ *
+ * Call before the session is used for anything but the terminal, like RPC.
+ * Jobs that do not check cli_cmd_interrupt_received keep running silently.
+ *
+ * @param      cli   Cli instance
+ */
+void cli_jobs_stop(Cli* cli);
+
 #ifdef __cplusplus
 }
 #endif
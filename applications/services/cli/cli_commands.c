@@ -12,6 +12,7 @@
 #include <loader/loader.h>
 #include <lib/toolbox/args.h>
 #include <lib/toolbox/strint.h>
+#include <lib/toolbox/zone_profiler.h>
 #include <storage/storage.h>
 
 // Close to ISO, `date +'%Y-%m-%d %H:%M:%S %u'`
@@ -246,6 +247,8 @@ void cli_command_help(Cli* cli, FuriString* args, void* context) {
         }
     }
 
+    printf("\r\n\r\nEnd a command with `&` to run it in background, see `jobs` and `kill`");
+
     if(furi_string_size(args) > 0) {
         cli_nl(cli);
         printf("`");
@@ -363,6 +366,8 @@ bool cli_command_log_level_set_from_string(FuriString* level) {
             "<log debug> — debug information including <log info> (may impact system performance)\r\n");
         printf(
             "<log trace> — system traces including <log debug> (may impact system performance)\r\n");
+        printf(
+            "<log deferred [level]> — binary records for scripts/logdecode.py, least timing impact\r\n");
     }
     return false;
 }
@@ -373,6 +378,14 @@ void cli_command_log(Cli* cli, FuriString* args, void* context) {
     uint8_t buffer[CLI_COMMAND_LOG_BUFFER_SIZE];
     FuriLogLevel previous_level = furi_log_get_level();
     bool restore_log_level = false;
+    bool restore_deferred = false;
+
+    if(furi_string_start_with_str(args, "deferred") &&
+       args_get_first_word_length(args) == strlen("deferred")) {
+        furi_string_right(args, strlen("deferred"));
+        furi_string_trim(args);
+        restore_deferred = !furi_log_is_deferred();
+    }
 
     if(furi_string_size(args) > 0) {
         if(!cli_command_log_level_set_from_string(args)) {
@@ -392,6 +405,7 @@ void cli_command_log(Cli* cli, FuriString* args, void* context) {
     };
 
     furi_log_add_handler(log_handler);
+    if(restore_deferred) furi_log_set_deferred(true);
 
     printf("Use <log ?> to list available log levels\r\n");
     printf("Press CTRL+C to stop...\r\n");
@@ -400,6 +414,7 @@ void cli_command_log(Cli* cli, FuriString* args, void* context) {
         cli_write(cli, buffer, ret);
     }
 
+    if(restore_deferred) furi_log_set_deferred(false);
     furi_log_remove_handler(log_handler);
 
     if(restore_log_level) {
@@ -651,12 +666,473 @@ void cli_command_free(Cli* cli, FuriString* args, void* context) {
     printf("Maximum pool block: %zu\r\n", memmgr_pool_get_max_block());
 }
 
+static void cli_command_free_blocks_latency(const char* name, const MemmgrHeapLatency* latency) {
+    const uint32_t cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+    printf(
+        "%-12s calls %-8lu avg %5lu max %5lu cycles, total %lu us\r\n",
+        name,
+        latency->count,
+        latency->count ? (uint32_t)(latency->total / latency->count) : 0,
+        latency->max,
+        (uint32_t)(latency->total / cycles_per_us));
+}
+
 void cli_command_free_blocks(Cli* cli, FuriString* args, void* context) {
     UNUSED(cli);
-    UNUSED(args);
     UNUSED(context);
 
+    if(furi_string_cmp_str(args, "reset") == 0) {
+        memmgr_heap_reset_latency();
+        return;
+    } else if(!furi_string_empty(args)) {
+        cli_print_usage("free_blocks", "<reset>", furi_string_get_cstr(args));
+        return;
+    }
+
     memmgr_heap_printf_free_blocks();
+
+    MemmgrHeapStats stats;
+    memmgr_heap_get_stats(&stats);
+
+    printf(
+        "Free: %zu bytes in %zu blocks, largest %zu, fragmentation %u%%\r\n",
+        stats.free_bytes,
+        stats.free_blocks,
+        stats.max_free_block,
+        stats.fragmentation);
+    for(size_t i = 0; i < MEMMGR_HEAP_POOL_COUNT; i++) {
+        const MemmgrHeapPoolStats* pool = &stats.pools[i];
+        printf(
+            "Pool %3zu: %zu slabs, %zu/%zu slots used\r\n",
+            pool->block_size,
+            pool->slabs,
+            pool->used,
+            pool->total);
+    }
+    cli_command_free_blocks_latency("heap malloc", &stats.heap_malloc);
+    cli_command_free_blocks_latency("heap free", &stats.heap_free);
+    cli_command_free_blocks_latency("pool malloc", &stats.pool_malloc);
+    cli_command_free_blocks_latency("pool free", &stats.pool_free);
+}
+
+#define CLI_COMMAND_HEAP_TRACE_CAPACITY 1024
+
+static void cli_command_heap_trace_dump(void) {
+    size_t lost = 0;
+    size_t count = memmgr_heap_trace_get_records(NULL, 0, NULL);
+    // Room for blocks allocated meanwhile, the dump buffer is one of them
+    count += 16;
+    MemmgrHeapTraceRecord* records = malloc(sizeof(MemmgrHeapTraceRecord) * count);
+    const size_t live = memmgr_heap_trace_get_records(records, count, &lost);
+
+    size_t total = 0;
+    printf("caller     size     pointer\r\n");
+    for(size_t i = 0; i < MIN(live, count); i++) {
+        printf(
+            "0x%08lX %-8zu 0x%08lX\r\n",
+            (uint32_t)records[i].caller,
+            records[i].size,
+            (uint32_t)records[i].pointer);
+        total += records[i].size;
+    }
+    printf("Live: %zu blocks, %zu bytes, lost: %zu\r\n", live, total, lost);
+
+    free(records);
+}
+
+void cli_command_heap_trace(Cli* cli, FuriString* args, void* context) {
+    UNUSED(cli);
+    UNUSED(context);
+
+    FuriString* cmd = furi_string_alloc();
+    do {
+        if(!args_read_string_and_trim(args, cmd)) {
+            cli_print_usage("heap_trace", "<start [capacity]|stop|dump>", "");
+            break;
+        }
+
+        if(furi_string_cmp_str(cmd, "start") == 0) {
+            int capacity = CLI_COMMAND_HEAP_TRACE_CAPACITY;
+            if(furi_string_size(args) &&
+               (!args_read_int_and_trim(args, &capacity) || capacity <= 0 ||
+                capacity > UINT16_MAX)) {
+                cli_print_usage("heap_trace start", "<1-65535>", furi_string_get_cstr(args));
+                break;
+            }
+            if(memmgr_heap_trace_is_running()) {
+                printf("Already running\r\n");
+            } else if(memmgr_heap_trace_start(capacity)) {
+                printf("Tracing up to %d live blocks\r\n", capacity);
+            } else {
+                printf("Not enough memory for %d blocks, try a smaller capacity\r\n", capacity);
+            }
+        } else if(furi_string_cmp_str(cmd, "stop") == 0) {
+            memmgr_heap_trace_stop();
+        } else if(furi_string_cmp_str(cmd, "dump") == 0) {
+            if(memmgr_heap_trace_is_running()) {
+                // Symbolize with scripts/heaptrace.py
+                cli_command_heap_trace_dump();
+            } else {
+                printf("Not running, use <heap_trace start>\r\n");
+            }
+        } else {
+            cli_print_usage(
+                "heap_trace", "<start [capacity]|stop|dump>", furi_string_get_cstr(cmd));
+        }
+    } while(false);
+
+    furi_string_free(cmd);
+}
+
+static void cli_command_histogram(const uint32_t* histogram, size_t size, char* text) {
+    static const char levels[] = " .:-=+*#";
+    uint32_t peak = 0;
+    for(size_t i = 0; i < size; i++) {
+        peak = MAX(peak, histogram[i]);
+    }
+    for(size_t i = 0; i < size; i++) {
+        const uint32_t value = histogram[i];
+        const size_t level = value ? 1 + (uint64_t)value * (sizeof(levels) - 3) / peak : 0;
+        text[i] = levels[level];
+    }
+    text[size] = '\0';
+}
+
+static void cli_command_profiler_view(Cli* cli, uint32_t interval) {
+    const float cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+    uint32_t previous[ZoneProfilerIdNum] = {0};
+    char histogram[ZONE_PROFILER_HISTOGRAM_SIZE + 1];
+
+    printf("\e[2J\e[?25l"); // Clear display, hide cursor
+    while(!cli_cmd_interrupt_received(cli)) {
+        printf("\e[0;0f"); // Return to 0,0
+        printf(
+            "\rZones: %d, histogram from <%lu cycles, x2 per column\e[0K\r\n\r\n",
+            ZoneProfilerIdNum,
+            zone_profiler_get_bucket_start(1));
+        printf(
+            "\r%-16s %10s %8s %9s %9s %9s  %-16s\e[0K\r\n",
+            "Zone",
+            "Calls",
+            "Calls/s",
+            "Min us",
+            "Avg us",
+            "Max us",
+            "Histogram");
+
+        for(size_t i = 0; i < ZoneProfilerIdNum; i++) {
+            ZoneProfilerStats stats;
+            zone_profiler_get_stats(i, &stats);
+            cli_command_histogram(stats.histogram, ZONE_PROFILER_HISTOGRAM_SIZE, histogram);
+            // Counts start over after <profiler reset>
+            const uint32_t calls = stats.count - ((stats.count >= previous[i]) ? previous[i] : 0);
+            const uint32_t rate = (uint64_t)calls * 1000 / interval;
+            previous[i] = stats.count;
+            printf(
+                "\r%-16s %10lu %8lu %9.2f %9.2f %9.2f |%s|\e[0K\r\n",
+                stats.name,
+                stats.count,
+                rate,
+                (double)(stats.min / cycles_per_us),
+                (double)(stats.count ? stats.total / stats.count / cycles_per_us : 0),
+                (double)(stats.max / cycles_per_us),
+                histogram);
+        }
+
+        furi_delay_ms(interval);
+    }
+    printf("\e[?25h"); // Show cursor
+}
+
+static void cli_command_profiler_stream(Cli* cli, uint32_t interval) {
+    // Parsed by scripts/zoneprof.py
+    printf(
+        "profiler,%lu,%d\r\n",
+        furi_hal_cortex_instructions_per_microsecond(),
+        ZONE_PROFILER_HISTOGRAM_SIZE);
+    while(!cli_cmd_interrupt_received(cli)) {
+        const uint32_t tick = furi_get_tick();
+        for(size_t i = 0; i < ZoneProfilerIdNum; i++) {
+            ZoneProfilerStats stats;
+            zone_profiler_get_stats(i, &stats);
+            printf(
+                "zone,%lu,%zu,%lu,%lu,%lu,%llu,",
+                tick,
+                i,
+                stats.count,
+                stats.min,
+                stats.max,
+                stats.total);
+            for(size_t bucket = 0; bucket < ZONE_PROFILER_HISTOGRAM_SIZE; bucket++) {
+                printf("%lu,", stats.histogram[bucket]);
+            }
+            printf("%s\r\n", stats.name);
+        }
+        furi_delay_ms(interval);
+    }
+}
+
+void cli_command_profiler(Cli* cli, FuriString* args, void* context) {
+    UNUSED(context);
+
+    FuriString* cmd = furi_string_alloc();
+    do {
+        args_read_string_and_trim(args, cmd);
+        const bool stream = furi_string_cmp_str(cmd, "stream") == 0;
+
+        if(furi_string_cmp_str(cmd, "on") == 0) {
+            zone_profiler_set_enabled(true);
+        } else if(furi_string_cmp_str(cmd, "off") == 0) {
+            zone_profiler_set_enabled(false);
+        } else if(furi_string_cmp_str(cmd, "reset") == 0) {
+            zone_profiler_reset();
+        } else if(furi_string_empty(cmd) || stream) {
+            int interval = 1000;
+            if(furi_string_size(args) &&
+               (!args_read_int_and_trim(args, &interval) || interval <= 0)) {
+                cli_print_usage("profiler", "[stream] [interval]", furi_string_get_cstr(args));
+                break;
+            }
+
+            // Zones are only timed while watched, unless enabled with <profiler on>
+            const bool restore = !zone_profiler_is_enabled();
+            zone_profiler_set_enabled(true);
+            if(stream) {
+                cli_command_profiler_stream(cli, interval);
+            } else {
+                cli_command_profiler_view(cli, interval);
+            }
+            if(restore) zone_profiler_set_enabled(false);
+        } else {
+            cli_print_usage(
+                "profiler", "<on|off|reset|[stream] [interval]>", furi_string_get_cstr(cmd));
+        }
+    } while(false);
+
+    furi_string_free(cmd);
+}
+
+#define CLI_COMMAND_SCHED_EVENTS 1024
+
+static void cli_command_sched_view(Cli* cli, uint32_t interval) {
+    const float cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+    FuriThreadTraceThread* threads =
+        malloc(sizeof(FuriThreadTraceThread) * FURI_THREAD_TRACE_THREADS_MAX);
+    char histogram[FURI_THREAD_TRACE_HISTOGRAM_SIZE + 1];
+
+    printf("\e[2J\e[?25l"); // Clear display, hide cursor
+    while(!cli_cmd_interrupt_received(cli) && furi_thread_trace_is_running()) {
+        FuriThreadTraceInfo info;
+        const size_t count =
+            furi_thread_trace_get_threads(threads, FURI_THREAD_TRACE_THREADS_MAX, &info);
+
+        printf("\e[0;0f"); // Return to 0,0
+        printf(
+            "\rThreads: %zu, events: %lu, untracked switches: %lu, traced for %llus\e[0K\r\n",
+            count,
+            info.events,
+            info.untracked,
+            info.cycles / furi_hal_cortex_instructions_per_microsecond() / 1000000);
+        printf(
+            "\rLatency histogram from <%lu cycles, x2 per column\e[0K\r\n\r\n",
+            furi_thread_trace_get_bucket_start(1));
+        printf(
+            "\r%-17s %6s %6s %9s %9s %9s %9s  %-16s  %s\e[0K\r\n",
+            "Name",
+            "CPU %",
+            "ISR %",
+            "Switches",
+            "Preempted",
+            "Avg us",
+            "Max us",
+            "Latency",
+            "Blocked most on");
+
+        for(size_t i = 0; i < MIN(count, (size_t)FURI_THREAD_TRACE_THREADS_MAX); i++) {
+            const FuriThreadTraceThread* thread = &threads[i];
+            uint32_t latencies = 0;
+            for(size_t bucket = 0; bucket < FURI_THREAD_TRACE_HISTOGRAM_SIZE; bucket++) {
+                latencies += thread->latency_histogram[bucket];
+            }
+            size_t blocked = FuriThreadTraceBlockOther;
+            for(size_t reason = 0; reason < FuriThreadTraceBlockNum; reason++) {
+                if(thread->blocked_cycles[reason] > thread->blocked_cycles[blocked]) {
+                    blocked = reason;
+                }
+            }
+            cli_command_histogram(
+                thread->latency_histogram, FURI_THREAD_TRACE_HISTOGRAM_SIZE, histogram);
+            printf(
+                "\r%-16s%c %6.2f %6.2f %9lu %9lu %9.2f %9.2f |%s| %s %.1f%%\e[0K\r\n",
+                thread->name,
+                thread->exited ? '*' : ' ',
+                (double)(info.cycles ? thread->run_cycles * 100.0f / info.cycles : 0),
+                (double)(thread->run_cycles ? thread->isr_cycles * 100.0f / thread->run_cycles :
+                                              0),
+                thread->switches,
+                thread->preemptions,
+                (double)(latencies ? thread->latency_total / latencies / cycles_per_us : 0),
+                (double)(thread->latency_max / cycles_per_us),
+                histogram,
+                furi_thread_trace_get_block_name(blocked),
+                (double)(info.cycles ? thread->blocked_cycles[blocked] * 100.0f / info.cycles :
+                                       0));
+        }
+        printf("\r* exited\e[0K\r\n");
+
+        furi_delay_ms(interval);
+    }
+    printf("\e[?25h"); // Show cursor
+
+    free(threads);
+}
+
+static void cli_command_sched_dump(void) {
+    FuriThreadTraceThread* threads =
+        malloc(sizeof(FuriThreadTraceThread) * FURI_THREAD_TRACE_THREADS_MAX);
+    FuriThreadTraceInfo info;
+    const size_t count =
+        MIN(furi_thread_trace_get_threads(threads, FURI_THREAD_TRACE_THREADS_MAX, &info),
+            (size_t)FURI_THREAD_TRACE_THREADS_MAX);
+
+    // Parsed by scripts/schedtrace.py
+    printf(
+        "sched,%lu,%d,%llu,%lu,%lu\r\n",
+        furi_hal_cortex_instructions_per_microsecond(),
+        FURI_THREAD_TRACE_HISTOGRAM_SIZE,
+        info.cycles,
+        info.events,
+        info.untracked);
+    for(size_t reason = 0; reason < FuriThreadTraceBlockNum; reason++) {
+        printf("reason,%zu,%s\r\n", reason, furi_thread_trace_get_block_name(reason));
+    }
+
+    for(size_t i = 0; i < count; i++) {
+        const FuriThreadTraceThread* thread = &threads[i];
+        printf(
+            "thread,%zu,%lu,%lu,%llu,%llu,%lu,%llu,",
+            i,
+            thread->switches,
+            thread->preemptions,
+            thread->run_cycles,
+            thread->isr_cycles,
+            thread->latency_max,
+            thread->latency_total);
+        for(size_t bucket = 0; bucket < FURI_THREAD_TRACE_HISTOGRAM_SIZE; bucket++) {
+            printf("%lu,", thread->latency_histogram[bucket]);
+        }
+        printf("%d,%s\r\n", thread->exited, thread->name);
+
+        for(size_t reason = 0; reason < FuriThreadTraceBlockNum; reason++) {
+            if(!thread->blocked_count[reason]) continue;
+            printf(
+                "block,%zu,%zu,%lu,%llu\r\n",
+                i,
+                reason,
+                thread->blocked_count[reason],
+                thread->blocked_cycles[reason]);
+        }
+    }
+    free(threads);
+
+    // Same size as the ring, leave room for other allocations
+    size_t events_count = MIN((size_t)info.events, info.capacity);
+    events_count = MIN(
+        events_count, memmgr_heap_get_max_free_block() / 2 / sizeof(FuriThreadTraceEvent));
+    FuriThreadTraceEvent* events = malloc(sizeof(FuriThreadTraceEvent) * events_count);
+    events_count = furi_thread_trace_get_events(events, events_count);
+    for(size_t i = 0; i < events_count; i++) {
+        printf(
+            "event,%lu,%u,%u,%u\r\n",
+            events[i].time,
+            events[i].type,
+            events[i].thread,
+            events[i].arg);
+    }
+    free(events);
+}
+
+void cli_command_sched(Cli* cli, FuriString* args, void* context) {
+    UNUSED(context);
+
+    FuriString* cmd = furi_string_alloc();
+    do {
+        args_read_string_and_trim(args, cmd);
+
+        if(furi_string_cmp_str(cmd, "start") == 0) {
+            int events = CLI_COMMAND_SCHED_EVENTS;
+            if(furi_string_size(args) &&
+               (!args_read_int_and_trim(args, &events) || events <= 0 || events > UINT16_MAX)) {
+                cli_print_usage("sched start", "<1-65535>", furi_string_get_cstr(args));
+                break;
+            }
+            if(furi_thread_trace_is_running()) {
+                printf("Already running\r\n");
+            } else if(furi_thread_trace_start(events)) {
+                printf("Tracing, last %d events kept\r\n", events);
+            } else {
+                printf("Not enough memory for %d events, try a smaller ring\r\n", events);
+            }
+        } else if(furi_string_cmp_str(cmd, "stop") == 0) {
+            furi_thread_trace_stop();
+        } else if(!furi_thread_trace_is_running()) {
+            printf("Not running, use <sched start>\r\n");
+        } else if(furi_string_cmp_str(cmd, "dump") == 0) {
+            cli_command_sched_dump();
+        } else {
+            // Command word is the interval, if any
+            int interval = 1000;
+            if(!furi_string_empty(cmd) &&
+               (!args_read_int_and_trim(cmd, &interval) || interval <= 0)) {
+                cli_print_usage(
+                    "sched", "<start [events]|stop|dump|[interval]>", furi_string_get_cstr(cmd));
+                break;
+            }
+            cli_command_sched_view(cli, interval);
+        }
+    } while(false);
+
+    furi_string_free(cmd);
+}
+
+void cli_command_jobs(Cli* cli, FuriString* args, void* context) {
+    UNUSED(args);
+    UNUSED(context);
+
+    cli_jobs_reap(cli);
+    furi_check(furi_mutex_acquire(cli->mutex, FuriWaitForever) == FuriStatusOk);
+    for(size_t i = 0; i < CLI_JOBS_MAX; i++) {
+        CliJob* job = &cli->jobs[i];
+        if(job->thread) {
+            printf(
+                "[%zu] %s%s\r\n",
+                i + 1,
+                furi_string_get_cstr(job->line),
+                job->stop ? " (stopping)" : "");
+        }
+    }
+    furi_check(furi_mutex_release(cli->mutex) == FuriStatusOk);
+}
+
+void cli_command_kill(Cli* cli, FuriString* args, void* context) {
+    UNUSED(context);
+
+    uint32_t index = 0;
+    if(strint_to_uint32(furi_string_get_cstr(args), NULL, &index, 10) != StrintParseNoError ||
+       index == 0 || index > CLI_JOBS_MAX) {
+        cli_print_usage("kill", "<job>", furi_string_get_cstr(args));
+        return;
+    }
+
+    furi_check(furi_mutex_acquire(cli->mutex, FuriWaitForever) == FuriStatusOk);
+    CliJob* job = &cli->jobs[index - 1];
+    if(job->thread) {
+        // Jobs see it as Ctrl+C
+        job->stop = true;
+    } else {
+        printf("No job %lu", index);
+    }
+    furi_check(furi_mutex_release(cli->mutex) == FuriStatusOk);
 }
 
 void cli_command_i2c(Cli* cli, FuriString* args, void* context) {
@@ -706,6 +1182,11 @@ void cli_commands_init(Cli* cli) {
     cli_add_command(cli, "top", CliCommandFlagParallelSafe, cli_command_top, NULL);
     cli_add_command(cli, "free", CliCommandFlagParallelSafe, cli_command_free, NULL);
     cli_add_command(cli, "free_blocks", CliCommandFlagParallelSafe, cli_command_free_blocks, NULL);
+    cli_add_command(cli, "heap_trace", CliCommandFlagParallelSafe, cli_command_heap_trace, NULL);
+    cli_add_command(cli, "profiler", CliCommandFlagParallelSafe, cli_command_profiler, NULL);
+    cli_add_command(cli, "sched", CliCommandFlagParallelSafe, cli_command_sched, NULL);
+    cli_add_command(cli, "jobs", CliCommandFlagParallelSafe, cli_command_jobs, NULL);
+    cli_add_command(cli, "kill", CliCommandFlagParallelSafe, cli_command_kill, NULL);
 
     cli_add_command(cli, "vibro", CliCommandFlagDefault, cli_command_vibro, NULL);
     cli_add_command(cli, "led", CliCommandFlagDefault, cli_command_led, NULL);
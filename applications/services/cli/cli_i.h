@@ -13,6 +13,8 @@
 
 #define CLI_LINE_SIZE_MAX
 #define CLI_COMMANDS_TREE_RANK 4
+#define CLI_JOBS_MAX           4
+#define CLI_JOB_STACK_SIZE     (4 * 1024)
 
 #ifdef __cplusplus
 extern "C" {
@@ -43,6 +45,18 @@ BPTREE_DEF2(
 
 #define M_OPL_CliCommandTree_t() BPTREE_OPLIST(CliCommandTree, M_POD_OPLIST)
 
+/** Command running in its own thread, started with a trailing `&` */
+typedef struct {
+    FuriThread* thread;
+    FuriThreadId thread_id;
+    Cli* cli;
+    CliCommand command;
+    FuriString* line;
+    FuriString* args;
+    volatile bool stop;
+    bool muted; /**< Output dropped, set under Cli mutex */
+} CliJob;
+
 struct Cli {
     CliCommandTree_t commands;
     FuriMutex* mutex;
@@ -52,6 +66,8 @@ struct Cli {
     CliSession* session;
 
     size_t cursor_position;
+
+    CliJob jobs[CLI_JOBS_MAX];
 };
 
 Cli* cli_alloc(void);
@@ -62,6 +78,9 @@ void cli_putc(Cli* cli, char c);
 
 void cli_stdout_callback(void* _cookie, const char* data, size_t size);
 
+/** Free jobs that are done, call from CLI thread */
+void cli_jobs_reap(Cli* cli);
+
 // Wraps CLI commands to load from plugin file
 // Must call from CLI context, like dummy CLI command callback
 // You need to setup the plugin to compile correctly separately
@@ -6,8 +6,16 @@
 #define TAG "CliVcp"
 
 #define USB_CDC_PKT_LEN CDC_DATA_SZ
-#define VCP_RX_BUF_SIZE (USB_CDC_PKT_LEN * 3)
-#define VCP_TX_BUF_SIZE (USB_CDC_PKT_LEN * 3)
+
+/** Packets buffered in each direction, bulk transfers stall on USB with too few */
+#ifndef CLI_VCP_BUF_PACKETS
+#define CLI_VCP_BUF_PACKETS 8
+#endif
+
+#define VCP_RX_BUF_SIZE   (USB_CDC_PKT_LEN * CLI_VCP_BUF_PACKETS)
+#define VCP_TX_BUF_SIZE   (USB_CDC_PKT_LEN * CLI_VCP_BUF_PACKETS)
+/** Writer queues this much at once, the worker keeps sending the other half meanwhile */
+#define VCP_TX_BATCH_SIZE (VCP_TX_BUF_SIZE / 2)
 
 #define VCP_IF_NUM 0
 
@@ -36,6 +44,7 @@ typedef struct {
 
     FuriStreamBuffer* tx_stream;
     FuriStreamBuffer* rx_stream;
+    FuriMutex* tx_mutex;
 
     volatile bool connected;
     volatile bool running;
@@ -69,6 +78,7 @@ static void cli_vcp_init(void) {
         vcp = malloc(sizeof(CliVcp));
         vcp->tx_stream = furi_stream_buffer_alloc(VCP_TX_BUF_SIZE, 1);
         vcp->rx_stream = furi_stream_buffer_alloc(VCP_RX_BUF_SIZE, 1);
+        vcp->tx_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
     }
     furi_assert(vcp->thread == NULL);
 
@@ -252,9 +262,11 @@ static void cli_vcp_tx(const uint8_t* buffer, size_t size) {
 
     VCP_DEBUG("tx %u start", size);
 
+    // Stream buffer takes one writer, background commands print concurrently
+    furi_check(furi_mutex_acquire(vcp->tx_mutex, FuriWaitForever) == FuriStatusOk);
     while(size > 0 && vcp->connected) {
         size_t batch_size = size;
-        if(batch_size > USB_CDC_PKT_LEN) batch_size = USB_CDC_PKT_LEN;
+        if(batch_size > VCP_TX_BATCH_SIZE) batch_size = VCP_TX_BATCH_SIZE;
 
         furi_stream_buffer_send(vcp->tx_stream, buffer, batch_size, FuriWaitForever);
         furi_thread_flags_set(furi_thread_get_id(vcp->thread), VcpEvtStreamTx);
@@ -263,6 +275,7 @@ static void cli_vcp_tx(const uint8_t* buffer, size_t size) {
         size -= batch_size;
         buffer += batch_size;
     }
+    furi_check(furi_mutex_release(vcp->tx_mutex) == FuriStatusOk);
 
     VCP_DEBUG("tx %u end", size);
 }
@@ -19,6 +19,7 @@ const CanvasFontParameters canvas_font_params[FontTotalNumber] = {
 Canvas* canvas_init(void) {
     Canvas* canvas = malloc(sizeof(Canvas));
     canvas->compress_icon = compress_icon_alloc(ICON_DECOMPRESSOR_BUFFER_SIZE);
+    compress_icon_set_cache_budget(canvas->compress_icon, ICON_CACHE_BUDGET);
 
     // Initialize mutex
     canvas->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
@@ -86,6 +87,16 @@ void canvas_commit(Canvas* canvas) {
     canvas_unlock(canvas);
 }
 
+void canvas_get_icon_cache_stats(Canvas* canvas, CompressIconCacheStats* stats) {
+    furi_check(canvas);
+    compress_icon_get_cache_stats(canvas->compress_icon, stats);
+}
+
+void canvas_reset_icon_cache_stats(Canvas* canvas) {
+    furi_check(canvas);
+    compress_icon_reset_cache_stats(canvas->compress_icon);
+}
+
 uint8_t* canvas_get_buffer(Canvas* canvas) {
     furi_check(canvas);
     return u8g2_GetBufferPtr(&canvas->fb);
@@ -390,7 +401,166 @@ static void canvas_draw_u8g2_bitmap_int(
     }
 }
 
-void canvas_draw_u8g2_bitmap(
+/* Direct blitter state, coordinates are relative to u8g2 buffer */
+typedef struct {
+    uint8_t* buffer;
+    int32_t stride;
+    int32_t clip_x0;
+    int32_t clip_x1;
+    int32_t clip_y0;
+    int32_t clip_y1;
+    /* 0x00/0xFF selectors of the operation for set and unset bitmap pixels */
+    uint8_t set_on;
+    uint8_t clear_on;
+    uint8_t toggle_on;
+    uint8_t set_off;
+    uint8_t clear_off;
+} CanvasBlit;
+
+static void canvas_blit_init(CanvasBlit* blit, u8g2_t* u8g2) {
+    blit->buffer = u8g2->tile_buf_ptr;
+    blit->stride = u8g2->pixel_buf_width;
+    blit->clip_x0 = u8g2->user_x0;
+    blit->clip_x1 = u8g2->user_x1;
+    blit->clip_y0 = (int32_t)u8g2->user_y0 - u8g2->pixel_curr_row;
+    blit->clip_y1 = (int32_t)u8g2->user_y1 - u8g2->pixel_curr_row;
+
+    /* Same as HV line per pixel: draw_color for set pixels, inverse for unset ones */
+    const uint8_t color = u8g2->draw_color;
+    const bool opaque = u8g2->bitmap_transparency == 0;
+    blit->set_on = color == 1 ? 0xFF : 0x00;
+    blit->clear_on = color == 0 ? 0xFF : 0x00;
+    blit->toggle_on = color > 1 ? 0xFF : 0x00;
+    blit->set_off = opaque && color == 0 ? 0xFF : 0x00;
+    blit->clear_off = opaque && color != 0 ? 0xFF : 0x00;
+}
+
+/* Draw up to 8 vertical pixels, bit 0 goes to (x, y), only valid bits are drawn */
+static inline void canvas_blit_column(
+    const CanvasBlit* blit,
+    int32_t x,
+    int32_t y,
+    uint8_t bits,
+    uint8_t valid) {
+    if(x < blit->clip_x0 || x >= blit->clip_x1) return;
+
+    const int32_t top = blit->clip_y0 - y;
+    const int32_t bottom = blit->clip_y1 - y;
+    if(top >= 8 || bottom <= 0) return;
+    if(top > 0) valid &= 0xFF << top;
+    if(bottom < 8) valid &= 0xFF >> (8 - bottom);
+
+    const uint8_t on = bits & valid;
+    const uint8_t off = ~bits & valid;
+    const uint8_t set = (on & blit->set_on) | (off & blit->set_off);
+    const uint8_t clear = (on & blit->clear_on) | (off & blit->clear_off);
+    const uint8_t toggle = on & blit->toggle_on;
+
+    /* y is at least -7 here, floor division */
+    const int32_t page = (y + 8) / 8 - 1;
+    const uint32_t shift = y - page * 8;
+    uint8_t* dst = &blit->buffer[page * blit->stride + x];
+
+    const uint16_t set16 = set << shift;
+    const uint16_t clear16 = clear << shift;
+    const uint16_t toggle16 = toggle << shift;
+    if((set16 | clear16 | toggle16) & 0xFF) {
+        *dst = ((*dst & ~clear16) | set16) ^ toggle16;
+    }
+    if((set16 | clear16 | toggle16) >> 8) {
+        dst += blit->stride;
+        *dst = ((*dst & ~(clear16 >> 8)) | (set16 >> 8)) ^ (toggle16 >> 8);
+    }
+}
+
+/* Transpose 8x8 bit block: bit j of row i goes to bit i of row j */
+static inline void canvas_blit_transpose(uint32_t* lo, uint32_t* hi) {
+    uint32_t t;
+    t = 0x00AA00AA & (*lo ^ (*lo >> 7));
+    *lo ^= t ^ (t << 7);
+    t = 0x00AA00AA & (*hi ^ (*hi >> 7));
+    *hi ^= t ^ (t << 7);
+    t = 0x0000CCCC & (*lo ^ (*lo >> 14));
+    *lo ^= t ^ (t << 14);
+    t = 0x0000CCCC & (*hi ^ (*hi >> 14));
+    *hi ^= t ^ (t << 14);
+    t = 0xF0F0F0F0 & (*lo ^ (*hi << 4));
+    *lo ^= t;
+    *hi ^= t >> 4;
+}
+
+/* Bitmap rows are horizontal, buffer bytes are vertical: blit in transposed 8x8 blocks */
+static void canvas_blit_rows(
+    const CanvasBlit* blit,
+    int32_t x,
+    int32_t y,
+    size_t width,
+    size_t height,
+    const uint8_t* bitmap,
+    bool mirror) {
+    const size_t row_size = (width + 7) / 8;
+
+    for(size_t band = 0; band < height; band += 8) {
+        const int32_t band_y = y + band;
+        if(band_y + 8 <= blit->clip_y0 || band_y >= blit->clip_y1) continue;
+
+        const size_t band_height = MIN(height - band, 8u);
+        const uint8_t valid = 0xFF >> (8 - band_height);
+        const uint8_t* rows[8];
+        for(size_t i = 0; i < band_height; i++) {
+            const size_t row = mirror ? height - 1 - (band + i) : band + i;
+            rows[i] = &bitmap[row * row_size];
+        }
+
+        for(size_t column = 0; column < row_size; column++) {
+            const int32_t block_x = x + column * 8;
+            if(block_x + 8 <= blit->clip_x0 || block_x >= blit->clip_x1) continue;
+
+            uint8_t block[8] = {0};
+            for(size_t i = 0; i < band_height; i++) {
+                block[i] = rows[i][column];
+            }
+            uint32_t lo = block[0] | (block[1] << 8) | (block[2] << 16) |
+                          ((uint32_t)block[3] << 24);
+            uint32_t hi = block[4] | (block[5] << 8) | (block[6] << 16) |
+                          ((uint32_t)block[7] << 24);
+            canvas_blit_transpose(&lo, &hi);
+
+            const size_t block_width = MIN(width - column * 8, 8u);
+            for(size_t j = 0; j < block_width; j++) {
+                const uint8_t bits = j < 4 ? lo >> (j * 8) : hi >> ((j - 4) * 8);
+                canvas_blit_column(blit, block_x + j, band_y, bits, valid);
+            }
+        }
+    }
+}
+
+/* Rotated bitmap rows are vertical, as buffer bytes: blit byte by byte */
+static void canvas_blit_columns(
+    const CanvasBlit* blit,
+    int32_t x,
+    int32_t y,
+    size_t width,
+    size_t height,
+    const uint8_t* bitmap,
+    bool mirror) {
+    const size_t row_size = (width + 7) / 8;
+    const uint8_t last_valid = (width % 8) ? 0xFF >> (8 - width % 8) : 0xFF;
+
+    for(size_t row = 0; row < height; row++) {
+        const int32_t column_x = mirror ? x + (int32_t)row : x + (int32_t)width + 1 - (int32_t)row;
+        if(column_x < blit->clip_x0 || column_x >= blit->clip_x1) continue;
+
+        const uint8_t* b = &bitmap[row * row_size];
+        for(size_t i = 0; i < row_size; i++) {
+            canvas_blit_column(
+                blit, column_x, y + i * 8, b[i], i == row_size - 1 ? last_valid : 0xFF);
+        }
+    }
+}
+
+/* Blit directly into the buffer, only for unrotated display and vertical buffer layout */
+static bool canvas_draw_u8g2_bitmap_fast(
     u8g2_t* u8g2,
     int32_t x,
     int32_t y,
@@ -398,10 +568,45 @@ void canvas_draw_u8g2_bitmap(
     size_t height,
     const uint8_t* bitmap,
     IconRotation rotation) {
-#ifdef U8G2_WITH_INTERSECTION
-    if(u8g2_IsIntersection(u8g2, x, y, x + width, y + height) == 0) return;
-#endif /* U8G2_WITH_INTERSECTION */
+    if(u8g2->cb != U8G2_R0 || u8g2->ll_hvline != u8g2_ll_hvline_vertical_top_lsb) {
+        return false;
+    }
+    if(u8g2->is_page_clip_window_intersection == 0) {
+        return true;
+    }
+
+    CanvasBlit blit;
+    canvas_blit_init(&blit, u8g2);
+    y -= u8g2->pixel_curr_row;
 
+    switch(rotation) {
+    case IconRotation0:
+        canvas_blit_rows(&blit, x, y, width, height, bitmap, false);
+        break;
+    case IconRotation90:
+        canvas_blit_columns(&blit, x, y, width, height, bitmap, false);
+        break;
+    case IconRotation180:
+        canvas_blit_rows(&blit, x, y, width, height, bitmap, true);
+        break;
+    case IconRotation270:
+        canvas_blit_columns(&blit, x, y, width, height, bitmap, true);
+        break;
+    default:
+        break;
+    }
+
+    return true;
+}
+
+void canvas_draw_u8g2_bitmap_generic(
+    u8g2_t* u8g2,
+    int32_t x,
+    int32_t y,
+    size_t width,
+    size_t height,
+    const uint8_t* bitmap,
+    IconRotation rotation) {
     switch(rotation) {
     case IconRotation0:
         canvas_draw_u8g2_bitmap_int(u8g2, x, y, width, height, 0, 0, bitmap);
@@ -420,6 +625,35 @@ void canvas_draw_u8g2_bitmap(
     }
 }
 
+void canvas_draw_u8g2_bitmap(
+    u8g2_t* u8g2,
+    int32_t x,
+    int32_t y,
+    size_t width,
+    size_t height,
+    const uint8_t* bitmap,
+    IconRotation rotation) {
+#ifdef U8G2_WITH_INTERSECTION
+    /* Bounds of the drawn pixels, as canvas_draw_u8g2_bitmap_int places them */
+    int32_t x0 = x;
+    int32_t x1 = x + (int32_t)width;
+    int32_t y1 = y + (int32_t)height;
+    if(rotation == IconRotation90) {
+        x0 = x + (int32_t)width + 2 - (int32_t)height;
+        x1 = x + (int32_t)width + 2;
+        y1 = y + (int32_t)width;
+    } else if(rotation == IconRotation270) {
+        x1 = x + (int32_t)height;
+        y1 = y + (int32_t)width;
+    }
+    if(u8g2_IsIntersection(u8g2, x0, y, x1, y1) == 0) return;
+#endif /* U8G2_WITH_INTERSECTION */
+
+    if(!canvas_draw_u8g2_bitmap_fast(u8g2, x, y, width, height, bitmap, rotation)) {
+        canvas_draw_u8g2_bitmap_generic(u8g2, x, y, width, height, bitmap, rotation);
+    }
+}
+
 void canvas_draw_icon_ex(
     Canvas* canvas,
     int32_t x,
@@ -14,6 +14,9 @@
 
 #define ICON_DECOMPRESSOR_BUFFER_SIZE (128u * 64 / 8)
 
+/** RAM budget for decoded icon frames, fits a few dozens of typical icons */
+#define ICON_CACHE_BUDGET (4u * 1024)
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -61,6 +64,19 @@ Canvas* canvas_init(void);
  */
 void canvas_free(Canvas* canvas);
 
+/** Get decoded icon cache statistics
+ *
+ * @param      canvas  Canvas instance
+ * @param[out] stats   statistics
+ */
+void canvas_get_icon_cache_stats(Canvas* canvas, CompressIconCacheStats* stats);
+
+/** Reset decoded icon cache statistics
+ *
+ * @param      canvas  Canvas instance
+ */
+void canvas_reset_icon_cache_stats(Canvas* canvas);
+
 /** Get canvas buffer.
  *
  * @param      canvas  Canvas instance
@@ -108,6 +124,9 @@ void canvas_set_orientation(Canvas* canvas, CanvasOrientation orientation);
 CanvasOrientation canvas_get_orientation(const Canvas* canvas);
 
 /** Draw a u8g2 bitmap
+ *
+ * Writes directly into the buffer with 8x8 block operations when display is
+ * not rotated, falls back to canvas_draw_u8g2_bitmap_generic otherwise.
  *
  * @param      u8g2     u8g2 instance
  * @param      x        x coordinate
@@ -126,6 +145,25 @@ void canvas_draw_u8g2_bitmap(
     const uint8_t* bitmap,
     IconRotation rotation);
 
+/** Draw a u8g2 bitmap pixel by pixel, works with any display rotation
+ *
+ * @param      u8g2     u8g2 instance
+ * @param      x        x coordinate
+ * @param      y        y coordinate
+ * @param      width    width
+ * @param      height   height
+ * @param      bitmap   bitmap
+ * @param      rotation rotation
+ */
+void canvas_draw_u8g2_bitmap_generic(
+    u8g2_t* u8g2,
+    int32_t x,
+    int32_t y,
+    size_t width,
+    size_t height,
+    const uint8_t* bitmap,
+    IconRotation rotation);
+
 /** Add canvas commit callback.
  *
  * This callback will be called upon Canvas commit.
@@ -1,5 +1,7 @@
 #include "gui_i.h"
 #include <assets_icons.h>
+#include <furi_hal_cortex.h>
+#include <toolbox/zone_profiler.h>
 
 #include <storage/storage.h>
 #include <storage/storage_i.h>
@@ -278,6 +280,27 @@ static bool gui_redraw_desktop(Gui* gui) {
     return false;
 }
 
+static void gui_report_icon_cache(Gui* gui) {
+    CompressIconCacheStats stats;
+    canvas_get_icon_cache_stats(gui->canvas, &stats);
+    const uint32_t redraw_us =
+        gui->redraw_cycles / gui->redraw_count / furi_hal_cortex_instructions_per_microsecond();
+
+    FURI_LOG_D(
+        TAG,
+        "Icon cache: %lu hits, %lu misses, %zu/%zuB, redraw %luus avg, saved %luus/redraw",
+        stats.hits,
+        stats.misses,
+        stats.used,
+        stats.budget,
+        redraw_us,
+        stats.saved_us / gui->redraw_count);
+
+    canvas_reset_icon_cache_stats(gui->canvas);
+    gui->redraw_count = 0;
+    gui->redraw_cycles = 0;
+}
+
 static void gui_redraw(Gui* gui) {
     furi_assert(gui);
     gui_lock(gui);
@@ -285,6 +308,8 @@ static void gui_redraw(Gui* gui) {
     do {
         if(gui->direct_draw) break;
 
+        const uint32_t start = furi_hal_cortex_timer_get(0).start;
+        const uint32_t zone_start = zone_profiler_begin();
         canvas_reset(gui->canvas);
 
         if(gui->lockdown) {
@@ -304,7 +329,15 @@ static void gui_redraw(Gui* gui) {
             }
         }
 
+        gui->redraw_cycles += furi_hal_cortex_timer_get(0).start - start;
+        zone_profiler_end(ZoneProfilerIdGuiRedraw, zone_start);
+        if(++gui->redraw_count == GUI_ICON_CACHE_REPORT_INTERVAL) {
+            gui_report_icon_cache(gui);
+        }
+
+        const uint32_t commit_start = zone_profiler_begin();
         canvas_commit(gui->canvas);
+        zone_profiler_end(ZoneProfilerIdGuiCommit, commit_start);
     } while(false);
 
     gui_unlock(gui);
@@ -621,6 +654,8 @@ Gui* gui_alloc(void) {
 
     // Drawing canvas
     gui->canvas = canvas_init();
+    gui->redraw_count = 0;
+    gui->redraw_cycles = 0;
 
     // Input
     gui->input_queue = furi_message_queue_alloc(8, sizeof(InputEvent));
@@ -37,6 +37,9 @@
 #define GUI_WINDOW_WIDTH  GUI_DISPLAY_WIDTH
 #define GUI_WINDOW_HEIGHT (GUI_DISPLAY_HEIGHT - GUI_WINDOW_Y)
 
+/* Redraws between icon cache statistics reports */
+#define GUI_ICON_CACHE_REPORT_INTERVAL 1024
+
 #define GUI_THREAD_FLAG_DRAW  (1 << 0)
 #define GUI_THREAD_FLAG_INPUT (1 << 1)
 #define GUI_THREAD_FLAG_ASCII (1 << 2)
@@ -55,6 +58,8 @@ struct Gui {
     bool direct_draw;
     ViewPortArray_t layers[GuiLayerMAX];
     Canvas* canvas;
+    uint32_t redraw_count;
+    uint64_t redraw_cycles;
 
     // Input
     FuriMessageQueue* input_queue;
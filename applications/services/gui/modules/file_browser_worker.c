@@ -4,6 +4,8 @@
 #include <storage/storage.h>
 
 #include <toolbox/path.h>
+#include <toolbox/dir_index.h>
+#include <momentum/momentum.h>
 #include <core/check.h>
 #include <core/common_defines.h>
 #include <furi.h>
@@ -16,7 +18,6 @@
 
 #define ASSETS_DIR          "assets"
 #define BROWSER_ROOT        STORAGE_EXT_PATH_PREFIX
-#define FILE_NAME_LEN_MAX   254
 #define LONG_LOAD_THRESHOLD 100
 
 typedef enum {
@@ -58,8 +59,48 @@ struct BrowserWorker {
     bool keep_selection;
     FuriString* select_next;
     FuriString* passed_ext_filter;
+
+    DirIndex* dir_index;
+    bool dir_index_valid;
 };
 
+typedef struct {
+    File* directory;
+    StorageDirEntry* entries;
+    size_t entries_cnt;
+    size_t position;
+    bool eof;
+} BrowserDirReader;
+
+static void browser_dir_reader_init(BrowserDirReader* reader, File* directory) {
+    reader->directory = directory;
+    reader->entries = malloc(sizeof(StorageDirEntry) * STORAGE_DIR_READ_BATCH_SIZE);
+    reader->entries_cnt = 0;
+    reader->position = 0;
+    reader->eof = false;
+}
+
+static void browser_dir_reader_deinit(BrowserDirReader* reader) {
+    free(reader->entries);
+}
+
+// Directory items are fetched from storage in batches, one storage request per batch
+static const StorageDirEntry* browser_dir_reader_next(BrowserDirReader* reader) {
+    if(reader->position == reader->entries_cnt) {
+        if(reader->eof) {
+            return NULL;
+        }
+        reader->entries_cnt = storage_dir_read_batch(
+            reader->directory, reader->entries, STORAGE_DIR_READ_BATCH_SIZE);
+        reader->position = 0;
+        reader->eof = reader->entries_cnt < STORAGE_DIR_READ_BATCH_SIZE;
+        if(reader->entries_cnt == 0) {
+            return NULL;
+        }
+    }
+    return &reader->entries[reader->position++];
+}
+
 static bool browser_path_is_file(FuriString* path) {
     bool state = false;
     FileInfo file_info;
@@ -178,13 +219,16 @@ static bool browser_folder_init(
     uint32_t* item_cnt,
     int32_t* file_idx) {
     bool state = false;
-    FileInfo file_info;
     uint32_t total_files_cnt = 0;
+    uint32_t index_checksum = 0;
 
     Storage* storage = furi_record_open(RECORD_STORAGE);
     File* directory = storage_file_alloc(storage);
+    storage_file_set_priority(directory, StoragePriorityInteractive);
 
-    char name_temp[FILE_NAME_LEN_MAX];
+    BrowserDirReader reader;
+    browser_dir_reader_init(&reader, directory);
+    const StorageDirEntry* entry;
     FuriString* name_str;
     name_str = furi_string_alloc();
 
@@ -193,36 +237,62 @@ static bool browser_folder_init(
 
     if(storage_dir_open(directory, furi_string_get_cstr(path))) {
         state = true;
-        while(1) {
-            if(!storage_dir_read(directory, &file_info, name_temp, FILE_NAME_LEN_MAX)) {
-                break;
-            }
-            if((storage_file_get_error(directory) == FSE_OK) && (name_temp[0] != '\0')) {
-                total_files_cnt++;
-                furi_string_set(name_str, name_temp);
-                if(browser_filter_by_name(browser, name_str, file_info_is_dir(&file_info))) {
-                    if(!furi_string_empty(filename)) {
-                        if(furi_string_cmp(name_str, filename) == 0) {
-                            *file_idx = *item_cnt;
-                        }
+        while((entry = browser_dir_reader_next(&reader))) {
+            total_files_cnt++;
+            index_checksum = dir_index_checksum_add(
+                index_checksum, entry->name, file_info_is_dir(&entry->fileinfo));
+            furi_string_set(name_str, entry->name);
+            if(browser_filter_by_name(browser, name_str, file_info_is_dir(&entry->fileinfo))) {
+                if(!furi_string_empty(filename)) {
+                    if(furi_string_cmp(name_str, filename) == 0) {
+                        *file_idx = *item_cnt;
                     }
-                    (*item_cnt)++;
                 }
-                if(total_files_cnt == LONG_LOAD_THRESHOLD) {
-                    // There are too many files in folder and counting them will take some time - send callback to app
-                    if(browser->long_load_cb) {
-                        browser->long_load_cb(browser->cb_ctx);
-                    }
+                (*item_cnt)++;
+            }
+            if(total_files_cnt == LONG_LOAD_THRESHOLD) {
+                // There are too many files in folder and counting them will take some time - send callback to app
+                if(browser->long_load_cb) {
+                    browser->long_load_cb(browser->cb_ctx);
                 }
             }
         }
     }
 
-    furi_string_free(name_str);
-
+    browser_dir_reader_deinit(&reader);
     storage_dir_close(directory);
     storage_file_free(directory);
 
+    // Folders too big to be sorted in RAM are paged through the sorted index
+    browser->dir_index_valid = false;
+    dir_index_close(browser->dir_index);
+    if(state && *item_cnt > BROWSER_SORT_THRESHOLD) {
+        browser->dir_index_valid = dir_index_open(
+            browser->dir_index,
+            furi_string_get_cstr(path),
+            momentum_settings.sort_dirs_first,
+            total_files_cnt,
+            index_checksum);
+    }
+
+    // Selected file position must match the sorted order
+    if(browser->dir_index_valid && *file_idx >= 0) {
+        bool is_dir;
+        int32_t idx = 0;
+        *file_idx = -1;
+        while(dir_index_read(browser->dir_index, name_str, &is_dir)) {
+            if(browser_filter_by_name(browser, name_str, is_dir)) {
+                if(furi_string_cmp(name_str, filename) == 0) {
+                    *file_idx = idx;
+                    break;
+                }
+                idx++;
+            }
+        }
+    }
+
+    furi_string_free(name_str);
+
     furi_record_close(RECORD_STORAGE);
 
     return state;
@@ -234,12 +304,13 @@ static bool browser_folder_load_chunked(
     FuriString* path,
     uint32_t offset,
     uint32_t count) {
-    FileInfo file_info;
-
     Storage* storage = furi_record_open(RECORD_STORAGE);
     File* directory = storage_file_alloc(storage);
+    storage_file_set_priority(directory, StoragePriorityInteractive);
 
-    char name_temp[FILE_NAME_LEN_MAX];
+    BrowserDirReader reader;
+    browser_dir_reader_init(&reader, directory);
+    const StorageDirEntry* entry;
     FuriString* name_str;
     name_str = furi_string_alloc();
 
@@ -252,16 +323,12 @@ static bool browser_folder_load_chunked(
 
         items_cnt = 0;
         while(items_cnt < offset) {
-            if(!storage_dir_read(directory, &file_info, name_temp, FILE_NAME_LEN_MAX)) {
+            if(!(entry = browser_dir_reader_next(&reader))) {
                 break;
             }
-            if(storage_file_get_error(directory) == FSE_OK) {
-                furi_string_set(name_str, name_temp);
-                if(browser_filter_by_name(browser, name_str, file_info_is_dir(&file_info))) {
-                    items_cnt++;
-                }
-            } else {
-                break;
+            furi_string_set(name_str, entry->name);
+            if(browser_filter_by_name(browser, name_str, file_info_is_dir(&entry->fileinfo))) {
+                items_cnt++;
             }
         }
         if(items_cnt != offset) {
@@ -274,21 +341,17 @@ static bool browser_folder_load_chunked(
 
         items_cnt = 0;
         while(items_cnt < count) {
-            if(!storage_dir_read(directory, &file_info, name_temp, FILE_NAME_LEN_MAX)) {
+            if(!(entry = browser_dir_reader_next(&reader))) {
                 break;
             }
-            if(storage_file_get_error(directory) == FSE_OK) {
-                furi_string_set(name_str, name_temp);
-                if(browser_filter_by_name(browser, name_str, file_info_is_dir(&file_info))) {
-                    furi_string_printf(name_str, "%s/%s", furi_string_get_cstr(path), name_temp);
-                    if(browser->list_item_cb) {
-                        browser->list_item_cb(
-                            browser->cb_ctx, name_str, file_info_is_dir(&file_info), false);
-                    }
-                    items_cnt++;
+            furi_string_set(name_str, entry->name);
+            if(browser_filter_by_name(browser, name_str, file_info_is_dir(&entry->fileinfo))) {
+                furi_string_printf(name_str, "%s/%s", furi_string_get_cstr(path), entry->name);
+                if(browser->list_item_cb) {
+                    browser->list_item_cb(
+                        browser->cb_ctx, name_str, file_info_is_dir(&entry->fileinfo), false);
                 }
-            } else {
-                break;
+                items_cnt++;
             }
         }
         if(browser->list_item_cb) {
@@ -297,6 +360,7 @@ static bool browser_folder_load_chunked(
     } while(0);
 
     furi_string_free(name_str);
+    browser_dir_reader_deinit(&reader);
 
     storage_dir_close(directory);
     storage_file_free(directory);
@@ -306,14 +370,79 @@ static bool browser_folder_load_chunked(
     return items_cnt == count;
 }
 
+// Load files list by chunks in sorted order from the directory index
+static bool browser_folder_load_indexed(
+    BrowserWorker* browser,
+    FuriString* path,
+    uint32_t offset,
+    uint32_t count) {
+    FuriString* name_str;
+    name_str = furi_string_alloc();
+    FuriString* item_path;
+    item_path = furi_string_alloc();
+
+    uint32_t items_cnt = 0;
+    bool is_dir;
+
+    do {
+        if(!dir_index_rewind(browser->dir_index)) {
+            break;
+        }
+
+        items_cnt = 0;
+        while(items_cnt < offset) {
+            if(!dir_index_read(browser->dir_index, name_str, &is_dir)) {
+                break;
+            }
+            if(browser_filter_by_name(browser, name_str, is_dir)) {
+                items_cnt++;
+            }
+        }
+        if(items_cnt != offset) {
+            break;
+        }
+
+        if(browser->list_load_cb) {
+            browser->list_load_cb(browser->cb_ctx, offset);
+        }
+
+        items_cnt = 0;
+        while(items_cnt < count) {
+            if(!dir_index_read(browser->dir_index, name_str, &is_dir)) {
+                break;
+            }
+            if(browser_filter_by_name(browser, name_str, is_dir)) {
+                furi_string_printf(
+                    item_path,
+                    "%s/%s",
+                    furi_string_get_cstr(path),
+                    furi_string_get_cstr(name_str));
+                if(browser->list_item_cb) {
+                    browser->list_item_cb(browser->cb_ctx, item_path, is_dir, false);
+                }
+                items_cnt++;
+            }
+        }
+        if(browser->list_item_cb) {
+            browser->list_item_cb(browser->cb_ctx, NULL, false, true);
+        }
+    } while(0);
+
+    furi_string_free(item_path);
+    furi_string_free(name_str);
+
+    return items_cnt == count;
+}
+
 // Load all files at once, may cause memory overflow so need to limit that to about 400 files
 static bool browser_folder_load_full(BrowserWorker* browser, FuriString* path) {
-    FileInfo file_info;
-
     Storage* storage = furi_record_open(RECORD_STORAGE);
     File* directory = storage_file_alloc(storage);
+    storage_file_set_priority(directory, StoragePriorityInteractive);
 
-    char name_temp[FILE_NAME_LEN_MAX];
+    BrowserDirReader reader;
+    browser_dir_reader_init(&reader, directory);
+    const StorageDirEntry* entry;
     FuriString* name_str;
     name_str = furi_string_alloc();
 
@@ -327,14 +456,13 @@ static bool browser_folder_load_full(BrowserWorker* browser, FuriString* path) {
         if(browser->list_load_cb) {
             browser->list_load_cb(browser->cb_ctx, 0);
         }
-        while(storage_dir_read(directory, &file_info, name_temp, FILE_NAME_LEN_MAX) &&
-              storage_file_get_error(directory) == FSE_OK) {
-            furi_string_set(name_str, name_temp);
-            if(browser_filter_by_name(browser, name_str, file_info_is_dir(&file_info))) {
-                furi_string_printf(name_str, "%s/%s", furi_string_get_cstr(path), name_temp);
+        while((entry = browser_dir_reader_next(&reader))) {
+            furi_string_set(name_str, entry->name);
+            if(browser_filter_by_name(browser, name_str, file_info_is_dir(&entry->fileinfo))) {
+                furi_string_printf(name_str, "%s/%s", furi_string_get_cstr(path), entry->name);
                 if(browser->list_item_cb) {
                     browser->list_item_cb(
-                        browser->cb_ctx, name_str, file_info_is_dir(&file_info), false);
+                        browser->cb_ctx, name_str, file_info_is_dir(&entry->fileinfo), false);
                 }
                 items_cnt++;
             }
@@ -346,6 +474,7 @@ static bool browser_folder_load_full(BrowserWorker* browser, FuriString* path) {
     } while(0);
 
     furi_string_free(name_str);
+    browser_dir_reader_deinit(&reader);
 
     storage_dir_close(directory);
     storage_file_free(directory);
@@ -367,6 +496,10 @@ static int32_t browser_worker(void* context) {
     FuriString* filename;
     filename = furi_string_alloc();
 
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    browser->dir_index = dir_index_alloc(storage);
+    browser->dir_index_valid = false;
+
     furi_thread_flags_set(furi_thread_get_id(browser->thread), WorkerEvtConfigChange);
 
     while(1) {
@@ -474,7 +607,10 @@ static int32_t browser_worker(void* context) {
         if(flags & WorkerEvtLoad) {
             FURI_LOG_D(
                 TAG, "Load offset: %lu cnt: %lu", browser->load_offset, browser->load_count);
-            if(items_cnt > BROWSER_SORT_THRESHOLD) {
+            if(items_cnt > BROWSER_SORT_THRESHOLD && browser->dir_index_valid) {
+                browser_folder_load_indexed(
+                    browser, path, browser->load_offset, browser->load_count);
+            } else if(items_cnt > BROWSER_SORT_THRESHOLD) {
                 browser_folder_load_chunked(
                     browser, path, browser->load_offset, browser->load_count);
             } else {
@@ -487,6 +623,10 @@ static int32_t browser_worker(void* context) {
         }
     }
 
+    dir_index_free(browser->dir_index);
+    browser->dir_index = NULL;
+    furi_record_close(RECORD_STORAGE);
+
     furi_string_free(filename);
     furi_string_free(path);
 
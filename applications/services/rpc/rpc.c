@@ -8,6 +8,7 @@
 #include <flipper.pb.h>
 
 #include <furi.h>
+#include <furi_hal_cortex.h>
 #include <furi_hal_rtc.h>
 
 #include <cli/cli.h>
@@ -27,6 +28,11 @@ typedef enum {
 
 #define RPC_ALL_EVENTS (RpcEvtNewData | RpcEvtDisconnect)
 
+/** Fits a screen frame and a storage data chunk, bigger messages are allocated */
+#define RPC_TX_BUFFER_SIZE (1536)
+/** Room for the varint length of a message */
+#define RPC_TX_PREFIX_SIZE (5)
+
 DICT_DEF2(RpcHandlerDict, pb_size_t, M_DEFAULT_OPLIST, RpcHandler, M_POD_OPLIST)
 
 typedef struct {
@@ -78,6 +84,10 @@ struct RpcSession {
     void** system_contexts;
     bool decode_error;
 
+    FuriMutex* tx_mutex;
+    uint8_t* tx_buffer;
+    RpcTxStats tx_stats;
+
     FuriMutex* callbacks_mutex;
     RpcSendBytesCallback send_bytes_callback;
     RpcBufferIsEmptyCallback buffer_is_empty_callback;
@@ -370,7 +380,13 @@ static void rpc_session_thread_pending_callback(void* context, uint32_t arg) {
     }
     furi_mutex_release(session->callbacks_mutex);
 
+#ifdef SRV_RPC_DEBUG
+    rpc_debug_print_tx_stats(&session->tx_stats);
+#endif
+
     furi_mutex_free(session->callbacks_mutex);
+    furi_mutex_free(session->tx_mutex);
+    free(session->tx_buffer);
     furi_thread_join(session->thread);
     furi_thread_free(session->thread);
     free(session);
@@ -393,6 +409,8 @@ RpcSession* rpc_session_open(Rpc* rpc, RpcOwner owner) {
 
     RpcSession* session = malloc(sizeof(RpcSession));
     session->callbacks_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    session->tx_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    session->tx_buffer = malloc(RPC_TX_BUFFER_SIZE);
     session->stream = furi_stream_buffer_alloc(RPC_BUFFER_SIZE, 1);
     session->rpc = rpc;
     session->terminate = false;
@@ -459,36 +477,73 @@ void rpc_add_handler(RpcSession* session, pb_size_t message_tag, RpcHandler* han
     RpcHandlerDict_set_at(session->handlers, message_tag, *handler);
 }
 
+static size_t rpc_encode_to_tx_buffer(RpcSession* session, PB_Main* message, uint8_t** data) {
+    // Message goes after the room for its length, encoded once
+    pb_ostream_t ostream = pb_ostream_from_buffer(
+        session->tx_buffer + RPC_TX_PREFIX_SIZE, RPC_TX_BUFFER_SIZE - RPC_TX_PREFIX_SIZE);
+    if(!pb_encode(&ostream, &PB_Main_msg, message)) return 0;
+
+    // Length is patched in right before the message
+    uint8_t prefix[RPC_TX_PREFIX_SIZE];
+    pb_ostream_t prefix_stream = pb_ostream_from_buffer(prefix, sizeof(prefix));
+    furi_check(pb_encode_varint(&prefix_stream, ostream.bytes_written));
+
+    *data = session->tx_buffer + RPC_TX_PREFIX_SIZE - prefix_stream.bytes_written;
+    memcpy(*data, prefix, prefix_stream.bytes_written);
+    return prefix_stream.bytes_written + ostream.bytes_written;
+}
+
+static size_t rpc_encode_to_heap(PB_Main* message, uint8_t** data) {
+    pb_ostream_t ostream = PB_OSTREAM_SIZING;
+
+    bool result = pb_encode_ex(&ostream, &PB_Main_msg, message, PB_ENCODE_DELIMITED);
+    furi_check(result && ostream.bytes_written);
+
+    *data = malloc(ostream.bytes_written);
+    ostream = pb_ostream_from_buffer(*data, ostream.bytes_written);
+
+    pb_encode_ex(&ostream, &PB_Main_msg, message, PB_ENCODE_DELIMITED);
+    return ostream.bytes_written;
+}
+
 void rpc_send(RpcSession* session, PB_Main* message) {
     furi_assert(session);
     furi_assert(message);
 
-    pb_ostream_t ostream = PB_OSTREAM_SIZING;
-
 #ifdef SRV_RPC_DEBUG
     FURI_LOG_I(TAG, "OUTPUT:");
     rpc_debug_print_message(message);
 #endif
 
-    bool result = pb_encode_ex(&ostream, &PB_Main_msg, message, PB_ENCODE_DELIMITED);
-    furi_check(result && ostream.bytes_written);
+    // Messages are sent from the session thread and from system callbacks
+    furi_mutex_acquire(session->tx_mutex, FuriWaitForever);
 
-    uint8_t* buffer = malloc(ostream.bytes_written);
-    ostream = pb_ostream_from_buffer(buffer, ostream.bytes_written);
+    const uint32_t start = furi_hal_cortex_timer_get(0).start;
+    uint8_t* buffer = NULL;
+    size_t size = rpc_encode_to_tx_buffer(session, message, &buffer);
+    bool allocated = !size;
+    if(allocated) size = rpc_encode_to_heap(message, &buffer);
+    const uint32_t cycles = furi_hal_cortex_timer_get(0).start - start;
 
-    pb_encode_ex(&ostream, &PB_Main_msg, message, PB_ENCODE_DELIMITED);
+    session->tx_stats.messages++;
+    session->tx_stats.bytes += size;
+    session->tx_stats.encode_cycles += cycles;
+    session->tx_stats.encode_cycles_max = MAX(session->tx_stats.encode_cycles_max, cycles);
+    if(allocated) session->tx_stats.heap_allocations++;
 
 #ifdef SRV_RPC_DEBUG
-    rpc_debug_print_data("OUTPUT", buffer, ostream.bytes_written);
+    rpc_debug_print_data("OUTPUT", buffer, size);
 #endif
 
     furi_mutex_acquire(session->callbacks_mutex, FuriWaitForever);
     if(session->send_bytes_callback) {
-        session->send_bytes_callback(session->context, buffer, ostream.bytes_written);
+        session->send_bytes_callback(session->context, buffer, size);
     }
     furi_mutex_release(session->callbacks_mutex);
 
-    free(buffer);
+    if(allocated) free(buffer);
+
+    furi_mutex_release(session->tx_mutex);
 }
 
 void rpc_send_and_release(RpcSession* session, PB_Main* message) {
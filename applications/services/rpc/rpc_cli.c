@@ -42,6 +42,9 @@ void rpc_cli_command_start_session(Cli* cli, FuriString* args, void* context) {
     furi_assert(context);
     Rpc* rpc = context;
 
+    // Job output would land inside of the protobuf stream
+    cli_jobs_stop(cli);
+
     uint32_t mem_before = memmgr_get_free_heap();
     FURI_LOG_D(TAG, "Free memory %lu", mem_before);
 
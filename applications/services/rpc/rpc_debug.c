@@ -1,5 +1,7 @@
 #include "rpc_i.h"
 
+#include <furi_hal_cortex.h>
+
 static size_t rpc_debug_print_file_msg(
     FuriString* str,
     const char* prefix,
@@ -257,3 +259,14 @@ void rpc_debug_print_message(const PB_Main* message) {
 
     furi_string_free(str);
 }
+
+void rpc_debug_print_tx_stats(const RpcTxStats* stats) {
+    const uint32_t cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+    printf(
+        "RPC TX: %lu messages, %lu bytes, %lu heap allocations, encode %luus avg %luus max\r\n",
+        stats->messages,
+        stats->bytes,
+        stats->heap_allocations,
+        stats->messages ? (uint32_t)(stats->encode_cycles / stats->messages) / cycles_per_us : 0,
+        stats->encode_cycles_max / cycles_per_us);
+}
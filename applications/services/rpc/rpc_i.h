@@ -15,6 +15,15 @@ typedef void* (*RpcSystemAlloc)(RpcSession* session);
 typedef void (*RpcSystemFree)(void* context);
 typedef void (*PBMessageHandler)(const PB_Main* msg_request, void* context);
 
+/** Transmit statistics of a session */
+typedef struct {
+    uint32_t messages; /**< Messages sent */
+    uint32_t bytes; /**< Encoded bytes sent */
+    uint32_t heap_allocations; /**< Messages too big for the transmit buffer */
+    uint64_t encode_cycles; /**< Total encoding time, CPU cycles */
+    uint32_t encode_cycles_max; /**< Longest encoding time, CPU cycles */
+} RpcTxStats;
+
 typedef struct {
     bool (*decode_submessage)(pb_istream_t* stream, const pb_field_t* field, void** arg);
     PBMessageHandler message_handler;
@@ -45,6 +54,7 @@ void rpc_desktop_free(void* ctx);
 
 void rpc_debug_print_message(const PB_Main* message);
 void rpc_debug_print_data(const char* prefix, uint8_t* buffer, size_t size);
+void rpc_debug_print_tx_stats(const RpcTxStats* stats);
 
 void rpc_cli_command_start_session(Cli* cli, FuriString* args, void* context);
 
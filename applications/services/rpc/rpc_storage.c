@@ -293,25 +293,33 @@ static void rpc_system_storage_list_process(const PB_Main* request, void* contex
         finish = true;
     }
 
+    StorageDirEntry* entries = malloc(sizeof(StorageDirEntry) * STORAGE_DIR_READ_BATCH_SIZE);
+    size_t entries_cnt = 0;
+    size_t entry_idx = 0;
+
     while(!finish) {
-        FileInfo fileinfo;
-        char* name = malloc(MAX_NAME_LENGTH);
-        if(storage_dir_read(dir, &fileinfo, name, MAX_NAME_LENGTH)) {
-            if(rpc_system_storage_list_filter(list_request, &fileinfo, name)) {
+        if(entry_idx == entries_cnt) {
+            entries_cnt = storage_dir_read_batch(dir, entries, STORAGE_DIR_READ_BATCH_SIZE);
+            entry_idx = 0;
+        }
+        if(entry_idx < entries_cnt) {
+            const StorageDirEntry* entry = &entries[entry_idx++];
+            const FileInfo* fileinfo = &entry->fileinfo;
+            if(rpc_system_storage_list_filter(list_request, fileinfo, entry->name)) {
                 if(i == COUNT_OF(list->file)) {
                     list->file_count = i;
                     response.has_next = true;
                     rpc_send_and_release(session, &response);
                     i = 0;
                 }
-                list->file[i].type = file_info_is_dir(&fileinfo) ? PB_Storage_File_FileType_DIR :
-                                                                   PB_Storage_File_FileType_FILE;
-                list->file[i].size = fileinfo.size;
+                list->file[i].type = file_info_is_dir(fileinfo) ? PB_Storage_File_FileType_DIR :
+                                                                  PB_Storage_File_FileType_FILE;
+                list->file[i].size = fileinfo->size;
                 list->file[i].data = NULL;
-                list->file[i].name = name;
+                list->file[i].name = strdup(entry->name);
 
-                if(include_md5 && !file_info_is_dir(&fileinfo)) {
-                    furi_string_printf(md5_path, "%s/%s", list_request->path, name); //-V576
+                if(include_md5 && !file_info_is_dir(fileinfo)) {
+                    furi_string_printf(md5_path, "%s/%s", list_request->path, entry->name); //-V576
 
                     if(md5_string_calc_file(file, furi_string_get_cstr(md5_path), md5, NULL)) {
                         char* md5sum = list->file[i].md5sum;
@@ -321,16 +329,15 @@ static void rpc_system_storage_list_process(const PB_Main* request, void* contex
                 }
 
                 ++i;
-            } else {
-                free(name);
             }
         } else {
             list->file_count = i;
             finish = true;
-            free(name);
         }
     }
 
+    free(entries);
+
     response.has_next = false;
     rpc_send_and_release(session, &response);
 
@@ -358,6 +365,8 @@ static void rpc_system_storage_read_process(const PB_Main* request, void* contex
     PB_Main* response = malloc(sizeof(PB_Main));
     const char* path = request->content.storage_read_request.path;
     File* file = storage_file_alloc(rpc_storage->api);
+    // Bulk transfer, must not delay on-device reads
+    storage_file_set_priority(file, StoragePriorityBackground);
     bool fs_operation_success = storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING);
 
     if(fs_operation_success) {
@@ -436,6 +445,7 @@ static void rpc_system_storage_write_process(const PB_Main* request, void* conte
 
     if(rpc_storage->state != RpcStorageStateWriting) {
         rpc_storage->file = storage_file_alloc(rpc_storage->api);
+        storage_file_set_priority(rpc_storage->file, StoragePriorityBackground);
         rpc_storage->current_command_id = request->command_id;
         rpc_storage->state = RpcStorageStateWriting;
         const char* path = request->content.storage_write_request.path;
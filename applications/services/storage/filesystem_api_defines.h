@@ -36,6 +36,14 @@ typedef enum {
     FSE_ALREADY_OPEN, /**< File/Dir already opened */
 } FS_Error;
 
+/** Storage request priority classes */
+typedef enum {
+    StoragePriorityBackground, /**< Bulk transfers and state saves */
+    StoragePriorityNormal, /**< Default */
+    StoragePriorityInteractive, /**< Reads the user is waiting for */
+    StoragePriorityCount,
+} StoragePriority;
+
 /** FileInfo flags */
 typedef enum {
     FSF_DIRECTORY = (1 << 0), /**< Directory */
@@ -50,6 +58,16 @@ typedef struct {
     uint64_t size; /**< file size */
 } FileInfo;
 
+/** Size of the name buffer in StorageDirEntry, including the terminator */
+#define STORAGE_DIR_ENTRY_NAME_SIZE 256
+
+/** Structure that hold a directory entry, filled by batched directory reads */
+typedef struct {
+    FileInfo fileinfo; /**< entry flags and size */
+    uint32_t mtime; /**< last modification time, UNIX timestamp */
+    char name[STORAGE_DIR_ENTRY_NAME_SIZE]; /**< zero-terminated entry name */
+} StorageDirEntry;
+
 /** Gets the error text from FS_Error
  * @param error_id error id
  * @return const char* error text
@@ -20,6 +20,7 @@ struct File {
     FS_Error error_id; /**< Standard API error from FS_Error enum */
     int32_t internal_error_id; /**< Internal API error value */
     void* storage;
+    StoragePriority priority; /**< Priority class of requests made through this file */
 };
 
 /** File api structure
@@ -128,6 +129,13 @@ typedef struct {
  *      @param name_length name buffer length
  *      @return success flag (if next object not exist also returns false and set error_id to FSE_NOT_EXIST)
  * 
+ *  @var FS_Dir_Api::read_batch
+ *      @brief Read up to count next objects in directory
+ *      @param file pointer to file object
+ *      @param entries pointer to array of at least count entries
+ *      @param count maximum number of entries to read
+ *      @return number of entries read (if less than count, error_id is set to the reason, FSE_NOT_EXIST at the end of directory)
+ * 
  *  @var FS_Dir_Api::rewind
  *      @brief Rewind to first object info in directory
  *      @param file pointer to file object
@@ -142,6 +150,7 @@ typedef struct {
         FileInfo* fileinfo,
         char* name,
         uint16_t name_length);
+    size_t (*const read_batch)(void* context, File* file, StorageDirEntry* entries, size_t count);
     bool (*const rewind)(void* context, File* file);
 } FS_Dir_Api;
 
@@ -8,6 +8,16 @@
 
 #define STORAGE_TICK 1000
 
+// Requests taken off the queue for reordering, senders wait on the queue beyond that
+#define STORAGE_PENDING_MAX 8
+
+// Lower priority requests waiting longer than this are served out of order
+#define STORAGE_PRIORITY_AGING_US (100 * 1000)
+
+// Sequential reads of the same file merged into a single filesystem call
+#define STORAGE_COALESCE_MESSAGES_MAX 8
+#define STORAGE_COALESCE_BYTES_MAX    4096
+
 #define ICON_SD_MOUNTED &I_SDcardMounted_11x8
 #define ICON_SD_ERROR   &I_SDcardFail_11x8
 
@@ -34,6 +44,9 @@ static void storage_app_sd_icon_draw_callback(Canvas* canvas, void* context) {
 Storage* storage_app_alloc(void) {
     Storage* app = malloc(sizeof(Storage));
     app->message_queue = furi_message_queue_alloc(8, sizeof(StorageMessage));
+    for(size_t i = 0; i < StoragePriorityCount; i++) {
+        StorageMessageDeque_init(app->pending[i]);
+    }
     app->pubsub = furi_pubsub_alloc();
 
     for(uint8_t i = 0; i < STORAGE_COUNT; i++) {
@@ -79,7 +92,12 @@ void storage_tick(Storage* app) {
     for(uint8_t i = 0; i < STORAGE_COUNT; i++) {
         StorageApi api = app->storage[i].api;
         if(api.tick != NULL) {
+            StorageStatus status = app->storage[i].status;
             api.tick(&app->storage[i]);
+            // Card could have been swapped, directories are not the same anymore
+            if(app->storage[i].status != status) {
+                storage_data_dir_index_cache_reset(&app->storage[i]);
+            }
         }
     }
 
@@ -121,6 +139,98 @@ void storage_tick(Storage* app) {
     }
 }
 
+static StoragePriority storage_message_get_priority(const StorageMessage* message) {
+    switch(message->command) {
+    case StorageCommandFileOpen:
+    case StorageCommandFileClose:
+    case StorageCommandFileRead:
+    case StorageCommandFileWrite:
+    case StorageCommandFileSeek:
+    case StorageCommandFileTell:
+    case StorageCommandFileTruncate:
+    case StorageCommandFileSize:
+    case StorageCommandFileSync:
+    case StorageCommandFileEof:
+    case StorageCommandFileExpand:
+    case StorageCommandDirOpen:
+    case StorageCommandDirClose:
+    case StorageCommandDirRead:
+    case StorageCommandDirRewind:
+    case StorageCommandDirReadBatch:
+        // File is the first member of all file and dir command data
+        return message->data->file.file->priority;
+    default:
+        return StoragePriorityNormal;
+    }
+}
+
+static bool storage_pending_empty(Storage* app) {
+    for(size_t i = 0; i < StoragePriorityCount; i++) {
+        if(!StorageMessageDeque_empty_p(app->pending[i])) return false;
+    }
+    return true;
+}
+
+static size_t storage_pending_size(Storage* app) {
+    size_t size = 0;
+    for(size_t i = 0; i < StoragePriorityCount; i++) {
+        size += StorageMessageDeque_size(app->pending[i]);
+    }
+    return size;
+}
+
+// Highest priority class first, unless a lower class waited for too long
+static StorageMessageDeque_ptr storage_pending_select(Storage* app) {
+    const uint32_t now = furi_hal_cortex_timer_get(0).start;
+    const uint32_t aging_cycles =
+        STORAGE_PRIORITY_AGING_US * furi_hal_cortex_instructions_per_microsecond();
+
+    for(size_t i = 0; i < StoragePriorityCount - 1; i++) {
+        if(StorageMessageDeque_empty_p(app->pending[i])) continue;
+        const StorageMessage* head = StorageMessageDeque_front(app->pending[i]);
+        if(now - head->timestamp > aging_cycles) {
+            return app->pending[i];
+        }
+    }
+
+    for(size_t i = StoragePriorityCount; i > 0; i--) {
+        if(!StorageMessageDeque_empty_p(app->pending[i - 1])) {
+            return app->pending[i - 1];
+        }
+    }
+
+    return NULL;
+}
+
+static void storage_pending_process(Storage* app) {
+    StorageMessageDeque_ptr pending = storage_pending_select(app);
+    StorageMessage messages[STORAGE_COALESCE_MESSAGES_MAX];
+    size_t count = 1;
+
+    StorageMessageDeque_pop_front(&messages[0], pending);
+
+    if(messages[0].command == StorageCommandFileRead) {
+        File* file = messages[0].data->fread.file;
+        size_t bytes = messages[0].data->fread.bytes_to_read;
+
+        while(count < STORAGE_COALESCE_MESSAGES_MAX && !StorageMessageDeque_empty_p(pending)) {
+            const StorageMessage* next = StorageMessageDeque_front(pending);
+            if(next->command != StorageCommandFileRead || next->data->fread.file != file ||
+               bytes + next->data->fread.bytes_to_read > STORAGE_COALESCE_BYTES_MAX) {
+                break;
+            }
+            bytes += next->data->fread.bytes_to_read;
+            StorageMessageDeque_pop_front(&messages[count++], pending);
+        }
+    }
+
+    if(count > 1) {
+        storage_process_file_read_coalesced(app, messages, count);
+    } else {
+        storage_process_message(app, &messages[0]);
+    }
+}
+
 int32_t storage_srv(void* p) {
     UNUSED(p);
     Storage* app = storage_app_alloc();
@@ -128,9 +238,18 @@ int32_t storage_srv(void* p) {
 
     StorageMessage message;
     while(1) {
-        if(furi_message_queue_get(app->message_queue, &message, STORAGE_TICK) == FuriStatusOk) {
-            storage_process_message(app, &message);
-        } else {
+        // Collect what was submitted so far, so that it can be served by priority
+        uint32_t timeout = storage_pending_empty(app) ? STORAGE_TICK : 0;
+        while(storage_pending_size(app) < STORAGE_PENDING_MAX &&
+              furi_message_queue_get(app->message_queue, &message, timeout) == FuriStatusOk) {
+            StorageMessageDeque_push_back(
+                app->pending[storage_message_get_priority(&message)], message);
+            timeout = 0;
+        }
+
+        if(!storage_pending_empty(app)) {
+            storage_pending_process(app);
+        } else if(timeout) {
             storage_tick(app);
         }
     }
@@ -220,6 +220,77 @@ bool storage_file_exists(Storage* storage, const char* path);
  */
 bool storage_file_copy_to_file(File* source, File* destination, size_t size);
 
+/**
+ * @brief Set the priority class of requests made through the file instance.
+ *
+ * Storage serves pending requests of higher classes first, so background
+ * transfers don't delay interactive reads. Requests not tied to a file
+ * instance (stat, mkdir, etc.) always use StoragePriorityNormal.
+ *
+ * @param file pointer to the file instance in question.
+ * @param priority priority class, StoragePriorityNormal by default.
+ */
+void storage_file_set_priority(File* file, StoragePriority priority);
+
+/******************* Asynchronous File Functions *******************/
+
+/**
+ * @brief Asynchronous request completion callback.
+ *
+ * Called from the storage thread: keep it short and never call the storage
+ * API from it. To continue in an event loop, post the result to a message
+ * queue or set an event flag the loop is subscribed to.
+ *
+ * @param context pointer to the user-defined context.
+ * @param bytes number of bytes read or written, see storage_file_get_error()
+ * for the error code.
+ */
+typedef void (*StorageAsyncCallback)(void* context, size_t bytes);
+
+/**
+ * @brief Submit a read request and return without waiting for it.
+ *
+ * Requests are served in submission order within the file priority class.
+ * Requests in different classes, e.g. after storage_file_set_priority(), may
+ * complete out of order, so a write can land after a later one.
+ * The buffer must stay valid, and the file must not be used with the
+ * blocking API, until the callback is called. Pending sequential reads of
+ * the same file may be served with a single filesystem call.
+ *
+ * @param file pointer to the file instance to read from.
+ * @param buff pointer to the buffer to be filled with read data.
+ * @param bytes_to_read number of bytes to read, at most UINT16_MAX.
+ * @param callback completion callback.
+ * @param context pointer to the user-defined context passed to the callback.
+ * @return true if submitted, false if the storage queue is full. The callback
+ * is not called then, submit again later.
+ */
+bool storage_file_read_async(
+    File* file,
+    void* buff,
+    size_t bytes_to_read,
+    StorageAsyncCallback callback,
+    void* context);
+
+/**
+ * @brief Submit a write request and return without waiting for it.
+ *
+ * Same rules as for storage_file_read_async() apply.
+ *
+ * @param file pointer to the file instance to write into.
+ * @param buff pointer to the buffer containing the data to be written.
+ * @param bytes_to_write number of bytes to write, at most UINT16_MAX.
+ * @param callback completion callback.
+ * @param context pointer to the user-defined context passed to the callback.
+ * @return true if submitted, false if the storage queue is full.
+ */
+bool storage_file_write_async(
+    File* file,
+    const void* buff,
+    size_t bytes_to_write,
+    StorageAsyncCallback callback,
+    void* context);
+
 /******************* Directory Functions *******************/
 
 /**
@@ -257,6 +328,26 @@ bool storage_dir_close(File* file);
  */
 bool storage_dir_read(File* file, FileInfo* fileinfo, char* name, uint16_t name_length);
 
+/** Recommended number of entries for storage_dir_read_batch() */
+#define STORAGE_DIR_READ_BATCH_SIZE 8
+
+/**
+ * @brief Get up to count next items in the directory in a single storage request.
+ *
+ * Unlike storage_dir_read(), which costs one round trip to the storage thread
+ * per item, this function fills the whole array at once, which is much faster
+ * for large directories.
+ *
+ * If less than count items are returned, the end of the directory was reached
+ * (the file error id is set to FSE_NOT_EXIST) or an error occurred.
+ *
+ * @param file pointer to a file instance representing the directory in question.
+ * @param entries pointer to the array of at least count entries to contain the items.
+ * @param count maximum number of items to read.
+ * @return number of items read.
+ */
+size_t storage_dir_read_batch(File* file, StorageDirEntry* entries, size_t count);
+
 /**
  * @brief Change the access position to first item in the directory.
  *
@@ -10,6 +10,7 @@
 #include <lib/toolbox/tar/tar_archive.h>
 #include <storage/storage.h>
 #include <storage/storage_sd_api.h>
+#include <storage/storage_i.h>
 #include <power/power_service/power.h>
 
 #define MAX_NAME_LENGTH 254
@@ -178,23 +179,21 @@ static void storage_cli_tree(Cli* cli, FuriString* path, FuriString* args) {
 }
 
 static void storage_cli_read(Cli* cli, FuriString* path, FuriString* args) {
-    UNUSED(cli);
     UNUSED(args);
     Storage* api = furi_record_open(RECORD_STORAGE);
     File* file = storage_file_alloc(api);
 
     if(storage_file_open(file, furi_string_get_cstr(path), FSAM_READ, FSOM_OPEN_EXISTING)) {
-        const size_t buffer_size = 128;
+        const size_t buffer_size = 512;
         size_t read_size = 0;
         uint8_t* data = malloc(buffer_size);
 
         printf("Size: %lu\r\n", (uint32_t)storage_file_size(file));
+        fflush(stdout);
 
         do {
             read_size = storage_file_read(file, data, buffer_size);
-            for(size_t i = 0; i < read_size; i++) {
-                printf("%c", data[i]);
-            }
+            cli_write(cli, data, read_size);
         } while(read_size > 0);
         printf("\r\n");
 
@@ -281,12 +280,11 @@ static void storage_cli_read_chunks(Cli* cli, FuriString* path, FuriString* args
             uint8_t* data = malloc(buffer_size);
             while(file_size > 0) {
                 printf("\r\nReady?\r\n");
+                fflush(stdout);
                 cli_getc(cli);
 
                 size_t read_size = storage_file_read(file, data, buffer_size);
-                for(size_t i = 0; i < read_size; i++) {
-                    putchar(data[i]);
-                }
+                cli_write(cli, data, read_size);
                 file_size -= read_size;
             }
             free(data);
@@ -550,6 +548,78 @@ static void storage_cli_extract(Cli* cli, FuriString* old_path, FuriString* args
 
 typedef void (*StorageCliCommandCallback)(Cli* cli, FuriString* path, FuriString* args);
 
+static const char* const storage_cli_command_names[StorageCommandCount] = {
+    [StorageCommandFileOpen] = "FileOpen",
+    [StorageCommandFileClose] = "FileClose",
+    [StorageCommandFileRead] = "FileRead",
+    [StorageCommandFileWrite] = "FileWrite",
+    [StorageCommandFileSeek] = "FileSeek",
+    [StorageCommandFileTell] = "FileTell",
+    [StorageCommandFileTruncate] = "FileTruncate",
+    [StorageCommandFileSize] = "FileSize",
+    [StorageCommandFileSync] = "FileSync",
+    [StorageCommandFileEof] = "FileEof",
+    [StorageCommandDirOpen] = "DirOpen",
+    [StorageCommandDirClose] = "DirClose",
+    [StorageCommandDirRead] = "DirRead",
+    [StorageCommandDirRewind] = "DirRewind",
+    [StorageCommandCommonTimestamp] = "Timestamp",
+    [StorageCommandCommonStat] = "Stat",
+    [StorageCommandCommonRemove] = "Remove",
+    [StorageCommandCommonMkDir] = "MkDir",
+    [StorageCommandCommonFSInfo] = "FSInfo",
+    [StorageCommandSDFormat] = "SDFormat",
+    [StorageCommandSDUnmount] = "SDUnmount",
+    [StorageCommandSDInfo] = "SDInfo",
+    [StorageCommandSDStatus] = "SDStatus",
+    [StorageCommandCommonResolvePath] = "ResolvePath",
+    [StorageCommandSDMount] = "SDMount",
+    [StorageCommandCommonEquivalentPath] = "EquivalentPath",
+    [StorageCommandFileExpand] = "FileExpand",
+    [StorageCommandCommonRename] = "Rename",
+    [StorageCommandVirtualInit] = "VirtualInit",
+    [StorageCommandVirtualFormat] = "VirtualFormat",
+    [StorageCommandVirtualMount] = "VirtualMount",
+    [StorageCommandVirtualUnmount] = "VirtualUnmount",
+    [StorageCommandVirtualQuit] = "VirtualQuit",
+    [StorageCommandDirReadBatch] = "DirReadBatch",
+    [StorageCommandLatencyReset] = "LatencyReset",
+};
+
+static void storage_cli_latency(Cli* cli, FuriString* path, FuriString* args) {
+    UNUSED(cli);
+    UNUSED(args);
+    Storage* api = furi_record_open(RECORD_STORAGE);
+
+    if(furi_string_cmp_str(path, "reset") == 0) {
+        storage_latency_reset(api);
+        printf("Latency stats reset\r\n");
+    } else {
+        // Stats are updated by the storage thread, a snapshot may be slightly inconsistent
+        printf("Command\t\tCount\tAvg,us\tMax,us\tHistogram: <64us, x2 up to 65ms, more\r\n");
+        for(size_t i = 0; i < StorageCommandCount; i++) {
+            const StorageLatency* latency = &api->latency[i];
+            if(!latency->count) continue;
+
+            const char* name = storage_cli_command_names[i] ? storage_cli_command_names[i] :
+                                                              "Unknown";
+            printf(
+                "%s%s%lu\t%lu\t%lu\t",
+                name,
+                strlen(name) > 7 ? "\t" : "\t\t",
+                latency->count,
+                (uint32_t)(latency->total_us / latency->count),
+                latency->max_us);
+            for(size_t bucket = 0; bucket < STORAGE_LATENCY_BUCKETS; bucket++) {
+                printf("%u ", latency->buckets[bucket]);
+            }
+            printf("\r\n");
+        }
+    }
+
+    furi_record_close(RECORD_STORAGE);
+}
+
 typedef struct {
     const char* command;
     const char* help;
@@ -642,6 +712,11 @@ static const StorageCliCommand storage_cli_commands[] = {
         "format filesystem",
         &storage_cli_format,
     },
+    {
+        "latency",
+        "request latency per command, use \"reset\" instead of <path> to clear",
+        &storage_cli_latency,
+    },
 };
 
 static void storage_cli_print_usage(void) {
@@ -671,7 +746,9 @@ void storage_cli(Cli* cli, FuriString* args, void* context) {
             break;
         }
 
-        if(!args_read_probably_quoted_string_and_trim(args, path)) {
+        // Latency stats don't need a path
+        if(!args_read_probably_quoted_string_and_trim(args, path) &&
+           furi_string_cmp_str(cmd, "latency") != 0) {
             storage_cli_print_usage();
             break;
         }
@@ -25,13 +25,14 @@
         FuriStatusOk);                                                               \
     api_lock_wait_unlock_and_free(lock)
 
-#define S_API_MESSAGE(_command)      \
-    SAReturn return_data;            \
-    StorageMessage message = {       \
-        .lock = lock,                \
-        .command = _command,         \
-        .data = &data,               \
-        .return_data = &return_data, \
+#define S_API_MESSAGE(_command)                         \
+    SAReturn return_data;                               \
+    StorageMessage message = {                          \
+        .lock = lock,                                   \
+        .command = _command,                            \
+        .data = &data,                                  \
+        .return_data = &return_data,                    \
+        .timestamp = furi_hal_cortex_timer_get(0).start, \
     };
 
 #define S_API_DATA_FILE   \
@@ -182,6 +183,65 @@ static uint16_t
     return S_RETURN_UINT16;
 }
 
+static bool storage_file_async(
+    File* file,
+    StorageCommand command,
+    StorageAsyncMessage* async,
+    StorageAsyncCallback callback,
+    void* context) {
+    S_FILE_API_PROLOGUE;
+    furi_check(callback);
+
+    StorageMessage message = {
+        .command = command,
+        .data = &async->data,
+        .return_data = &async->return_data,
+        .timestamp = furi_hal_cortex_timer_get(0).start,
+        .callback = callback,
+        .callback_context = context,
+    };
+
+    // Freed by the storage thread once the callback is called, never wait for a full queue
+    if(furi_message_queue_put(storage->message_queue, &message, 0) != FuriStatusOk) {
+        free(async);
+        return false;
+    }
+
+    return true;
+}
+
+bool storage_file_read_async(
+    File* file,
+    void* buff,
+    size_t bytes_to_read,
+    StorageAsyncCallback callback,
+    void* context) {
+    furi_check(bytes_to_read <= UINT16_MAX);
+
+    StorageAsyncMessage* async = malloc(sizeof(StorageAsyncMessage));
+    async->data.fread.file = file;
+    async->data.fread.buff = buff;
+    async->data.fread.bytes_to_read = bytes_to_read;
+
+    return storage_file_async(file, StorageCommandFileRead, async, callback, context);
+}
+
+bool storage_file_write_async(
+    File* file,
+    const void* buff,
+    size_t bytes_to_write,
+    StorageAsyncCallback callback,
+    void* context) {
+    furi_check(bytes_to_write <= UINT16_MAX);
+
+    StorageAsyncMessage* async = malloc(sizeof(StorageAsyncMessage));
+    async->data.fwrite.file = file;
+    async->data.fwrite.buff = buff;
+    async->data.fwrite.bytes_to_write = bytes_to_write;
+
+    return storage_file_async(file, StorageCommandFileWrite, async, callback, context);
+}
+
 size_t storage_file_read(File* file, void* buff, size_t to_read) {
     size_t total = 0;
 
@@ -331,6 +391,12 @@ bool storage_file_copy_to_file(File* source, File* destination, size_t size) {
     return size == 0;
 }
 
+void storage_file_set_priority(File* file, StoragePriority priority) {
+    furi_check(file);
+    furi_check(priority < StoragePriorityCount);
+    file->priority = priority;
+}
+
 /****************** DIR ******************/
 
 static bool storage_dir_open_internal(File* file, const char* path) {
@@ -418,6 +484,26 @@ bool storage_dir_read(File* file, FileInfo* fileinfo, char* name, uint16_t name_
     return S_RETURN_BOOL;
 }
 
+size_t storage_dir_read_batch(File* file, StorageDirEntry* entries, size_t count) {
+    S_FILE_API_PROLOGUE;
+    furi_check(entries);
+
+    if(count == 0) return 0;
+
+    S_API_PROLOGUE;
+
+    SAData data = {
+        .dreadbatch = {
+            .file = file,
+            .entries = entries,
+            .count = count,
+        }};
+
+    S_API_MESSAGE(StorageCommandDirReadBatch);
+    S_API_EPILOGUE;
+    return S_RETURN_UINT64;
+}
+
 bool storage_dir_rewind(File* file) {
     S_FILE_API_PROLOGUE;
     S_API_PROLOGUE;
@@ -1113,12 +1199,22 @@ FS_Error storage_virtual_quit(Storage* storage) {
     return error;
 }
 
+void storage_latency_reset(Storage* storage) {
+    furi_check(storage);
+
+    S_API_PROLOGUE;
+    SAData data = {};
+    S_API_MESSAGE(StorageCommandLatencyReset);
+    S_API_EPILOGUE;
+}
+
 File* storage_file_alloc(Storage* storage) {
     furi_check(storage);
 
     File* file = malloc(sizeof(File));
     file->type = FileTypeClosed;
     file->storage = storage;
+    file->priority = StoragePriorityNormal;
 
     FURI_LOG_T(TAG, "File/Dir %p alloc", (void*)((uint32_t)file - SRAM_BASE));
 
@@ -1158,7 +1254,6 @@ FuriPubSub* storage_get_pubsub(Storage* storage) {
 bool storage_simply_remove_recursive(Storage* storage, const char* path) {
     furi_check(storage);
     furi_check(path);
-    FileInfo fileinfo;
     bool result = false;
     FuriString* fullname;
     FuriString* cur_dir;
@@ -1167,7 +1262,7 @@ bool storage_simply_remove_recursive(Storage* storage, const char* path) {
         return true;
     }
 
-    char* name = malloc(MAX_NAME_LENGTH); //-V799
+    StorageDirEntry* entries = malloc(sizeof(StorageDirEntry) * STORAGE_DIR_READ_BATCH_SIZE);
     File* dir = storage_file_alloc(storage);
     cur_dir = furi_string_alloc_set(path);
     bool go_deeper = false;
@@ -1178,18 +1273,23 @@ bool storage_simply_remove_recursive(Storage* storage, const char* path) {
             break;
         }
 
-        while(storage_dir_read(dir, &fileinfo, name, MAX_NAME_LENGTH)) {
-            if(file_info_is_dir(&fileinfo)) {
-                furi_string_cat_printf(cur_dir, "/%s", name); //-V576
-                go_deeper = true;
-                break;
-            }
+        size_t entries_cnt;
+        do {
+            entries_cnt = storage_dir_read_batch(dir, entries, STORAGE_DIR_READ_BATCH_SIZE);
+            for(size_t i = 0; i < entries_cnt; i++) {
+                if(file_info_is_dir(&entries[i].fileinfo)) {
+                    furi_string_cat_printf(cur_dir, "/%s", entries[i].name); //-V576
+                    go_deeper = true;
+                    break;
+                }
 
-            fullname = furi_string_alloc_printf("%s/%s", furi_string_get_cstr(cur_dir), name);
-            FS_Error error = storage_common_remove(storage, furi_string_get_cstr(fullname));
-            furi_check(error == FSE_OK);
-            furi_string_free(fullname);
-        }
+                fullname = furi_string_alloc_printf(
+                    "%s/%s", furi_string_get_cstr(cur_dir), entries[i].name);
+                FS_Error error = storage_common_remove(storage, furi_string_get_cstr(fullname));
+                furi_check(error == FSE_OK);
+                furi_string_free(fullname);
+            }
+        } while(!go_deeper && entries_cnt == STORAGE_DIR_READ_BATCH_SIZE);
         storage_dir_close(dir);
 
         if(go_deeper) {
@@ -1212,7 +1312,7 @@ bool storage_simply_remove_recursive(Storage* storage, const char* path) {
 
     storage_file_free(dir);
     furi_string_free(cur_dir);
-    free(name);
+    free(entries);
     return result;
 } //-V773
 
@@ -33,6 +33,10 @@ void storage_data_init(StorageData* storage) {
     storage->data = NULL;
     storage->status = StorageStatusNotReady;
     StorageFileList_init(storage->files);
+    for(size_t i = 0; i < STORAGE_DIR_INDEX_CACHE_SIZE; i++) {
+        storage->dir_index_cache[i].dir = furi_string_alloc();
+    }
+    storage_data_dir_index_cache_reset(storage);
 }
 
 StorageStatus storage_data_status(StorageData* storage) {
@@ -73,6 +77,13 @@ uint32_t storage_data_get_timestamp(StorageData* storage) {
     return storage->timestamp;
 }
 
+void storage_data_dir_index_cache_reset(StorageData* storage) {
+    for(size_t i = 0; i < STORAGE_DIR_INDEX_CACHE_SIZE; i++) {
+        storage->dir_index_cache[i].used = false;
+    }
+    storage->dir_index_cache_next = 0;
+}
+
 /****************** storage glue ******************/
 
 static StorageFile* storage_get_file(const File* file, StorageData* storage) {
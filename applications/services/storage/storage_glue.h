@@ -37,6 +37,16 @@ typedef enum {
     StorageStatusErrorInternal, /**< any other internal error */
 } StorageStatus;
 
+/** Number of directories whose directory index state is remembered */
+#define STORAGE_DIR_INDEX_CACHE_SIZE 4
+
+typedef struct {
+    bool used;
+    bool indexed; /**< directory has a directory index */
+    size_t dir_hash; /**< hash of the directory path, checked first */
+    FuriString* dir; /**< directory path */
+} StorageDirIndexCacheEntry;
+
 void storage_file_init(StorageFile* obj);
 void storage_file_init_set(StorageFile* obj, const StorageFile* src);
 void storage_file_set(StorageFile* obj, const StorageFile* src);
@@ -48,6 +58,7 @@ StorageStatus storage_data_status(StorageData* storage);
 const char* storage_data_status_text(StorageData* storage);
 void storage_data_timestamp(StorageData* storage);
 uint32_t storage_data_get_timestamp(StorageData* storage);
+void storage_data_dir_index_cache_reset(StorageData* storage);
 
 LIST_DEF(
     StorageFileList,
@@ -64,6 +75,8 @@ struct StorageData {
     StorageStatus status;
     StorageFileList_t files;
     uint32_t timestamp;
+    StorageDirIndexCacheEntry dir_index_cache[STORAGE_DIR_INDEX_CACHE_SIZE];
+    uint8_t dir_index_cache_next;
 };
 
 bool storage_has_file(const File* file, StorageData* storage_data);
@@ -2,9 +2,12 @@
 #include <furi.h>
 #include <furi_hal.h>
 #include <gui/gui.h>
+#include "storage.h"
 #include "storage_glue.h"
 #include "storage_sd_api.h"
+#include "storage_message.h"
 #include "filesystem_api_internal.h"
+#include <m-deque.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -15,18 +18,38 @@ extern "C" {
 #define APPS_DATA_PATH   EXT_PATH("apps_data")
 #define APPS_ASSETS_PATH EXT_PATH("apps_assets")
 
+/** Latency histogram buckets: below 64us, doubling up to 65ms, then everything above */
+#define STORAGE_LATENCY_BUCKET_MIN_US_LOG2 6
+#define STORAGE_LATENCY_BUCKETS            12
+
+typedef struct {
+    uint32_t count;
+    uint32_t max_us;
+    uint64_t total_us;
+    uint16_t buckets[STORAGE_LATENCY_BUCKETS]; /**< Saturating counters */
+} StorageLatency;
+
 typedef struct {
     ViewPort* view_port;
     bool enabled;
 } StorageSDGui;
 
+DEQUE_DEF(StorageMessageDeque, StorageMessage, M_POD_OPLIST)
+
 struct Storage {
     FuriMessageQueue* message_queue;
+    StorageMessageDeque_t pending[StoragePriorityCount];
     StorageData storage[STORAGE_COUNT];
     StorageSDGui sd_gui;
     FuriPubSub* pubsub;
+    StorageLatency latency[StorageCommandCount];
 };
 
+/** Clear request latency stats on the storage thread, which is the one updating them
+ * @param storage
+ */
+void storage_latency_reset(Storage* storage);
+
 #ifdef __cplusplus
 }
 #endif
@@ -50,6 +50,12 @@ typedef struct {
     uint16_t name_length;
 } SADataDRead;
 
+typedef struct {
+    File* file;
+    StorageDirEntry* entries;
+    size_t count;
+} SADataDReadBatch;
+
 typedef struct {
     const char* path;
     uint32_t* timestamp;
@@ -117,6 +123,7 @@ typedef union {
 
     SADataDOpen dopen;
     SADataDRead dread;
+    SADataDReadBatch dreadbatch;
 
     SADataCTimestamp ctimestamp;
     SADataCStat cstat;
@@ -178,6 +185,10 @@ typedef enum {
     StorageCommandVirtualMount,
     StorageCommandVirtualUnmount,
     StorageCommandVirtualQuit,
+    StorageCommandDirReadBatch,
+    StorageCommandLatencyReset,
+
+    StorageCommandCount,
 } StorageCommand;
 
 typedef struct {
@@ -185,8 +196,17 @@ typedef struct {
     StorageCommand command;
     SAData* data;
     SAReturn* return_data;
+    uint32_t timestamp; /**< Submission time, in DWT cycles */
+    StorageAsyncCallback callback; /**< Completion callback of asynchronous requests */
+    void* callback_context;
 } StorageMessage;
 
+/** Message storage of an asynchronous request, freed by the storage thread on completion */
+typedef struct {
+    SAData data;
+    SAReturn return_data;
+} StorageAsyncMessage;
+
 #ifdef __cplusplus
 }
 #endif
@@ -4,6 +4,8 @@
 #include "storage_processing.h"
 #include "storage_internal_dirname_i.h"
 
+#include <toolbox/dir_index.h>
+
 #define TAG "Storage"
 
 #define STORAGE_PATH_PREFIX_LEN 4u
@@ -101,6 +103,162 @@ static void storage_path_trim_trailing_slashes(FuriString* path) {
     }
 }
 
+/******************* Directory Index Journal *******************/
+
+// Check if the directory has an index, state of recently changed directories is cached
+static StorageDirIndexCacheEntry*
+    storage_dir_index_cache_find(StorageData* storage, FuriString* dir, size_t dir_hash) {
+    for(size_t i = 0; i < STORAGE_DIR_INDEX_CACHE_SIZE; i++) {
+        StorageDirIndexCacheEntry* entry = &storage->dir_index_cache[i];
+        if(entry->used && entry->dir_hash == dir_hash && furi_string_equal(entry->dir, dir)) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static bool storage_dir_index_exists(StorageData* storage, FuriString* dir) {
+    const size_t dir_hash = furi_string_hash(dir);
+    const StorageDirIndexCacheEntry* cached = storage_dir_index_cache_find(storage, dir, dir_hash);
+    if(cached) return cached->indexed;
+
+    const size_t dir_size = furi_string_size(dir);
+    furi_string_cat(dir, "/" DIR_INDEX_FILE_NAME);
+    const bool indexed =
+        storage->fs_api->common.stat(storage, cstr_path_without_vfs_prefix(dir), NULL) == FSE_OK;
+    furi_string_left(dir, dir_size);
+
+    StorageDirIndexCacheEntry* entry = &storage->dir_index_cache[storage->dir_index_cache_next];
+    storage->dir_index_cache_next = (storage->dir_index_cache_next + 1) %
+                                    STORAGE_DIR_INDEX_CACHE_SIZE;
+    entry->used = true;
+    entry->indexed = indexed;
+    entry->dir_hash = dir_hash;
+    furi_string_set(entry->dir, dir);
+
+    return indexed;
+}
+
+static void storage_dir_index_forget(StorageData* storage, FuriString* dir) {
+    StorageDirIndexCacheEntry* entry =
+        storage_dir_index_cache_find(storage, dir, furi_string_hash(dir));
+    if(entry) entry->used = false;
+}
+
+// Find journal of the directory holding the entry, only indexed directories are journaled
+static bool
+    storage_dir_index_journal_path(StorageData* storage, FuriString* path, FuriString* journal) {
+    const char* path_cstr = furi_string_get_cstr(path);
+    const char* name = strrchr(path_cstr, '/');
+    if(!name) return false;
+
+    furi_string_set_strn(journal, path_cstr, name - path_cstr);
+
+    // Index is being created or removed, cached state is about to be stale
+    if(dir_index_is_service_file(name + 1)) {
+        storage_dir_index_forget(storage, journal);
+        return false;
+    }
+
+    if(!storage_dir_index_exists(storage, journal)) return false;
+
+    furi_string_cat(journal, "/" DIR_INDEX_JOURNAL_FILE_NAME);
+    return true;
+}
+
+static void storage_dir_index_journal_append(
+    StorageData* storage,
+    FuriString* journal,
+    FuriString* path,
+    DirIndexJournalOp op,
+    bool is_dir) {
+    // Someone is reading the journal right now, index will be revalidated anyway
+    if(storage_path_already_open(journal, storage)) return;
+
+    uint8_t record[DIR_INDEX_JOURNAL_RECORD_SIZE_MAX];
+    const char* name = strrchr(furi_string_get_cstr(path), '/') + 1;
+    size_t record_size = dir_index_journal_record_encode(record, op, is_dir, name);
+    if(!record_size) return;
+
+    File file = {.type = FileTypeClosed};
+    storage_push_storage_file(&file, journal, storage);
+
+    const char* journal_cstr_no_vfs = cstr_path_without_vfs_prefix(journal);
+    if(storage->fs_api->file.open(
+           storage, &file, journal_cstr_no_vfs, FSAM_WRITE, FSOM_OPEN_APPEND)) {
+        if(storage->fs_api->file.write(storage, &file, record, record_size) != record_size) {
+            FURI_LOG_W(TAG, "Failed to journal %s", furi_string_get_cstr(path));
+        }
+    }
+    storage->fs_api->file.close(storage, &file);
+
+    storage_pop_storage_file(&file, storage);
+}
+
+static void storage_dir_index_journal(
+    StorageData* storage,
+    FuriString* path,
+    DirIndexJournalOp op,
+    bool is_dir) {
+    FuriString* journal = furi_string_alloc();
+    if(storage_dir_index_journal_path(storage, path, journal)) {
+        storage_dir_index_journal_append(storage, journal, path, op, is_dir);
+    }
+    furi_string_free(journal);
+}
+
+// Service files are not listed, so a directory holding nothing else must still be removable
+static bool storage_dir_index_purge(StorageData* storage, FuriString* path) {
+    static const char* const service_files[] = {
+        DIR_INDEX_FILE_NAME,
+        DIR_INDEX_JOURNAL_FILE_NAME,
+        DIR_INDEX_TEMP_FILE_NAME,
+        DIR_INDEX_PENDING_JOURNAL_FILE_NAME,
+    };
+    char name[sizeof(DIR_INDEX_PENDING_JOURNAL_FILE_NAME)];
+    bool purge = false;
+
+    File dir = {.type = FileTypeClosed};
+    storage_push_storage_file(&dir, path, storage);
+    if(storage->fs_api->dir.open(storage, &dir, cstr_path_without_vfs_prefix(path))) {
+        while(storage->fs_api->dir.read(storage, &dir, NULL, name, sizeof(name))) {
+            purge = dir_index_is_service_file(name);
+            if(!purge) break;
+        }
+    }
+    storage->fs_api->dir.close(storage, &dir);
+    storage_pop_storage_file(&dir, storage);
+
+    if(!purge) return false;
+
+    // An index in use is left alone, removing the directory fails as it did before
+    FuriString* file_path = furi_string_alloc();
+    for(size_t i = 0; (i < COUNT_OF(service_files)) && purge; i++) {
+        furi_string_printf(file_path, "%s/%s", furi_string_get_cstr(path), service_files[i]);
+        purge = !storage_path_already_open(file_path, storage);
+    }
+
+    for(size_t i = 0; (i < COUNT_OF(service_files)) && purge; i++) {
+        furi_string_printf(
+            file_path, "%s/%s", cstr_path_without_vfs_prefix(path), service_files[i]);
+        storage->fs_api->common.remove(storage, furi_string_get_cstr(file_path));
+    }
+    furi_string_free(file_path);
+
+    return purge;
+}
+
+// Index service files are hidden from everyone listing directories
+static size_t storage_dir_index_filter(StorageDirEntry* entries, size_t count) {
+    size_t kept = 0;
+    for(size_t i = 0; i < count; i++) {
+        if(dir_index_is_service_file(entries[i].name)) continue;
+        if(kept != i) entries[kept] = entries[i];
+        kept++;
+    }
+    return kept;
+}
+
 /******************* File Functions *******************/
 
 bool storage_process_file_open(
@@ -117,13 +275,33 @@ bool storage_process_file_open(
         if(storage_path_already_open(path, storage)) {
             file->error_id = FSE_ALREADY_OPEN;
         } else {
+            const char* path_cstr_no_vfs = cstr_path_without_vfs_prefix(path);
+            FuriString* journal = NULL;
+
             if(access_mode & FSAM_WRITE) {
                 storage_data_timestamp(storage);
+
+                // Only files that didn't exist before are new to the directory index
+                if(open_mode != FSOM_OPEN_EXISTING) {
+                    journal = furi_string_alloc();
+                    if(!storage_dir_index_journal_path(storage, path, journal) ||
+                       storage->fs_api->common.stat(storage, path_cstr_no_vfs, NULL) == FSE_OK) {
+                        furi_string_free(journal);
+                        journal = NULL;
+                    }
+                }
             }
             storage_push_storage_file(file, path, storage);
 
-            const char* path_cstr_no_vfs = cstr_path_without_vfs_prefix(path);
             FS_CALL(storage, file.open(storage, file, path_cstr_no_vfs, access_mode, open_mode));
+
+            if(journal) {
+                if(ret) {
+                    storage_dir_index_journal_append(
+                        storage, journal, path, DirIndexJournalOpAdd, false);
+                }
+                furi_string_free(journal);
+            }
         }
     }
 
@@ -324,7 +502,40 @@ bool storage_process_dir_read(
     if(storage == NULL) {
         file->error_id = FSE_INVALID_PARAMETER;
     } else {
-        FS_CALL(storage, dir.read(storage, file, fileinfo, name, name_length));
+        // Name is needed to skip index service files
+        char service_name[sizeof(DIR_INDEX_FILE_NAME)];
+        uint16_t length = name_length;
+        if(name == NULL) {
+            name = service_name;
+            length = sizeof(service_name);
+        }
+
+        do {
+            FS_CALL(storage, dir.read(storage, file, fileinfo, name, length));
+        } while(ret && dir_index_is_service_file(name));
+    }
+
+    return ret;
+}
+
+size_t storage_process_dir_read_batch(
+    Storage* app,
+    File* file,
+    StorageDirEntry* entries,
+    size_t count) {
+    size_t ret = 0;
+    StorageData* storage = get_storage_by_file(file, app->storage);
+
+    if(storage == NULL) {
+        file->error_id = FSE_INVALID_PARAMETER;
+    } else {
+        // Callers take a short batch for the end of directory, skipped entries are made up
+        size_t requested, read;
+        do {
+            requested = count - ret;
+            read = storage->fs_api->dir.read_batch(storage, file, &entries[ret], requested);
+            ret += storage_dir_index_filter(&entries[ret], read);
+        } while(read == requested && ret < count);
     }
 
     return ret;
@@ -382,6 +593,15 @@ static FS_Error storage_process_common_remove(Storage* app, FuriString* path) {
 
         storage_data_timestamp(storage);
         FS_CALL(storage, common.remove(storage, cstr_path_without_vfs_prefix(path)));
+
+        if(ret != FSE_OK && ret != FSE_NOT_EXIST && storage_dir_index_purge(storage, path)) {
+            FS_CALL(storage, common.remove(storage, cstr_path_without_vfs_prefix(path)));
+        }
+
+        if(ret == FSE_OK) {
+            storage_dir_index_forget(storage, path);
+            storage_dir_index_journal(storage, path, DirIndexJournalOpRemove, false);
+        }
     } while(false);
 
     return ret;
@@ -416,6 +636,22 @@ static FS_Error storage_process_common_rename(Storage* app, FuriString* old, Fur
             storage,
             common.rename(
                 storage, cstr_path_without_vfs_prefix(old), cstr_path_without_vfs_prefix(new)));
+
+        if(ret == FSE_OK) {
+            // Renamed directory takes its subdirectories along, cached paths are stale
+            storage_data_dir_index_cache_reset(storage);
+            storage_dir_index_journal(storage, old, DirIndexJournalOpRemove, false);
+
+            FuriString* journal = furi_string_alloc();
+            const char* new_cstr_no_vfs = cstr_path_without_vfs_prefix(new);
+            FileInfo fileinfo;
+            if(storage_dir_index_journal_path(storage, new, journal) &&
+               storage->fs_api->common.stat(storage, new_cstr_no_vfs, &fileinfo) == FSE_OK) {
+                storage_dir_index_journal_append(
+                    storage, journal, new, DirIndexJournalOpAdd, file_info_is_dir(&fileinfo));
+            }
+            furi_string_free(journal);
+        }
     } while(false);
 
     return ret;
@@ -428,6 +664,11 @@ static FS_Error storage_process_common_mkdir(Storage* app, FuriString* path) {
     if(ret == FSE_OK) {
         storage_data_timestamp(storage);
         FS_CALL(storage, common.mkdir(storage, cstr_path_without_vfs_prefix(path)));
+
+        if(ret == FSE_OK) {
+            storage_dir_index_forget(storage, path);
+            storage_dir_index_journal(storage, path, DirIndexJournalOpAdd, true);
+        }
     }
 
     return ret;
@@ -487,6 +728,7 @@ static FS_Error storage_process_sd_format(Storage* app) {
     } else {
         ret = sd_format_card(&app->storage[ST_EXT]);
         storage_data_timestamp(&app->storage[ST_EXT]);
+        storage_data_dir_index_cache_reset(&app->storage[ST_EXT]);
     }
 
     return ret;
@@ -509,6 +751,7 @@ static FS_Error storage_process_sd_unmount(Storage* app) {
 
         sd_unmount_card(storage);
         storage_data_timestamp(storage);
+        storage_data_dir_index_cache_reset(storage);
     } while(false);
 
     return ret;
@@ -526,6 +769,7 @@ static FS_Error storage_process_sd_mount(Storage* app) {
 
         ret = sd_mount_card(storage, true);
         storage_data_timestamp(storage);
+        storage_data_dir_index_cache_reset(storage);
     } while(false);
 
     return ret;
@@ -701,6 +945,13 @@ void storage_process_message_internal(Storage* app, StorageMessage* message) {
             message->data->dread.name,
             message->data->dread.name_length);
         break;
+    case StorageCommandDirReadBatch:
+        message->return_data->uint64_value = storage_process_dir_read_batch(
+            app,
+            message->data->dreadbatch.file,
+            message->data->dreadbatch.entries,
+            message->data->dreadbatch.count);
+        break;
     case StorageCommandDirRewind:
         message->return_data->bool_value =
             storage_process_dir_rewind(app, message->data->file.file);
@@ -810,9 +1061,11 @@ void storage_process_message_internal(Storage* app, StorageMessage* message) {
         break;
     case StorageCommandVirtualFormat:
         message->return_data->error_value = storage_process_virtual_format(&app->storage[ST_MNT]);
+        storage_data_dir_index_cache_reset(&app->storage[ST_MNT]);
         break;
     case StorageCommandVirtualMount:
         message->return_data->error_value = storage_process_virtual_mount(&app->storage[ST_MNT]);
+        storage_data_dir_index_cache_reset(&app->storage[ST_MNT]);
         break;
     case StorageCommandVirtualUnmount:
         message->return_data->error_value = storage_process_virtual_unmount(&app->storage[ST_MNT]);
@@ -820,15 +1073,79 @@ void storage_process_message_internal(Storage* app, StorageMessage* message) {
     case StorageCommandVirtualQuit:
         message->return_data->error_value = storage_process_virtual_quit(&app->storage[ST_MNT]);
         break;
+
+    // Stats
+    case StorageCommandLatencyReset:
+        memset(app->latency, 0, sizeof(app->latency));
+        break;
     }
 
     if(path != NULL) { //-V547
         furi_string_free(path);
     }
+}
+
+static void storage_process_latency(Storage* app, const StorageMessage* message) {
+    StorageLatency* latency = &app->latency[message->command];
+    uint32_t latency_us = (furi_hal_cortex_timer_get(0).start - message->timestamp) /
+                          furi_hal_cortex_instructions_per_microsecond();
+
+    size_t bucket = 0;
+    if(latency_us) {
+        size_t bits = 32 - __builtin_clz(latency_us);
+        if(bits > STORAGE_LATENCY_BUCKET_MIN_US_LOG2) {
+            bucket = MIN(bits - STORAGE_LATENCY_BUCKET_MIN_US_LOG2, STORAGE_LATENCY_BUCKETS - 1);
+        }
+    }
 
-    api_lock_unlock(message->lock);
+    if(latency->buckets[bucket] < UINT16_MAX) {
+        latency->buckets[bucket]++;
+    }
+    latency->count++;
+    latency->total_us += latency_us;
+    latency->max_us = MAX(latency->max_us, latency_us);
+}
+
+static void storage_process_complete(Storage* app, StorageMessage* message) {
+    storage_process_latency(app, message);
+
+    if(message->callback) {
+        // Asynchronous requests are file reads and writes only
+        message->callback(message->callback_context, message->return_data->uint16_value);
+        // Data is the first member of StorageAsyncMessage
+        free(message->data);
+    } else {
+        api_lock_unlock(message->lock);
+    }
 }
 
 void storage_process_message(Storage* app, StorageMessage* message) {
     storage_process_message_internal(app, message);
+    storage_process_complete(app, message);
+}
+
+void storage_process_file_read_coalesced(Storage* app, StorageMessage* messages, size_t count) {
+    File* file = messages[0].data->fread.file;
+
+    size_t bytes_to_read = 0;
+    for(size_t i = 0; i < count; i++) {
+        bytes_to_read += messages[i].data->fread.bytes_to_read;
+    }
+
+    uint8_t* buffer = malloc(bytes_to_read);
+    uint16_t bytes_read = storage_process_file_read(app, file, buffer, bytes_to_read);
+
+    // Scatter data in request order, requests past the end of file get what is left
+    size_t offset = 0;
+    for(size_t i = 0; i < count; i++) {
+        SADataFRead* fread = &messages[i].data->fread;
+        uint16_t chunk = MIN(fread->bytes_to_read, bytes_read - offset);
+        memcpy(fread->buff, buffer + offset, chunk);
+        offset += chunk;
+
+        messages[i].return_data->uint16_value = chunk;
+        storage_process_complete(app, &messages[i]);
+    }
+
+    free(buffer);
 }
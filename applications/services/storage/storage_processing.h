@@ -13,6 +13,14 @@ FS_Error storage_get_data(Storage* app, FuriString* path, StorageData** storage)
 
 void storage_process_message(Storage* app, StorageMessage* message);
 
+/**
+ * Serve sequential reads of the same file with a single filesystem call
+ * @param app
+ * @param messages StorageCommandFileRead messages, in submission order
+ * @param count number of messages
+ */
+void storage_process_file_read_coalesced(Storage* app, StorageMessage* messages, size_t count);
+
 #ifdef __cplusplus
 }
 #endif
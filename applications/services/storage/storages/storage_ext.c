@@ -2,6 +2,7 @@
 #include <furi_hal.h>
 #include <furi_hal_sd.h>
 #include <toolbox/path.h>
+#include <datetime/datetime.h>
 
 #include "sd_notify.h"
 #include "storage_ext.h"
@@ -613,6 +614,46 @@ static bool storage_ext_dir_read(
     return file->error_id == FSE_OK;
 }
 
+static uint32_t storage_ext_fat_timestamp(WORD fdate, WORD ftime) {
+    DateTime datetime = {
+        .year = 1980 + (fdate >> 9),
+        .month = (fdate >> 5) & 0x0F,
+        .day = fdate & 0x1F,
+        .hour = ftime >> 11,
+        .minute = (ftime >> 5) & 0x3F,
+        .second = (ftime & 0x1F) * 2,
+    };
+    return datetime_datetime_to_timestamp(&datetime);
+}
+
+static size_t
+    storage_ext_dir_read_batch(void* ctx, File* file, StorageDirEntry* entries, size_t count) {
+    StorageData* storage = ctx;
+    SDDir* file_data = storage_get_storage_file_data(file, storage);
+
+    SDFileInfo _fileinfo;
+    size_t read = 0;
+
+    while(read < count) {
+        file->internal_error_id = f_readdir(file_data, &_fileinfo);
+        file->error_id = storage_ext_parse_error(file->internal_error_id);
+        if(file->error_id != FSE_OK) break;
+
+        if(_fileinfo.fname[0] == 0) {
+            file->error_id = FSE_NOT_EXIST;
+            break;
+        }
+
+        StorageDirEntry* entry = &entries[read++];
+        entry->fileinfo.size = _fileinfo.fsize;
+        entry->fileinfo.flags = (_fileinfo.fattrib & AM_DIR) ? FSF_DIRECTORY : 0;
+        entry->mtime = storage_ext_fat_timestamp(_fileinfo.fdate, _fileinfo.ftime);
+        snprintf(entry->name, sizeof(entry->name), "%s", _fileinfo.fname);
+    }
+
+    return read;
+}
+
 static bool storage_ext_dir_rewind(void* ctx, File* file) {
     StorageData* storage = ctx;
     SDDir* file_data = storage_get_storage_file_data(file, storage);
@@ -757,6 +798,7 @@ static const FS_Api fs_api = {
             .open = storage_ext_dir_open,
             .close = storage_ext_dir_close,
             .read = storage_ext_dir_read,
+            .read_batch = storage_ext_dir_read_batch,
             .rewind = storage_ext_dir_rewind,
         },
     .common =
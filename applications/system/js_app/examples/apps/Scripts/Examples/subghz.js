@@ -37,6 +37,12 @@ subghz.transmitFile("/ext/subghz/0.sub");
 print("Send success");
 delay(1000);
 
+// RAW files recorded with the same frequency and preset can be played back to back,
+// from a Sub-GHz playlist file or an array
+// An optional second argument starts the first file at the given time, in ms
+subghz.transmitPlaylist(["/ext/subghz/0.sub", "/ext/subghz/1.sub"]);
+delay(1000);
+
 changeFrequency(315000000);
 printRXline();
 
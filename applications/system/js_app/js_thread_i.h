@@ -4,6 +4,7 @@
 #include <mjs_core_public.h>
 #include <mjs_ffi_public.h>
 #include <mjs_exec_public.h>
+#include <mjs_gc_public.h>
 #include <mjs_object_public.h>
 #include <mjs_string_public.h>
 #include <mjs_array_public.h>
@@ -344,7 +344,10 @@ static void js_event_loop_tick(void* param) {
     if(flags & ThreadEventStop) {
         furi_event_loop_stop(context->loop);
         mjs_exit(context->mjs);
+        return;
     }
+    // the loop is idle: collect short-lived garbage now instead of in the middle of a callback
+    mjs_gc_idle(context->mjs);
 }
 
 static void* js_event_loop_create(struct mjs* mjs, mjs_val_t* object, JsModules* modules) {
@@ -25,12 +25,25 @@ static void js_flipper_get_battery(struct mjs* mjs) {
     mjs_return(mjs, mjs_mk_number(mjs, info.charge));
 }
 
+static void js_flipper_get_gc_stats(struct mjs* mjs) {
+    struct mjs_gc_stats stats;
+    mjs_gc_get_stats(mjs, &stats);
+    mjs_val_t ret = mjs_mk_object(mjs);
+    mjs_set(mjs, ret, "collections", ~0, mjs_mk_number(mjs, stats.collections));
+    mjs_set(mjs, ret, "idleCollections", ~0, mjs_mk_number(mjs, stats.idle_collections));
+    mjs_set(mjs, ret, "lastPauseUs", ~0, mjs_mk_number(mjs, stats.last_pause_us));
+    mjs_set(mjs, ret, "maxPauseUs", ~0, mjs_mk_number(mjs, stats.max_pause_us));
+    mjs_set(mjs, ret, "totalPauseUs", ~0, mjs_mk_number(mjs, stats.total_pause_us));
+    mjs_return(mjs, ret);
+}
+
 void* js_flipper_create(struct mjs* mjs, mjs_val_t* object, JsModules* modules) {
     UNUSED(modules);
     mjs_val_t flipper_obj = mjs_mk_object(mjs);
     mjs_set(mjs, flipper_obj, "getModel", ~0, MJS_MK_FN(js_flipper_get_model));
     mjs_set(mjs, flipper_obj, "getName", ~0, MJS_MK_FN(js_flipper_get_name));
     mjs_set(mjs, flipper_obj, "getBatteryCharge", ~0, MJS_MK_FN(js_flipper_get_battery));
+    mjs_set(mjs, flipper_obj, "getGcStats", ~0, MJS_MK_FN(js_flipper_get_gc_stats));
     *object = flipper_obj;
 
     return (void*)1;
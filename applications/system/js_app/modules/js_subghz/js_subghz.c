@@ -2,6 +2,7 @@
 #include "radio_device_loader.h"
 
 #include <lib/subghz/transmitter.h>
+#include <lib/subghz/subghz_file_encoder_worker.h>
 #include <lib/subghz/devices/devices.h>
 #include <lib/subghz/protocols/protocol_items.h>
 
@@ -192,6 +193,75 @@ static void js_subghz_get_frequency(struct mjs* mjs) {
     mjs_return(mjs, mjs_mk_number(mjs, (double)js_subghz->frequency));
 }
 
+/** Read frequency and preset from a Sub-GHz file header and apply them to the radio */
+static bool js_subghz_load_radio_config(
+    struct mjs* mjs,
+    JsSubghzInst* js_subghz,
+    FlipperFormat* fff_file,
+    FuriString* temp_str) {
+    uint32_t temp_data32 = 0;
+    uint32_t frequency = 0;
+
+    if(!flipper_format_read_header(fff_file, temp_str, &temp_data32)) {
+        mjs_prepend_errorf(mjs, MJS_INTERNAL_ERROR, "Missing or incorrect header");
+        return false;
+    }
+
+    if(((!strcmp(furi_string_get_cstr(temp_str), SUBGHZ_KEY_FILE_TYPE)) ||
+        (!strcmp(furi_string_get_cstr(temp_str), SUBGHZ_RAW_FILE_TYPE))) &&
+       temp_data32 == SUBGHZ_KEY_FILE_VERSION) {
+    } else {
+        mjs_prepend_errorf(mjs, MJS_INTERNAL_ERROR, "Type or version mismatch");
+        return false;
+    }
+    if(!flipper_format_read_uint32(fff_file, "Frequency", &frequency, 1)) {
+        mjs_prepend_errorf(mjs, MJS_INTERNAL_ERROR, "Missing Frequency");
+        return false;
+    }
+
+    if(subghz_devices_check_tx(js_subghz->radio_device, frequency) != SubGhzTxAllowed) {
+        mjs_prepend_errorf(mjs, MJS_INTERNAL_ERROR, "Unsupported frequency");
+        return false;
+    }
+
+    if(!flipper_format_read_string(fff_file, "Preset", temp_str)) {
+        mjs_prepend_errorf(mjs, MJS_INTERNAL_ERROR, "Missing Preset");
+        return false;
+    }
+
+    FuriHalSubGhzPreset preset = js_subghz_get_preset_name(furi_string_get_cstr(temp_str));
+    if(preset == FuriHalSubGhzPresetIDLE) {
+        mjs_prepend_errorf(mjs, MJS_INTERNAL_ERROR, "Unknown preset");
+        return false;
+    }
+
+    subghz_devices_reset(js_subghz->radio_device);
+    subghz_devices_idle(js_subghz->radio_device);
+
+    if(preset == FuriHalSubGhzPresetCustom) {
+        uint8_t* custom_preset_data;
+        if(!flipper_format_get_value_count(fff_file, "Custom_preset_data", &temp_data32) ||
+           !temp_data32 || (temp_data32 % 2)) {
+            mjs_prepend_errorf(mjs, MJS_INTERNAL_ERROR, "Custom_preset_data size error");
+            return false;
+        }
+        custom_preset_data = malloc(temp_data32);
+        if(!flipper_format_read_hex(
+               fff_file, "Custom_preset_data", custom_preset_data, temp_data32)) {
+            free(custom_preset_data);
+            mjs_prepend_errorf(mjs, MJS_INTERNAL_ERROR, "Custom_preset_data read error");
+            return false;
+        }
+        subghz_devices_load_preset(js_subghz->radio_device, preset, custom_preset_data);
+        free(custom_preset_data);
+    } else {
+        subghz_devices_load_preset(js_subghz->radio_device, preset, NULL);
+    }
+
+    js_subghz->frequency = subghz_devices_set_frequency(js_subghz->radio_device, frequency);
+    return true;
+}
+
 static void js_subghz_transmit_file(struct mjs* mjs) {
     mjs_val_t obj_inst = mjs_get(mjs, mjs_get_this(mjs), INST_PROP_NAME, ~0);
     JsSubghzInst* js_subghz = mjs_get_ptr(mjs, obj_inst);
@@ -260,68 +330,13 @@ static void js_subghz_transmit_file(struct mjs* mjs) {
 
     FuriString* temp_str = furi_string_alloc();
     SubGhzTransmitter* transmitter = NULL;
-    uint32_t temp_data32 = 0;
-    uint32_t frequency = 0;
     bool is_sent = false;
 
     do {
-        if(!flipper_format_read_header(fff_file, temp_str, &temp_data32)) {
-            mjs_prepend_errorf(mjs, MJS_INTERNAL_ERROR, "Missing or incorrect header");
+        if(!js_subghz_load_radio_config(mjs, js_subghz, fff_file, temp_str)) {
             break;
         }
 
-        if(((!strcmp(furi_string_get_cstr(temp_str), SUBGHZ_KEY_FILE_TYPE)) ||
-            (!strcmp(furi_string_get_cstr(temp_str), SUBGHZ_RAW_FILE_TYPE))) &&
-           temp_data32 == SUBGHZ_KEY_FILE_VERSION) {
-        } else {
-            mjs_prepend_errorf(mjs, MJS_INTERNAL_ERROR, "Type or version mismatch");
-            break;
-        }
-        if(!flipper_format_read_uint32(fff_file, "Frequency", &frequency, 1)) {
-            mjs_prepend_errorf(mjs, MJS_INTERNAL_ERROR, "Missing Frequency");
-            break;
-        }
-
-        if(subghz_devices_check_tx(js_subghz->radio_device, frequency) != SubGhzTxAllowed) {
-            mjs_prepend_errorf(mjs, MJS_INTERNAL_ERROR, "Unsupported frequency");
-            break;
-        }
-
-        if(!flipper_format_read_string(fff_file, "Preset", temp_str)) {
-            mjs_prepend_errorf(mjs, MJS_INTERNAL_ERROR, "Missing Preset");
-            break;
-        }
-
-        FuriHalSubGhzPreset preset = js_subghz_get_preset_name(furi_string_get_cstr(temp_str));
-        if(preset == FuriHalSubGhzPresetIDLE) {
-            mjs_prepend_errorf(mjs, MJS_INTERNAL_ERROR, "Unknown preset");
-            break;
-        }
-
-        subghz_devices_reset(js_subghz->radio_device);
-        subghz_devices_idle(js_subghz->radio_device);
-
-        if(preset == FuriHalSubGhzPresetCustom) {
-            uint8_t* custom_preset_data;
-            if(!flipper_format_get_value_count(fff_file, "Custom_preset_data", &temp_data32) ||
-               !temp_data32 || (temp_data32 % 2)) {
-                mjs_prepend_errorf(mjs, MJS_INTERNAL_ERROR, "Custom_preset_data size error");
-                break;
-            }
-            custom_preset_data = malloc(temp_data32);
-            if(!flipper_format_read_hex(
-                   fff_file, "Custom_preset_data", custom_preset_data, temp_data32)) {
-                mjs_prepend_errorf(mjs, MJS_INTERNAL_ERROR, "Custom_preset_data read error");
-                break;
-            }
-            subghz_devices_load_preset(js_subghz->radio_device, preset, custom_preset_data);
-            free(custom_preset_data);
-        } else {
-            subghz_devices_load_preset(js_subghz->radio_device, preset, NULL);
-        }
-
-        js_subghz->frequency = subghz_devices_set_frequency(js_subghz->radio_device, frequency);
-
         if(!flipper_format_read_string(fff_file, "Protocol", temp_str)) {
             mjs_prepend_errorf(mjs, MJS_INTERNAL_ERROR, "Missing protocol");
             break;
@@ -433,6 +448,198 @@ static void js_subghz_transmit_file(struct mjs* mjs) {
     }
 }
 
+// Radio is configured once for the playlist, so every file must be recorded with the same settings
+static bool js_subghz_check_playlist(
+    struct mjs* mjs,
+    SubGhzFileEncoderWorker* worker,
+    FlipperFormat* fff_file,
+    FuriString* temp_str) {
+    FuriString* preset = furi_string_alloc();
+    uint32_t frequency = 0;
+    uint8_t* custom_data = NULL;
+    uint32_t custom_size = 0;
+    bool valid = true;
+
+    const char* file_path;
+    for(size_t i = 0; valid && (file_path = subghz_file_encoder_worker_get_file_path(worker, i));
+        i++) {
+        uint32_t file_version = 0;
+        uint32_t file_frequency = 0;
+        uint8_t* file_custom_data = NULL;
+        uint32_t file_custom_size = 0;
+        valid = false;
+
+        do {
+            if(!flipper_format_file_open_existing(fff_file, file_path)) {
+                mjs_prepend_errorf(mjs, MJS_INTERNAL_ERROR, "Failed to open %s", file_path);
+                break;
+            }
+            if(!flipper_format_read_header(fff_file, temp_str, &file_version) ||
+               !flipper_format_read_uint32(fff_file, "Frequency", &file_frequency, 1) ||
+               !flipper_format_read_string(fff_file, "Preset", temp_str)) {
+                mjs_prepend_errorf(
+                    mjs, MJS_INTERNAL_ERROR, "Missing radio settings in %s", file_path);
+                break;
+            }
+            if(js_subghz_get_preset_name(furi_string_get_cstr(temp_str)) ==
+               FuriHalSubGhzPresetCustom) {
+                if(!flipper_format_get_value_count(
+                       fff_file, "Custom_preset_data", &file_custom_size) ||
+                   !file_custom_size) {
+                    mjs_prepend_errorf(
+                    mjs, MJS_INTERNAL_ERROR, "Missing preset data in %s", file_path);
+                    break;
+                }
+                file_custom_data = malloc(file_custom_size);
+                if(!flipper_format_read_hex(
+                       fff_file, "Custom_preset_data", file_custom_data, file_custom_size)) {
+                    mjs_prepend_errorf(
+                    mjs, MJS_INTERNAL_ERROR, "Missing preset data in %s", file_path);
+                    break;
+                }
+            }
+
+            if(i == 0) {
+                frequency = file_frequency;
+                furi_string_set(preset, temp_str);
+                custom_data = file_custom_data;
+                custom_size = file_custom_size;
+                file_custom_data = NULL;
+            } else if(
+                file_frequency != frequency || !furi_string_equal(temp_str, preset) ||
+                file_custom_size != custom_size ||
+                (custom_size && memcmp(file_custom_data, custom_data, custom_size))) {
+                mjs_prepend_errorf(
+                    mjs, MJS_INTERNAL_ERROR, "Frequency or preset differs in %s", file_path);
+                break;
+            }
+
+            if(!flipper_format_read_string(fff_file, "Protocol", temp_str) ||
+               !furi_string_equal(temp_str, "RAW")) {
+                mjs_prepend_errorf(mjs, MJS_INTERNAL_ERROR, "Only RAW files can be played");
+                break;
+            }
+            valid = true;
+        } while(false);
+
+        free(file_custom_data);
+        flipper_format_file_close(fff_file);
+    }
+
+    free(custom_data);
+    furi_string_free(preset);
+    return valid;
+}
+
+static void js_subghz_transmit_playlist(struct mjs* mjs) {
+    mjs_val_t obj_inst = mjs_get(mjs, mjs_get_this(mjs), INST_PROP_NAME, ~0);
+    JsSubghzInst* js_subghz = mjs_get_ptr(mjs, obj_inst);
+    furi_assert(js_subghz);
+
+    if(!js_subghz->radio_device) {
+        mjs_prepend_errorf(mjs, MJS_INTERNAL_ERROR, "Radio is not setup");
+        mjs_return(mjs, MJS_UNDEFINED);
+        return;
+    }
+
+    // Playlist file path with "sub: <path>" lines, or array of file paths
+    mjs_val_t files = mjs_arg(mjs, 0);
+    if(!mjs_is_string(files) && !mjs_is_array(files)) {
+        mjs_prepend_errorf(mjs, MJS_INTERNAL_ERROR, "Files must be a playlist path or an array");
+        mjs_return(mjs, MJS_UNDEFINED);
+        return;
+    }
+
+    // Optional start time in the first file
+    uint32_t start_ms = 0;
+    mjs_val_t start_arg = mjs_arg(mjs, 1);
+    if(mjs_is_number(start_arg)) {
+        int32_t start_val = mjs_get_int32(mjs, start_arg);
+        start_ms = MAX(start_val, 0);
+    }
+
+    SubGhzFileEncoderWorker* worker = subghz_file_encoder_worker_alloc();
+    if(mjs_is_string(files)) {
+        const char* playlist_path = mjs_get_string(mjs, &files, NULL);
+        if(playlist_path) subghz_file_encoder_worker_load_playlist(worker, playlist_path);
+    } else {
+        size_t count = mjs_array_length(mjs, files);
+        for(size_t i = 0; i < count; i++) {
+            mjs_val_t file = mjs_array_get(mjs, files, i);
+            const char* file_path = mjs_is_string(file) ? mjs_get_string(mjs, &file, NULL) : NULL;
+            if(file_path) subghz_file_encoder_worker_add_file(worker, file_path);
+        }
+    }
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* fff_file = flipper_format_file_alloc(storage);
+    FuriString* temp_str = furi_string_alloc();
+    bool is_sent = false;
+
+    do {
+        // Radio is configured from the first file, the rest must match it
+        const char* file_path = subghz_file_encoder_worker_get_file_path(worker, 0);
+        if(!file_path) {
+            mjs_prepend_errorf(mjs, MJS_INTERNAL_ERROR, "Playlist is empty");
+            break;
+        }
+        if(!flipper_format_file_open_existing(fff_file, file_path)) {
+            mjs_prepend_errorf(mjs, MJS_INTERNAL_ERROR, "Failed to open file");
+            break;
+        }
+        if(!js_subghz_load_radio_config(mjs, js_subghz, fff_file, temp_str)) {
+            break;
+        }
+        flipper_format_file_close(fff_file);
+        if(!js_subghz_check_playlist(mjs, worker, fff_file, temp_str)) {
+            break;
+        }
+
+        if(start_ms) subghz_file_encoder_worker_seek(worker, start_ms);
+        subghz_file_encoder_worker_start(
+            worker, NULL, subghz_devices_get_name(js_subghz->radio_device));
+
+        if(!js_subghz->is_external) {
+            furi_hal_power_suppress_charge_enter();
+        }
+        subghz_devices_set_tx(js_subghz->radio_device);
+        FURI_LOG_I(TAG, "Transmitting playlist from %s", file_path);
+
+        if(subghz_devices_start_async_tx(
+               js_subghz->radio_device, subghz_file_encoder_worker_get_level_duration, worker)) {
+            while(!subghz_devices_is_async_complete_tx(js_subghz->radio_device)) {
+                furi_delay_ms(100);
+            }
+            subghz_devices_stop_async_tx(js_subghz->radio_device);
+            is_sent = true;
+        } else {
+            mjs_prepend_errorf(mjs, MJS_INTERNAL_ERROR, "Failed to start async tx");
+        }
+        FURI_LOG_I(TAG, "Underruns: %lu", subghz_file_encoder_worker_get_underruns(worker));
+
+        if(!js_subghz->is_external) {
+            furi_hal_power_suppress_charge_exit();
+        }
+    } while(false);
+
+    subghz_devices_idle(js_subghz->radio_device);
+    js_subghz->state = JsSubghzRadioStateIDLE;
+
+    if(subghz_file_encoder_worker_is_running(worker)) {
+        subghz_file_encoder_worker_stop(worker);
+    }
+    subghz_file_encoder_worker_free(worker);
+    furi_string_free(temp_str);
+    flipper_format_free(fff_file);
+    furi_record_close(RECORD_STORAGE);
+
+    if(is_sent) {
+        mjs_return(mjs, mjs_mk_boolean(mjs, true));
+    } else {
+        mjs_return(mjs, MJS_UNDEFINED);
+    }
+}
+
 static void js_subghz_setup(struct mjs* mjs) {
     mjs_val_t obj_inst = mjs_get(mjs, mjs_get_this(mjs), INST_PROP_NAME, ~0);
     JsSubghzInst* js_subghz = mjs_get_ptr(mjs, obj_inst);
@@ -502,6 +709,7 @@ static void* js_subghz_create(struct mjs* mjs, mjs_val_t* object, JsModules* mod
     mjs_set(mjs, subghz_obj, "setFrequency", ~0, MJS_MK_FN(js_subghz_set_frequency));
     mjs_set(mjs, subghz_obj, "isExternal", ~0, MJS_MK_FN(js_subghz_is_external));
     mjs_set(mjs, subghz_obj, "transmitFile", ~0, MJS_MK_FN(js_subghz_transmit_file));
+    mjs_set(mjs, subghz_obj, "transmitPlaylist", ~0, MJS_MK_FN(js_subghz_transmit_playlist));
 
     *object = subghz_obj;
 
@@ -12,3 +12,19 @@ export declare function getName(): string;
  * @brief Returns the battery charge percentage
  */
 export declare function getBatteryCharge(): number;
+
+/**
+ * @brief Garbage collector pause statistics, all times are in microseconds
+ */
+export type GcStats = {
+    collections: number;
+    idleCollections: number;
+    lastPauseUs: number;
+    maxPauseUs: number;
+    totalPauseUs: number;
+};
+
+/**
+ * @brief Returns garbage collector pause statistics of the current script
+ */
+export declare function getGcStats(): GcStats;
@@ -352,6 +352,18 @@ void furi_event_loop_subscribe_stream_buffer(
         instance, stream_buffer, &furi_stream_buffer_event_loop_contract, event, callback, context);
 }
 
+void furi_event_loop_subscribe_spsc_ring(
+    FuriEventLoop* instance,
+    FuriSpscRing* ring,
+    FuriEventLoopEvent event,
+    FuriEventLoopEventCallback callback,
+    void* context) {
+    extern const FuriEventLoopContract furi_spsc_ring_event_loop_contract;
+
+    furi_event_loop_object_subscribe(
+        instance, ring, &furi_spsc_ring_event_loop_contract, event, callback, context);
+}
+
 void furi_event_loop_subscribe_semaphore(
     FuriEventLoop* instance,
     FuriSemaphore* semaphore,
@@ -36,6 +36,7 @@ typedef enum {
      * In events occur on the following conditions:
      * - One or more items were inserted into a FuriMessageQueue,
      * - Enough data has been written to a FuriStreamBuffer,
+     * - One or more items were pushed to a FuriSpscRing,
      * - A FuriSemaphore has been released at least once,
      * - A FuriMutex has been released.
      */
@@ -46,6 +47,7 @@ typedef enum {
      * Out events occur on the following conditions:
      * - One or more items were removed from a FuriMessageQueue,
      * - Any amount of data has been read out of a FuriStreamBuffer,
+     * - One or more items were popped from a FuriSpscRing,
      * - A FuriSemaphore has been acquired at least once,
      * - A FuriMutex has been acquired.
      */
@@ -63,12 +65,14 @@ typedef enum {
      * In events:
      * - a FuriMessageQueue contains one or more items,
      * - a FuriStreamBuffer contains one or more bytes,
+     * - a FuriSpscRing contains one or more items,
      * - a FuriSemaphore can be acquired at least once,
      * - a FuriMutex can be acquired.
      *
      * Out events:
      * - a FuriMessageQueue has at least one item of free space,
      * - a FuriStreamBuffer has at least one byte of free space,
+     * - a FuriSpscRing has at least one item of free space,
      * - a FuriSemaphore has been acquired at least once,
      * - a FuriMutex has been acquired.
      *
@@ -242,6 +246,26 @@ void furi_event_loop_subscribe_stream_buffer(
     FuriEventLoopEventCallback callback,
     void* context);
 
+/** Opaque single producer, single consumer ring buffer type */
+typedef struct FuriSpscRing FuriSpscRing;
+
+/** Subscribe to ring buffer events
+ *
+ * @warning you can only have one subscription for one event type.
+ *
+ * @param      instance       The Event Loop instance
+ * @param      ring           The ring buffer to add
+ * @param[in]  event          The Event Loop event to trigger on
+ * @param[in]  callback       The callback to call on event
+ * @param      context        The context for callback
+ */
+void furi_event_loop_subscribe_spsc_ring(
+    FuriEventLoop* instance,
+    FuriSpscRing* ring,
+    FuriEventLoopEvent event,
+    FuriEventLoopEventCallback callback,
+    void* context);
+
 /** Opaque semaphore type */
 typedef struct FuriSemaphore FuriSemaphore;
 
@@ -1,6 +1,7 @@
 #include "log.h"
 #include "check.h"
 #include "mutex.h"
+#include "thread.h"
 #include <furi_hal.h>
 #include <m-list.h>
 
@@ -8,10 +9,43 @@ LIST_DEF(FuriLogHandlersList, FuriLogHandler, M_POD_OPLIST)
 
 #define FURI_LOG_LEVEL_DEFAULT FuriLogLevelInfo
 
+/** Deferred records ring size, power of two */
+#define FURI_LOG_DEFERRED_RING_SIZE   2048U
+/** Largest record with arguments, bigger ones are truncated */
+#define FURI_LOG_DEFERRED_RECORD_MAX  128U
+/** Longest %s argument copied to the record */
+#define FURI_LOG_DEFERRED_STRING_MAX  48U
+#define FURI_LOG_DEFERRED_TRUNCATED   0x80U
+#define FURI_LOG_DEFERRED_STACK_SIZE  1024U
+#define FURI_LOG_DEFERRED_FLAG_DATA   (1UL << 0)
+#define FURI_LOG_DEFERRED_FLAG_EXIT   (1UL << 1)
+#define FURI_LOG_DEFERRED_PERIOD_MS   100U
+
+/** Frame start on the wire, never part of UTF-8 text */
+static const uint8_t furi_log_deferred_magic[] = {0xFE, 0xFF};
+
+/** Deferred record, followed by the raw arguments */
+typedef struct {
+    uint16_t size; /**< Record size with the header, multiple of 4 */
+    uint8_t level; /**< FuriLogLevel, FuriLogLevelDefault for padding */
+    uint8_t state; /**< Committed flag in the ring, records dropped before it on the wire */
+    uint32_t tick;
+    const char* tag;
+    const char* format;
+} FuriLogDeferredHeader;
+
 typedef struct {
     FuriLogLevel log_level;
     FuriMutex* mutex;
     FuriLogHandlersList_t tx_handlers;
+
+    volatile bool deferred;
+    uint8_t* deferred_ring;
+    uint32_t deferred_head;
+    uint32_t deferred_tail;
+    uint32_t deferred_dropped;
+    FuriThread* deferred_thread;
+    FuriThreadId deferred_thread_id;
 } FuriLogParams;
 
 static FuriLogParams furi_log = {0};
@@ -107,12 +141,239 @@ void furi_log_puts(const char* data) {
     furi_log_tx((const uint8_t*)data, strlen(data));
 }
 
+static bool furi_log_deferred_is_firmware(const void* pointer) {
+    // Only strings of the firmware image can be found by the decoder in the ELF
+    return (size_t)pointer >= furi_hal_flash_get_base() &&
+           pointer < furi_hal_flash_get_free_start_address();
+}
+
+static bool furi_log_deferred_put(uint8_t* record, size_t* size, const void* data, size_t length) {
+    if(*size + length > FURI_LOG_DEFERRED_RECORD_MAX) return false;
+    memcpy(&record[*size], data, length);
+    *size += length;
+    return true;
+}
+
+static bool furi_log_deferred_put_string(uint8_t* record, size_t* size, const char* string) {
+    if(!string) string = "(null)";
+    uint8_t length = strnlen(string, FURI_LOG_DEFERRED_STRING_MAX);
+    size_t padded = (1 + length + 3) & ~3U;
+    if(*size + padded > FURI_LOG_DEFERRED_RECORD_MAX) return false;
+    record[*size] = length;
+    memcpy(&record[*size + 1], string, length);
+    memset(&record[*size + 1 + length], 0, padded - 1 - length);
+    *size += padded;
+    return true;
+}
+
+/** Copy arguments as they are, the format is only scanned for their types.
+ * The decoder scans it the same way: 32-bit integers and pointers, 64-bit
+ * integers and doubles, %s as length and up to FURI_LOG_DEFERRED_STRING_MAX
+ * characters padded to 4 bytes.
+ */
+static bool
+    furi_log_deferred_encode(uint8_t* record, size_t* size, const char* format, va_list args) {
+    const char* cursor = format;
+    while((cursor = strchr(cursor, '%'))) {
+        cursor++;
+        while(*cursor && strchr("-+ #0", *cursor))
+            cursor++;
+        if(*cursor == '*') {
+            int width = va_arg(args, int);
+            if(!furi_log_deferred_put(record, size, &width, sizeof(width))) return false;
+            cursor++;
+        }
+        while(*cursor >= '0' && *cursor <= '9')
+            cursor++;
+        if(*cursor == '.') {
+            cursor++;
+            if(*cursor == '*') {
+                int precision = va_arg(args, int);
+                if(!furi_log_deferred_put(record, size, &precision, sizeof(precision)))
+                    return false;
+                cursor++;
+            }
+            while(*cursor >= '0' && *cursor <= '9')
+                cursor++;
+        }
+        bool wide = false;
+        while(*cursor && strchr("hlLjzt", *cursor)) {
+            if(*cursor == 'j' || (cursor[0] == 'l' && cursor[1] == 'l')) wide = true;
+            cursor++;
+        }
+
+        bool ok = true;
+        switch(*cursor) {
+        case 'd':
+        case 'i':
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X':
+        case 'c':
+            if(wide) {
+                uint64_t value = va_arg(args, uint64_t);
+                ok = furi_log_deferred_put(record, size, &value, sizeof(value));
+            } else {
+                uint32_t value = va_arg(args, uint32_t);
+                ok = furi_log_deferred_put(record, size, &value, sizeof(value));
+            }
+            break;
+        case 'p':
+        case 'n': {
+            uint32_t value = (uintptr_t)va_arg(args, void*);
+            ok = furi_log_deferred_put(record, size, &value, sizeof(value));
+        } break;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A': {
+            double value = va_arg(args, double);
+            ok = furi_log_deferred_put(record, size, &value, sizeof(value));
+        } break;
+        case 's':
+            ok = furi_log_deferred_put_string(record, size, va_arg(args, const char*));
+            break;
+        case '%':
+            break;
+        default:
+            // Unknown conversion, the decoder stops at it too
+            return true;
+        }
+        if(!ok) return false;
+        cursor++;
+    }
+    return true;
+}
+
+static uint8_t* furi_log_deferred_reserve(size_t size) {
+    uint32_t head = __atomic_load_n(&furi_log.deferred_head, __ATOMIC_RELAXED);
+    uint32_t offset, padding;
+
+    // Lock free, records may be reserved from threads and interrupts at the same time
+    do {
+        offset = head & (FURI_LOG_DEFERRED_RING_SIZE - 1);
+        padding = (offset + size > FURI_LOG_DEFERRED_RING_SIZE) ?
+                      FURI_LOG_DEFERRED_RING_SIZE - offset :
+                      0;
+        uint32_t tail = __atomic_load_n(&furi_log.deferred_tail, __ATOMIC_ACQUIRE);
+        if(head + padding + size - tail > FURI_LOG_DEFERRED_RING_SIZE) {
+            __atomic_fetch_add(&furi_log.deferred_dropped, 1, __ATOMIC_RELAXED);
+            return NULL;
+        }
+    } while(!__atomic_compare_exchange_n(
+        &furi_log.deferred_head,
+        &head,
+        head + padding + size,
+        true,
+        __ATOMIC_ACQ_REL,
+        __ATOMIC_RELAXED));
+
+    if(padding) {
+        // Records don't wrap, the rest of the ring is skipped. Only size and
+        // state of the header are written, the padding can be 4 bytes long.
+        FuriLogDeferredHeader* header =
+            (FuriLogDeferredHeader*)&furi_log.deferred_ring[offset];
+        header->size = padding;
+        header->level = FuriLogLevelDefault;
+        __atomic_store_n(&header->state, 1, __ATOMIC_RELEASE);
+        offset = 0;
+    }
+
+    return &furi_log.deferred_ring[offset];
+}
+
+static void furi_log_deferred_print(
+    FuriLogLevel level,
+    const char* tag,
+    const char* format,
+    va_list args) {
+    uint8_t record[FURI_LOG_DEFERRED_RECORD_MAX];
+    size_t size = sizeof(FuriLogDeferredHeader);
+    bool complete = furi_log_deferred_encode(record, &size, format, args);
+    size = (size + 3) & ~3U;
+
+    uint8_t* slot = furi_log_deferred_reserve(size);
+    if(!slot) return;
+
+    FuriLogDeferredHeader* header = (FuriLogDeferredHeader*)slot;
+    header->size = size;
+    header->level = level | (complete ? 0 : FURI_LOG_DEFERRED_TRUNCATED);
+    header->tick = furi_get_tick();
+    header->tag = tag;
+    header->format = format;
+    memcpy(
+        slot + sizeof(FuriLogDeferredHeader),
+        record + sizeof(FuriLogDeferredHeader),
+        size - sizeof(FuriLogDeferredHeader));
+    __atomic_store_n(&header->state, 1, __ATOMIC_RELEASE);
+
+    FuriThreadId thread_id = furi_log.deferred_thread_id;
+    if(thread_id) furi_thread_flags_set(thread_id, FURI_LOG_DEFERRED_FLAG_DATA);
+}
+
+static void furi_log_deferred_flush(void) {
+    uint8_t frame[sizeof(furi_log_deferred_magic) + FURI_LOG_DEFERRED_RECORD_MAX];
+    memcpy(frame, furi_log_deferred_magic, sizeof(furi_log_deferred_magic));
+
+    uint32_t tail = furi_log.deferred_tail;
+    while(tail != __atomic_load_n(&furi_log.deferred_head, __ATOMIC_ACQUIRE)) {
+        uint8_t* slot = &furi_log.deferred_ring[tail & (FURI_LOG_DEFERRED_RING_SIZE - 1)];
+        FuriLogDeferredHeader* header = (FuriLogDeferredHeader*)slot;
+        // Reserved, but not written yet
+        if(!__atomic_load_n(&header->state, __ATOMIC_ACQUIRE)) break;
+
+        size_t size = header->size;
+        if(header->level != FuriLogLevelDefault) {
+            memcpy(&frame[sizeof(furi_log_deferred_magic)], slot, size);
+            uint32_t dropped =
+                __atomic_exchange_n(&furi_log.deferred_dropped, 0, __ATOMIC_RELAXED);
+            ((FuriLogDeferredHeader*)&frame[sizeof(furi_log_deferred_magic)])->state =
+                MIN(dropped, UINT8_MAX);
+            furi_log_tx(frame, sizeof(furi_log_deferred_magic) + size);
+        }
+
+        // Next records start anywhere, no stale state byte may be left behind
+        memset(slot, 0, size);
+        tail += size;
+        __atomic_store_n(&furi_log.deferred_tail, tail, __ATOMIC_RELEASE);
+    }
+}
+
+static int32_t furi_log_deferred_thread(void* context) {
+    UNUSED(context);
+
+    while(true) {
+        uint32_t flags = furi_thread_flags_wait(
+            FURI_LOG_DEFERRED_FLAG_DATA | FURI_LOG_DEFERRED_FLAG_EXIT,
+            FuriFlagWaitAny,
+            FURI_LOG_DEFERRED_PERIOD_MS);
+        furi_log_deferred_flush();
+        if(!(flags & FuriFlagError) && (flags & FURI_LOG_DEFERRED_FLAG_EXIT)) break;
+    }
+
+    return 0;
+}
+
 void furi_log_print_format(FuriLogLevel level, const char* tag, const char* format, ...) {
     do {
         if(level > furi_log.log_level) {
             break;
         }
 
+        if(furi_log.deferred && furi_log_deferred_is_firmware(tag) &&
+           furi_log_deferred_is_firmware(format)) {
+            va_list args;
+            va_start(args, format);
+            furi_log_deferred_print(level, tag, format, args);
+            va_end(args);
+            break;
+        }
+
         if(furi_mutex_acquire(furi_log.mutex, furi_kernel_is_running() ? FuriWaitForever : 0) !=
            FuriStatusOk) {
             break;
@@ -197,6 +458,35 @@ FuriLogLevel furi_log_get_level(void) {
     return furi_log.log_level;
 }
 
+void furi_log_set_deferred(bool deferred) {
+    furi_check(!FURI_IS_ISR());
+
+    if(deferred && !furi_log.deferred_thread) {
+        // Kept after disabling, a record may still be written by an interrupt
+        if(!furi_log.deferred_ring) furi_log.deferred_ring = malloc(FURI_LOG_DEFERRED_RING_SIZE);
+
+        furi_log.deferred_thread = furi_thread_alloc_ex(
+            "LogDrain", FURI_LOG_DEFERRED_STACK_SIZE, furi_log_deferred_thread, NULL);
+        furi_thread_set_priority(furi_log.deferred_thread, FuriThreadPriorityLowest);
+        furi_thread_start(furi_log.deferred_thread);
+        furi_log.deferred_thread_id = furi_thread_get_id(furi_log.deferred_thread);
+        furi_log.deferred = true;
+    } else if(!deferred && furi_log.deferred_thread) {
+        furi_log.deferred = false;
+        furi_log.deferred_thread_id = NULL;
+        // Records already in the ring are sent before the thread exits
+        FuriThread* thread = furi_log.deferred_thread;
+        furi_thread_flags_set(furi_thread_get_id(thread), FURI_LOG_DEFERRED_FLAG_EXIT);
+        furi_thread_join(thread);
+        furi_log.deferred_thread = NULL;
+        furi_thread_free(thread);
+    }
+}
+
+bool furi_log_is_deferred(void) {
+    return furi_log.deferred;
+}
+
 bool furi_log_level_to_string(FuriLogLevel level, const char** str) {
     for(size_t i = 0; i < COUNT_OF(FURI_LOG_LEVEL_DESCRIPTIONS); i++) {
         if(level == FURI_LOG_LEVEL_DESCRIPTIONS[i].level) {
@@ -109,6 +109,25 @@ void furi_log_set_level(FuriLogLevel level);
  */
 FuriLogLevel furi_log_get_level(void);
 
+/** Enable or disable deferred logging
+ *
+ * Log records with tag and format in the firmware image are not formatted,
+ * their arguments are stored raw in a ring buffer and sent to the handlers as
+ * binary frames by a low priority thread. Use scripts/logdecode.py with the
+ * firmware ELF to print them. Other records are printed as usual.
+ *
+ * @warning    do not call from multiple threads at once
+ *
+ * @param[in]  deferred  true to enable
+ */
+void furi_log_set_deferred(bool deferred);
+
+/** Check if deferred logging is enabled
+ *
+ * @return     true if enabled
+ */
+bool furi_log_is_deferred(void);
+
 /** Log level to string
  *
  * @param[in]  level  The level
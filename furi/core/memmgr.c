@@ -2,14 +2,17 @@
 #include <string.h>
 #include <furi_hal_memory.h>
 
-extern void* pvPortMalloc(size_t xSize);
+extern void* memmgr_heap_malloc_from(size_t size, void* caller);
 extern void vPortFree(void* pv);
 extern size_t xPortGetFreeHeapSize(void);
 extern size_t xPortGetTotalHeapSize(void);
 extern size_t xPortGetMinimumEverFreeHeapSize(void);
 
+// Allocation trace attributes blocks to the caller of these wrappers
+#define MEMMGR_CALLER __builtin_return_address(0)
+
 void* malloc(size_t size) {
-    return pvPortMalloc(size);
+    return memmgr_heap_malloc_from(size, MEMMGR_CALLER);
 }
 
 void free(void* ptr) {
@@ -22,7 +25,7 @@ void* realloc(void* ptr, size_t size) {
         return NULL;
     }
 
-    void* p = pvPortMalloc(size);
+    void* p = memmgr_heap_malloc_from(size, MEMMGR_CALLER);
     if(ptr != NULL) {
         memcpy(p, ptr, size);
         vPortFree(ptr);
@@ -32,7 +35,7 @@ void* realloc(void* ptr, size_t size) {
 }
 
 void* calloc(size_t count, size_t size) {
-    return pvPortMalloc(count * size);
+    return memmgr_heap_malloc_from(count * size, MEMMGR_CALLER);
 }
 
 char* strdup(const char* s) {
@@ -40,7 +43,7 @@ char* strdup(const char* s) {
     furi_check(((uint32_t)s << 2) != 0);
 
     size_t siz = strlen(s) + 1;
-    char* y = pvPortMalloc(siz);
+    char* y = memmgr_heap_malloc_from(siz, MEMMGR_CALLER);
     memcpy(y, s, siz);
 
     return y;
@@ -60,7 +63,7 @@ size_t memmgr_get_minimum_free_heap(void) {
 
 void* __wrap__malloc_r(struct _reent* r, size_t size) {
     UNUSED(r);
-    return pvPortMalloc(size);
+    return memmgr_heap_malloc_from(size, MEMMGR_CALLER);
 }
 
 void __wrap__free_r(struct _reent* r, void* ptr) {
@@ -70,7 +73,7 @@ void __wrap__free_r(struct _reent* r, void* ptr) {
 
 void* __wrap__calloc_r(struct _reent* r, size_t count, size_t size) {
     UNUSED(r);
-    return calloc(count, size);
+    return memmgr_heap_malloc_from(count * size, MEMMGR_CALLER);
 }
 
 void* __wrap__realloc_r(struct _reent* r, void* ptr, size_t size) {
@@ -80,7 +83,7 @@ void* __wrap__realloc_r(struct _reent* r, void* ptr, size_t size) {
 
 void* memmgr_alloc_from_pool(size_t size) {
     void* p = furi_hal_memory_alloc(size);
-    if(p == NULL) p = malloc(size);
+    if(p == NULL) p = memmgr_heap_malloc_from(size, MEMMGR_CALLER);
 
     return p;
 }
@@ -97,7 +100,7 @@ void* aligned_malloc(size_t size, size_t alignment) {
     void* p1; // original block
     void** p2; // aligned block
     int offset = alignment - 1 + sizeof(void*);
-    if((p1 = (void*)malloc(size + offset)) == NULL) {
+    if((p1 = memmgr_heap_malloc_from(size + offset, MEMMGR_CALLER)) == NULL) {
         return NULL;
     }
     p2 = (void**)(((size_t)(p1) + offset) & ~(alignment - 1));
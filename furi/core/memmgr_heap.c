@@ -38,6 +38,7 @@
 #include "check.h"
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <stm32wbxx.h>
 #include <stm32wb55_linker.h>
 #include <core/log.h>
@@ -63,6 +64,10 @@ task.h is included from an application file. */
 /* Assumes 8bit bytes! */
 #define heapBITS_PER_BYTE ((size_t)8)
 
+/* Set in the size of blocks that belong to a small block pool, see
+memmgr_heap_pool_alloc. */
+#define heapPOOL_BIT ((size_t)1 << ((sizeof(size_t) * heapBITS_PER_BYTE) - 2))
+
 /* Heap start end symbols provided by linker */
 uint8_t* ucHeap = (uint8_t*)&__heap_start__;
 
@@ -89,6 +94,18 @@ static void prvInsertBlockIntoFreeList(BlockLink_t* pxBlockToInsert);
  */
 static void prvHeapInit(void);
 
+/*
+ * Take a block of at least xWantedSize bytes from the free list, returns NULL
+ * if there is none. Must be called with the scheduler suspended.
+ */
+static void* prvHeapAllocate(size_t xWantedSize);
+
+/*
+ * Return an allocated block to the free list. Must be called with the
+ * scheduler suspended.
+ */
+static void prvHeapFree(BlockLink_t* pxLink);
+
 /*-----------------------------------------------------------*/
 
 /* The size of the structure placed at the beginning of each allocated memory
@@ -176,7 +193,8 @@ size_t memmgr_heap_get_thread_memory(FuriThreadId thread_id) {
                     BlockLink_t* pxLink = (void*)puc;
 
                     if((pxLink->xBlockSize & xBlockAllocatedBit) != 0 &&
-                       pxLink->pxNextFreeBlock == NULL) {
+                       (pxLink->pxNextFreeBlock == NULL ||
+                        (pxLink->xBlockSize & heapPOOL_BIT) != 0)) {
                         leftovers += data->value;
                     }
                 }
@@ -219,6 +237,407 @@ static inline void traceFREE(void* pointer, size_t size) {
     }
 }
 
+/* Allocation trace
+ *
+ * Live blocks are recorded in an open addressing table keyed by the block
+ * pointer, together with the address malloc returns to and the requested
+ * size. The table is taken from the heap when tracing starts and is only
+ * touched with the scheduler suspended, so a stopped trace costs one pointer
+ * check per malloc and free.
+ */
+typedef struct {
+    MemmgrHeapTraceRecord* records;
+    uint32_t mask;
+    uint32_t shift;
+    size_t count;
+    size_t lost;
+} MemmgrHeapTrace;
+
+static MemmgrHeapTrace* memmgr_heap_trace = NULL;
+
+/* Free memory left to the traced code after the table is allocated */
+#define MEMMGR_HEAP_TRACE_HEADROOM (8 * 1024)
+
+static inline uint32_t memmgr_heap_trace_slot(const MemmgrHeapTrace* trace, const void* pointer) {
+    // Blocks are 8 byte aligned, Fibonacci hashing spreads the remaining bits
+    return (uint32_t)(((uintptr_t)pointer >> 3) * 2654435761U) >> trace->shift;
+}
+
+static void
+    memmgr_heap_trace_add(MemmgrHeapTrace* trace, void* pointer, size_t size, void* caller) {
+    // Keep a quarter of the slots empty so probes stay short
+    const size_t slots = trace->mask + 1;
+    if(trace->count >= slots - slots / 4) {
+        trace->lost++;
+        return;
+    }
+
+    uint32_t slot = memmgr_heap_trace_slot(trace, pointer);
+    while(trace->records[slot].pointer) {
+        slot = (slot + 1) & trace->mask;
+    }
+
+    trace->records[slot].pointer = pointer;
+    trace->records[slot].caller = caller;
+    trace->records[slot].size = size;
+    trace->count++;
+}
+
+static void memmgr_heap_trace_remove(MemmgrHeapTrace* trace, void* pointer) {
+    uint32_t slot = memmgr_heap_trace_slot(trace, pointer);
+    while(trace->records[slot].pointer != pointer) {
+        // Allocated before the trace started or not recorded
+        if(!trace->records[slot].pointer) return;
+        slot = (slot + 1) & trace->mask;
+    }
+
+    // Shift the rest of the probe run back instead of leaving tombstones
+    uint32_t hole = slot;
+    for(uint32_t next = (slot + 1) & trace->mask; trace->records[next].pointer;
+        next = (next + 1) & trace->mask) {
+        const uint32_t home = memmgr_heap_trace_slot(trace, trace->records[next].pointer);
+        if(((next - home) & trace->mask) >= ((next - hole) & trace->mask)) {
+            trace->records[hole] = trace->records[next];
+            hole = next;
+        }
+    }
+
+    trace->records[hole].pointer = NULL;
+    trace->count--;
+}
+
+bool memmgr_heap_trace_start(size_t capacity) {
+    furi_check(capacity > 0 && capacity <= UINT16_MAX);
+
+    uint32_t bits = 2;
+    while(((size_t)1 << bits) < capacity + capacity / 3) {
+        bits++;
+    }
+
+    const size_t records_size = sizeof(MemmgrHeapTraceRecord) << bits;
+
+    bool started = false;
+    vTaskSuspendAll();
+    {
+        // Failed malloc crashes, check the heap first, nothing else allocates meanwhile
+        const size_t free_block = memmgr_heap_get_max_free_block();
+        if(!memmgr_heap_trace && free_block >= records_size + MEMMGR_HEAP_TRACE_HEADROOM) {
+            MemmgrHeapTrace* trace = malloc(sizeof(MemmgrHeapTrace));
+            trace->records = malloc(records_size);
+            trace->mask = (1U << bits) - 1;
+            trace->shift = 32 - bits;
+            memmgr_heap_trace = trace;
+            started = true;
+        }
+    }
+    (void)xTaskResumeAll();
+
+    return started;
+}
+
+void memmgr_heap_trace_stop(void) {
+    MemmgrHeapTrace* trace;
+
+    vTaskSuspendAll();
+    {
+        trace = memmgr_heap_trace;
+        memmgr_heap_trace = NULL;
+    }
+    (void)xTaskResumeAll();
+
+    if(trace) {
+        free(trace->records);
+        free(trace);
+    }
+}
+
+bool memmgr_heap_trace_is_running(void) {
+    return memmgr_heap_trace != NULL;
+}
+
+size_t memmgr_heap_trace_get_records(MemmgrHeapTraceRecord* records, size_t count, size_t* lost) {
+    furi_check(records || !count);
+
+    size_t live = 0;
+    vTaskSuspendAll();
+    {
+        MemmgrHeapTrace* trace = memmgr_heap_trace;
+        if(trace) {
+            live = trace->count;
+            if(lost) *lost = trace->lost;
+
+            size_t copied = 0;
+            for(uint32_t slot = 0; slot <= trace->mask && copied < count; slot++) {
+                if(trace->records[slot].pointer) {
+                    records[copied++] = trace->records[slot];
+                }
+            }
+        } else if(lost) {
+            *lost = 0;
+        }
+    }
+    (void)xTaskResumeAll();
+
+    return live;
+}
+
+/* Small block pools
+ *
+ * Requests up to MEMMGR_HEAP_POOL_MAX_SIZE bytes are rounded up to a size
+ * class and served from slabs: heap blocks cut into equal slots. A slot
+ * starts with a BlockLink_t like any heap block, with heapPOOL_BIT set in the
+ * size and pxNextFreeBlock pointing to its slab while allocated. Allocation
+ * and free are O(1) and small objects stop splitting the free list.
+ */
+#define MEMMGR_HEAP_POOL_MAX_SIZE  128
+/* Slots per slab are chosen to fill about this many bytes */
+#define MEMMGR_HEAP_SLAB_SIZE      512
+#define MEMMGR_HEAP_SLAB_MIN_SLOTS 4
+
+static const uint8_t memmgr_heap_pool_sizes[MEMMGR_HEAP_POOL_COUNT] = {16, 32, 48, 64, 96, 128};
+
+typedef struct MemmgrHeapSlab {
+    struct MemmgrHeapSlab* next; /* Slabs of the same pool with free slots */
+    struct MemmgrHeapSlab* prev;
+    BlockLink_t* free_slots;
+    uint16_t used;
+    uint16_t total;
+    uint8_t pool;
+} MemmgrHeapSlab;
+
+typedef struct {
+    MemmgrHeapSlab* partial; /* Slabs with at least one free slot */
+    size_t slabs;
+    size_t used;
+    size_t total;
+} MemmgrHeapPool;
+
+static const size_t memmgr_heap_slab_header_size =
+    (sizeof(MemmgrHeapSlab) + ((size_t)(portBYTE_ALIGNMENT - 1))) &
+    ~((size_t)portBYTE_ALIGNMENT_MASK);
+
+static MemmgrHeapPool memmgr_heap_pools[MEMMGR_HEAP_POOL_COUNT] = {0};
+
+/* Latency of allocator calls, measured with the scheduler suspended */
+static struct {
+    MemmgrHeapLatency heap_malloc;
+    MemmgrHeapLatency heap_free;
+    MemmgrHeapLatency pool_malloc;
+    MemmgrHeapLatency pool_free;
+} memmgr_heap_stats = {0};
+
+static inline void memmgr_heap_latency_add(MemmgrHeapLatency* latency, uint32_t start) {
+    const uint32_t cycles = DWT->CYCCNT - start;
+    latency->count++;
+    latency->total += cycles;
+    if(cycles > latency->max) latency->max = cycles;
+}
+
+static inline size_t memmgr_heap_block_size(void* pointer) {
+    BlockLink_t* pxLink = (void*)((uint8_t*)pointer - xHeapStructSize);
+    return pxLink->xBlockSize & ~(xBlockAllocatedBit | heapPOOL_BIT);
+}
+
+static void memmgr_heap_slab_unlink(MemmgrHeapPool* pool, MemmgrHeapSlab* slab) {
+    if(slab->prev) {
+        slab->prev->next = slab->next;
+    } else {
+        pool->partial = slab->next;
+    }
+    if(slab->next) slab->next->prev = slab->prev;
+    slab->next = NULL;
+    slab->prev = NULL;
+}
+
+static void* memmgr_heap_pool_alloc(size_t size) {
+    size_t index = 0;
+    while(memmgr_heap_pool_sizes[index] < size) {
+        index++;
+    }
+
+    MemmgrHeapPool* pool = &memmgr_heap_pools[index];
+    const size_t slot_size = xHeapStructSize + memmgr_heap_pool_sizes[index];
+
+    MemmgrHeapSlab* slab = pool->partial;
+    if(!slab) {
+        const size_t slots = MAX(MEMMGR_HEAP_SLAB_SIZE / slot_size, MEMMGR_HEAP_SLAB_MIN_SLOTS);
+        slab = prvHeapAllocate(memmgr_heap_slab_header_size + slots * slot_size);
+        if(!slab) return NULL;
+
+        slab->next = NULL;
+        slab->prev = NULL;
+        slab->free_slots = NULL;
+        slab->used = 0;
+        slab->total = slots;
+        slab->pool = index;
+
+        uint8_t* slots_start = (uint8_t*)slab + memmgr_heap_slab_header_size;
+        for(size_t i = slots; i-- > 0;) {
+            BlockLink_t* pxSlot = (void*)(slots_start + i * slot_size);
+            pxSlot->xBlockSize = heapPOOL_BIT | slot_size;
+            pxSlot->pxNextFreeBlock = slab->free_slots;
+            slab->free_slots = pxSlot;
+        }
+
+        pool->partial = slab;
+        pool->slabs++;
+        pool->total += slots;
+    }
+
+    BlockLink_t* pxSlot = slab->free_slots;
+    slab->free_slots = pxSlot->pxNextFreeBlock;
+    pxSlot->pxNextFreeBlock = (void*)slab;
+    pxSlot->xBlockSize |= xBlockAllocatedBit;
+
+    slab->used++;
+    pool->used++;
+    if(slab->used == slab->total) {
+        memmgr_heap_slab_unlink(pool, slab);
+    }
+
+    return (uint8_t*)pxSlot + xHeapStructSize;
+}
+
+static void memmgr_heap_pool_free(BlockLink_t* pxSlot) {
+    MemmgrHeapSlab* slab = (void*)pxSlot->pxNextFreeBlock;
+    MemmgrHeapPool* pool = &memmgr_heap_pools[slab->pool];
+
+    pxSlot->xBlockSize &= ~xBlockAllocatedBit;
+    pxSlot->pxNextFreeBlock = slab->free_slots;
+    slab->free_slots = pxSlot;
+
+    if(slab->used == slab->total) {
+        slab->next = pool->partial;
+        if(pool->partial) pool->partial->prev = slab;
+        pool->partial = slab;
+    }
+
+    slab->used--;
+    pool->used--;
+
+    // Keep the last slab with free slots to avoid heap calls on churn
+    if(slab->used == 0 && (slab->prev || slab->next)) {
+        memmgr_heap_slab_unlink(pool, slab);
+        pool->slabs--;
+        pool->total -= slab->total;
+        prvHeapFree((void*)((uint8_t*)slab - xHeapStructSize));
+    }
+}
+
+void memmgr_heap_get_stats(MemmgrHeapStats* stats) {
+    furi_check(stats);
+    memset(stats, 0, sizeof(MemmgrHeapStats));
+
+    vTaskSuspendAll();
+    {
+        if(pxEnd != NULL) {
+            for(BlockLink_t* pxBlock = xStart.pxNextFreeBlock; pxBlock != pxEnd;
+                pxBlock = pxBlock->pxNextFreeBlock) {
+                stats->free_blocks++;
+                if(pxBlock->xBlockSize > stats->max_free_block) {
+                    stats->max_free_block = pxBlock->xBlockSize;
+                }
+            }
+        }
+        stats->free_bytes = xFreeBytesRemaining;
+
+        for(size_t i = 0; i < MEMMGR_HEAP_POOL_COUNT; i++) {
+            stats->pools[i].block_size = memmgr_heap_pool_sizes[i];
+            stats->pools[i].slabs = memmgr_heap_pools[i].slabs;
+            stats->pools[i].used = memmgr_heap_pools[i].used;
+            stats->pools[i].total = memmgr_heap_pools[i].total;
+        }
+
+        stats->heap_malloc = memmgr_heap_stats.heap_malloc;
+        stats->heap_free = memmgr_heap_stats.heap_free;
+        stats->pool_malloc = memmgr_heap_stats.pool_malloc;
+        stats->pool_free = memmgr_heap_stats.pool_free;
+    }
+    (void)xTaskResumeAll();
+
+    if(stats->free_bytes) {
+        stats->fragmentation =
+            100 - (uint8_t)((uint64_t)stats->max_free_block * 100 / stats->free_bytes);
+    }
+}
+
+void memmgr_heap_reset_latency(void) {
+    vTaskSuspendAll();
+    memset(&memmgr_heap_stats, 0, sizeof(memmgr_heap_stats));
+    (void)xTaskResumeAll();
+}
+
+/* Arenas */
+
+typedef struct MemmgrHeapArenaChunk {
+    struct MemmgrHeapArenaChunk* next;
+    size_t size;
+    size_t used;
+    uint8_t data[] __attribute__((aligned(portBYTE_ALIGNMENT)));
+} MemmgrHeapArenaChunk;
+
+struct MemmgrHeapArena {
+    MemmgrHeapArenaChunk* chunks; /* Chunk being filled first */
+    size_t chunk_size;
+    size_t used;
+};
+
+MemmgrHeapArena* memmgr_heap_arena_alloc(size_t chunk_size) {
+    furi_check(chunk_size > 0);
+
+    MemmgrHeapArena* arena = malloc(sizeof(MemmgrHeapArena));
+    arena->chunk_size = chunk_size;
+
+    return arena;
+}
+
+void memmgr_heap_arena_free(MemmgrHeapArena* arena) {
+    furi_check(arena);
+
+    while(arena->chunks) {
+        MemmgrHeapArenaChunk* chunk = arena->chunks;
+        arena->chunks = chunk->next;
+        free(chunk);
+    }
+
+    free(arena);
+}
+
+void* memmgr_heap_arena_malloc(MemmgrHeapArena* arena, size_t size) {
+    furi_check(arena);
+    furi_check(size > 0, "malloc(0)");
+
+    size = (size + portBYTE_ALIGNMENT_MASK) & ~((size_t)portBYTE_ALIGNMENT_MASK);
+
+    MemmgrHeapArenaChunk* chunk = arena->chunks;
+    if(!chunk || (chunk->size - chunk->used) < size) {
+        const size_t chunk_size = MAX(size, arena->chunk_size);
+        chunk = malloc(sizeof(MemmgrHeapArenaChunk) + chunk_size);
+        chunk->size = chunk_size;
+
+        if(size >= arena->chunk_size && arena->chunks) {
+            // Oversized chunk is full right away, keep filling the current one
+            chunk->next = arena->chunks->next;
+            arena->chunks->next = chunk;
+        } else {
+            chunk->next = arena->chunks;
+            arena->chunks = chunk;
+        }
+    }
+
+    void* pointer = &chunk->data[chunk->used];
+    chunk->used += size;
+    arena->used += size;
+
+    // Chunks are zeroed by malloc and never reused
+    return pointer;
+}
+
+size_t memmgr_heap_arena_get_used(MemmgrHeapArena* arena) {
+    furi_check(arena);
+    return arena->used;
+}
+
 size_t memmgr_heap_get_max_free_block(void) {
     size_t max_free_size = 0;
     BlockLink_t* pxBlock;
@@ -336,19 +755,121 @@ static void print_heap_free(void* ptr) {
 #endif
 /*-----------------------------------------------------------*/
 
-void* pvPortMalloc(size_t xWantedSize) {
+static void* prvHeapAllocate(size_t xWantedSize) {
     BlockLink_t *pxBlock, *pxPreviousBlock, *pxNewBlockLink;
     void* pvReturn = NULL;
+
+    /* Check the requested block size is not so large that the top bit is
+    set.  The top bit of the block size member of the BlockLink_t structure
+    is used to determine who owns the block - the application or the
+    kernel, so it must be free. */
+    if((xWantedSize & (xBlockAllocatedBit | heapPOOL_BIT)) == 0) {
+        /* The wanted size is increased so it can contain a BlockLink_t
+        structure in addition to the requested amount of bytes. */
+        if(xWantedSize > 0) {
+            xWantedSize += xHeapStructSize;
+
+            /* Ensure that blocks are always aligned to the required number
+            of bytes. */
+            if((xWantedSize & portBYTE_ALIGNMENT_MASK) != 0x00) {
+                /* Byte alignment required. */
+                xWantedSize += (portBYTE_ALIGNMENT - (xWantedSize & portBYTE_ALIGNMENT_MASK));
+                configASSERT((xWantedSize & portBYTE_ALIGNMENT_MASK) == 0);
+            } else {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        } else {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if((xWantedSize > 0) && (xWantedSize <= xFreeBytesRemaining)) {
+            /* Traverse the list from the start (lowest address) block until
+            one of adequate size is found. */
+            pxPreviousBlock = &xStart;
+            pxBlock = xStart.pxNextFreeBlock;
+            while((pxBlock->xBlockSize < xWantedSize) && (pxBlock->pxNextFreeBlock != NULL)) {
+                pxPreviousBlock = pxBlock;
+                pxBlock = pxBlock->pxNextFreeBlock;
+            }
+
+            /* If the end marker was reached then a block of adequate size
+            was not found. */
+            if(pxBlock != pxEnd) {
+                /* Return the memory space pointed to - jumping over the
+                BlockLink_t structure at its start. */
+                pvReturn = (void*)(((uint8_t*)pxPreviousBlock->pxNextFreeBlock) + xHeapStructSize);
+
+                /* This block is being returned for use so must be taken out
+                of the list of free blocks. */
+                pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+
+                /* If the block is larger than required it can be split into
+                two. */
+                if((pxBlock->xBlockSize - xWantedSize) > heapMINIMUM_BLOCK_SIZE) {
+                    /* This block is to be split into two.  Create a new
+                    block following the number of bytes requested. The void
+                    cast is used to prevent byte alignment warnings from the
+                    compiler. */
+                    pxNewBlockLink = (void*)(((uint8_t*)pxBlock) + xWantedSize);
+                    configASSERT((((size_t)pxNewBlockLink) & portBYTE_ALIGNMENT_MASK) == 0);
+
+                    /* Calculate the sizes of two blocks split from the
+                    single block. */
+                    pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+                    pxBlock->xBlockSize = xWantedSize;
+
+                    /* Insert the new block into the list of free blocks. */
+                    prvInsertBlockIntoFreeList(pxNewBlockLink);
+                } else {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+                if(xFreeBytesRemaining < xMinimumEverFreeBytesRemaining) {
+                    xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                } else {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* The block is being returned - it is allocated and owned
+                by the application and has no "next" block. */
+                pxBlock->xBlockSize |= xBlockAllocatedBit;
+                pxBlock->pxNextFreeBlock = NULL;
+            } else {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        } else {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    } else {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapFree(BlockLink_t* pxLink) {
+    /* The block is being returned to the heap - it is no longer
+    allocated. */
+    pxLink->xBlockSize &= ~xBlockAllocatedBit;
+
+    /* Add this block to the list of free blocks. */
+    xFreeBytesRemaining += pxLink->xBlockSize;
+    memset((uint8_t*)pxLink + xHeapStructSize, 0, pxLink->xBlockSize - xHeapStructSize);
+    prvInsertBlockIntoFreeList(pxLink);
+}
+/*-----------------------------------------------------------*/
+
+void* memmgr_heap_malloc_from(size_t xWantedSize, void* caller) {
+    void* pvReturn = NULL;
     size_t to_wipe = xWantedSize;
 
     if(FURI_IS_IRQ_MODE()) {
         furi_crash("memmgt in ISR");
     }
 
-#ifdef HEAP_PRINT_DEBUG
-    BlockLink_t* print_heap_block = NULL;
-#endif
-
     /* If this is the first call to malloc then the heap will require
         initialisation to setup the list of free blocks. */
     if(pxEnd == NULL) {
@@ -368,104 +889,33 @@ void* pvPortMalloc(size_t xWantedSize) {
 
     vTaskSuspendAll();
     {
-        /* Check the requested block size is not so large that the top bit is
-        set.  The top bit of the block size member of the BlockLink_t structure
-        is used to determine who owns the block - the application or the
-        kernel, so it must be free. */
-        if((xWantedSize & xBlockAllocatedBit) == 0) {
-            /* The wanted size is increased so it can contain a BlockLink_t
-            structure in addition to the requested amount of bytes. */
-            if(xWantedSize > 0) {
-                xWantedSize += xHeapStructSize;
-
-                /* Ensure that blocks are always aligned to the required number
-                of bytes. */
-                if((xWantedSize & portBYTE_ALIGNMENT_MASK) != 0x00) {
-                    /* Byte alignment required. */
-                    xWantedSize += (portBYTE_ALIGNMENT - (xWantedSize & portBYTE_ALIGNMENT_MASK));
-                    configASSERT((xWantedSize & portBYTE_ALIGNMENT_MASK) == 0);
-                } else {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-            } else {
-                mtCOVERAGE_TEST_MARKER();
-            }
-
-            if((xWantedSize > 0) && (xWantedSize <= xFreeBytesRemaining)) {
-                /* Traverse the list from the start (lowest address) block until
-                one of adequate size is found. */
-                pxPreviousBlock = &xStart;
-                pxBlock = xStart.pxNextFreeBlock;
-                while((pxBlock->xBlockSize < xWantedSize) && (pxBlock->pxNextFreeBlock != NULL)) {
-                    pxPreviousBlock = pxBlock;
-                    pxBlock = pxBlock->pxNextFreeBlock;
-                }
+        const uint32_t start = DWT->CYCCNT;
+        size_t traced_size = 0;
 
-                /* If the end marker was reached then a block of adequate size
-                was not found. */
-                if(pxBlock != pxEnd) {
-                    /* Return the memory space pointed to - jumping over the
-                    BlockLink_t structure at its start. */
-                    pvReturn =
-                        (void*)(((uint8_t*)pxPreviousBlock->pxNextFreeBlock) + xHeapStructSize);
-
-                    /* This block is being returned for use so must be taken out
-                    of the list of free blocks. */
-                    pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
-
-                    /* If the block is larger than required it can be split into
-                    two. */
-                    if((pxBlock->xBlockSize - xWantedSize) > heapMINIMUM_BLOCK_SIZE) {
-                        /* This block is to be split into two.  Create a new
-                        block following the number of bytes requested. The void
-                        cast is used to prevent byte alignment warnings from the
-                        compiler. */
-                        pxNewBlockLink = (void*)(((uint8_t*)pxBlock) + xWantedSize);
-                        configASSERT((((size_t)pxNewBlockLink) & portBYTE_ALIGNMENT_MASK) == 0);
-
-                        /* Calculate the sizes of two blocks split from the
-                        single block. */
-                        pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
-                        pxBlock->xBlockSize = xWantedSize;
-
-                        /* Insert the new block into the list of free blocks. */
-                        prvInsertBlockIntoFreeList(pxNewBlockLink);
-                    } else {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-
-                    xFreeBytesRemaining -= pxBlock->xBlockSize;
-
-                    if(xFreeBytesRemaining < xMinimumEverFreeBytesRemaining) {
-                        xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
-                    } else {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-
-                    /* The block is being returned - it is allocated and owned
-                    by the application and has no "next" block. */
-                    pxBlock->xBlockSize |= xBlockAllocatedBit;
-                    pxBlock->pxNextFreeBlock = NULL;
+        /* Small blocks come from size class pools, the free list is only
+        used when a pool can not get a new slab. */
+        if(xWantedSize > 0 && xWantedSize <= MEMMGR_HEAP_POOL_MAX_SIZE) {
+            pvReturn = memmgr_heap_pool_alloc(xWantedSize);
+        }
 
-#ifdef HEAP_PRINT_DEBUG
-                    print_heap_block = pxBlock;
-#endif
-                } else {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-            } else {
-                mtCOVERAGE_TEST_MARKER();
-            }
+        if(pvReturn) {
+            traced_size = memmgr_heap_block_size(pvReturn);
+            memmgr_heap_latency_add(&memmgr_heap_stats.pool_malloc, start);
         } else {
-            mtCOVERAGE_TEST_MARKER();
+            pvReturn = prvHeapAllocate(xWantedSize);
+            if(pvReturn) traced_size = memmgr_heap_block_size(pvReturn);
+            memmgr_heap_latency_add(&memmgr_heap_stats.heap_malloc, start);
         }
 
-        traceMALLOC(pvReturn, xWantedSize);
+        traceMALLOC(pvReturn, traced_size);
+        if(memmgr_heap_trace && pvReturn) {
+            memmgr_heap_trace_add(memmgr_heap_trace, pvReturn, xWantedSize, caller);
+        }
     }
     (void)xTaskResumeAll();
 
 #ifdef HEAP_PRINT_DEBUG
-    print_heap_malloc(print_heap_block, print_heap_block->xBlockSize & ~xBlockAllocatedBit);
+    print_heap_malloc(pvReturn, memmgr_heap_block_size(pvReturn));
 #endif
 
 #if(configUSE_MALLOC_FAILED_HOOK == 1)
@@ -487,6 +937,11 @@ void* pvPortMalloc(size_t xWantedSize) {
 }
 /*-----------------------------------------------------------*/
 
+void* pvPortMalloc(size_t xWantedSize) {
+    return memmgr_heap_malloc_from(xWantedSize, __builtin_return_address(0));
+}
+/*-----------------------------------------------------------*/
+
 void vPortFree(void* pv) {
     uint8_t* puc = (uint8_t*)pv;
     BlockLink_t* pxLink;
@@ -505,30 +960,39 @@ void vPortFree(void* pv) {
 
         /* Check the block is actually allocated. */
         configASSERT((pxLink->xBlockSize & xBlockAllocatedBit) != 0);
-        configASSERT(pxLink->pxNextFreeBlock == NULL);
+        configASSERT(
+            (pxLink->pxNextFreeBlock == NULL) || ((pxLink->xBlockSize & heapPOOL_BIT) != 0));
 
         if((pxLink->xBlockSize & xBlockAllocatedBit) != 0) {
-            if(pxLink->pxNextFreeBlock == NULL) {
-                /* The block is being returned to the heap - it is no longer
-                allocated. */
-                pxLink->xBlockSize &= ~xBlockAllocatedBit;
-
 #ifdef HEAP_PRINT_DEBUG
-                print_heap_free(pxLink);
+            print_heap_free(pxLink);
 #endif
 
+            if((pxLink->xBlockSize & heapPOOL_BIT) != 0) {
+                vTaskSuspendAll();
+                {
+                    const uint32_t start = DWT->CYCCNT;
+                    traceFREE(pv, memmgr_heap_block_size(pv));
+                    if(memmgr_heap_trace) memmgr_heap_trace_remove(memmgr_heap_trace, pv);
+                    memmgr_heap_pool_free(pxLink);
+                    memmgr_heap_latency_add(&memmgr_heap_stats.pool_free, start);
+                }
+                (void)xTaskResumeAll();
+            } else if(pxLink->pxNextFreeBlock == NULL) {
                 vTaskSuspendAll();
                 {
+                    const uint32_t start = DWT->CYCCNT;
                     furi_assert((size_t)pv >= SRAM_BASE);
                     furi_assert((size_t)pv < SRAM_BASE + 1024 * 256);
-                    furi_assert(pxLink->xBlockSize >= xHeapStructSize);
-                    furi_assert((pxLink->xBlockSize - xHeapStructSize) < 1024 * 256);
-
-                    /* Add this block to the list of free blocks. */
-                    xFreeBytesRemaining += pxLink->xBlockSize;
-                    traceFREE(pv, pxLink->xBlockSize);
-                    memset(pv, 0, pxLink->xBlockSize - xHeapStructSize);
-                    prvInsertBlockIntoFreeList((BlockLink_t*)pxLink);
+                    furi_assert((pxLink->xBlockSize & ~xBlockAllocatedBit) >= xHeapStructSize);
+                    furi_assert(
+                        ((pxLink->xBlockSize & ~xBlockAllocatedBit) - xHeapStructSize) <
+                        1024 * 256);
+
+                    traceFREE(pv, memmgr_heap_block_size(pv));
+                    if(memmgr_heap_trace) memmgr_heap_trace_remove(memmgr_heap_trace, pv);
+                    prvHeapFree(pxLink);
+                    memmgr_heap_latency_add(&memmgr_heap_stats.heap_free, start);
                 }
                 (void)xTaskResumeAll();
             } else {
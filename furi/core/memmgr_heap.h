@@ -14,6 +14,47 @@ extern "C" {
 
 #define MEMMGR_HEAP_UNKNOWN 0xFFFFFFFF
 
+/** Number of small block size classes, up to 128 bytes */
+#define MEMMGR_HEAP_POOL_COUNT 6
+
+/** Small block pool statistics */
+typedef struct {
+    size_t block_size; /**< Largest request served by the pool */
+    size_t slabs; /**< Heap blocks cut into pool slots */
+    size_t used; /**< Slots in use */
+    size_t total; /**< Slots in all slabs */
+} MemmgrHeapPoolStats;
+
+/** Allocator call latency, in CPU cycles */
+typedef struct {
+    uint32_t count;
+    uint32_t max;
+    uint64_t total;
+} MemmgrHeapLatency;
+
+/** Heap statistics */
+typedef struct {
+    size_t free_bytes; /**< Free heap, free pool slots not included */
+    size_t free_blocks; /**< Number of free heap blocks */
+    size_t max_free_block; /**< Largest free heap block */
+    uint8_t fragmentation; /**< Percent of free heap outside of the largest free block */
+    MemmgrHeapPoolStats pools[MEMMGR_HEAP_POOL_COUNT];
+    MemmgrHeapLatency heap_malloc; /**< malloc served by the free list */
+    MemmgrHeapLatency heap_free; /**< free of free list blocks */
+    MemmgrHeapLatency pool_malloc; /**< malloc served by small block pools */
+    MemmgrHeapLatency pool_free; /**< free of small blocks */
+} MemmgrHeapStats;
+
+/** Live block recorded by the allocation trace */
+typedef struct {
+    void* pointer; /**< Block returned by malloc */
+    void* caller; /**< Return address of the malloc call */
+    size_t size; /**< Requested size */
+} MemmgrHeapTraceRecord;
+
+/** Bump allocator freed at once, see memmgr_heap_arena_alloc */
+typedef struct MemmgrHeapArena MemmgrHeapArena;
+
 /** Memmgr heap enable thread allocation tracking
  *
  * @param      thread_id  - thread id to track
@@ -44,6 +85,87 @@ size_t memmgr_heap_get_max_free_block(void);
  */
 void memmgr_heap_printf_free_blocks(void);
 
+/** Memmgr heap get fragmentation, pool and latency statistics
+ *
+ * @param      stats  - output statistics
+ */
+void memmgr_heap_get_stats(MemmgrHeapStats* stats);
+
+/** Memmgr heap reset allocator latency statistics
+ */
+void memmgr_heap_reset_latency(void);
+
+/** Start recording caller and size of every allocated block
+ *
+ * Records are kept until the block is freed. Blocks allocated before the
+ * start are not recorded. While tracing is stopped the allocator only checks
+ * one pointer, the table is allocated here and released by
+ * memmgr_heap_trace_stop.
+ *
+ * @param      capacity  - number of live blocks the table is sized for, blocks
+ *                         that do not fit are counted as lost
+ *
+ * @return     true if started, false if already running or the heap has no
+ *             room for the table
+ */
+bool memmgr_heap_trace_start(size_t capacity);
+
+/** Stop the allocation trace and drop the records
+ */
+void memmgr_heap_trace_stop(void);
+
+/** Check if the allocation trace is running
+ *
+ * @return     true if running
+ */
+bool memmgr_heap_trace_is_running(void);
+
+/** Copy the live block records of the allocation trace
+ *
+ * @param      records  - output records
+ * @param      count    - maximum number of records to copy
+ * @param      lost     - optional output, allocations not recorded because
+ *                        the table was full
+ *
+ * @return     number of live records, may be more than count
+ */
+size_t memmgr_heap_trace_get_records(MemmgrHeapTraceRecord* records, size_t count, size_t* lost);
+
+/** Allocate an arena
+ *
+ * Arena memory is taken from the heap in chunks and handed out without
+ * per-block headers. Blocks can not be freed one by one, everything is
+ * released by memmgr_heap_arena_free. An arena is not thread safe.
+ *
+ * @param      chunk_size  - bytes taken from the heap at once
+ *
+ * @return     MemmgrHeapArena instance
+ */
+MemmgrHeapArena* memmgr_heap_arena_alloc(size_t chunk_size);
+
+/** Free an arena and all memory allocated from it
+ *
+ * @param      arena  - MemmgrHeapArena instance
+ */
+void memmgr_heap_arena_free(MemmgrHeapArena* arena);
+
+/** Allocate zeroed memory from an arena, crashes if out of memory
+ *
+ * @param      arena  - MemmgrHeapArena instance
+ * @param      size   - bytes to allocate
+ *
+ * @return     pointer to memory, must not be passed to free
+ */
+void* memmgr_heap_arena_malloc(MemmgrHeapArena* arena, size_t size);
+
+/** Get bytes allocated from an arena
+ *
+ * @param      arena  - MemmgrHeapArena instance
+ *
+ * @return     allocated bytes, alignment included
+ */
+size_t memmgr_heap_arena_get_used(MemmgrHeapArena* arena);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,203 @@
+#include "spsc_ring.h"
+
+#include <string.h>
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include "check.h"
+#include "common_defines.h"
+#include "kernel.h"
+
+#include "event_loop_link_i.h"
+
+// Same as stream buffers, a task only waits for one of them at a time
+#define FURI_SPSC_RING_NOTIFY_INDEX (0)
+
+struct FuriSpscRing {
+    uint32_t head; /**< Written by the producer only */
+    uint32_t tail; /**< Written by the consumer only */
+    uint32_t mask;
+    size_t item_size;
+    TaskHandle_t waiter; /**< Consumer waiting for items, taken by the producer */
+    FuriEventLoopLink event_loop_link;
+    uint8_t buffer[];
+};
+
+FuriSpscRing* furi_spsc_ring_alloc(size_t item_size, size_t capacity) {
+    furi_check(item_size != 0);
+    furi_check(capacity != 0 && (capacity & (capacity - 1)) == 0);
+    furi_check(capacity <= UINT32_MAX / 2);
+
+    FuriSpscRing* ring = malloc(sizeof(FuriSpscRing) + item_size * capacity);
+    ring->mask = capacity - 1;
+    ring->item_size = item_size;
+
+    return ring;
+}
+
+void furi_spsc_ring_free(FuriSpscRing* ring) {
+    furi_check(ring);
+
+    // Event Loop must be disconnected
+    furi_check(!ring->event_loop_link.item_in);
+    furi_check(!ring->event_loop_link.item_out);
+
+    free(ring);
+}
+
+static void
+    furi_spsc_ring_copy_in(FuriSpscRing* ring, uint32_t index, const void* items, size_t count) {
+    const size_t offset = index & ring->mask;
+    const size_t first = MIN(count, ring->mask + 1 - offset);
+
+    memcpy(&ring->buffer[offset * ring->item_size], items, first * ring->item_size);
+    if(first < count) {
+        memcpy(
+            ring->buffer,
+            (const uint8_t*)items + first * ring->item_size,
+            (count - first) * ring->item_size);
+    }
+}
+
+static void
+    furi_spsc_ring_copy_out(FuriSpscRing* ring, uint32_t index, void* items, size_t count) {
+    const size_t offset = index & ring->mask;
+    const size_t first = MIN(count, ring->mask + 1 - offset);
+
+    memcpy(items, &ring->buffer[offset * ring->item_size], first * ring->item_size);
+    if(first < count) {
+        memcpy(
+            (uint8_t*)items + first * ring->item_size,
+            ring->buffer,
+            (count - first) * ring->item_size);
+    }
+}
+
+bool furi_spsc_ring_push(FuriSpscRing* ring, const void* items, size_t count) {
+    furi_check(ring);
+    furi_check(items || !count);
+
+    const uint32_t head = ring->head;
+    const uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    if(count > ring->mask + 1 - (head - tail)) return false;
+    if(count == 0) return true;
+
+    furi_spsc_ring_copy_in(ring, head, items, count);
+    __atomic_store_n(&ring->head, head + count, __ATOMIC_SEQ_CST);
+
+    // Wake the consumer once, it takes the waiter back before waiting again
+    TaskHandle_t waiter = __atomic_exchange_n(&ring->waiter, NULL, __ATOMIC_SEQ_CST);
+    if(waiter) {
+        if(FURI_IS_IRQ_MODE()) {
+            BaseType_t yield = pdFALSE;
+            vTaskNotifyGiveIndexedFromISR(waiter, FURI_SPSC_RING_NOTIFY_INDEX, &yield);
+            portYIELD_FROM_ISR(yield);
+        } else {
+            xTaskNotifyGiveIndexed(waiter, FURI_SPSC_RING_NOTIFY_INDEX);
+        }
+    }
+
+    // Subscription is rechecked under the lock, skip it when nobody listens
+    if(ring->event_loop_link.item_in) {
+        furi_event_loop_link_notify(&ring->event_loop_link, FuriEventLoopEventIn);
+    }
+
+    return true;
+}
+
+size_t furi_spsc_ring_pop(FuriSpscRing* ring, void* items, size_t count, uint32_t timeout) {
+    furi_check(ring);
+    furi_check(items || !count);
+    furi_check(!FURI_IS_IRQ_MODE() || timeout == 0);
+
+    const uint32_t tail = ring->tail;
+    uint32_t available = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) - tail;
+
+    if(available == 0 && timeout != 0) {
+        TaskHandle_t self = xTaskGetCurrentTaskHandle();
+        const uint32_t start = furi_get_tick();
+        uint32_t remaining = timeout;
+
+        do {
+            ulTaskNotifyValueClearIndexed(self, FURI_SPSC_RING_NOTIFY_INDEX, UINT32_MAX);
+            __atomic_store_n(&ring->waiter, self, __ATOMIC_SEQ_CST);
+
+            // Items pushed before the waiter was set did not notify
+            available = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) - tail;
+            if(available == 0) {
+                ulTaskNotifyTakeIndexed(FURI_SPSC_RING_NOTIFY_INDEX, pdTRUE, remaining);
+                available = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) - tail;
+            }
+
+            __atomic_store_n(&ring->waiter, NULL, __ATOMIC_SEQ_CST);
+
+            // Other notifications on the same index wake the task early
+            if(timeout != FuriWaitForever) {
+                const uint32_t elapsed = furi_get_tick() - start;
+                remaining = (elapsed < timeout) ? (timeout - elapsed) : 0;
+            }
+        } while(available == 0 && remaining != 0);
+    }
+
+    const size_t popped = MIN(count, available);
+    if(popped == 0) return 0;
+
+    furi_spsc_ring_copy_out(ring, tail, items, popped);
+    __atomic_store_n(&ring->tail, tail + popped, __ATOMIC_RELEASE);
+
+    if(ring->event_loop_link.item_out) {
+        furi_event_loop_link_notify(&ring->event_loop_link, FuriEventLoopEventOut);
+    }
+
+    return popped;
+}
+
+size_t furi_spsc_ring_get_count(FuriSpscRing* ring) {
+    furi_check(ring);
+
+    return __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) -
+           __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+}
+
+size_t furi_spsc_ring_get_space(FuriSpscRing* ring) {
+    furi_check(ring);
+
+    return ring->mask + 1 - furi_spsc_ring_get_count(ring);
+}
+
+void furi_spsc_ring_reset(FuriSpscRing* ring) {
+    furi_check(ring);
+
+    const uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    __atomic_store_n(&ring->tail, head, __ATOMIC_RELEASE);
+
+    if(ring->event_loop_link.item_out) {
+        furi_event_loop_link_notify(&ring->event_loop_link, FuriEventLoopEventOut);
+    }
+}
+
+static FuriEventLoopLink* furi_spsc_ring_event_loop_get_link(FuriEventLoopObject* object) {
+    FuriSpscRing* ring = object;
+    furi_assert(ring);
+    return &ring->event_loop_link;
+}
+
+static uint32_t
+    furi_spsc_ring_event_loop_get_level(FuriEventLoopObject* object, FuriEventLoopEvent event) {
+    FuriSpscRing* ring = object;
+    furi_assert(ring);
+
+    if(event == FuriEventLoopEventIn) {
+        return furi_spsc_ring_get_count(ring);
+    } else if(event == FuriEventLoopEventOut) {
+        return furi_spsc_ring_get_space(ring);
+    } else {
+        furi_crash();
+    }
+}
+
+const FuriEventLoopContract furi_spsc_ring_event_loop_contract = {
+    .get_link = furi_spsc_ring_event_loop_get_link,
+    .get_level = furi_spsc_ring_event_loop_get_level,
+};
@@ -0,0 +1,96 @@
+/**
+ * @file spsc_ring.h
+ * Furi single producer, single consumer ring buffer primitive.
+ *
+ * The ring moves fixed size items from one task or interrupt (the producer)
+ * to one task (the consumer) without critical sections: the producer only
+ * writes the head index and the consumer only writes the tail index. Push
+ * never waits and is safe to call from an interrupt, pop copies as many items
+ * as are available in one call.
+ *
+ * ***NOTE***: there must be only one producer and only one consumer at any
+ * time. Use FuriStreamBuffer or FuriMessageQueue otherwise.
+ */
+#pragma once
+
+#include "base.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct FuriSpscRing FuriSpscRing;
+
+/**
+ * @brief Allocate ring buffer instance.
+ *
+ * @param item_size The size of one item in bytes.
+ * @param capacity The number of items the ring can hold, must be a power of two.
+ * @return The ring buffer instance.
+ */
+FuriSpscRing* furi_spsc_ring_alloc(size_t item_size, size_t capacity);
+
+/**
+ * @brief Free ring buffer instance.
+ *
+ * @param ring The ring buffer instance.
+ */
+void furi_spsc_ring_free(FuriSpscRing* ring);
+
+/**
+ * @brief Push items to the ring, producer side. Never waits, safe to call
+ * from an interrupt.
+ *
+ * Either all items are pushed or none of them, so a group of items written by
+ * one call is never split by an overrun.
+ *
+ * @param ring The ring buffer instance.
+ * @param items A pointer to the items to copy into the ring.
+ * @param count The number of items to push.
+ * @return true if the items were pushed, false if there was not enough space.
+ */
+bool furi_spsc_ring_push(FuriSpscRing* ring, const void* items, size_t count);
+
+/**
+ * @brief Pop items from the ring, consumer side.
+ *
+ * Copies all available items, up to count, waiting for at least one item
+ * to be pushed if the ring is empty.
+ *
+ * @param ring The ring buffer instance.
+ * @param items A pointer to the buffer the items will be copied to.
+ * @param count The maximum number of items to pop.
+ * @param timeout The maximum amount of ticks to wait for an item if the ring
+ * is empty. Will return immediately if timeout is zero. Setting timeout to
+ * FuriWaitForever will cause the task to wait indefinitely. Must be zero if
+ * called from ISR.
+ * @return The number of items popped.
+ */
+size_t furi_spsc_ring_pop(FuriSpscRing* ring, void* items, size_t count, uint32_t timeout);
+
+/**
+ * @brief Get the number of items that can be popped.
+ *
+ * @param ring The ring buffer instance.
+ * @return The number of items in the ring.
+ */
+size_t furi_spsc_ring_get_count(FuriSpscRing* ring);
+
+/**
+ * @brief Get the number of items that can be pushed.
+ *
+ * @param ring The ring buffer instance.
+ * @return The number of free items in the ring.
+ */
+size_t furi_spsc_ring_get_space(FuriSpscRing* ring);
+
+/**
+ * @brief Drop all items pushed so far, consumer side.
+ *
+ * @param ring The ring buffer instance.
+ */
+void furi_spsc_ring_reset(FuriSpscRing* ring);
+
+#ifdef __cplusplus
+}
+#endif
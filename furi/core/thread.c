@@ -25,6 +25,8 @@
 
 #define THREAD_MAX_STACK_SIZE (UINT16_MAX * sizeof(StackType_t))
 
+#define THREAD_ARENA_CHUNK_SIZE (1024U)
+
 typedef struct FuriThreadStdout FuriThreadStdout;
 
 struct FuriThreadStdout {
@@ -58,6 +60,8 @@ struct FuriThread {
 
     FuriThreadStdout output;
 
+    MemmgrHeapArena* arena;
+
     // Keep all non-alignable byte types in one place,
     // this ensures that the size of this structure is minimal
     bool is_service;
@@ -111,6 +115,11 @@ static void furi_thread_body(void* context) {
 
     furi_check(!thread->is_service, "Service threads MUST NOT return");
 
+    if(thread->arena) {
+        memmgr_heap_arena_free(thread->arena);
+        thread->arena = NULL;
+    }
+
     if(thread->heap_trace_enabled == true) {
         furi_delay_ms(33);
         thread->heap_size = memmgr_heap_get_thread_memory((FuriThreadId)thread);
@@ -446,6 +455,17 @@ FuriThread* furi_thread_get_current(void) {
     return thread;
 }
 
+MemmgrHeapArena* furi_thread_get_arena(void) {
+    FuriThread* thread = furi_thread_get_current();
+    furi_check(thread);
+
+    if(!thread->arena) {
+        thread->arena = memmgr_heap_arena_alloc(THREAD_ARENA_CHUNK_SIZE);
+    }
+
+    return thread->arena;
+}
+
 void furi_thread_yield(void) {
     furi_check(!FURI_IS_IRQ_MODE());
     taskYIELD();
@@ -386,6 +386,19 @@ FuriThreadId furi_thread_get_current_id(void);
  */
 FuriThread* furi_thread_get_current(void);
 
+/** Opaque arena type, see memmgr_heap.h */
+typedef struct MemmgrHeapArena MemmgrHeapArena;
+
+/**
+ * @brief Get the heap arena of the current FuriThread, allocated on first use.
+ *
+ * Everything allocated from the arena is freed at once when the thread
+ * callback returns. Memory handed over to other threads must not come from it.
+ *
+ * @return pointer to a MemmgrHeapArena instance
+ */
+MemmgrHeapArena* furi_thread_get_arena(void);
+
 /**
  * @brief Return control to the scheduler.
  */
@@ -0,0 +1,501 @@
+#include "thread_trace.h"
+#include "check.h"
+#include "common_defines.h"
+#include "memmgr.h"
+#include "memmgr_heap.h"
+
+#include <furi_hal_interrupt.h>
+
+#include <FreeRTOS.h>
+#include <task.h>
+#include <queue.h>
+#include <string.h>
+
+/* Latencies under 2^FURI_THREAD_TRACE_HISTOGRAM_SHIFT cycles go to bucket 0 */
+#define FURI_THREAD_TRACE_HISTOGRAM_SHIFT 8
+
+/* Task to thread index map, at most FURI_THREAD_TRACE_THREADS_MAX entries are used */
+#define FURI_THREAD_TRACE_TASKS_BITS 7
+#define FURI_THREAD_TRACE_TASKS_SIZE (1U << FURI_THREAD_TRACE_TASKS_BITS)
+
+/* Free memory left to the traced code after the trace is allocated */
+#define FURI_THREAD_TRACE_HEADROOM (8 * 1024)
+
+/* Events copied per critical section by furi_thread_trace_get_events */
+#define FURI_THREAD_TRACE_EVENTS_CHUNK 32
+
+/* Notification indexes, see configTASK_NOTIFICATION_ARRAY_ENTRIES */
+#define FURI_THREAD_TRACE_NOTIFY_INDEX_STREAM     (0)
+#define FURI_THREAD_TRACE_NOTIFY_INDEX_THREAD     (1)
+#define FURI_THREAD_TRACE_NOTIFY_INDEX_EVENT_LOOP (2)
+
+typedef enum {
+    FuriThreadTraceStateUnknown,
+    FuriThreadTraceStateRunning,
+    FuriThreadTraceStateReady,
+    FuriThreadTraceStateBlocked,
+    FuriThreadTraceStateExited,
+} FuriThreadTraceState;
+
+typedef struct {
+    void* task;
+    uint8_t thread; /* FURI_THREAD_TRACE_THREAD_UNTRACKED until the next switch */
+} FuriThreadTraceTask;
+
+typedef struct {
+    FuriThreadTraceThread stats;
+    uint32_t since; /* Start of the current state */
+    uint32_t isr_since; /* Interrupt time total when switched in */
+    uint8_t state;
+    uint8_t reason; /* Block reason reported while running */
+} FuriThreadTraceSlot;
+
+typedef struct {
+    FuriThreadTraceTask tasks[FURI_THREAD_TRACE_TASKS_SIZE];
+    FuriThreadTraceSlot threads[FURI_THREAD_TRACE_THREADS_MAX];
+    size_t thread_count;
+    FuriThreadTraceSlot* current;
+    void* out_task; /* Switched out, accounted once another task is switched in */
+    FuriThreadTraceSlot* out_slot;
+    uint32_t out_time;
+    uint32_t out_isr;
+    uint32_t out_ready;
+    uint32_t last;
+    uint64_t cycles;
+    uint32_t untracked;
+    FuriThreadTraceEvent* events;
+    size_t capacity;
+    size_t head;
+    uint32_t written;
+} FuriThreadTrace;
+
+/* Switch and ready hooks run with interrupts masked up to
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY, block hooks with the scheduler
+ * suspended at least. Readers hold a critical section. */
+static FuriThreadTrace* furi_thread_trace = NULL;
+
+/* Checked by the hooks in FreeRTOSConfig.h before calling in */
+volatile uint32_t furi_thread_trace_enabled = 0;
+
+static const char* const furi_thread_trace_block_names[FuriThreadTraceBlockNum] = {
+    [FuriThreadTraceBlockOther] = "other",
+    [FuriThreadTraceBlockDelay] = "delay",
+    [FuriThreadTraceBlockMutex] = "mutex",
+    [FuriThreadTraceBlockSemaphore] = "semaphore",
+    [FuriThreadTraceBlockQueueGet] = "queue get",
+    [FuriThreadTraceBlockQueuePut] = "queue put",
+    [FuriThreadTraceBlockEventFlag] = "event flag",
+    [FuriThreadTraceBlockStream] = "stream",
+    [FuriThreadTraceBlockThreadFlags] = "thread flags",
+    [FuriThreadTraceBlockEventLoop] = "event loop",
+    [FuriThreadTraceBlockSuspended] = "suspended",
+};
+
+static inline uint32_t furi_thread_trace_now(FuriThreadTrace* trace) {
+    const uint32_t now = DWT->CYCCNT;
+    // Hooks run far more often than the counter wraps
+    trace->cycles += now - trace->last;
+    trace->last = now;
+    return now;
+}
+
+static inline uint8_t furi_thread_trace_index(FuriThreadTrace* trace, FuriThreadTraceSlot* slot) {
+    return slot ? (uint8_t)(slot - trace->threads) : FURI_THREAD_TRACE_THREAD_UNTRACKED;
+}
+
+static inline void furi_thread_trace_record(
+    FuriThreadTrace* trace,
+    uint32_t now,
+    FuriThreadTraceEventType type,
+    FuriThreadTraceSlot* slot,
+    uint8_t arg) {
+    FuriThreadTraceEvent* event = &trace->events[trace->head];
+    event->time = now;
+    event->type = type;
+    event->thread = furi_thread_trace_index(trace, slot);
+    event->arg = arg;
+
+    trace->head = (trace->head + 1 == trace->capacity) ? 0 : trace->head + 1;
+    trace->written++;
+}
+
+static FuriThreadTraceTask* furi_thread_trace_find(FuriThreadTrace* trace, void* task) {
+    uint32_t index = (uint32_t)(((uintptr_t)task >> 3) * 2654435761U) >>
+                     (32 - FURI_THREAD_TRACE_TASKS_BITS);
+    while(trace->tasks[index].task != task) {
+        if(!trace->tasks[index].task) return &trace->tasks[index];
+        index = (index + 1) & (FURI_THREAD_TRACE_TASKS_SIZE - 1);
+    }
+    return &trace->tasks[index];
+}
+
+static FuriThreadTraceSlot* furi_thread_trace_get(FuriThreadTrace* trace, void* task) {
+    FuriThreadTraceTask* entry = furi_thread_trace_find(trace, task);
+    if(entry->task && entry->thread != FURI_THREAD_TRACE_THREAD_UNTRACKED) {
+        return &trace->threads[entry->thread];
+    }
+    if(trace->thread_count == FURI_THREAD_TRACE_THREADS_MAX) return NULL;
+
+    // First seen, or created with the memory of an exited thread
+    FuriThreadTraceSlot* slot = &trace->threads[trace->thread_count];
+    entry->task = task;
+    entry->thread = trace->thread_count++;
+    slot->stats.thread_id = task;
+    strncpy(slot->stats.name, pcTaskGetName(task), sizeof(slot->stats.name) - 1);
+    return slot;
+}
+
+static void furi_thread_trace_latency(FuriThreadTraceThread* stats, uint32_t cycles) {
+    stats->latency_total += cycles;
+    stats->latency_max = MAX(stats->latency_max, cycles);
+
+    const uint32_t bits = 32 - __builtin_clz(cycles | 1);
+    size_t bucket = 0;
+    if(bits > FURI_THREAD_TRACE_HISTOGRAM_SHIFT) {
+        bucket = MIN(
+            bits - FURI_THREAD_TRACE_HISTOGRAM_SHIFT, FURI_THREAD_TRACE_HISTOGRAM_SIZE - 1U);
+    }
+    stats->latency_histogram[bucket]++;
+}
+
+static void furi_thread_trace_block(FuriThreadTraceBlock reason) {
+    FuriThreadTrace* trace = furi_thread_trace;
+    if(!trace || !trace->current) return;
+
+    // Scheduler is suspended and only the running thread writes its own reason
+    trace->current->reason = reason;
+}
+
+static void furi_thread_trace_switch_out(
+    FuriThreadTrace* trace,
+    FuriThreadTraceSlot* slot,
+    uint32_t ready,
+    uint32_t now,
+    uint32_t isr_total) {
+    if(!slot) {
+        furi_thread_trace_record(
+            trace,
+            now,
+            ready ? FuriThreadTraceEventPreempted : FuriThreadTraceEventBlocked,
+            NULL,
+            FuriThreadTraceBlockOther);
+        return;
+    }
+
+    // The thread running when the trace started has no slice to account
+    if(slot->state == FuriThreadTraceStateRunning) {
+        slot->stats.run_cycles += now - slot->since;
+        slot->stats.isr_cycles += isr_total - slot->isr_since;
+    }
+
+    slot->since = now;
+    if(slot->stats.exited) {
+        slot->state = FuriThreadTraceStateExited;
+        furi_thread_trace_record(
+            trace, now, FuriThreadTraceEventBlocked, slot, FuriThreadTraceBlockOther);
+    } else if(ready) {
+        slot->state = FuriThreadTraceStateReady;
+        slot->stats.preemptions++;
+        furi_thread_trace_record(trace, now, FuriThreadTraceEventPreempted, slot, 0);
+    } else {
+        slot->state = FuriThreadTraceStateBlocked;
+        slot->stats.blocked_count[slot->reason]++;
+        furi_thread_trace_record(trace, now, FuriThreadTraceEventBlocked, slot, slot->reason);
+    }
+}
+
+/* Kernel hooks, see FreeRTOSConfig.h */
+
+void furi_thread_trace_hook_switched_in(void* task) {
+    FuriThreadTrace* trace = furi_thread_trace;
+    if(!trace) return;
+
+    // Yield that picked the same task again, nothing was switched
+    void* out_task = trace->out_task;
+    trace->out_task = NULL;
+    if(out_task == task) {
+        trace->current = trace->out_slot;
+        return;
+    }
+
+    if(out_task) {
+        furi_thread_trace_switch_out(
+            trace, trace->out_slot, trace->out_ready, trace->out_time, trace->out_isr);
+    }
+
+    const uint32_t now = furi_thread_trace_now(trace);
+    FuriThreadTraceSlot* slot = furi_thread_trace_get(trace, task);
+    trace->current = slot;
+    furi_thread_trace_record(trace, now, FuriThreadTraceEventRunning, slot, 0);
+    if(!slot) {
+        trace->untracked++;
+        return;
+    }
+
+    if(slot->state == FuriThreadTraceStateReady) {
+        furi_thread_trace_latency(&slot->stats, now - slot->since);
+    }
+    slot->state = FuriThreadTraceStateRunning;
+    slot->since = now;
+    slot->isr_since = furi_hal_interrupt_get_time_in_isr_total();
+    slot->reason = FuriThreadTraceBlockOther;
+    slot->stats.switches++;
+}
+
+void furi_thread_trace_hook_switched_out(void* task, uint32_t ready) {
+    FuriThreadTrace* trace = furi_thread_trace;
+    if(!trace) return;
+
+    // Ready state is known now, the task list may change before the switch in
+    trace->out_task = task;
+    trace->out_slot = furi_thread_trace_get(trace, task);
+    trace->current = NULL;
+    trace->out_time = furi_thread_trace_now(trace);
+    trace->out_isr = furi_hal_interrupt_get_time_in_isr_total();
+    trace->out_ready = ready;
+}
+
+void furi_thread_trace_hook_ready(void* task) {
+    FuriThreadTrace* trace = furi_thread_trace;
+    if(!trace) return;
+
+    const uint32_t now = furi_thread_trace_now(trace);
+    FuriThreadTraceSlot* slot = furi_thread_trace_get(trace, task);
+    if(slot) {
+        // Priority changes move running and ready threads between ready lists
+        if(slot->state == FuriThreadTraceStateRunning ||
+           slot->state == FuriThreadTraceStateReady) {
+            return;
+        }
+        if(slot->state == FuriThreadTraceStateBlocked) {
+            slot->stats.blocked_cycles[slot->reason] += now - slot->since;
+        }
+        slot->state = FuriThreadTraceStateReady;
+        slot->since = now;
+    }
+
+    const uint8_t waker = FURI_IS_IRQ_MODE() ? FURI_THREAD_TRACE_WAKER_ISR :
+                                               furi_thread_trace_index(trace, trace->current);
+    furi_thread_trace_record(trace, now, FuriThreadTraceEventReady, slot, waker);
+}
+
+void furi_thread_trace_hook_created(void* task) {
+    FuriThreadTrace* trace = furi_thread_trace;
+    if(!trace) return;
+
+    // Memory of an exited thread, its statistics stay with the old index
+    FuriThreadTraceTask* entry = furi_thread_trace_find(trace, task);
+    if(entry->task) entry->thread = FURI_THREAD_TRACE_THREAD_UNTRACKED;
+}
+
+void furi_thread_trace_hook_deleted(void* task) {
+    FuriThreadTrace* trace = furi_thread_trace;
+    if(!trace) return;
+
+    FuriThreadTraceTask* entry = furi_thread_trace_find(trace, task);
+    if(entry->task && entry->thread != FURI_THREAD_TRACE_THREAD_UNTRACKED) {
+        FuriThreadTraceSlot* slot = &trace->threads[entry->thread];
+        slot->stats.exited = true;
+        // A running thread is accounted by its last switch out
+        if(slot->state != FuriThreadTraceStateRunning) slot->state = FuriThreadTraceStateExited;
+    }
+}
+
+void furi_thread_trace_hook_suspended(void* task) {
+    FuriThreadTrace* trace = furi_thread_trace;
+    if(!trace) return;
+
+    if(trace->current && trace->current->stats.thread_id == task) {
+        trace->current->reason = FuriThreadTraceBlockSuspended;
+        return;
+    }
+
+    // Ready threads leave the ready list without a switch
+    FuriThreadTraceTask* entry = furi_thread_trace_find(trace, task);
+    if(entry->task && entry->thread != FURI_THREAD_TRACE_THREAD_UNTRACKED) {
+        FuriThreadTraceSlot* slot = &trace->threads[entry->thread];
+        if(slot->state == FuriThreadTraceStateReady) {
+            slot->state = FuriThreadTraceStateBlocked;
+            slot->reason = FuriThreadTraceBlockSuspended;
+            slot->since = furi_thread_trace_now(trace);
+            slot->stats.blocked_count[FuriThreadTraceBlockSuspended]++;
+        }
+    }
+}
+
+void furi_thread_trace_hook_block_on_delay(void) {
+    furi_thread_trace_block(FuriThreadTraceBlockDelay);
+}
+
+void furi_thread_trace_hook_block_on_event_group(void) {
+    furi_thread_trace_block(FuriThreadTraceBlockEventFlag);
+}
+
+void furi_thread_trace_hook_block_on_queue(uint32_t queue_type, uint32_t send) {
+    if(queue_type == queueQUEUE_TYPE_MUTEX || queue_type == queueQUEUE_TYPE_RECURSIVE_MUTEX) {
+        furi_thread_trace_block(FuriThreadTraceBlockMutex);
+    } else if(
+        queue_type == queueQUEUE_TYPE_COUNTING_SEMAPHORE ||
+        queue_type == queueQUEUE_TYPE_BINARY_SEMAPHORE) {
+        furi_thread_trace_block(FuriThreadTraceBlockSemaphore);
+    } else {
+        furi_thread_trace_block(
+            send ? FuriThreadTraceBlockQueuePut : FuriThreadTraceBlockQueueGet);
+    }
+}
+
+void furi_thread_trace_hook_block_on_notify(uint32_t index) {
+    if(index == FURI_THREAD_TRACE_NOTIFY_INDEX_THREAD) {
+        furi_thread_trace_block(FuriThreadTraceBlockThreadFlags);
+    } else if(index == FURI_THREAD_TRACE_NOTIFY_INDEX_EVENT_LOOP) {
+        furi_thread_trace_block(FuriThreadTraceBlockEventLoop);
+    } else {
+        furi_thread_trace_block(FuriThreadTraceBlockStream);
+    }
+}
+
+/* Public API */
+
+bool furi_thread_trace_start(size_t events) {
+    furi_check(events > 0);
+    const size_t events_size = sizeof(FuriThreadTraceEvent) * events;
+
+    bool started = false;
+    vTaskSuspendAll();
+    // Failed malloc crashes, check the heap first, nothing else allocates meanwhile
+    const size_t free_block = memmgr_heap_get_max_free_block();
+    if(!furi_thread_trace && events <= SIZE_MAX / sizeof(FuriThreadTraceEvent) &&
+       free_block >= sizeof(FuriThreadTrace) + events_size + FURI_THREAD_TRACE_HEADROOM) {
+        FuriThreadTrace* trace = malloc(sizeof(FuriThreadTrace));
+        trace->events = malloc(events_size);
+        trace->capacity = events;
+
+        FURI_CRITICAL_ENTER();
+        trace->last = DWT->CYCCNT;
+        furi_thread_trace = trace;
+        furi_thread_trace_enabled = 1;
+        FURI_CRITICAL_EXIT();
+        started = true;
+    }
+    (void)xTaskResumeAll();
+
+    return started;
+}
+
+void furi_thread_trace_stop(void) {
+    FuriThreadTrace* trace;
+
+    FURI_CRITICAL_ENTER();
+    trace = furi_thread_trace;
+    furi_thread_trace = NULL;
+    furi_thread_trace_enabled = 0;
+    FURI_CRITICAL_EXIT();
+
+    if(trace) {
+        free(trace->events);
+        free(trace);
+    }
+}
+
+bool furi_thread_trace_is_running(void) {
+    return furi_thread_trace != NULL;
+}
+
+size_t furi_thread_trace_get_threads(
+    FuriThreadTraceThread* threads,
+    size_t count,
+    FuriThreadTraceInfo* info) {
+    furi_check(threads || !count);
+
+    size_t thread_count = 0;
+    if(info) memset(info, 0, sizeof(FuriThreadTraceInfo));
+
+    FURI_CRITICAL_ENTER();
+    FuriThreadTrace* trace = furi_thread_trace;
+    if(trace) {
+        (void)furi_thread_trace_now(trace);
+        thread_count = trace->thread_count;
+        if(info) {
+            info->cycles = trace->cycles;
+            info->events = trace->written;
+            info->capacity = trace->capacity;
+            info->untracked = trace->untracked;
+        }
+    }
+    FURI_CRITICAL_EXIT();
+
+    // One thread per critical section, the table only grows while the trace runs
+    for(size_t i = 0; i < MIN(count, thread_count); i++) {
+        FURI_CRITICAL_ENTER();
+        trace = furi_thread_trace;
+        if(trace) {
+            const FuriThreadTraceSlot* slot = &trace->threads[i];
+            threads[i] = slot->stats;
+            if(slot->state == FuriThreadTraceStateRunning) {
+                threads[i].run_cycles += DWT->CYCCNT - slot->since;
+                threads[i].isr_cycles += furi_hal_interrupt_get_time_in_isr_total() -
+                                         slot->isr_since;
+            }
+        } else {
+            memset(&threads[i], 0, sizeof(FuriThreadTraceThread));
+        }
+        FURI_CRITICAL_EXIT();
+    }
+
+    return thread_count;
+}
+
+size_t furi_thread_trace_get_events(FuriThreadTraceEvent* events, size_t count) {
+    furi_check(events || !count);
+
+    size_t total = 0;
+    uint32_t end = 0;
+
+    FURI_CRITICAL_ENTER();
+    FuriThreadTrace* trace = furi_thread_trace;
+    if(trace) {
+        total = MIN(count, MIN((size_t)trace->written, trace->capacity));
+        end = trace->written;
+    }
+    FURI_CRITICAL_EXIT();
+
+    // Newest first, one chunk per critical section. Events are numbered by the
+    // written counter, the oldest ones overwritten meanwhile are left out.
+    size_t copied = 0;
+    while(copied < total) {
+        const size_t chunk = MIN(total - copied, (size_t)FURI_THREAD_TRACE_EVENTS_CHUNK);
+        const uint32_t first = end - copied - chunk;
+        bool valid = false;
+
+        FURI_CRITICAL_ENTER();
+        if(furi_thread_trace == trace && trace->written - first <= trace->capacity) {
+            size_t index = (trace->head + trace->capacity - (trace->written - first)) %
+                           trace->capacity;
+            for(size_t i = total - copied - chunk; i < total - copied; i++) {
+                events[i] = trace->events[index];
+                index = (index + 1 == trace->capacity) ? 0 : index + 1;
+            }
+            valid = true;
+        }
+        FURI_CRITICAL_EXIT();
+
+        if(!valid) break;
+        copied += chunk;
+    }
+
+    if(copied < total) {
+        memmove(events, &events[total - copied], copied * sizeof(FuriThreadTraceEvent));
+    }
+
+    return copied;
+}
+
+const char* furi_thread_trace_get_block_name(FuriThreadTraceBlock reason) {
+    furi_check(reason < FuriThreadTraceBlockNum);
+    return furi_thread_trace_block_names[reason];
+}
+
+uint32_t furi_thread_trace_get_bucket_start(size_t bucket) {
+    furi_check(bucket < FURI_THREAD_TRACE_HISTOGRAM_SIZE);
+    return bucket ? (1UL << (bucket + FURI_THREAD_TRACE_HISTOGRAM_SHIFT - 1)) : 0;
+}
@@ -0,0 +1,164 @@
+/**
+ * @file thread_trace.h
+ * Scheduler trace: per-thread run time, wakeup latency and blocking reasons.
+ *
+ * FreeRTOS trace hooks (see FreeRTOSConfig.h) report every context switch,
+ * every thread that becomes ready and the reason a thread is about to block.
+ * While the trace runs, they are accounted per thread and the switches are
+ * recorded into a ring buffer, oldest events are overwritten. Times are DWT
+ * cycle counter values. While the trace is stopped the hooks only check one
+ * flag.
+ *
+ * Threads are identified by their index in the thread table, which stays
+ * valid until the trace is stopped. A thread created with the task memory of
+ * an exited one gets a new index.
+ */
+#pragma once
+
+#include "base.h"
+#include "thread.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum number of threads accounted, switches of later threads are counted as untracked */
+#define FURI_THREAD_TRACE_THREADS_MAX 48
+
+/** Number of latency histogram buckets. Bucket 0 counts latencies under 256
+ * cycles, bucket N counts latencies from 2^(N+7) cycles, the last one has no limit */
+#define FURI_THREAD_TRACE_HISTOGRAM_SIZE 16
+
+/** Event thread value for threads over FURI_THREAD_TRACE_THREADS_MAX */
+#define FURI_THREAD_TRACE_THREAD_UNTRACKED (0xFFU)
+
+/** Ready event waker value for threads made ready from an interrupt */
+#define FURI_THREAD_TRACE_WAKER_ISR (0xFEU)
+
+/** What a thread was waiting for before it became ready */
+typedef enum {
+    FuriThreadTraceBlockOther, /**< Blocked without a reported reason */
+    FuriThreadTraceBlockDelay, /**< furi_delay_ms, furi_delay_tick and friends */
+    FuriThreadTraceBlockMutex, /**< FuriMutex */
+    FuriThreadTraceBlockSemaphore, /**< FuriSemaphore */
+    FuriThreadTraceBlockQueueGet, /**< FuriMessageQueue, waiting for a message */
+    FuriThreadTraceBlockQueuePut, /**< FuriMessageQueue, waiting for space */
+    FuriThreadTraceBlockEventFlag, /**< FuriEventFlag, including API locks of services */
+    FuriThreadTraceBlockStream, /**< FuriStreamBuffer and FuriSpscRing */
+    FuriThreadTraceBlockThreadFlags, /**< furi_thread_flags_wait */
+    FuriThreadTraceBlockEventLoop, /**< FuriEventLoop */
+    FuriThreadTraceBlockSuspended, /**< furi_thread_suspend */
+
+    FuriThreadTraceBlockNum,
+} FuriThreadTraceBlock;
+
+/** Trace ring event type */
+typedef enum {
+    FuriThreadTraceEventReady, /**< Thread became ready, arg is the waker thread */
+    FuriThreadTraceEventRunning, /**< Thread switched in */
+    FuriThreadTraceEventPreempted, /**< Thread switched out while still ready */
+    FuriThreadTraceEventBlocked, /**< Thread switched out to wait, arg is FuriThreadTraceBlock */
+} FuriThreadTraceEventType;
+
+/** Trace ring event */
+typedef struct {
+    uint32_t time; /**< DWT cycle counter */
+    uint8_t type; /**< FuriThreadTraceEventType */
+    uint8_t thread; /**< Thread index or FURI_THREAD_TRACE_THREAD_UNTRACKED */
+    uint8_t arg; /**< Depends on type */
+    uint8_t reserved;
+} FuriThreadTraceEvent;
+
+/** Per-thread statistics, durations in CPU cycles */
+typedef struct {
+    char name[16]; /**< Thread name, may be truncated */
+    FuriThreadId thread_id; /**< Task handle, may be reused once the thread exited */
+    bool exited; /**< Thread was deleted while the trace was running */
+    uint32_t switches; /**< Times switched in */
+    uint32_t preemptions; /**< Times switched out while still ready */
+    uint64_t run_cycles; /**< Time running, interrupts included */
+    uint64_t isr_cycles; /**< Time spent in interrupts while the thread was running */
+    uint32_t latency_max; /**< Longest time from ready to running */
+    uint64_t latency_total; /**< Sum of times from ready to running */
+    uint32_t latency_histogram[FURI_THREAD_TRACE_HISTOGRAM_SIZE];
+    uint32_t blocked_count[FuriThreadTraceBlockNum]; /**< Waits per reason */
+    uint64_t blocked_cycles[FuriThreadTraceBlockNum]; /**< Time blocked per reason */
+} FuriThreadTraceThread;
+
+/** Trace totals */
+typedef struct {
+    uint64_t cycles; /**< Time since the trace was started */
+    uint32_t events; /**< Events recorded, including overwritten ones */
+    size_t capacity; /**< Event ring capacity */
+    uint32_t untracked; /**< Switches of threads over FURI_THREAD_TRACE_THREADS_MAX */
+} FuriThreadTraceInfo;
+
+/** Start the scheduler trace
+ *
+ * The thread table and the event ring are allocated here and released by
+ * furi_thread_trace_stop.
+ *
+ * @param      events  - event ring capacity, at least 1
+ *
+ * @return     true if started, false if already running or the heap has no
+ *             room for the event ring
+ */
+bool furi_thread_trace_start(size_t events);
+
+/** Stop the scheduler trace and drop the statistics
+ */
+void furi_thread_trace_stop(void);
+
+/** Check if the scheduler trace is running
+ *
+ * @return     true if running
+ */
+bool furi_thread_trace_is_running(void);
+
+/** Copy the thread table
+ *
+ * The running thread is accounted up to the moment of the call.
+ *
+ * @param      threads  - output table, index is the thread index of events
+ * @param      count    - maximum number of threads to copy
+ * @param      info     - optional output, trace totals
+ *
+ * @return     number of threads in the table, may be more than count, 0 if
+ *             not running
+ */
+size_t furi_thread_trace_get_threads(
+    FuriThreadTraceThread* threads,
+    size_t count,
+    FuriThreadTraceInfo* info);
+
+/** Copy the most recent events of the ring, oldest first
+ *
+ * Events are copied in short critical sections. Older events overwritten
+ * while copying are left out, so fewer than available may be returned.
+ *
+ * @param      events  - output events
+ * @param      count   - maximum number of events to copy
+ *
+ * @return     number of events copied, 0 if not running
+ */
+size_t furi_thread_trace_get_events(FuriThreadTraceEvent* events, size_t count);
+
+/** Get the block reason name
+ *
+ * @param      reason  - block reason
+ *
+ * @return     short name
+ */
+const char* furi_thread_trace_get_block_name(FuriThreadTraceBlock reason);
+
+/** Get the shortest latency counted by a histogram bucket
+ *
+ * @param      bucket  - bucket index
+ *
+ * @return     latency in CPU cycles
+ */
+uint32_t furi_thread_trace_get_bucket_start(size_t bucket);
+
+#ifdef __cplusplus
+}
+#endif
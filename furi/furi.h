@@ -16,8 +16,10 @@
 #include "core/pubsub.h"
 #include "core/record.h"
 #include "core/semaphore.h"
+#include "core/spsc_ring.h"
 #include "core/thread.h"
 #include "core/thread_list.h"
+#include "core/thread_trace.h"
 #include "core/timer.h"
 #include "core/string.h"
 #include "core/stream_buffer.h"
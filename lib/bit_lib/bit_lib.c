@@ -1,6 +1,7 @@
 #include "bit_lib.h"
 #include <core/check.h>
 #include <stdio.h>
+#include <string.h>
 
 void bit_lib_push_bit(uint8_t* data, size_t data_size, bool bit) {
     size_t last_index = data_size - 1;
@@ -23,9 +24,15 @@ void bit_lib_set_bits(uint8_t* data, size_t position, uint8_t byte, uint8_t leng
     furi_check(length <= 8);
     furi_check(length > 0);
 
-    for(uint8_t i = 0; i < length; ++i) {
-        uint8_t shift = (length - 1) - i;
-        bit_lib_set_bit(data, position + i, (byte >> shift) & 1); //-V610
+    // Bits are placed in a 16 bit window of the byte at position and the next one
+    const uint8_t shift = 16 - (position % 8) - length;
+    const uint16_t mask = ((1U << length) - 1) << shift;
+    const uint16_t bits = ((uint16_t)byte << shift) & mask;
+
+    uint8_t* dest = &data[position / 8];
+    dest[0] = (dest[0] & ~(mask >> 8)) | (bits >> 8);
+    if(mask & 0xFF) {
+        dest[1] = (dest[1] & ~mask) | (bits & 0xFF);
     }
 }
 
@@ -34,99 +41,68 @@ bool bit_lib_get_bit(const uint8_t* data, size_t position) {
 }
 
 uint8_t bit_lib_get_bits(const uint8_t* data, size_t position, uint8_t length) {
-    uint8_t shift = position % 8;
-    if(shift == 0) {
-        return data[position / 8] >> (8 - length);
-    } else {
-        // TODO FL-3534: fix read out of bounds
-        uint8_t value = (data[position / 8] << (shift));
-        value |= data[position / 8 + 1] >> (8 - shift);
-        value = value >> (8 - length);
-        return value;
-    }
+    const uint8_t shift = position % 8;
+    const uint8_t* src = &data[position / 8];
+
+    // Next byte is read only if the bits cross the byte boundary
+    uint16_t window = (uint16_t)src[0] << 8;
+    if(shift + length > 8) window |= src[1];
+    return (uint16_t)(window << shift) >> (16 - length);
 }
 
-uint16_t bit_lib_get_bits_16(const uint8_t* data, size_t position, uint8_t length) {
-    uint16_t value = 0;
-    if(length <= 8) {
-        value = bit_lib_get_bits(data, position, length);
+/**
+ * Read up to 64 bits, touching only the bytes that hold them
+ */
+static uint64_t bit_lib_get_bits_word(const uint8_t* data, size_t position, uint8_t length) {
+    if(length == 0) return 0;
+
+    const uint8_t shift = position % 8;
+    const uint8_t* src = &data[position / 8];
+    const size_t bytes = (shift + length + 7) / 8;
+
+    uint64_t value = 0;
+    if(bytes <= 8) {
+        for(size_t i = 0; i < bytes; i++) {
+            value = (value << 8) | src[i];
+        }
+        value >>= bytes * 8 - shift - length;
     } else {
-        value = bit_lib_get_bits(data, position, 8) << (length - 8);
-        value |= bit_lib_get_bits(data, position + 8, length - 8);
+        // 64 bits at an unaligned position span 9 bytes
+        for(size_t i = 0; i < 8; i++) {
+            value = (value << 8) | src[i];
+        }
+        value = (value << shift) | (src[8] >> (8 - shift));
+        value >>= 64 - length;
     }
-    return value;
+
+    return (length < 64) ? value & ((1ULL << length) - 1) : value;
 }
 
-uint32_t bit_lib_get_bits_32(const uint8_t* data, size_t position, uint8_t length) {
-    uint32_t value = 0;
-    if(length <= 8) {
-        value = bit_lib_get_bits(data, position, length);
-    } else if(length <= 16) {
-        value = bit_lib_get_bits(data, position, 8) << (length - 8);
-        value |= bit_lib_get_bits(data, position + 8, length - 8);
-    } else if(length <= 24) {
-        value = bit_lib_get_bits(data, position, 8) << (length - 8);
-        value |= bit_lib_get_bits(data, position + 8, 8) << (length - 16);
-        value |= bit_lib_get_bits(data, position + 16, length - 16);
-    } else {
-        value = (uint32_t)bit_lib_get_bits(data, position, 8) << (length - 8);
-        value |= (uint32_t)bit_lib_get_bits(data, position + 8, 8) << (length - 16);
-        value |= (uint32_t)bit_lib_get_bits(data, position + 16, 8) << (length - 24);
-        value |= bit_lib_get_bits(data, position + 24, length - 24);
+/**
+ * Write up to 32 bits, a byte at a time
+ */
+static void
+    bit_lib_set_bits_word(uint8_t* data, size_t position, uint32_t value, uint8_t length) {
+    while(length >= 8) {
+        length -= 8;
+        bit_lib_set_bits(data, position, value >> length, 8);
+        position += 8;
+    }
+    if(length) {
+        bit_lib_set_bits(data, position, value, length);
     }
+}
 
-    return value;
+uint16_t bit_lib_get_bits_16(const uint8_t* data, size_t position, uint8_t length) {
+    return bit_lib_get_bits_word(data, position, length);
 }
 
-uint64_t bit_lib_get_bits_64(const uint8_t* data, size_t position, uint8_t length) {
-    uint64_t value = 0;
-    if(length <= 8) {
-        value = bit_lib_get_bits(data, position, length);
-    } else if(length <= 16) {
-        value = bit_lib_get_bits(data, position, 8) << (length - 8);
-        value |= bit_lib_get_bits(data, position + 8, length - 8);
-    } else if(length <= 24) {
-        value = bit_lib_get_bits(data, position, 8) << (length - 8);
-        value |= bit_lib_get_bits(data, position + 8, 8) << (length - 16);
-        value |= bit_lib_get_bits(data, position + 16, length - 16);
-    } else if(length <= 32) {
-        value = (uint64_t)bit_lib_get_bits(data, position, 8) << (length - 8);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 8, 8) << (length - 16);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 16, 8) << (length - 24);
-        value |= bit_lib_get_bits(data, position + 24, length - 24);
-    } else if(length <= 40) {
-        value = (uint64_t)bit_lib_get_bits(data, position, 8) << (length - 8);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 8, 8) << (length - 16);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 16, 8) << (length - 24);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 24, 8) << (length - 32);
-        value |= bit_lib_get_bits(data, position + 32, length - 32);
-    } else if(length <= 48) {
-        value = (uint64_t)bit_lib_get_bits(data, position, 8) << (length - 8);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 8, 8) << (length - 16);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 16, 8) << (length - 24);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 24, 8) << (length - 32);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 32, 8) << (length - 40);
-        value |= bit_lib_get_bits(data, position + 40, length - 40);
-    } else if(length <= 56) {
-        value = (uint64_t)bit_lib_get_bits(data, position, 8) << (length - 8);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 8, 8) << (length - 16);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 16, 8) << (length - 24);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 24, 8) << (length - 32);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 32, 8) << (length - 40);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 40, 8) << (length - 48);
-        value |= bit_lib_get_bits(data, position + 48, length - 48);
-    } else {
-        value = (uint64_t)bit_lib_get_bits(data, position, 8) << (length - 8);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 8, 8) << (length - 16);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 16, 8) << (length - 24);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 24, 8) << (length - 32);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 32, 8) << (length - 40);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 40, 8) << (length - 48);
-        value |= (uint64_t)bit_lib_get_bits(data, position + 48, 8) << (length - 56);
-        value |= bit_lib_get_bits(data, position + 56, length - 56);
-    }
+uint32_t bit_lib_get_bits_32(const uint8_t* data, size_t position, uint8_t length) {
+    return bit_lib_get_bits_word(data, position, length);
+}
 
-    return value;
+uint64_t bit_lib_get_bits_64(const uint8_t* data, size_t position, uint8_t length) {
+    return bit_lib_get_bits_word(data, position, length);
 }
 
 bool bit_lib_test_parity_32(uint32_t bits, BitLibParity parity) {
@@ -188,14 +164,12 @@ size_t bit_lib_add_parity(
     uint8_t source_length,
     uint8_t parity_length,
     BitLibParity parity) {
-    uint32_t parity_word = 0;
+    const uint8_t word_length = parity_length - 1;
     size_t j = 0, bit_count = 0;
-    for(int word = 0; word < source_length; word += parity_length - 1) {
-        for(int bit = 0; bit < parity_length - 1; bit++) {
-            parity_word = (parity_word << 1) | bit_lib_get_bit(data, position + word + bit);
-            bit_lib_set_bit(
-                dest, dest_position + j++, bit_lib_get_bit(data, position + word + bit));
-        }
+    for(int word = 0; word < source_length; word += word_length) {
+        uint32_t parity_word = bit_lib_get_bits_32(data, position + word, word_length);
+        bit_lib_set_bits_word(dest, dest_position + j, parity_word, word_length);
+        j += word_length;
         // if parity fails then return 0
         switch(parity) {
         case BitLibParityAlways0:
@@ -212,7 +186,6 @@ size_t bit_lib_add_parity(
             break;
         }
         bit_count += parity_length;
-        parity_word = 0;
     }
     // if we got here then all the parities passed
     // return bit count
@@ -220,30 +193,15 @@ size_t bit_lib_add_parity(
 }
 
 size_t bit_lib_remove_bit_every_nth(uint8_t* data, size_t position, uint8_t length, uint8_t n) {
-    size_t counter = 0;
     size_t result_counter = 0;
-    uint8_t bit_buffer = 0;
-    uint8_t bit_counter = 0;
-
-    while(counter < length) {
-        if((counter + 1) % n != 0) {
-            bit_buffer = (bit_buffer << 1) | bit_lib_get_bit(data, position + counter);
-            bit_counter++;
-        }
 
-        if(bit_counter == 8) {
-            bit_lib_set_bits(data, position + result_counter, bit_buffer, 8);
-            bit_counter = 0;
-            bit_buffer = 0;
-            result_counter += 8;
-        }
-        counter++;
+    // Runs of n - 1 bits are moved down, destination never passes the source
+    for(size_t counter = 0; counter < length; counter += n) {
+        size_t run = (length - counter < n) ? length - counter : (size_t)n - 1;
+        bit_lib_copy_bits(data, position + result_counter, run, data, position + counter);
+        result_counter += run;
     }
 
-    if(bit_counter != 0) {
-        bit_lib_set_bits(data, position + result_counter, bit_buffer, bit_counter);
-        result_counter += bit_counter;
-    }
     return result_counter;
 }
 
@@ -253,21 +211,53 @@ void bit_lib_copy_bits(
     size_t length,
     const uint8_t* source,
     size_t source_position) {
-    for(size_t i = 0; i < length; ++i) {
-        bit_lib_set_bit(data, position + i, bit_lib_get_bit(source, source_position + i));
+    // Whole bytes at once when both ends are byte aligned
+    if(position % 8 == 0 && source_position % 8 == 0) {
+        memmove(&data[position / 8], &source[source_position / 8], length / 8);
+        position += length / 8 * 8;
+        source_position += length / 8 * 8;
+        length %= 8;
+    }
+
+    // Source byte is read before the destination is written, copy down in place is safe
+    while(length >= 8) {
+        const uint8_t byte = bit_lib_get_bits(source, source_position, 8);
+        if(position % 8 == 0) {
+            data[position / 8] = byte;
+        } else {
+            bit_lib_set_bits(data, position, byte, 8);
+        }
+        position += 8;
+        source_position += 8;
+        length -= 8;
+    }
+
+    if(length) {
+        const uint8_t bits = bit_lib_get_bits(source, source_position, length);
+        bit_lib_set_bits(data, position, bits, length);
     }
 }
 
 void bit_lib_reverse_bits(uint8_t* data, size_t position, uint8_t length) {
-    size_t i = 0;
-    size_t j = length - 1;
-
-    while(i < j) {
-        bool tmp = bit_lib_get_bit(data, position + i);
-        bit_lib_set_bit(data, position + i, bit_lib_get_bit(data, position + j));
-        bit_lib_set_bit(data, position + j, tmp);
-        i++;
-        j--;
+    size_t head = position;
+    size_t tail = position + length;
+
+    // Swap mirrored bytes from both ends
+    while(tail - head >= 16) {
+        const uint8_t head_byte = bit_lib_get_bits(data, head, 8);
+        const uint8_t tail_byte = bit_lib_get_bits(data, tail - 8, 8);
+        bit_lib_set_bits(data, head, bit_lib_reverse_8_fast(tail_byte), 8);
+        bit_lib_set_bits(data, tail - 8, bit_lib_reverse_8_fast(head_byte), 8);
+        head += 8;
+        tail -= 8;
+    }
+
+    // Less than 16 bits left in the middle
+    const uint8_t rest = tail - head;
+    if(rest > 1) {
+        uint16_t value = bit_lib_get_bits_16(data, head, rest);
+        value = bit_lib_reverse_16_fast(value) >> (16 - rest);
+        bit_lib_set_bits_word(data, head, value, rest);
     }
 }
 
@@ -371,7 +361,7 @@ uint16_t bit_lib_crc8(
 
     for(size_t i = 0; i < data_size; ++i) {
         uint8_t byte = data[i];
-        if(ref_in) bit_lib_reverse_bits(&byte, 0, 8);
+        if(ref_in) byte = bit_lib_reverse_8_fast(byte);
         crc ^= byte;
 
         for(size_t j = 8; j > 0; --j) {
@@ -383,7 +373,7 @@ uint16_t bit_lib_crc8(
         }
     }
 
-    if(ref_out) bit_lib_reverse_bits(&crc, 0, 8);
+    if(ref_out) crc = bit_lib_reverse_8_fast(crc);
     crc ^= xor_out;
 
     return crc;
@@ -401,13 +391,16 @@ uint16_t bit_lib_crc16(
 
     for(size_t i = 0; i < data_size; ++i) {
         uint8_t byte = data[i];
-        if(ref_in) byte = bit_lib_reverse_16_fast(byte) >> 8;
+        if(ref_in) byte = bit_lib_reverse_8_fast(byte);
 
+        // Whole byte enters the register, then 8 shifts
+        crc ^= (uint16_t)byte << 8;
         for(size_t j = 0; j < 8; ++j) {
-            bool c15 = (crc >> 15 & 1);
-            bool bit = (byte >> (7 - j) & 1);
-            crc <<= 1;
-            if(c15 ^ bit) crc ^= polynom;
+            if(crc & TOPBIT(16)) {
+                crc = (crc << 1) ^ polynom;
+            } else {
+                crc = (crc << 1);
+            }
         }
     }
 
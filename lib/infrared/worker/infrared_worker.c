@@ -2,6 +2,7 @@
 
 #include <furi_hal_infrared.h>
 #include <float_tools.h>
+#include <toolbox/zone_profiler.h>
 
 #include <core/check.h>
 #include <core/common_defines.h>
@@ -101,6 +102,7 @@ static void infrared_worker_rx_timeout_callback(void* context) {
 
 static void infrared_worker_rx_callback(void* context, bool level, uint32_t duration) {
     InfraredWorker* instance = context;
+    const uint32_t zone_start = zone_profiler_begin();
 
     furi_assert(duration != 0);
     LevelDuration level_duration = level_duration_make(level, duration);
@@ -112,6 +114,8 @@ static void infrared_worker_rx_callback(void* context, bool level, uint32_t dura
 
     uint32_t flags_set = furi_thread_flags_set(furi_thread_get_id(instance->thread), events);
     furi_check(flags_set & events);
+
+    zone_profiler_end(ZoneProfilerIdInfraredRxIsr, zone_start);
 }
 
 static void infrared_worker_process_timeout(InfraredWorker* instance) {
@@ -133,9 +137,11 @@ static void infrared_worker_process_timeout(InfraredWorker* instance) {
 
 static void
     infrared_worker_process_timings(InfraredWorker* instance, uint32_t duration, bool level) {
+    const uint32_t zone_start = zone_profiler_begin();
     const InfraredMessage* message_decoded =
         instance->decode_enable ? infrared_decode(instance->infrared_decoder, level, duration) :
                                   NULL;
+    zone_profiler_end(ZoneProfilerIdInfraredDecode, zone_start);
     if(message_decoded) {
         instance->signal.message = *message_decoded;
         instance->signal.timings_cnt = 0;
@@ -363,6 +369,7 @@ static FuriHalInfraredTxGetDataState
     InfraredWorker* instance = context;
     InfraredWorkerTiming timing;
     FuriHalInfraredTxGetDataState state;
+    const uint32_t zone_start = zone_profiler_begin();
 
     if(sizeof(InfraredWorkerTiming) ==
        furi_stream_buffer_receive(instance->stream, &timing, sizeof(InfraredWorkerTiming), 0)) {
@@ -381,6 +388,7 @@ static FuriHalInfraredTxGetDataState
         furi_thread_get_id(instance->thread), INFRARED_WORKER_TX_FILL_BUFFER);
     furi_check(flags_set & INFRARED_WORKER_TX_FILL_BUFFER);
 
+    zone_profiler_end(ZoneProfilerIdInfraredTxIsr, zone_start);
     return state;
 }
 
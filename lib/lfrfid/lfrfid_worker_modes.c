@@ -4,7 +4,6 @@
 #include "lfrfid_worker_i.h"
 #include "tools/t5577.h"
 #include <toolbox/pulse_protocols/pulse_glue.h>
-#include <toolbox/buffer_stream.h>
 #include "tools/varint_pair.h"
 #include <lib/bit_lib/bit_lib.h>
 
@@ -35,8 +34,10 @@
 
 #define LFRFID_WORKER_WRITE_MAX_UNSUCCESSFUL_READS 5
 
-#define LFRFID_WORKER_READ_BUFFER_SIZE  512
-#define LFRFID_WORKER_READ_BUFFER_COUNT 16
+/** Packed pulses buffered between capture and decoding, bytes */
+#define LFRFID_WORKER_READ_RING_SIZE   8192
+/** Packed pulses decoded per wakeup, bytes */
+#define LFRFID_WORKER_READ_BUFFER_SIZE 512
 
 #define LFRFID_WORKER_EMULATE_BUFFER_SIZE 1024
 
@@ -64,9 +65,10 @@ void t5577_trace(LFRFIDT5577 t5577, const char* message) {
 /**************************************************************************************************/
 
 typedef struct {
-    BufferStream* stream;
+    FuriSpscRing* ring;
     VarintPair* pair;
     bool ignore_next_pulse;
+    volatile bool overrun;
 } LFRFIDWorkerReadContext;
 
 static void lfrfid_worker_read_capture(bool level, uint32_t duration, void* context) {
@@ -93,8 +95,11 @@ static void lfrfid_worker_read_capture(bool level, uint32_t duration, void* cont
 
     bool need_to_send = varint_pair_pack(ctx->pair, level, duration);
     if(need_to_send) {
-        buffer_stream_send_from_isr(
-            ctx->stream, varint_pair_get_data(ctx->pair), varint_pair_get_size(ctx->pair));
+        // Pairs are pushed whole, an overrun never splits one
+        if(!furi_spsc_ring_push(
+               ctx->ring, varint_pair_get_data(ctx->pair), varint_pair_get_size(ctx->pair))) {
+            ctx->overrun = true;
+        }
         varint_pair_reset(ctx->pair);
     }
 }
@@ -140,8 +145,9 @@ static LFRFIDWorkerReadState lfrfid_worker_read_internal(
 
     LFRFIDWorkerReadContext ctx;
     ctx.pair = varint_pair_alloc();
-    ctx.stream =
-        buffer_stream_alloc(LFRFID_WORKER_READ_BUFFER_SIZE, LFRFID_WORKER_READ_BUFFER_COUNT);
+    ctx.ring = furi_spsc_ring_alloc(sizeof(uint8_t), LFRFID_WORKER_READ_RING_SIZE);
+    ctx.ignore_next_pulse = false;
+    ctx.overrun = false;
 
     furi_hal_rfid_tim_read_capture_start(lfrfid_worker_read_capture, &ctx);
 
@@ -152,6 +158,10 @@ static LFRFIDWorkerReadState lfrfid_worker_read_internal(
     uint8_t* protocol_data = malloc(last_size);
     size_t last_read_count = 0;
 
+    // A pair split between two pops is kept at the start of the buffer
+    uint8_t* data = malloc(LFRFID_WORKER_READ_BUFFER_SIZE);
+    size_t size = 0;
+
     uint32_t switch_os_tick_last = furi_get_tick();
 
     uint32_t average_duration = 0;
@@ -166,30 +176,32 @@ static LFRFIDWorkerReadState lfrfid_worker_read_internal(
             break;
         }
 
-        Buffer* buffer = buffer_stream_receive(ctx.stream, 100);
+        size_t received =
+            furi_spsc_ring_pop(ctx.ring, &data[size], LFRFID_WORKER_READ_BUFFER_SIZE - size, 100);
 
 #ifdef LFRFID_WORKER_READ_DEBUG_GPIO
         furi_hal_gpio_write(LFRFID_WORKER_READ_DEBUG_GPIO_LOAD, true);
 #endif
 
-        if(buffer_stream_get_overrun_count(ctx.stream) > 0) {
+        if(ctx.overrun) {
             FURI_LOG_E(TAG, "Read overrun, recovering");
-            buffer_stream_reset(ctx.stream);
+            furi_spsc_ring_reset(ctx.ring);
+            ctx.overrun = false;
+            size = 0;
 #ifdef LFRFID_WORKER_READ_DEBUG_GPIO
             furi_hal_gpio_write(LFRFID_WORKER_READ_DEBUG_GPIO_LOAD, false);
 #endif
             continue;
         }
 
-        if(buffer == NULL) {
+        if(received == 0) {
 #ifdef LFRFID_WORKER_READ_DEBUG_GPIO
             furi_hal_gpio_write(LFRFID_WORKER_READ_DEBUG_GPIO_LOAD, false);
 #endif
             continue;
         }
 
-        size_t size = buffer_get_size(buffer);
-        uint8_t* data = buffer_get_data(buffer);
+        size += received;
         size_t index = 0;
 
         while(index < size) {
@@ -198,7 +210,7 @@ static LFRFIDWorkerReadState lfrfid_worker_read_internal(
             size_t tmp_size;
 
             if(!varint_pair_unpack(&data[index], size - index, &pulse, &duration, &tmp_size)) {
-                FURI_LOG_E(TAG, "can't unpack varint pair");
+                // Rest of the pair is not popped yet
                 break;
             } else {
                 index += tmp_size;
@@ -296,7 +308,9 @@ static LFRFIDWorkerReadState lfrfid_worker_read_internal(
             }
         }
 
-        buffer_reset(buffer);
+        // Keep the incomplete pair, pairs are much shorter than the buffer
+        size -= index;
+        memmove(data, &data[index], size);
 
 #ifdef LFRFID_WORKER_READ_DEBUG_GPIO
         furi_hal_gpio_write(LFRFID_WORKER_READ_DEBUG_GPIO_LOAD, false);
@@ -327,8 +341,9 @@ static LFRFIDWorkerReadState lfrfid_worker_read_internal(
     furi_hal_rfid_pins_reset();
 
     varint_pair_free(ctx.pair);
-    buffer_stream_free(ctx.stream);
+    furi_spsc_ring_free(ctx.ring);
 
+    free(data);
     free(protocol_data);
     free(last_data);
 
@@ -55,6 +55,11 @@ bool varint_pair_unpack(
 
     size += varint_uint32_unpack(&tmp_value_2, &data[size], (size_t)(data_length - size));
 
+    // Second value is cut off
+    if(size > data_length) {
+        return false;
+    }
+
     *value_1 = tmp_value_1;
     *value_2 = tmp_value_2;
     *length = size;
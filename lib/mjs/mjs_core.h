@@ -89,6 +89,10 @@ struct mjs {
     struct gc_arena property_arena;
     struct gc_arena ffi_sig_arena;
 
+    struct mjs_gc_stats gc_stats;
+    size_t gc_young_cells; /* Cells allocated since the last collection */
+    size_t gc_strings_len; /* Length of owned_strings after the last collection */
+
     unsigned inhibit_gc : 1;
     unsigned need_gc : 1;
     unsigned generate_jsc : 1;
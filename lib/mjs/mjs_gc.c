@@ -5,6 +5,8 @@
 
 #include <stdio.h>
 
+#include <furi_hal_cortex.h>
+
 #include "common/cs_varint.h"
 #include "common/mbuf.h"
 
@@ -37,6 +39,17 @@
  */
 #define GC_ARENA_CELLS_RESERVE 2
 
+/*
+ * Young generation budget: once that many cells or owned string bytes have
+ * been allocated since the last collection, `mjs_gc_idle()` will collect.
+ */
+#ifndef MJS_GC_NURSERY_CELLS
+#define MJS_GC_NURSERY_CELLS 64
+#endif
+#ifndef MJS_GC_NURSERY_STRING_BYTES
+#define MJS_GC_NURSERY_STRING_BYTES 512
+#endif
+
 static struct gc_block* gc_new_block(struct gc_arena* a, size_t size);
 static void gc_free_block(struct gc_block* b);
 static void gc_mark_mbuf_pt(struct mjs* mjs, const struct mbuf* mbuf);
@@ -146,6 +159,7 @@ MJS_PRIVATE void* gc_alloc_cell(struct mjs* mjs, struct gc_arena* a) {
     a->allocations++;
     a->alive++;
 #endif
+    mjs->gc_young_cells++;
 
     /* Schedule GC if needed */
     if(gc_arena_is_gc_needed(a)) {
@@ -485,6 +499,8 @@ static void gc_mark_ffi_cbargs_list(struct mjs* mjs, ffi_cb_args_t* cbargs) {
 
 /* Perform garbage collection */
 void mjs_gc(struct mjs* mjs, int full) {
+    uint32_t start = furi_hal_cortex_timer_get(0).start;
+
     gc_mark_val_array(mjs, (mjs_val_t*)&mjs->vals, sizeof(mjs->vals) / sizeof(mjs_val_t));
 
     gc_mark_mbuf_pt(mjs, &mjs->owned_values);
@@ -511,6 +527,36 @@ void mjs_gc(struct mjs* mjs, int full) {
             mbuf_resize(&mjs->owned_strings, trimmed_size);
         }
     }
+
+    mjs->gc_young_cells = 0;
+    mjs->gc_strings_len = mjs->owned_strings.len;
+
+    uint32_t pause_us = (furi_hal_cortex_timer_get(0).start - start) /
+                        furi_hal_cortex_instructions_per_microsecond();
+    mjs->gc_stats.collections++;
+    mjs->gc_stats.last_pause_us = pause_us;
+    mjs->gc_stats.total_pause_us += pause_us;
+    if(pause_us > mjs->gc_stats.max_pause_us) {
+        mjs->gc_stats.max_pause_us = pause_us;
+    }
+}
+
+int mjs_gc_idle(struct mjs* mjs) {
+    if(mjs->inhibit_gc) return 0;
+
+    if(!mjs->need_gc && mjs->gc_young_cells < MJS_GC_NURSERY_CELLS &&
+       mjs->owned_strings.len < mjs->gc_strings_len + MJS_GC_NURSERY_STRING_BYTES) {
+        return 0;
+    }
+
+    mjs_gc(mjs, 0);
+    mjs->need_gc = 0;
+    mjs->gc_stats.idle_collections++;
+    return 1;
+}
+
+void mjs_gc_get_stats(struct mjs* mjs, struct mjs_gc_stats* stats) {
+    *stats = mjs->gc_stats;
 }
 
 MJS_PRIVATE int gc_check_val(struct mjs* mjs, mjs_val_t v) {
@@ -12,12 +12,42 @@
 extern "C" {
 #endif /* __cplusplus */
 
+/*
+ * Garbage collector pause statistics, all times are in microseconds.
+ */
+struct mjs_gc_stats {
+    uint32_t collections; /* Total number of collections */
+    uint32_t idle_collections; /* Collections performed from idle points */
+    uint32_t last_pause_us; /* Duration of the most recent collection */
+    uint32_t max_pause_us; /* Longest collection so far */
+    uint64_t total_pause_us; /* Sum of all collection durations */
+};
+
 /*
  * Perform garbage collection.
  * Pass true to full in order to reclaim unused heap back to the OS.
  */
 void mjs_gc(struct mjs* mjs, int full);
 
+/*
+ * Perform garbage collection from an idle point (e.g. an event loop tick),
+ * but only if it's due: either a collection has been scheduled by the
+ * allocator, or the young generation (cells and string bytes allocated since
+ * the previous collection) has outgrown the nursery budget.
+ *
+ * Collecting short-lived temporaries while the script is idle keeps the
+ * arenas from running dry in the middle of execution, which is where
+ * stop-the-world pauses are visible.
+ *
+ * Returns 1 if a collection has been performed, 0 otherwise.
+ */
+int mjs_gc_idle(struct mjs* mjs);
+
+/*
+ * Copy garbage collector statistics into `stats`.
+ */
+void mjs_gc_get_stats(struct mjs* mjs, struct mjs_gc_stats* stats);
+
 #if defined(__cplusplus)
 }
 #endif /* __cplusplus */
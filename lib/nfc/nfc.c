@@ -4,6 +4,7 @@
 
 #include <furi_hal_nfc.h>
 #include <furi/furi.h>
+#include <toolbox/zone_profiler.h>
 
 #define TAG "Nfc"
 
@@ -138,6 +139,7 @@ static int32_t nfc_worker_listener(void* context) {
             instance->callback(nfc_event, instance->context);
         }
         if(event & FuriHalNfcEventRxEnd) {
+            const uint32_t zone_start = zone_profiler_begin();
             furi_hal_nfc_timer_block_tx_start(instance->fdt_listen_fc);
 
             nfc_event.type = NfcEventTypeRxEnd;
@@ -145,6 +147,7 @@ static int32_t nfc_worker_listener(void* context) {
                 instance->rx_buffer, sizeof(instance->rx_buffer), &instance->rx_bits);
             bit_buffer_copy_bits(event_data.buffer, instance->rx_buffer, instance->rx_bits);
             command = instance->callback(nfc_event, instance->context);
+            zone_profiler_end(ZoneProfilerIdNfcListenerRx, zone_start);
             if(command == NfcCommandStop) {
                 break;
             } else if(command == NfcCommandReset) {
@@ -179,7 +182,9 @@ bool nfc_worker_poller_ready_handler(Nfc* instance) {
     NfcCommand command = NfcCommandContinue;
 
     NfcEvent event = {.type = NfcEventTypePollerReady};
+    const uint32_t zone_start = zone_profiler_begin();
     command = instance->callback(event, instance->context);
+    zone_profiler_end(ZoneProfilerIdNfcPoller, zone_start);
     if(command == NfcCommandReset) {
         instance->poller_state = NfcPollerStateReset;
     } else if(command == NfcCommandStop) {
@@ -3,6 +3,7 @@
 
 struct SubGhzEnvironment {
     SubGhzKeystore* keystore;
+    SubGhzKeyCache* key_cache;
     const SubGhzProtocolRegistry* protocol_registry;
     const char* nice_flor_s_rainbow_table_file_name;
     const char* alutech_at_4n_rainbow_table_file_name;
@@ -14,6 +15,7 @@ SubGhzEnvironment* subghz_environment_alloc(void) {
     SubGhzEnvironment* instance = malloc(sizeof(SubGhzEnvironment));
 
     instance->keystore = subghz_keystore_alloc();
+    instance->key_cache = subghz_key_cache_alloc();
     instance->protocol_registry = NULL;
     instance->nice_flor_s_rainbow_table_file_name = NULL;
     instance->alutech_at_4n_rainbow_table_file_name = NULL;
@@ -30,6 +32,7 @@ void subghz_environment_free(SubGhzEnvironment* instance) {
     instance->nice_flor_s_rainbow_table_file_name = NULL;
     instance->alutech_at_4n_rainbow_table_file_name = NULL;
     subghz_keystore_free(instance->keystore);
+    subghz_key_cache_free(instance->key_cache);
 
     free(instance);
 }
@@ -37,6 +40,8 @@ void subghz_environment_free(SubGhzEnvironment* instance) {
 bool subghz_environment_load_keystore(SubGhzEnvironment* instance, const char* filename) {
     furi_check(instance);
 
+    // Cached key indexes refer to the previous keystore contents
+    subghz_key_cache_reset(instance->key_cache);
     return subghz_keystore_load(instance->keystore, filename);
 }
 
@@ -46,6 +51,12 @@ SubGhzKeystore* subghz_environment_get_keystore(SubGhzEnvironment* instance) {
     return instance->keystore;
 }
 
+SubGhzKeyCache* subghz_environment_get_key_cache(SubGhzEnvironment* instance) {
+    furi_check(instance);
+
+    return instance->key_cache;
+}
+
 void subghz_environment_set_came_atomo_rainbow_table_file_name(
     SubGhzEnvironment* instance,
     const char* filename) {
@@ -4,6 +4,7 @@
 #include "registry.h"
 
 #include "subghz_keystore.h"
+#include "subghz_key_cache.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -38,6 +39,13 @@ bool subghz_environment_load_keystore(SubGhzEnvironment* instance, const char* f
  */
 SubGhzKeystore* subghz_environment_get_keystore(SubGhzEnvironment* instance);
 
+/**
+ * Get pointer to a SubGhzKeyCache* instance, shared by the rolling code decoders.
+ * @param instance Pointer to a SubGhzEnvironment instance
+ * @return SubGhzKeyCache* pointer to a SubGhzKeyCache instance
+ */
+SubGhzKeyCache* subghz_environment_get_key_cache(SubGhzEnvironment* instance);
+
 /**
  * Set filename to work with Came Atomo.
  * @param instance Pointer to a SubGhzEnvironment instance
@@ -30,6 +30,7 @@ struct SubGhzProtocolDecoderKeeloq {
 
     uint16_t header_count;
     SubGhzKeystore* keystore;
+    SubGhzKeyCache* key_cache;
     const char* manufacture_name;
 
     FuriString* manufacture_from_file;
@@ -42,6 +43,7 @@ struct SubGhzProtocolEncoderKeeloq {
     SubGhzBlockGeneric generic;
 
     SubGhzKeystore* keystore;
+    SubGhzKeyCache* key_cache;
     const char* manufacture_name;
 
     FuriString* manufacture_from_file;
@@ -93,11 +95,13 @@ const SubGhzProtocol subghz_protocol_keeloq = {
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
  * @param keystore Pointer to a SubGhzKeystore* instance
+ * @param key_cache Pointer to a SubGhzKeyCache* instance
  * @param manufacture_name
  */
 static void subghz_protocol_keeloq_check_remote_controller(
     SubGhzBlockGeneric* instance,
     SubGhzKeystore* keystore,
+    SubGhzKeyCache* key_cache,
     const char** manufacture_name);
 
 void* subghz_protocol_encoder_keeloq_alloc(SubGhzEnvironment* environment) {
@@ -106,6 +110,7 @@ void* subghz_protocol_encoder_keeloq_alloc(SubGhzEnvironment* environment) {
     instance->base.protocol = &subghz_protocol_keeloq;
     instance->generic.protocol_name = instance->base.protocol->name;
     instance->keystore = subghz_environment_get_keystore(environment);
+    instance->key_cache = subghz_environment_get_key_cache(environment);
 
     instance->encoder.repeat = 100;
     instance->encoder.size_upload = 256;
@@ -552,7 +557,10 @@ SubGhzProtocolStatus
         }
 
         subghz_protocol_keeloq_check_remote_controller(
-            &instance->generic, instance->keystore, &instance->manufacture_name);
+            &instance->generic,
+            instance->keystore,
+            instance->key_cache,
+            &instance->manufacture_name);
 
         //optional parameter parameter
         flipper_format_read_uint32(
@@ -611,6 +619,7 @@ void* subghz_protocol_decoder_keeloq_alloc(SubGhzEnvironment* environment) {
     instance->base.protocol = &subghz_protocol_keeloq;
     instance->generic.protocol_name = instance->base.protocol->name;
     instance->keystore = subghz_environment_get_keystore(environment);
+    instance->key_cache = subghz_environment_get_key_cache(environment);
     instance->manufacture_from_file = furi_string_alloc();
 
     subghz_custom_btn_set_prog_mode(PROG_MODE_OFF);
@@ -778,20 +787,22 @@ static inline bool subghz_protocol_keeloq_check_decrypt_centurion(
     return false;
 }
 
-/** 
- * Checking the accepted code against the database manafacture key
+/**
+ * Checking the accepted code against one manufacture key
  * @param instance Pointer to a SubGhzBlockGeneric* instance
  * @param fix Fix part of the parcel
  * @param hop Hop encrypted part of the parcel
  * @param keystore Pointer to a SubGhzKeystore* instance
+ * @param manufacture_code Pointer to a SubGhzKey* of the keystore
  * @param manufacture_name 
- * @return true on successful search
+ * @return true if the key decrypts the parcel
  */
-static uint8_t subghz_protocol_keeloq_check_remote_controller_selector(
+static bool subghz_protocol_keeloq_check_key(
     SubGhzBlockGeneric* instance,
     uint32_t fix,
     uint32_t hop,
     SubGhzKeystore* keystore,
+    SubGhzKey* manufacture_code,
     const char** manufacture_name) {
     // protocol HCS300 uses 10 bits in discriminator, HCS200 uses 8 bits, for backward compatibility, we are looking for the 8-bit pattern
     // HCS300 -> uint16_t end_serial = (uint16_t)(fix & 0x3FF);
@@ -801,6 +812,198 @@ static uint8_t subghz_protocol_keeloq_check_remote_controller_selector(
     uint8_t btn = (uint8_t)(fix >> 28);
     uint32_t decrypt = 0;
     uint64_t man;
+
+    switch(manufacture_code->type) {
+    case KEELOQ_LEARNING_SIMPLE:
+        // Simple Learning
+        decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
+        if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+            keystore->mfname = *manufacture_name;
+            return true;
+        }
+        break;
+    case KEELOQ_LEARNING_NORMAL:
+        // Normal Learning
+        // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
+        man = subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
+        decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+        if(strcmp(furi_string_get_cstr(manufacture_code->name), "Centurion") == 0) {
+            if(subghz_protocol_keeloq_check_decrypt_centurion(instance, decrypt, btn)) {
+                *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+                keystore->mfname = *manufacture_name;
+                return true;
+            }
+        } else {
+            if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+                *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+                keystore->mfname = *manufacture_name;
+                return true;
+            }
+        }
+        break;
+    case KEELOQ_LEARNING_SECURE:
+        man = subghz_protocol_keeloq_common_secure_learning(
+            fix, instance->seed, manufacture_code->key);
+        decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+        if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+            keystore->mfname = *manufacture_name;
+            return true;
+        }
+        break;
+    case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
+        man = subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, manufacture_code->key);
+        decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+        if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+            keystore->mfname = *manufacture_name;
+            return true;
+        }
+        break;
+    case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1:
+        man = subghz_protocol_keeloq_common_magic_serial_type1_learning(
+            fix, manufacture_code->key);
+        decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+        if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+            keystore->mfname = *manufacture_name;
+            return true;
+        }
+        break;
+    case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_2:
+        man = subghz_protocol_keeloq_common_magic_serial_type2_learning(
+            fix, manufacture_code->key);
+        decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+        if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+            keystore->mfname = *manufacture_name;
+            return true;
+        }
+        break;
+    case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3:
+        man = subghz_protocol_keeloq_common_magic_serial_type3_learning(
+            fix, manufacture_code->key);
+        decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+        if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+            keystore->mfname = *manufacture_name;
+            return true;
+        }
+        break;
+    case KEELOQ_LEARNING_UNKNOWN:
+        // Simple Learning
+        decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
+        if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+            keystore->mfname = *manufacture_name;
+            keystore->kl_type = 1;
+            return true;
+        }
+
+        // Check for mirrored man
+        uint64_t man_rev = 0;
+        uint64_t man_rev_byte = 0;
+        for(uint8_t i = 0; i < 64; i += 8) {
+            man_rev_byte = (uint8_t)(manufacture_code->key >> i);
+            man_rev = man_rev | man_rev_byte << (56 - i);
+        }
+
+        decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_rev);
+        if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+            keystore->mfname = *manufacture_name;
+            keystore->kl_type = 1;
+            return true;
+        }
+
+        //###########################
+        // Normal Learning
+        // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
+        man = subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
+        decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+        if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+            keystore->mfname = *manufacture_name;
+            keystore->kl_type = 2;
+            return true;
+        }
+
+        // Check for mirrored man
+        man = subghz_protocol_keeloq_common_normal_learning(fix, man_rev);
+        decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+        if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+            keystore->mfname = *manufacture_name;
+            keystore->kl_type = 2;
+            return true;
+        }
+
+        // Secure Learning
+        man = subghz_protocol_keeloq_common_secure_learning(
+            fix, instance->seed, manufacture_code->key);
+        decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+        if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+            keystore->mfname = *manufacture_name;
+            keystore->kl_type = 3;
+            return true;
+        }
+
+        // Check for mirrored man
+        man = subghz_protocol_keeloq_common_secure_learning(fix, instance->seed, man_rev);
+        decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+        if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+            keystore->mfname = *manufacture_name;
+            keystore->kl_type = 3;
+            return true;
+        }
+
+        // Magic xor type1 learning
+        man = subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, manufacture_code->key);
+        decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+        if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+            keystore->mfname = *manufacture_name;
+            keystore->kl_type = 4;
+            return true;
+        }
+
+        // Check for mirrored man
+        man = subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, man_rev);
+        decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+        if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
+            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+            keystore->mfname = *manufacture_name;
+            keystore->kl_type = 4;
+            return true;
+        }
+
+        break;
+    }
+
+    return false;
+}
+
+/** 
+ * Checking the accepted code against the database manafacture key
+ * @param instance Pointer to a SubGhzBlockGeneric* instance
+ * @param fix Fix part of the parcel
+ * @param hop Hop encrypted part of the parcel
+ * @param keystore Pointer to a SubGhzKeystore* instance
+ * @param key_cache Pointer to a SubGhzKeyCache* instance
+ * @param manufacture_name 
+ * @return true on successful search
+ */
+static uint8_t subghz_protocol_keeloq_check_remote_controller_selector(
+    SubGhzBlockGeneric* instance,
+    uint32_t fix,
+    uint32_t hop,
+    SubGhzKeystore* keystore,
+    SubGhzKeyCache* key_cache,
+    const char** manufacture_name) {
+    uint32_t serial = fix & 0x0FFFFFFF;
     bool mf_not_set = false;
     // TODO:
     // if(mfname == 0x0) {
@@ -814,185 +1017,34 @@ static uint8_t subghz_protocol_keeloq_check_remote_controller_selector(
     } else if(strcmp(mfname, "") == 0) {
         mf_not_set = true;
     }
-    for
-        M_EACH(manufacture_code, *subghz_keystore_get_data(keystore), SubGhzKeyArray_t) {
-            if(mf_not_set || (strcmp(furi_string_get_cstr(manufacture_code->name), mfname) == 0)) {
-                switch(manufacture_code->type) {
-                case KEELOQ_LEARNING_SIMPLE:
-                    // Simple Learning
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_NORMAL:
-                    // Normal Learning
-                    // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                    man =
-                        subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(strcmp(furi_string_get_cstr(manufacture_code->name), "Centurion") == 0) {
-                        if(subghz_protocol_keeloq_check_decrypt_centurion(instance, decrypt, btn)) {
-                            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                            keystore->mfname = *manufacture_name;
-                            return 1;
-                        }
-                    } else {
-                        if(subghz_protocol_keeloq_check_decrypt(
-                               instance, decrypt, btn, end_serial)) {
-                            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                            keystore->mfname = *manufacture_name;
-                            return 1;
-                        }
-                    }
-                    break;
-                case KEELOQ_LEARNING_SECURE:
-                    man = subghz_protocol_keeloq_common_secure_learning(
-                        fix, instance->seed, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
-                    man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1:
-                    man = subghz_protocol_keeloq_common_magic_serial_type1_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_2:
-                    man = subghz_protocol_keeloq_common_magic_serial_type2_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3:
-                    man = subghz_protocol_keeloq_common_magic_serial_type3_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_UNKNOWN:
-                    // Simple Learning
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 1;
-                        return 1;
-                    }
-
-                    // Check for mirrored man
-                    uint64_t man_rev = 0;
-                    uint64_t man_rev_byte = 0;
-                    for(uint8_t i = 0; i < 64; i += 8) {
-                        man_rev_byte = (uint8_t)(manufacture_code->key >> i);
-                        man_rev = man_rev | man_rev_byte << (56 - i);
-                    }
-
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_rev);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 1;
-                        return 1;
-                    }
-
-                    //###########################
-                    // Normal Learning
-                    // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                    man =
-                        subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 2;
-                        return 1;
-                    }
-
-                    // Check for mirrored man
-                    man = subghz_protocol_keeloq_common_normal_learning(fix, man_rev);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 2;
-                        return 1;
-                    }
 
-                    // Secure Learning
-                    man = subghz_protocol_keeloq_common_secure_learning(
-                        fix, instance->seed, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 3;
-                        return 1;
-                    }
-
-                    // Check for mirrored man
-                    man = subghz_protocol_keeloq_common_secure_learning(
-                        fix, instance->seed, man_rev);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 3;
-                        return 1;
-                    }
-
-                    // Magic xor type1 learning
-                    man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 4;
-                        return 1;
-                    }
-
-                    // Check for mirrored man
-                    man = subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, man_rev);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 4;
-                        return 1;
-                    }
+    // Repeated presses of a known remote take one key trial instead of the whole keystore
+    SubGhzKeyArray_t* keys = subghz_keystore_get_data(keystore);
+    uint16_t cached_index = 0;
+    bool cached =
+        subghz_key_cache_get(key_cache, instance->protocol_name, serial, &cached_index) &&
+        cached_index < SubGhzKeyArray_size(*keys);
+    if(cached) {
+        SubGhzKey* manufacture_code = SubGhzKeyArray_get(*keys, cached_index);
+        if((mf_not_set || (strcmp(furi_string_get_cstr(manufacture_code->name), mfname) == 0)) &&
+           subghz_protocol_keeloq_check_key(
+               instance, fix, hop, keystore, manufacture_code, manufacture_name)) {
+            return 1;
+        }
+    }
 
-                    break;
-                }
+    uint16_t index = 0;
+    for
+        M_EACH(manufacture_code, *keys, SubGhzKeyArray_t) {
+            if((!cached || index != cached_index) &&
+               (mf_not_set ||
+                (strcmp(furi_string_get_cstr(manufacture_code->name), mfname) == 0)) &&
+               subghz_protocol_keeloq_check_key(
+                   instance, fix, hop, keystore, manufacture_code, manufacture_name)) {
+                subghz_key_cache_put(key_cache, instance->protocol_name, serial, index);
+                return 1;
             }
+            index++;
         }
 
     // MF not found
@@ -1006,6 +1058,7 @@ static uint8_t subghz_protocol_keeloq_check_remote_controller_selector(
 static void subghz_protocol_keeloq_check_remote_controller(
     SubGhzBlockGeneric* instance,
     SubGhzKeystore* keystore,
+    SubGhzKeyCache* key_cache,
     const char** manufacture_name) {
     // Reverse key, split FIX and HOP parts
     uint64_t key = subghz_protocol_blocks_reverse_key(instance->data, instance->data_count_bit);
@@ -1037,7 +1090,7 @@ static void subghz_protocol_keeloq_check_remote_controller(
                 instance->cnt = key_hop >> 16;
             } else {
                 subghz_protocol_keeloq_check_remote_controller_selector(
-                    instance, key_fix, key_hop, keystore, manufacture_name);
+                    instance, key_fix, key_hop, keystore, key_cache, manufacture_name);
             }
         } else {
             // If we have mfname and its one of AN-Motors or HCS101 we should preform only check for this system
@@ -1054,7 +1107,7 @@ static void subghz_protocol_keeloq_check_remote_controller(
             } else {
                 // Else we have mfname that is not AN-Motors or HCS101 we should check it via default selector
                 subghz_protocol_keeloq_check_remote_controller_selector(
-                    instance, key_fix, key_hop, keystore, manufacture_name);
+                    instance, key_fix, key_hop, keystore, key_cache, manufacture_name);
             }
         }
         // Save original counter as temp counter in case of later usage of prog mode
@@ -1110,7 +1163,7 @@ SubGhzProtocolStatus subghz_protocol_decoder_keeloq_serialize(
         subghz_block_generic_serialize(&instance->generic, flipper_format, preset);
 
     subghz_protocol_keeloq_check_remote_controller(
-        &instance->generic, instance->keystore, &instance->manufacture_name);
+        &instance->generic, instance->keystore, instance->key_cache, &instance->manufacture_name);
 
     if(strcmp(instance->manufacture_name, "BFT") == 0) {
         uint8_t seed_data[sizeof(uint32_t)] = {0};
@@ -1310,7 +1363,7 @@ void subghz_protocol_decoder_keeloq_get_string(void* context, FuriString* output
     SubGhzProtocolDecoderKeeloq* instance = context;
 
     subghz_protocol_keeloq_check_remote_controller(
-        &instance->generic, instance->keystore, &instance->manufacture_name);
+        &instance->generic, instance->keystore, instance->key_cache, &instance->manufacture_name);
 
     uint32_t code_found_hi = instance->generic.data >> 32;
     uint32_t code_found_lo = instance->generic.data & 0x00000000ffffffff;
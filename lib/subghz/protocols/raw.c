@@ -1,6 +1,7 @@
 #include "raw.h"
 #include <lib/flipper_format/flipper_format.h>
 #include "../subghz_file_encoder_worker.h"
+#include "../subghz_raw_binary.h"
 
 #include "../blocks/const.h"
 #include "../blocks/generic.h"
@@ -31,6 +32,8 @@ struct SubGhzProtocolDecoderRAW {
     size_t sample_write;
     bool last_level;
     bool pause;
+    bool binary;
+    SubGhzRawBinaryWriter* binary_writer;
 };
 
 struct SubGhzProtocolEncoderRAW {
@@ -158,6 +161,17 @@ bool subghz_protocol_raw_save_to_file_init(
             break;
         }
 
+        if(instance->binary) {
+            const uint32_t version = SUBGHZ_RAW_BINARY_VERSION;
+            if(!flipper_format_write_uint32(
+                   instance->flipper_file, SUBGHZ_RAW_BINARY_KEY, &version, 1)) {
+                FURI_LOG_E(TAG, "Unable to add " SUBGHZ_RAW_BINARY_KEY);
+                break;
+            }
+            instance->binary_writer = subghz_raw_binary_writer_alloc(
+                flipper_format_get_raw_stream(instance->flipper_file));
+        }
+
         instance->upload_raw = malloc(SUBGHZ_DOWNLOAD_MAX_SIZE * sizeof(int32_t));
         instance->file_is_open = RAWFileIsOpenWrite;
         instance->sample_write = 0;
@@ -176,13 +190,19 @@ static bool subghz_protocol_raw_save_to_file_write(SubGhzProtocolDecoderRAW* ins
 
     bool is_write = false;
     if(instance->file_is_open == RAWFileIsOpenWrite) {
-        if(!flipper_format_write_int32(
+        if(instance->binary_writer) {
+            is_write = subghz_raw_binary_writer_add(
+                instance->binary_writer, instance->upload_raw, instance->ind_write);
+            if(!is_write) FURI_LOG_E(TAG, "Unable to add binary RAW data");
+        } else if(!flipper_format_write_int32(
                instance->flipper_file, "RAW_Data", instance->upload_raw, instance->ind_write)) {
             FURI_LOG_E(TAG, "Unable to add RAW_Data");
         } else {
+            is_write = true;
+        }
+        if(is_write) {
             instance->sample_write += instance->ind_write;
             instance->ind_write = 0;
-            is_write = true;
         }
     }
     return is_write;
@@ -193,6 +213,13 @@ void subghz_protocol_raw_save_to_file_stop(SubGhzProtocolDecoderRAW* instance) {
 
     if(instance->file_is_open == RAWFileIsOpenWrite && instance->ind_write)
         subghz_protocol_raw_save_to_file_write(instance);
+    if(instance->binary_writer) {
+        if(!subghz_raw_binary_writer_finish(instance->binary_writer)) {
+            FURI_LOG_E(TAG, "Unable to finish binary RAW data");
+        }
+        subghz_raw_binary_writer_free(instance->binary_writer);
+        instance->binary_writer = NULL;
+    }
     if(instance->file_is_open != RAWFileIsOpenClose) {
         free(instance->upload_raw);
         instance->upload_raw = NULL;
@@ -212,6 +239,13 @@ void subghz_protocol_raw_save_to_file_pause(SubGhzProtocolDecoderRAW* instance,
     }
 }
 
+void subghz_protocol_raw_save_to_file_set_binary(SubGhzProtocolDecoderRAW* instance, bool binary) {
+    furi_check(instance);
+    furi_check(instance->file_is_open == RAWFileIsOpenClose);
+
+    instance->binary = binary;
+}
+
 size_t subghz_protocol_raw_get_sample_write(SubGhzProtocolDecoderRAW* instance) {
     furi_check(instance);
     return instance->sample_write + instance->ind_write;
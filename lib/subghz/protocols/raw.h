@@ -35,6 +35,13 @@ bool subghz_protocol_raw_save_to_file_init(
  */
 void subghz_protocol_raw_save_to_file_stop(SubGhzProtocolDecoderRAW* instance);
 
+/**
+ * Select RAW file format for the following recordings
+ * @param instance Pointer to a SubGhzProtocolDecoderRAW instance
+ * @param binary true to write binary RAW data (see subghz_raw_binary.h), false for text
+ */
+void subghz_protocol_raw_save_to_file_set_binary(SubGhzProtocolDecoderRAW* instance, bool binary);
+
 /**
  * Get the number of samples received SubGhzProtocolDecoderRAW.
  * @param instance Pointer to a SubGhzProtocolDecoderRAW instance
@@ -29,6 +29,7 @@ struct SubGhzProtocolDecoderStarLine {
 
     uint16_t header_count;
     SubGhzKeystore* keystore;
+    SubGhzKeyCache* key_cache;
     const char* manufacture_name;
 
     FuriString* manufacture_from_file;
@@ -41,6 +42,7 @@ struct SubGhzProtocolEncoderStarLine {
     SubGhzBlockGeneric generic;
 
     SubGhzKeystore* keystore;
+    SubGhzKeyCache* key_cache;
     const char* manufacture_name;
 
     FuriString* manufacture_from_file;
@@ -93,11 +95,13 @@ const SubGhzProtocol subghz_protocol_star_line = {
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
  * @param keystore Pointer to a SubGhzKeystore* instance
+ * @param key_cache Pointer to a SubGhzKeyCache* instance
  * @param manufacture_name
  */
 static void subghz_protocol_star_line_check_remote_controller(
     SubGhzBlockGeneric* instance,
     SubGhzKeystore* keystore,
+    SubGhzKeyCache* key_cache,
     const char** manufacture_name);
 
 void* subghz_protocol_encoder_star_line_alloc(SubGhzEnvironment* environment) {
@@ -106,6 +110,7 @@ void* subghz_protocol_encoder_star_line_alloc(SubGhzEnvironment* environment) {
     instance->base.protocol = &subghz_protocol_star_line;
     instance->generic.protocol_name = instance->base.protocol->name;
     instance->keystore = subghz_environment_get_keystore(environment);
+    instance->key_cache = subghz_environment_get_key_cache(environment);
 
     instance->manufacture_from_file = furi_string_alloc();
 
@@ -301,7 +306,10 @@ SubGhzProtocolStatus
         }
 
         subghz_protocol_star_line_check_remote_controller(
-            &instance->generic, instance->keystore, &instance->manufacture_name);
+            &instance->generic,
+            instance->keystore,
+            instance->key_cache,
+            &instance->manufacture_name);
 
         //optional parameter parameter
         flipper_format_read_uint32(
@@ -361,6 +369,7 @@ void* subghz_protocol_decoder_star_line_alloc(SubGhzEnvironment* environment) {
     instance->manufacture_from_file = furi_string_alloc();
 
     instance->keystore = subghz_environment_get_keystore(environment);
+    instance->key_cache = subghz_environment_get_key_cache(environment);
 
     return instance;
 }
@@ -499,25 +508,118 @@ static inline bool subghz_protocol_star_line_check_decrypt(
     return false;
 }
 
-/** 
- * Checking the accepted code against the database manafacture key
+/**
+ * Checking the accepted code against one manufacture key
  * @param instance Pointer to a SubGhzBlockGeneric* instance
  * @param fix Fix part of the parcel
  * @param hop Hop encrypted part of the parcel
  * @param keystore Pointer to a SubGhzKeystore* instance
+ * @param manufacture_code Pointer to a SubGhzKey* of the keystore
  * @param manufacture_name 
- * @return true on successful search
+ * @return true if the key decrypts the parcel
  */
-static uint8_t subghz_protocol_star_line_check_remote_controller_selector(
+static bool subghz_protocol_star_line_check_key(
     SubGhzBlockGeneric* instance,
     uint32_t fix,
     uint32_t hop,
     SubGhzKeystore* keystore,
+    SubGhzKey* manufacture_code,
     const char** manufacture_name) {
     uint16_t end_serial = (uint16_t)(fix & 0xFF);
     uint8_t btn = (uint8_t)(fix >> 24);
     uint32_t decrypt = 0;
     uint64_t man_normal_learning;
+
+    switch(manufacture_code->type) {
+    case KEELOQ_LEARNING_SIMPLE:
+        // Simple Learning
+        decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
+        if(subghz_protocol_star_line_check_decrypt(instance, decrypt, btn, end_serial)) {
+            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+            keystore->mfname = *manufacture_name;
+            return true;
+        }
+        break;
+    case KEELOQ_LEARNING_NORMAL:
+        // Normal Learning
+        // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
+        man_normal_learning =
+            subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
+        decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_normal_learning);
+        if(subghz_protocol_star_line_check_decrypt(instance, decrypt, btn, end_serial)) {
+            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+            keystore->mfname = *manufacture_name;
+            return true;
+        }
+        break;
+    case KEELOQ_LEARNING_UNKNOWN:
+        // Simple Learning
+        decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
+        if(subghz_protocol_star_line_check_decrypt(instance, decrypt, btn, end_serial)) {
+            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+            keystore->mfname = *manufacture_name;
+            keystore->kl_type = 1;
+            return true;
+        }
+        // Check for mirrored man
+        uint64_t man_rev = 0;
+        uint64_t man_rev_byte = 0;
+        for(uint8_t i = 0; i < 64; i += 8) {
+            man_rev_byte = (uint8_t)(manufacture_code->key >> i);
+            man_rev = man_rev | man_rev_byte << (56 - i);
+        }
+        decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_rev);
+        if(subghz_protocol_star_line_check_decrypt(instance, decrypt, btn, end_serial)) {
+            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+            keystore->mfname = *manufacture_name;
+            keystore->kl_type = 1;
+            return true;
+        }
+        //###########################
+        // Normal Learning
+        // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
+        man_normal_learning =
+            subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
+        decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_normal_learning);
+        if(subghz_protocol_star_line_check_decrypt(instance, decrypt, btn, end_serial)) {
+            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+            keystore->mfname = *manufacture_name;
+            keystore->kl_type = 2;
+            return true;
+        }
+        // Check for mirrored man
+        man_normal_learning = subghz_protocol_keeloq_common_normal_learning(fix, man_rev);
+        decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_normal_learning);
+        if(subghz_protocol_star_line_check_decrypt(instance, decrypt, btn, end_serial)) {
+            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+            keystore->mfname = *manufacture_name;
+            keystore->kl_type = 2;
+            return true;
+        }
+        break;
+    }
+
+    return false;
+}
+
+/** 
+ * Checking the accepted code against the database manafacture key
+ * @param instance Pointer to a SubGhzBlockGeneric* instance
+ * @param fix Fix part of the parcel
+ * @param hop Hop encrypted part of the parcel
+ * @param keystore Pointer to a SubGhzKeystore* instance
+ * @param key_cache Pointer to a SubGhzKeyCache* instance
+ * @param manufacture_name 
+ * @return true on successful search
+ */
+static uint8_t subghz_protocol_star_line_check_remote_controller_selector(
+    SubGhzBlockGeneric* instance,
+    uint32_t fix,
+    uint32_t hop,
+    SubGhzKeystore* keystore,
+    SubGhzKeyCache* key_cache,
+    const char** manufacture_name) {
+    uint32_t serial = fix & 0x00FFFFFF;
     bool mf_not_set = false;
     // TODO:
     // if(mfname == 0x0) {
@@ -531,85 +633,34 @@ static uint8_t subghz_protocol_star_line_check_remote_controller_selector(
     } else if(strcmp(mfname, "") == 0) {
         mf_not_set = true;
     }
+
+    // Repeated presses of a known remote take one key trial instead of the whole keystore
+    SubGhzKeyArray_t* keys = subghz_keystore_get_data(keystore);
+    uint16_t cached_index = 0;
+    bool cached =
+        subghz_key_cache_get(key_cache, instance->protocol_name, serial, &cached_index) &&
+        cached_index < SubGhzKeyArray_size(*keys);
+    if(cached) {
+        SubGhzKey* manufacture_code = SubGhzKeyArray_get(*keys, cached_index);
+        if((mf_not_set || (strcmp(furi_string_get_cstr(manufacture_code->name), mfname) == 0)) &&
+           subghz_protocol_star_line_check_key(
+               instance, fix, hop, keystore, manufacture_code, manufacture_name)) {
+            return 1;
+        }
+    }
+
+    uint16_t index = 0;
     for
-        M_EACH(manufacture_code, *subghz_keystore_get_data(keystore), SubGhzKeyArray_t) {
-            if(mf_not_set || (strcmp(furi_string_get_cstr(manufacture_code->name), mfname) == 0)) {
-                switch(manufacture_code->type) {
-                case KEELOQ_LEARNING_SIMPLE:
-                    // Simple Learning
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                    if(subghz_protocol_star_line_check_decrypt(
-                           instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_NORMAL:
-                    // Normal Learning
-                    // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                    man_normal_learning =
-                        subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_normal_learning);
-                    if(subghz_protocol_star_line_check_decrypt(
-                           instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_UNKNOWN:
-                    // Simple Learning
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                    if(subghz_protocol_star_line_check_decrypt(
-                           instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 1;
-                        return 1;
-                    }
-                    // Check for mirrored man
-                    uint64_t man_rev = 0;
-                    uint64_t man_rev_byte = 0;
-                    for(uint8_t i = 0; i < 64; i += 8) {
-                        man_rev_byte = (uint8_t)(manufacture_code->key >> i);
-                        man_rev = man_rev | man_rev_byte << (56 - i);
-                    }
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_rev);
-                    if(subghz_protocol_star_line_check_decrypt(
-                           instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 1;
-                        return 1;
-                    }
-                    //###########################
-                    // Normal Learning
-                    // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                    man_normal_learning =
-                        subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_normal_learning);
-                    if(subghz_protocol_star_line_check_decrypt(
-                           instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 2;
-                        return 1;
-                    }
-                    // Check for mirrored man
-                    man_normal_learning =
-                        subghz_protocol_keeloq_common_normal_learning(fix, man_rev);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_normal_learning);
-                    if(subghz_protocol_star_line_check_decrypt(
-                           instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 2;
-                        return 1;
-                    }
-                    break;
-                }
+        M_EACH(manufacture_code, *keys, SubGhzKeyArray_t) {
+            if((!cached || index != cached_index) &&
+               (mf_not_set ||
+                (strcmp(furi_string_get_cstr(manufacture_code->name), mfname) == 0)) &&
+               subghz_protocol_star_line_check_key(
+                   instance, fix, hop, keystore, manufacture_code, manufacture_name)) {
+                subghz_key_cache_put(key_cache, instance->protocol_name, serial, index);
+                return 1;
             }
+            index++;
         }
 
     *manufacture_name = "Unknown";
@@ -623,18 +674,20 @@ static uint8_t subghz_protocol_star_line_check_remote_controller_selector(
  * Analysis of received data
  * @param instance Pointer to a SubGhzBlockGeneric* instance
  * @param keystore Pointer to a SubGhzKeystore* instance
+ * @param key_cache Pointer to a SubGhzKeyCache* instance
  * @param manufacture_name
  */
 static void subghz_protocol_star_line_check_remote_controller(
     SubGhzBlockGeneric* instance,
     SubGhzKeystore* keystore,
+    SubGhzKeyCache* key_cache,
     const char** manufacture_name) {
     uint64_t key = subghz_protocol_blocks_reverse_key(instance->data, instance->data_count_bit);
     uint32_t key_fix = key >> 32;
     uint32_t key_hop = key & 0x00000000ffffffff;
 
     subghz_protocol_star_line_check_remote_controller_selector(
-        instance, key_fix, key_hop, keystore, manufacture_name);
+        instance, key_fix, key_hop, keystore, key_cache, manufacture_name);
 
     instance->serial = key_fix & 0x00FFFFFF;
     instance->btn = key_fix >> 24;
@@ -654,7 +707,7 @@ SubGhzProtocolStatus subghz_protocol_decoder_star_line_serialize(
     furi_assert(context);
     SubGhzProtocolDecoderStarLine* instance = context;
     subghz_protocol_star_line_check_remote_controller(
-        &instance->generic, instance->keystore, &instance->manufacture_name);
+        &instance->generic, instance->keystore, instance->key_cache, &instance->manufacture_name);
     SubGhzProtocolStatus ret =
         subghz_block_generic_serialize(&instance->generic, flipper_format, preset);
 
@@ -705,7 +758,7 @@ void subghz_protocol_decoder_star_line_get_string(void* context, FuriString* out
     SubGhzProtocolDecoderStarLine* instance = context;
 
     subghz_protocol_star_line_check_remote_controller(
-        &instance->generic, instance->keystore, &instance->manufacture_name);
+        &instance->generic, instance->keystore, instance->key_cache, &instance->manufacture_name);
 
     uint32_t code_found_hi = instance->generic.data >> 32;
     uint32_t code_found_lo = instance->generic.data & 0x00000000ffffffff;
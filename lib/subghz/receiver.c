@@ -21,16 +21,28 @@ struct SubGhzReceiver {
 };
 
 SubGhzReceiver* subghz_receiver_alloc_init(SubGhzEnvironment* environment) {
+    return subghz_receiver_alloc_init_slice(environment, 0, 1);
+}
+
+SubGhzReceiver* subghz_receiver_alloc_init_slice(
+    SubGhzEnvironment* environment,
+    size_t slice,
+    size_t slice_count) {
+    furi_check(slice < slice_count);
+
     SubGhzReceiver* instance = malloc(sizeof(SubGhzReceiver));
     SubGhzReceiverSlotArray_init(instance->slots);
     const SubGhzProtocolRegistry* protocol_registry_items =
         subghz_environment_get_protocol_registry(environment);
 
+    size_t decoder_index = 0;
     for(size_t i = 0; i < subghz_protocol_registry_count(protocol_registry_items); ++i) {
         const SubGhzProtocol* protocol =
             subghz_protocol_registry_get_by_index(protocol_registry_items, i);
 
         if(protocol->decoder && protocol->decoder->alloc) {
+            // Decoders are dealt to slices in turn
+            if(decoder_index++ % slice_count != slice) continue;
             SubGhzReceiverSlot* slot = SubGhzReceiverSlotArray_push_new(instance->slots);
             slot->base = protocol->decoder->alloc(environment);
         }
@@ -21,6 +21,20 @@ typedef void (*SubGhzReceiverCallback)(
  */
 SubGhzReceiver* subghz_receiver_alloc_init(SubGhzEnvironment* environment);
 
+/**
+ * Allocate and init SubGhzReceiver with a part of the protocol decoders.
+ * Decoders of the registry are dealt to slice_count receivers in turn,
+ * together the slices hold every decoder exactly once.
+ * @param environment Pointer to a SubGhzEnvironment instance
+ * @param slice Index of the slice, less than slice_count
+ * @param slice_count Number of slices
+ * @return SubGhzReceiver* pointer to a SubGhzReceiver instance
+ */
+SubGhzReceiver* subghz_receiver_alloc_init_slice(
+    SubGhzEnvironment* environment,
+    size_t slice,
+    size_t slice_count);
+
 /**
  * Free SubGhzReceiver.
  * @param instance Pointer to a SubGhzReceiver instance
@@ -1,14 +1,30 @@
 #include "subghz_file_encoder_worker.h"
+#include "subghz_raw_binary.h"
 
 #include <toolbox/stream/stream.h>
 #include <flipper_format/flipper_format.h>
 #include <flipper_format/flipper_format_i.h>
 #include <lib/subghz/devices/devices.h>
-#include <lib/toolbox/strint.h>
+
+#include <m-array.h>
 
 #define TAG "SubGhzFileEncoderWorker"
 
-#define SUBGHZ_FILE_ENCODER_LOAD 512
+#define SUBGHZ_FILE_ENCODER_LOAD        512
+#define SUBGHZ_FILE_ENCODER_BUFFER      2048
+#define SUBGHZ_FILE_ENCODER_READ_SIZE   1024
+#define SUBGHZ_FILE_ENCODER_BINARY_LOAD 128
+#define SUBGHZ_FILE_ENCODER_KEY_SIZE    16
+
+#define SUBGHZ_FILE_ENCODER_PLAYLIST_KEY "sub"
+
+ARRAY_DEF(SubGhzFileEncoderPlaylist, FuriString*, FURI_STRING_OPLIST)
+
+typedef enum {
+    SubGhzFileEncoderParseKey,
+    SubGhzFileEncoderParseData,
+    SubGhzFileEncoderParseSkip,
+} SubGhzFileEncoderParse;
 
 struct SubGhzFileEncoderWorker {
     FuriThread* thread;
@@ -21,9 +37,32 @@ struct SubGhzFileEncoderWorker {
     volatile bool worker_stopping;
     bool is_storage_slow;
     FuriString* str_data;
-    FuriString* file_path;
+    SubGhzFileEncoderPlaylist_t playlist;
+    volatile size_t file_index;
+    SubGhzRawBinaryReader* binary_reader;
     const SubGhzDevice* device;
 
+    // Block reader and text parser state
+    uint8_t* read_buffer;
+    int32_t* binary_buffer;
+    size_t data_start;
+    SubGhzFileEncoderParse parse;
+    char key[SUBGHZ_FILE_ENCODER_KEY_SIZE];
+    size_t key_length;
+    int32_t value;
+    bool value_negative;
+    bool value_present;
+    uint64_t skip_us;
+
+    // Seek request, applied by the worker thread
+    volatile bool seek_pending;
+    volatile uint32_t seek_time;
+
+    // Consumer side, updated from the radio yield
+    uint64_t time_us;
+    volatile uint32_t underruns;
+    bool is_playing;
+
     SubGhzFileEncoderWorkerCallbackEnd callback_end;
     void* context_end;
 };
@@ -45,37 +84,92 @@ void subghz_file_encoder_worker_add_level_duration(
     if(sizeof(int32_t) != ret) FURI_LOG_E(TAG, "Invalid add duration in the stream");
 }
 
-bool subghz_file_encoder_worker_data_parse(SubGhzFileEncoderWorker* instance, const char* strStart) {
-    // Line sample: "RAW_Data: -1, 2, -2..."
+static void
+    subghz_file_encoder_worker_add_sample(SubGhzFileEncoderWorker* instance, int32_t duration) {
+    // Drop samples ending before the seek target
+    if(instance->skip_us) {
+        const uint32_t length = (duration < 0) ? -(uint32_t)duration : (uint32_t)duration;
+        if(length <= instance->skip_us) {
+            instance->skip_us -= length;
+            return;
+        }
+        instance->skip_us = 0;
+    }
 
-    // Look for the key in the line
-    char* str = strstr(strStart, "RAW_Data: ");
-    bool res = false;
+    if((duration < -1000000) || (duration > 1000000)) {
+        if(duration > 0) {
+            subghz_file_encoder_worker_add_level_duration(instance, (int32_t)100);
+        } else {
+            subghz_file_encoder_worker_add_level_duration(instance, (int32_t)-100);
+        }
+        //FURI_LOG_I("PARSE", "Number overflow - %d", duration);
+    } else {
+        subghz_file_encoder_worker_add_level_duration(instance, duration);
+    }
+}
+
+static void subghz_file_encoder_worker_parse_reset(SubGhzFileEncoderWorker* instance) {
+    instance->parse = SubGhzFileEncoderParseKey;
+    instance->key_length = 0;
+    instance->value = 0;
+    instance->value_negative = false;
+    instance->value_present = false;
+}
+
+static void subghz_file_encoder_worker_parse_value_end(SubGhzFileEncoderWorker* instance) {
+    if(instance->value_present) {
+        subghz_file_encoder_worker_add_sample(
+            instance, instance->value_negative ? -instance->value : instance->value);
+    }
+    instance->value = 0;
+    instance->value_negative = false;
+    instance->value_present = false;
+}
 
-    if(str) {
-        // Skip key
-        str = strchr(str, ' ');
-
-        // Parse next element
-        int32_t duration;
-        while(strint_to_int32(str, &str, &duration, 10) == StrintParseNoError) {
-            if((duration < -1000000) || (duration > 1000000)) {
-                if(duration > 0) {
-                    subghz_file_encoder_worker_add_level_duration(instance, (int32_t)100);
-                } else {
-                    subghz_file_encoder_worker_add_level_duration(instance, (int32_t)-100);
+/** Parse text RAW data, lines may be split across blocks
+ * 
+ * Line sample: "RAW_Data: -1, 2, -2...", lines with other keys are skipped
+ */
+static void subghz_file_encoder_worker_data_parse(
+    SubGhzFileEncoderWorker* instance,
+    const uint8_t* data,
+    size_t size) {
+    for(size_t i = 0; i < size; i++) {
+        const char c = data[i];
+        switch(instance->parse) {
+        case SubGhzFileEncoderParseKey:
+            if(c == ':') {
+                instance->key[instance->key_length] = '\0';
+                instance->parse = strcmp(instance->key, "RAW_Data") ?
+                                      SubGhzFileEncoderParseSkip :
+                                      SubGhzFileEncoderParseData;
+            } else if(c == '\n') {
+                instance->key_length = 0;
+            } else if(instance->key_length < SUBGHZ_FILE_ENCODER_KEY_SIZE - 1) {
+                instance->key[instance->key_length++] = c;
+            } else {
+                instance->parse = SubGhzFileEncoderParseSkip;
+            }
+            break;
+        case SubGhzFileEncoderParseData:
+            if(c >= '0' && c <= '9') {
+                // Saturate, anything this long is clamped on output anyway
+                if(instance->value < 100000000) {
+                    instance->value = instance->value * 10 + (c - '0');
                 }
-                //FURI_LOG_I("PARSE", "Number overflow - %d", duration);
+                instance->value_present = true;
+            } else if(c == '-') {
+                instance->value_negative = true;
             } else {
-                subghz_file_encoder_worker_add_level_duration(instance, duration);
+                subghz_file_encoder_worker_parse_value_end(instance);
+                if(c == '\n') subghz_file_encoder_worker_parse_reset(instance);
             }
-            if(*str == ',') str++; // could also be `\0`
+            break;
+        case SubGhzFileEncoderParseSkip:
+            if(c == '\n') subghz_file_encoder_worker_parse_reset(instance);
+            break;
         }
-
-        res = true;
     }
-
-    return res;
 }
 
 void subghz_file_encoder_worker_get_text_progress(
@@ -86,8 +180,22 @@ void subghz_file_encoder_worker_get_text_progress(
     size_t total_size = stream_size(stream);
     size_t current_offset = stream_tell(stream);
     size_t buffer_avail = furi_stream_buffer_bytes_available(instance->stream);
+    size_t percent = 0;
+    if(total_size && current_offset > buffer_avail) {
+        percent = MIN(100 * (current_offset - buffer_avail) / total_size, 100U);
+    }
 
-    furi_string_printf(output, "%03u%%", 100 * (current_offset - buffer_avail) / total_size);
+    size_t file_count = SubGhzFileEncoderPlaylist_size(instance->playlist);
+    if(file_count > 1) {
+        furi_string_printf(
+            output,
+            "%u/%u %03u%%",
+            MIN(instance->file_index + 1, file_count),
+            file_count,
+            percent);
+    } else {
+        furi_string_printf(output, "%03u%%", percent);
+    }
 }
 
 LevelDuration subghz_file_encoder_worker_get_level_duration(void* context) {
@@ -99,38 +207,36 @@ LevelDuration subghz_file_encoder_worker_get_level_duration(void* context) {
         LevelDuration level_duration = {.level = LEVEL_DURATION_RESET};
         if(duration < 0) {
             level_duration = level_duration_make(false, -duration);
+            instance->time_us += (uint32_t)-duration;
+            instance->is_playing = true;
         } else if(duration > 0) {
             level_duration = level_duration_make(true, duration);
+            instance->time_us += duration;
+            instance->is_playing = true;
         } else if(duration == 0) { //-V547
             level_duration = level_duration_reset();
             FURI_LOG_I(TAG, "Stop transmission");
             instance->worker_stopping = true;
+            instance->is_playing = false;
         }
         return level_duration;
     } else {
         instance->is_storage_slow = true;
+        // Waiting for the first sample is not an underrun
+        if(instance->is_playing) instance->underruns++;
         return level_duration_wait();
     }
 }
 
-/** Worker thread
- * 
- * @param context 
- * @return exit code 
- */
-static int32_t subghz_file_encoder_worker_thread(void* context) {
-    SubGhzFileEncoderWorker* instance = context;
-    FURI_LOG_I(TAG, "Worker start");
-    bool res = false;
-    instance->is_storage_slow = false;
+static bool subghz_file_encoder_worker_file_open(SubGhzFileEncoderWorker* instance) {
+    const char* file_path = furi_string_get_cstr(
+        *SubGhzFileEncoderPlaylist_get(instance->playlist, instance->file_index));
     Stream* stream = flipper_format_get_raw_stream(instance->flipper_format);
+    bool res = false;
+
     do {
-        if(!flipper_format_file_open_existing(
-               instance->flipper_format, furi_string_get_cstr(instance->file_path))) {
-            FURI_LOG_E(
-                TAG,
-                "Unable to open file for read: %s",
-                furi_string_get_cstr(instance->file_path));
+        if(!flipper_format_file_open_existing(instance->flipper_format, file_path)) {
+            FURI_LOG_E(TAG, "Unable to open file for read: %s", file_path);
             break;
         }
         if(!flipper_format_read_string(instance->flipper_format, "Protocol", instance->str_data)) {
@@ -140,32 +246,131 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
 
         //skip the end of the previous line "\n"
         stream_seek(stream, 1, StreamOffsetFromCurrent);
+
+        // Binary RAW data follows its key line, text data is parsed block by block
+        instance->data_start = stream_tell(stream);
+        if(stream_read_line(stream, instance->str_data) &&
+           furi_string_start_with_str(instance->str_data, SUBGHZ_RAW_BINARY_KEY ":")) {
+            instance->binary_reader = subghz_raw_binary_reader_alloc(stream);
+        } else {
+            stream_seek(stream, instance->data_start, StreamOffsetFromStart);
+        }
+        subghz_file_encoder_worker_parse_reset(instance);
+        instance->skip_us = 0;
         res = true;
-        instance->worker_stopping = false;
-        FURI_LOG_I(TAG, "Start transmission");
     } while(0);
 
-    while(res && instance->worker_running) {
-        size_t stream_free_byte = furi_stream_buffer_spaces_available(instance->stream);
-        if((stream_free_byte / sizeof(int32_t)) >= SUBGHZ_FILE_ENCODER_LOAD) {
-            if(stream_read_line(stream, instance->str_data)) {
-                furi_string_trim(instance->str_data);
-                if(!subghz_file_encoder_worker_data_parse(
-                       instance, furi_string_get_cstr(instance->str_data))) {
-                    subghz_file_encoder_worker_add_level_duration(instance, LEVEL_DURATION_RESET);
-                    break;
-                }
+    if(!res) flipper_format_file_close(instance->flipper_format);
+    return res;
+}
+
+static void subghz_file_encoder_worker_file_close(SubGhzFileEncoderWorker* instance) {
+    if(instance->binary_reader) {
+        subghz_raw_binary_reader_free(instance->binary_reader);
+        instance->binary_reader = NULL;
+    }
+    flipper_format_file_close(instance->flipper_format);
+}
+
+/** Move to the given time of the current file
+ * 
+ * Binary files use their seek index, text files are parsed from the beginning
+ * of data with samples dropped until the target time.
+ */
+static bool
+    subghz_file_encoder_worker_file_seek(SubGhzFileEncoderWorker* instance, uint32_t time_ms) {
+    if(instance->binary_reader) {
+        return subghz_raw_binary_reader_seek(instance->binary_reader, time_ms);
+    } else {
+        Stream* stream = flipper_format_get_raw_stream(instance->flipper_format);
+        subghz_file_encoder_worker_parse_reset(instance);
+        instance->skip_us = (uint64_t)time_ms * 1000;
+        return stream_seek(stream, instance->data_start, StreamOffsetFromStart);
+    }
+}
+
+/** Read and parse the next block of the current file
+ * 
+ * @return false at the end of file
+ */
+static bool subghz_file_encoder_worker_file_load(SubGhzFileEncoderWorker* instance) {
+    if(instance->binary_reader) {
+        size_t count = subghz_raw_binary_reader_read(
+            instance->binary_reader, instance->binary_buffer, SUBGHZ_FILE_ENCODER_BINARY_LOAD);
+        for(size_t i = 0; i < count; i++) {
+            subghz_file_encoder_worker_add_sample(instance, instance->binary_buffer[i]);
+        }
+        return count;
+    } else {
+        Stream* stream = flipper_format_get_raw_stream(instance->flipper_format);
+        size_t size = stream_read(stream, instance->read_buffer, SUBGHZ_FILE_ENCODER_READ_SIZE);
+        subghz_file_encoder_worker_data_parse(instance, instance->read_buffer, size);
+        if(!size) subghz_file_encoder_worker_parse_value_end(instance);
+        return size;
+    }
+}
+
+static void subghz_file_encoder_worker_seek_apply(SubGhzFileEncoderWorker* instance) {
+    const uint32_t time_ms = instance->seek_time;
+    instance->seek_pending = false;
+
+    // Drop prefetched samples, the radio continues from the new position
+    FURI_CRITICAL_ENTER();
+    furi_stream_buffer_reset(instance->stream);
+    instance->time_us = (uint64_t)time_ms * 1000;
+    FURI_CRITICAL_EXIT();
+
+    if(!subghz_file_encoder_worker_file_seek(instance, time_ms)) {
+        FURI_LOG_W(TAG, "Seek to %lums is beyond the end of file", time_ms);
+    }
+}
+
+/** Worker thread
+ * 
+ * Plays the playlist files back to back: the data is read in large blocks and
+ * parsed ahead of the radio, only the last file ends with a reset.
+ * 
+ * @param context 
+ * @return exit code 
+ */
+static int32_t subghz_file_encoder_worker_thread(void* context) {
+    SubGhzFileEncoderWorker* instance = context;
+    FURI_LOG_I(TAG, "Worker start");
+    bool res = false;
+    instance->is_storage_slow = false;
+
+    const size_t file_count = SubGhzFileEncoderPlaylist_size(instance->playlist);
+    for(instance->file_index = 0; instance->file_index < file_count && instance->worker_running;
+        instance->file_index++) {
+        if(!subghz_file_encoder_worker_file_open(instance)) continue;
+
+        if(!res) {
+            res = true;
+            instance->worker_stopping = false;
+            FURI_LOG_I(TAG, "Start transmission");
+        }
+
+        while(instance->worker_running) {
+            if(instance->seek_pending) {
+                subghz_file_encoder_worker_seek_apply(instance);
+            }
+            size_t stream_free_byte = furi_stream_buffer_spaces_available(instance->stream);
+            if((stream_free_byte / sizeof(int32_t)) >= SUBGHZ_FILE_ENCODER_LOAD) {
+                if(!subghz_file_encoder_worker_file_load(instance)) break;
             } else {
-                subghz_file_encoder_worker_add_level_duration(instance, LEVEL_DURATION_RESET);
-                break;
+                furi_delay_ms(1);
             }
-        } else {
-            furi_delay_ms(1);
         }
+
+        subghz_file_encoder_worker_file_close(instance);
+    }
+    if(res) {
+        subghz_file_encoder_worker_add_level_duration(instance, LEVEL_DURATION_RESET);
     }
+
     //waiting for the end of the transfer
     if(instance->is_storage_slow) {
-        FURI_LOG_E(TAG, "Storage is slow");
+        FURI_LOG_E(TAG, "Storage is slow, underruns: %lu", instance->underruns);
     }
 
     FURI_LOG_I(TAG, "End read file");
@@ -181,7 +386,6 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
         }
         furi_delay_ms(50);
     }
-    flipper_format_file_close(instance->flipper_format);
 
     FURI_LOG_I(TAG, "Worker stop");
     return 0;
@@ -192,13 +396,16 @@ SubGhzFileEncoderWorker* subghz_file_encoder_worker_alloc(void) {
 
     instance->thread =
         furi_thread_alloc_ex("SubGhzFEWorker", 2048, subghz_file_encoder_worker_thread, instance);
-    instance->stream = furi_stream_buffer_alloc(sizeof(int32_t) * 2048, sizeof(int32_t));
+    instance->stream = furi_stream_buffer_alloc(
+        sizeof(int32_t) * SUBGHZ_FILE_ENCODER_BUFFER, sizeof(int32_t));
 
     instance->storage = furi_record_open(RECORD_STORAGE);
     instance->flipper_format = flipper_format_file_alloc(instance->storage);
 
     instance->str_data = furi_string_alloc();
-    instance->file_path = furi_string_alloc();
+    SubGhzFileEncoderPlaylist_init(instance->playlist);
+    instance->read_buffer = malloc(SUBGHZ_FILE_ENCODER_READ_SIZE);
+    instance->binary_buffer = malloc(sizeof(int32_t) * SUBGHZ_FILE_ENCODER_BINARY_LOAD);
     instance->worker_stopping = true;
 
     return instance;
@@ -211,7 +418,9 @@ void subghz_file_encoder_worker_free(SubGhzFileEncoderWorker* instance) {
     furi_thread_free(instance->thread);
 
     furi_string_free(instance->str_data);
-    furi_string_free(instance->file_path);
+    SubGhzFileEncoderPlaylist_clear(instance->playlist);
+    free(instance->read_buffer);
+    free(instance->binary_buffer);
 
     flipper_format_free(instance->flipper_format);
     furi_record_close(RECORD_STORAGE);
@@ -219,6 +428,68 @@ void subghz_file_encoder_worker_free(SubGhzFileEncoderWorker* instance) {
     free(instance);
 }
 
+void subghz_file_encoder_worker_add_file(
+    SubGhzFileEncoderWorker* instance,
+    const char* file_path) {
+    furi_assert(instance);
+    furi_assert(file_path);
+    furi_assert(!instance->worker_running);
+
+    FuriString* path = furi_string_alloc_set(file_path);
+    SubGhzFileEncoderPlaylist_push_back(instance->playlist, path);
+    furi_string_free(path);
+}
+
+size_t subghz_file_encoder_worker_load_playlist(
+    SubGhzFileEncoderWorker* instance,
+    const char* playlist_path) {
+    furi_assert(instance);
+    furi_assert(playlist_path);
+
+    FlipperFormat* flipper_format = flipper_format_file_alloc(instance->storage);
+    size_t count = 0;
+
+    if(flipper_format_file_open_existing(flipper_format, playlist_path)) {
+        while(flipper_format_read_string(
+            flipper_format, SUBGHZ_FILE_ENCODER_PLAYLIST_KEY, instance->str_data)) {
+            subghz_file_encoder_worker_add_file(
+                instance, furi_string_get_cstr(instance->str_data));
+            count++;
+        }
+    } else {
+        FURI_LOG_E(TAG, "Unable to open playlist: %s", playlist_path);
+    }
+
+    flipper_format_free(flipper_format);
+    return count;
+}
+
+const char*
+    subghz_file_encoder_worker_get_file_path(SubGhzFileEncoderWorker* instance, size_t index) {
+    furi_assert(instance);
+    if(index >= SubGhzFileEncoderPlaylist_size(instance->playlist)) return NULL;
+    return furi_string_get_cstr(*SubGhzFileEncoderPlaylist_get(instance->playlist, index));
+}
+
+void subghz_file_encoder_worker_seek(SubGhzFileEncoderWorker* instance, uint32_t time_ms) {
+    furi_assert(instance);
+    instance->seek_time = time_ms;
+    instance->seek_pending = true;
+}
+
+uint32_t subghz_file_encoder_worker_get_time(SubGhzFileEncoderWorker* instance) {
+    furi_assert(instance);
+    FURI_CRITICAL_ENTER();
+    uint64_t time_us = instance->time_us;
+    FURI_CRITICAL_EXIT();
+    return time_us / 1000;
+}
+
+uint32_t subghz_file_encoder_worker_get_underruns(SubGhzFileEncoderWorker* instance) {
+    furi_assert(instance);
+    return instance->underruns;
+}
+
 bool subghz_file_encoder_worker_start(
     SubGhzFileEncoderWorker* instance,
     const char* file_path,
@@ -227,7 +498,13 @@ bool subghz_file_encoder_worker_start(
     furi_assert(!instance->worker_running);
 
     furi_stream_buffer_reset(instance->stream);
-    furi_string_set(instance->file_path, file_path);
+    if(file_path) {
+        SubGhzFileEncoderPlaylist_reset(instance->playlist);
+        subghz_file_encoder_worker_add_file(instance, file_path);
+    }
+    instance->time_us = instance->seek_pending ? (uint64_t)instance->seek_time * 1000 : 0;
+    instance->underruns = 0;
+    instance->is_playing = false;
     if(radio_device_name) {
         instance->device = subghz_devices_get_by_name(radio_device_name);
     }
@@ -49,9 +49,60 @@ void subghz_file_encoder_worker_get_text_progress(
 LevelDuration subghz_file_encoder_worker_get_level_duration(void* context);
 
 /** 
- * Start SubGhzFileEncoderWorker.
+ * Add file to the playlist, files are played back to back without gaps.
+ * Files are expected to share frequency and preset.
  * @param instance Pointer to a SubGhzFileEncoderWorker instance
  * @param file_path File path
+ */
+void subghz_file_encoder_worker_add_file(
+    SubGhzFileEncoderWorker* instance,
+    const char* file_path);
+
+/** 
+ * Add files listed in a playlist file ("sub: <path>" lines) to the playlist.
+ * @param instance Pointer to a SubGhzFileEncoderWorker instance
+ * @param playlist_path Playlist file path
+ * @return size_t - number of files added
+ */
+size_t subghz_file_encoder_worker_load_playlist(
+    SubGhzFileEncoderWorker* instance,
+    const char* playlist_path);
+
+/** 
+ * Get path of a playlist file.
+ * @param instance Pointer to a SubGhzFileEncoderWorker instance
+ * @param index File index
+ * @return const char* - file path, NULL if index is out of the playlist
+ */
+const char*
+    subghz_file_encoder_worker_get_file_path(SubGhzFileEncoderWorker* instance, size_t index);
+
+/** 
+ * Move playback to the given time of the file being played.
+ * Before start, sets the start time of the first file.
+ * @param instance Pointer to a SubGhzFileEncoderWorker instance
+ * @param time_ms Time from the start of file, ms
+ */
+void subghz_file_encoder_worker_seek(SubGhzFileEncoderWorker* instance, uint32_t time_ms);
+
+/** 
+ * Get playback time of the samples handed to the radio.
+ * @param instance Pointer to a SubGhzFileEncoderWorker instance
+ * @return uint32_t - time, ms
+ */
+uint32_t subghz_file_encoder_worker_get_time(SubGhzFileEncoderWorker* instance);
+
+/** 
+ * Get number of times the radio found the buffer empty during playback.
+ * @param instance Pointer to a SubGhzFileEncoderWorker instance
+ * @return uint32_t - underrun count
+ */
+uint32_t subghz_file_encoder_worker_get_underruns(SubGhzFileEncoderWorker* instance);
+
+/** 
+ * Start SubGhzFileEncoderWorker.
+ * @param instance Pointer to a SubGhzFileEncoderWorker instance
+ * @param file_path File path, NULL to play the files added to the playlist
  * @param radio_device_name Radio device name
  * @return bool - true if ok
  */
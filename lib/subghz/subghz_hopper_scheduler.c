@@ -0,0 +1,163 @@
+#include "subghz_hopper_scheduler.h"
+
+#include <furi.h>
+
+/** Weight of the RSSI running average of a channel, 1/8 of the new measurement */
+#define SUBGHZ_HOPPER_SCHEDULER_RSSI_ALPHA 0.125f
+/** Weight of the decode rate of previous visits */
+#define SUBGHZ_HOPPER_SCHEDULER_HIT_DECAY  0.75f
+/** Activity score of one decoded signal per visit, dB equivalent */
+#define SUBGHZ_HOPPER_SCHEDULER_HIT_WEIGHT 10.0f
+/** RSSI above the quietest channel that is still considered noise, dB */
+#define SUBGHZ_HOPPER_SCHEDULER_NOISE      3.0f
+
+typedef struct {
+    SubGhzHopperSchedulerStats stats;
+    float hit_rate;
+    uint32_t visit_hits;
+} SubGhzHopperSchedulerChannel;
+
+struct SubGhzHopperScheduler {
+    SubGhzHopperSchedulerChannel* channels;
+    size_t channel_count;
+    uint32_t revisit_ticks;
+
+    size_t channel;
+    uint32_t channel_ticks;
+};
+
+SubGhzHopperScheduler*
+    subghz_hopper_scheduler_alloc(size_t channel_count, uint32_t revisit_ticks) {
+    SubGhzHopperScheduler* instance = malloc(sizeof(SubGhzHopperScheduler));
+    instance->channel_count = channel_count;
+    instance->revisit_ticks = MAX(revisit_ticks, channel_count);
+    instance->channels = malloc(sizeof(SubGhzHopperSchedulerChannel) * MAX(channel_count, 1U));
+    subghz_hopper_scheduler_reset(instance);
+    return instance;
+}
+
+void subghz_hopper_scheduler_free(SubGhzHopperScheduler* instance) {
+    furi_check(instance);
+    free(instance->channels);
+    free(instance);
+}
+
+void subghz_hopper_scheduler_reset(SubGhzHopperScheduler* instance) {
+    furi_check(instance);
+    memset(instance->channels, 0, sizeof(SubGhzHopperSchedulerChannel) * instance->channel_count);
+    for(size_t i = 0; i < instance->channel_count; i++) {
+        instance->channels[i].stats.dwell = 1;
+    }
+    instance->channel = 0;
+    instance->channel_ticks = 0;
+    if(instance->channel_count) instance->channels[0].stats.visits = 1;
+}
+
+void subghz_hopper_scheduler_add_rssi(SubGhzHopperScheduler* instance, float rssi) {
+    furi_check(instance);
+    if(!instance->channel_count) return;
+
+    SubGhzHopperSchedulerChannel* channel = &instance->channels[instance->channel];
+    if(channel->stats.ticks == 0 && instance->channel_ticks == 0) {
+        channel->stats.rssi = rssi;
+    } else {
+        channel->stats.rssi += (rssi - channel->stats.rssi) * SUBGHZ_HOPPER_SCHEDULER_RSSI_ALPHA;
+    }
+}
+
+void subghz_hopper_scheduler_add_hit(SubGhzHopperScheduler* instance) {
+    furi_check(instance);
+    if(!instance->channel_count) return;
+
+    SubGhzHopperSchedulerChannel* channel = &instance->channels[instance->channel];
+    channel->stats.hits++;
+    channel->visit_hits++;
+}
+
+bool subghz_hopper_scheduler_tick(SubGhzHopperScheduler* instance) {
+    furi_check(instance);
+    if(!instance->channel_count) return false;
+
+    SubGhzHopperSchedulerChannel* channel = &instance->channels[instance->channel];
+    channel->stats.ticks++;
+    instance->channel_ticks++;
+    return instance->channel_ticks >= channel->stats.dwell;
+}
+
+static float
+    subghz_hopper_scheduler_get_weight(SubGhzHopperSchedulerChannel* channel, float rssi_floor) {
+    float weight = channel->hit_rate * SUBGHZ_HOPPER_SCHEDULER_HIT_WEIGHT;
+    if(channel->stats.ticks) {
+        float activity = channel->stats.rssi - rssi_floor - SUBGHZ_HOPPER_SCHEDULER_NOISE;
+        if(activity > 0.0f) weight += activity;
+    }
+    return weight;
+}
+
+size_t subghz_hopper_scheduler_next(SubGhzHopperScheduler* instance) {
+    furi_check(instance);
+    if(!instance->channel_count) return 0;
+
+    // Close the visit of the current channel
+    SubGhzHopperSchedulerChannel* channel = &instance->channels[instance->channel];
+    channel->hit_rate = channel->hit_rate * SUBGHZ_HOPPER_SCHEDULER_HIT_DECAY +
+                        channel->visit_hits * (1.0f - SUBGHZ_HOPPER_SCHEDULER_HIT_DECAY);
+    channel->visit_hits = 0;
+
+    instance->channel = (instance->channel + 1) % instance->channel_count;
+    instance->channel_ticks = 0;
+    channel = &instance->channels[instance->channel];
+    channel->stats.visits++;
+
+    // Quietest measured channel is the noise reference
+    float rssi_floor = 0.0f;
+    bool rssi_floor_valid = false;
+    for(size_t i = 0; i < instance->channel_count; i++) {
+        if(!instance->channels[i].stats.ticks) continue;
+        if(!rssi_floor_valid || instance->channels[i].stats.rssi < rssi_floor) {
+            rssi_floor = instance->channels[i].stats.rssi;
+            rssi_floor_valid = true;
+        }
+    }
+
+    // Share of the spare cycle ticks proportional to the channel activity
+    float total_weight = 0.0f;
+    for(size_t i = 0; i < instance->channel_count; i++) {
+        total_weight += subghz_hopper_scheduler_get_weight(&instance->channels[i], rssi_floor);
+    }
+    uint32_t dwell = 1;
+    if(total_weight > 0.0f) {
+        const uint32_t spare_ticks = instance->revisit_ticks - instance->channel_count;
+        const float weight = subghz_hopper_scheduler_get_weight(channel, rssi_floor);
+        dwell += (uint32_t)(spare_ticks * weight / total_weight);
+    }
+
+    // Any channel cycle, this visit and the last ones of the other channels, fits revisit time
+    uint32_t others_ticks = 0;
+    for(size_t i = 0; i < instance->channel_count; i++) {
+        if(i != instance->channel) others_ticks += instance->channels[i].stats.dwell;
+    }
+    channel->stats.dwell = MIN(dwell, instance->revisit_ticks - others_ticks);
+
+    return instance->channel;
+}
+
+size_t subghz_hopper_scheduler_get_channel(SubGhzHopperScheduler* instance) {
+    furi_check(instance);
+    return instance->channel;
+}
+
+size_t subghz_hopper_scheduler_get_channel_count(SubGhzHopperScheduler* instance) {
+    furi_check(instance);
+    return instance->channel_count;
+}
+
+void subghz_hopper_scheduler_get_stats(
+    SubGhzHopperScheduler* instance,
+    size_t channel,
+    SubGhzHopperSchedulerStats* stats) {
+    furi_check(instance);
+    furi_check(channel < instance->channel_count);
+    furi_check(stats);
+    *stats = instance->channels[channel].stats;
+}
@@ -0,0 +1,110 @@
+/**
+ * @file subghz_hopper_scheduler.h
+ * Adaptive frequency hopping scheduler
+ *
+ * Channels are visited in round-robin order, so every channel is revisited
+ * within one hopping cycle. The cycle length is bounded by the revisit time,
+ * ticks left after one tick per channel are shared between channels
+ * proportionally to their activity: average RSSI above the quietest channel
+ * and the rate of decoded signals. Quiet bands get the minimal dwell time.
+ *
+ * The scheduler only keeps statistics and decides when and where to hop,
+ * radio control is up to the caller. This keeps it usable with simulated
+ * RSSI traces.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct SubGhzHopperScheduler SubGhzHopperScheduler;
+
+/** Channel statistics */
+typedef struct {
+    float rssi; /**< Average RSSI, dBm */
+    uint32_t hits; /**< Decoded signals */
+    uint32_t visits; /**< Number of visits */
+    uint32_t ticks; /**< Total ticks spent on the channel */
+    uint32_t dwell; /**< Ticks planned for the next visit */
+} SubGhzHopperSchedulerStats;
+
+/**
+ * Allocate SubGhzHopperScheduler, starting on the first channel
+ * @param channel_count number of channels
+ * @param revisit_ticks maximum ticks between visits of a channel, at least one tick per channel
+ * @return SubGhzHopperScheduler*
+ */
+SubGhzHopperScheduler* subghz_hopper_scheduler_alloc(size_t channel_count, uint32_t revisit_ticks);
+
+/**
+ * Free SubGhzHopperScheduler
+ * @param instance SubGhzHopperScheduler instance
+ */
+void subghz_hopper_scheduler_free(SubGhzHopperScheduler* instance);
+
+/**
+ * Forget statistics and start over from the first channel
+ * @param instance SubGhzHopperScheduler instance
+ */
+void subghz_hopper_scheduler_reset(SubGhzHopperScheduler* instance);
+
+/**
+ * Add RSSI measurement of the current channel
+ * @param instance SubGhzHopperScheduler instance
+ * @param rssi RSSI, dBm
+ */
+void subghz_hopper_scheduler_add_rssi(SubGhzHopperScheduler* instance, float rssi);
+
+/**
+ * Count a signal decoded on the current channel
+ * @param instance SubGhzHopperScheduler instance
+ */
+void subghz_hopper_scheduler_add_hit(SubGhzHopperScheduler* instance);
+
+/**
+ * Account one tick on the current channel
+ * @param instance SubGhzHopperScheduler instance
+ * @return true if the dwell time is over and it is time to hop
+ */
+bool subghz_hopper_scheduler_tick(SubGhzHopperScheduler* instance);
+
+/**
+ * Move to the next channel
+ * @param instance SubGhzHopperScheduler instance
+ * @return index of the new current channel
+ */
+size_t subghz_hopper_scheduler_next(SubGhzHopperScheduler* instance);
+
+/**
+ * Get current channel
+ * @param instance SubGhzHopperScheduler instance
+ * @return channel index
+ */
+size_t subghz_hopper_scheduler_get_channel(SubGhzHopperScheduler* instance);
+
+/**
+ * Get number of channels
+ * @param instance SubGhzHopperScheduler instance
+ * @return channel count
+ */
+size_t subghz_hopper_scheduler_get_channel_count(SubGhzHopperScheduler* instance);
+
+/**
+ * Get channel statistics
+ * @param instance SubGhzHopperScheduler instance
+ * @param channel channel index
+ * @param stats output statistics
+ */
+void subghz_hopper_scheduler_get_stats(
+    SubGhzHopperScheduler* instance,
+    size_t channel,
+    SubGhzHopperSchedulerStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
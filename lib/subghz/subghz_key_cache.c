@@ -0,0 +1,118 @@
+#include "subghz_key_cache.h"
+
+#include <furi.h>
+
+/** Number of remotes, power of two */
+#define SUBGHZ_KEY_CACHE_SIZE  64
+/** Slots looked up from the hash position */
+#define SUBGHZ_KEY_CACHE_PROBE 8
+
+typedef struct {
+    const char* protocol;
+    uint32_t serial;
+    uint32_t stamp;
+    uint16_t key_index;
+} SubGhzKeyCacheEntry;
+
+struct SubGhzKeyCache {
+    SubGhzKeyCacheEntry entries[SUBGHZ_KEY_CACHE_SIZE];
+    uint32_t stamp;
+    SubGhzKeyCacheStats stats;
+};
+
+static size_t subghz_key_cache_hash(const char* protocol, uint32_t serial) {
+    uint32_t hash = (serial ^ (uint32_t)(uintptr_t)protocol) * 2654435761UL;
+    return (hash >> 16) & (SUBGHZ_KEY_CACHE_SIZE - 1);
+}
+
+static SubGhzKeyCacheEntry*
+    subghz_key_cache_find(SubGhzKeyCache* instance, const char* protocol, uint32_t serial) {
+    size_t slot = subghz_key_cache_hash(protocol, serial);
+    for(size_t i = 0; i < SUBGHZ_KEY_CACHE_PROBE; i++) {
+        SubGhzKeyCacheEntry* entry = &instance->entries[(slot + i) & (SUBGHZ_KEY_CACHE_SIZE - 1)];
+        if(entry->protocol == protocol && entry->serial == serial) return entry;
+    }
+    return NULL;
+}
+
+SubGhzKeyCache* subghz_key_cache_alloc(void) {
+    SubGhzKeyCache* instance = malloc(sizeof(SubGhzKeyCache));
+    return instance;
+}
+
+void subghz_key_cache_free(SubGhzKeyCache* instance) {
+    furi_check(instance);
+    free(instance);
+}
+
+void subghz_key_cache_reset(SubGhzKeyCache* instance) {
+    furi_check(instance);
+    FURI_CRITICAL_ENTER();
+    memset(instance, 0, sizeof(SubGhzKeyCache));
+    FURI_CRITICAL_EXIT();
+}
+
+bool subghz_key_cache_get(
+    SubGhzKeyCache* instance,
+    const char* protocol,
+    uint32_t serial,
+    uint16_t* key_index) {
+    furi_check(instance);
+    furi_check(protocol);
+    furi_check(key_index);
+
+    bool found = false;
+    // Decoders of different threads share the environment
+    FURI_CRITICAL_ENTER();
+    SubGhzKeyCacheEntry* entry = subghz_key_cache_find(instance, protocol, serial);
+    if(entry) {
+        entry->stamp = ++instance->stamp;
+        *key_index = entry->key_index;
+        instance->stats.hits++;
+        found = true;
+    } else {
+        instance->stats.misses++;
+    }
+    FURI_CRITICAL_EXIT();
+
+    return found;
+}
+
+void subghz_key_cache_put(
+    SubGhzKeyCache* instance,
+    const char* protocol,
+    uint32_t serial,
+    uint16_t key_index) {
+    furi_check(instance);
+    furi_check(protocol);
+
+    FURI_CRITICAL_ENTER();
+    SubGhzKeyCacheEntry* entry = subghz_key_cache_find(instance, protocol, serial);
+    if(!entry) {
+        // Free slot or the least recently used one in the probe window
+        size_t slot = subghz_key_cache_hash(protocol, serial);
+        for(size_t i = 0; i < SUBGHZ_KEY_CACHE_PROBE; i++) {
+            SubGhzKeyCacheEntry* candidate =
+                &instance->entries[(slot + i) & (SUBGHZ_KEY_CACHE_SIZE - 1)];
+            if(!candidate->protocol) {
+                entry = candidate;
+                break;
+            }
+            if(!entry || candidate->stamp < entry->stamp) entry = candidate;
+        }
+        if(!entry->protocol) instance->stats.entries++;
+        entry->protocol = protocol;
+        entry->serial = serial;
+    }
+    entry->key_index = key_index;
+    entry->stamp = ++instance->stamp;
+    FURI_CRITICAL_EXIT();
+}
+
+void subghz_key_cache_get_stats(SubGhzKeyCache* instance, SubGhzKeyCacheStats* stats) {
+    furi_check(instance);
+    furi_check(stats);
+    FURI_CRITICAL_ENTER();
+    *stats = instance->stats;
+    FURI_CRITICAL_EXIT();
+}
@@ -0,0 +1,82 @@
+/**
+ * @file subghz_key_cache.h
+ * Cache of manufacturer keys found for rolling code remotes
+ *
+ * Remembers which keystore entry decrypted a remote, identified by protocol
+ * and serial number. Repeated presses of the same remote then try that key
+ * first instead of searching the whole keystore.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct SubGhzKeyCache SubGhzKeyCache;
+
+/** Cache statistics */
+typedef struct {
+    uint32_t hits; /**< Lookups answered by the cache */
+    uint32_t misses; /**< Lookups not answered, full search */
+    size_t entries; /**< Remotes in the cache */
+} SubGhzKeyCacheStats;
+
+/**
+ * Allocate SubGhzKeyCache
+ * @return SubGhzKeyCache*
+ */
+SubGhzKeyCache* subghz_key_cache_alloc(void);
+
+/**
+ * Free SubGhzKeyCache
+ * @param instance SubGhzKeyCache instance
+ */
+void subghz_key_cache_free(SubGhzKeyCache* instance);
+
+/**
+ * Forget all remotes and statistics, keystore indexes are no longer valid
+ * @param instance SubGhzKeyCache instance
+ */
+void subghz_key_cache_reset(SubGhzKeyCache* instance);
+
+/**
+ * Find the key of a remote
+ * @param instance SubGhzKeyCache instance
+ * @param protocol protocol name, compared by pointer
+ * @param serial serial number of the remote
+ * @param key_index output keystore index of the key
+ * @return true if the remote is in the cache
+ */
+bool subghz_key_cache_get(
+    SubGhzKeyCache* instance,
+    const char* protocol,
+    uint32_t serial,
+    uint16_t* key_index);
+
+/**
+ * Remember the key of a remote, the oldest remote is replaced if there is no room
+ * @param instance SubGhzKeyCache instance
+ * @param protocol protocol name, compared by pointer
+ * @param serial serial number of the remote
+ * @param key_index keystore index of the key
+ */
+void subghz_key_cache_put(
+    SubGhzKeyCache* instance,
+    const char* protocol,
+    uint32_t serial,
+    uint16_t key_index);
+
+/**
+ * Get cache statistics
+ * @param instance SubGhzKeyCache instance
+ * @param stats output statistics
+ */
+void subghz_key_cache_get_stats(SubGhzKeyCache* instance, SubGhzKeyCacheStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,478 @@
+#include "subghz_raw_analyzer.h"
+#include "subghz_file_encoder_worker.h"
+
+#include <flipper_format/flipper_format.h>
+
+#include <m-array.h>
+
+#define TAG "SubGhzRawAnalyzer"
+
+#define SUBGHZ_RAW_ANALYZER_CHUNK_SAMPLES 512
+#define SUBGHZ_RAW_ANALYZER_THREADS_MAX   4
+
+#define SUBGHZ_RAW_ANALYZER_FLAG_CHUNK (1UL << 0)
+#define SUBGHZ_RAW_ANALYZER_FLAG_EXIT  (1UL << 1)
+
+typedef struct {
+    uint64_t time;
+    size_t slice;
+    FlipperFormat* data;
+} SubGhzRawAnalyzerResult;
+
+ARRAY_DEF(SubGhzRawAnalyzerResultArray, SubGhzRawAnalyzerResult, M_POD_OPLIST)
+
+typedef struct {
+    int32_t samples[SUBGHZ_RAW_ANALYZER_CHUNK_SAMPLES];
+    size_t count;
+    uint64_t time;
+} SubGhzRawAnalyzerChunk;
+
+typedef struct {
+    SubGhzRawAnalyzer* analyzer;
+    size_t index;
+    FuriThread* thread;
+    SubGhzReceiver* receiver;
+    uint64_t time;
+    SubGhzRawAnalyzerResultArray_t results;
+} SubGhzRawAnalyzerSlice;
+
+struct SubGhzRawAnalyzer {
+    FuriThread* thread;
+    SubGhzFileEncoderWorker* reader;
+    SubGhzRadioPreset* preset;
+
+    SubGhzRawAnalyzerSlice* slices;
+    size_t slice_count;
+    FuriSemaphore* slice_done;
+
+    // Chunk being decoded and the one being read
+    SubGhzRawAnalyzerChunk chunks[2];
+    volatile size_t chunk_index;
+    bool chunk_pending;
+    uint64_t read_time;
+
+    // Merge of the results
+    SubGhzReceiver* output;
+    SubGhzRawAnalyzerResultArray_t results;
+    FuriString* protocol_name;
+    uint64_t result_time;
+
+    // Results kept for subghz_raw_analyzer_process_results, guarded by lock
+    FuriMutex* lock;
+    SubGhzRawAnalyzerResultArray_t pending;
+    SubGhzRawAnalyzerResultArray_t processing;
+
+    volatile bool running;
+    volatile bool finished;
+    bool paused;
+
+    SubGhzReceiverCallback callback;
+    void* context;
+    SubGhzRawAnalyzerCallbackEnd callback_end;
+    void* context_end;
+    SubGhzRawAnalyzerCallbackResults callback_results;
+    void* context_results;
+};
+
+static void subghz_raw_analyzer_slice_rx_callback(
+    SubGhzReceiver* receiver,
+    SubGhzProtocolDecoderBase* decoder_base,
+    void* context) {
+    UNUSED(receiver);
+    SubGhzRawAnalyzerSlice* slice = context;
+
+    // Decoder state moves on with the next samples, keep the result serialized
+    SubGhzRawAnalyzerResult* result = SubGhzRawAnalyzerResultArray_push_new(slice->results);
+    result->time = slice->time;
+    result->slice = slice->index;
+    result->data = flipper_format_string_alloc();
+    if(subghz_protocol_decoder_base_serialize(
+           decoder_base, result->data, slice->analyzer->preset) != SubGhzProtocolStatusOk) {
+        FURI_LOG_W(TAG, "Unable to serialize %s", decoder_base->protocol->name);
+    }
+}
+
+static int32_t subghz_raw_analyzer_slice_thread(void* context) {
+    SubGhzRawAnalyzerSlice* slice = context;
+    SubGhzRawAnalyzer* instance = slice->analyzer;
+
+    while(true) {
+        uint32_t flags = furi_thread_flags_wait(
+            SUBGHZ_RAW_ANALYZER_FLAG_CHUNK | SUBGHZ_RAW_ANALYZER_FLAG_EXIT,
+            FuriFlagWaitAny,
+            FuriWaitForever);
+        if(flags & SUBGHZ_RAW_ANALYZER_FLAG_EXIT) break;
+
+        const SubGhzRawAnalyzerChunk* chunk = &instance->chunks[instance->chunk_index];
+        slice->time = chunk->time;
+        for(size_t i = 0; i < chunk->count; i++) {
+            const int32_t sample = chunk->samples[i];
+            const bool level = sample > 0;
+            const uint32_t duration = level ? sample : -sample;
+            slice->time += duration;
+            subghz_receiver_decode(slice->receiver, level, duration);
+        }
+
+        furi_semaphore_release(instance->slice_done);
+    }
+
+    return 0;
+}
+
+static int subghz_raw_analyzer_result_compare(const void* a, const void* b) {
+    const SubGhzRawAnalyzerResult* result_a = a;
+    const SubGhzRawAnalyzerResult* result_b = b;
+    if(result_a->time != result_b->time) return (result_a->time < result_b->time) ? -1 : 1;
+    return (int)result_a->slice - (int)result_b->slice;
+}
+
+static void subghz_raw_analyzer_results_free(SubGhzRawAnalyzerResultArray_t results) {
+    for
+        M_EACH(result, results, SubGhzRawAnalyzerResultArray_t) {
+            flipper_format_free(result->data);
+        }
+    SubGhzRawAnalyzerResultArray_reset(results);
+}
+
+/** Call the rx callback for every result, in order, and free them */
+static void subghz_raw_analyzer_report(
+    SubGhzRawAnalyzer* instance,
+    SubGhzRawAnalyzerResultArray_t results) {
+    for
+        M_EACH(result, results, SubGhzRawAnalyzerResultArray_t) {
+            // Restore the result into the decoder of the output receiver
+            SubGhzProtocolDecoderBase* decoder = NULL;
+            flipper_format_rewind(result->data);
+            if(flipper_format_read_string(result->data, "Protocol", instance->protocol_name)) {
+                decoder = subghz_receiver_search_decoder_base_by_name(
+                    instance->output, furi_string_get_cstr(instance->protocol_name));
+            }
+            flipper_format_rewind(result->data);
+            if(decoder && subghz_protocol_decoder_base_deserialize(decoder, result->data) ==
+                              SubGhzProtocolStatusOk) {
+                instance->result_time = result->time;
+                if(instance->callback) {
+                    instance->callback(instance->output, decoder, instance->context);
+                }
+            }
+        }
+    subghz_raw_analyzer_results_free(results);
+}
+
+/** Wait until results may be reported, returns with the lock held */
+static void subghz_raw_analyzer_lock_ready(SubGhzRawAnalyzer* instance) {
+    while(true) {
+        furi_check(furi_mutex_acquire(instance->lock, FuriWaitForever) == FuriStatusOk);
+        // Held back while paused and until the owner took the previous results
+        const bool held = instance->paused ||
+                          SubGhzRawAnalyzerResultArray_size(instance->pending) > 0;
+        if(!held || !instance->running) break;
+        furi_check(furi_mutex_release(instance->lock) == FuriStatusOk);
+        furi_delay_ms(10);
+    }
+}
+
+/** Wait for the decode threads to finish the published chunk and report its results,
+ * called with the lock held. Returns true if results are left for the owner */
+static bool subghz_raw_analyzer_collect(SubGhzRawAnalyzer* instance) {
+    if(!instance->chunk_pending) return false;
+    for(size_t i = 0; i < instance->slice_count; i++) {
+        furi_check(furi_semaphore_acquire(instance->slice_done, FuriWaitForever) == FuriStatusOk);
+    }
+    instance->chunk_pending = false;
+
+    SubGhzRawAnalyzerResultArray_reset(instance->results);
+    for(size_t i = 0; i < instance->slice_count; i++) {
+        SubGhzRawAnalyzerSlice* slice = &instance->slices[i];
+        for
+            M_EACH(result, slice->results, SubGhzRawAnalyzerResultArray_t) {
+                SubGhzRawAnalyzerResultArray_push_back(instance->results, *result);
+            }
+        SubGhzRawAnalyzerResultArray_reset(slice->results);
+    }
+    if(!SubGhzRawAnalyzerResultArray_size(instance->results)) return false;
+
+    // Nobody waits for the results of a cancelled decoding
+    if(!instance->running) {
+        subghz_raw_analyzer_results_free(instance->results);
+        return false;
+    }
+
+    qsort(
+        SubGhzRawAnalyzerResultArray_get(instance->results, 0),
+        SubGhzRawAnalyzerResultArray_size(instance->results),
+        sizeof(SubGhzRawAnalyzerResult),
+        subghz_raw_analyzer_result_compare);
+
+    if(instance->callback_results) {
+        // Pending results are empty here, see subghz_raw_analyzer_lock_ready
+        SubGhzRawAnalyzerResultArray_swap(instance->pending, instance->results);
+        return true;
+    }
+
+    subghz_raw_analyzer_report(instance, instance->results);
+    return false;
+}
+
+/** Collect the published chunk once results may be reported */
+static void subghz_raw_analyzer_collect_ready(SubGhzRawAnalyzer* instance) {
+    if(!instance->chunk_pending) return;
+    subghz_raw_analyzer_lock_ready(instance);
+    const bool pending = subghz_raw_analyzer_collect(instance);
+    furi_check(furi_mutex_release(instance->lock) == FuriStatusOk);
+    // Outside of the lock, the owner may be pausing meanwhile
+    if(pending) instance->callback_results(instance->context_results);
+}
+
+static int32_t subghz_raw_analyzer_thread(void* context) {
+    SubGhzRawAnalyzer* instance = context;
+    FURI_LOG_I(TAG, "Start");
+    uint32_t start = furi_get_tick();
+
+    size_t fill = 0;
+    bool end = false;
+    while(!end && instance->running) {
+        // Read the next chunk while the decode threads process the previous one
+        SubGhzRawAnalyzerChunk* chunk = &instance->chunks[fill];
+        chunk->count = 0;
+        chunk->time = instance->read_time;
+        while(chunk->count < SUBGHZ_RAW_ANALYZER_CHUNK_SAMPLES && instance->running) {
+            LevelDuration level_duration =
+                subghz_file_encoder_worker_get_level_duration(instance->reader);
+            if(level_duration_is_reset(level_duration)) {
+                end = true;
+                break;
+            } else if(level_duration_is_wait(level_duration)) {
+                furi_delay_ms(1);
+                continue;
+            }
+            const int32_t duration = level_duration_get_duration(level_duration);
+            chunk->samples[chunk->count++] =
+                level_duration_get_level(level_duration) ? duration : -duration;
+            instance->read_time += duration;
+        }
+
+        subghz_raw_analyzer_collect_ready(instance);
+
+        if(chunk->count && instance->running) {
+            instance->chunk_index = fill;
+            instance->chunk_pending = true;
+            for(size_t i = 0; i < instance->slice_count; i++) {
+                furi_thread_flags_set(
+                    furi_thread_get_id(instance->slices[i].thread),
+                    SUBGHZ_RAW_ANALYZER_FLAG_CHUNK);
+            }
+            fill ^= 1;
+        }
+    }
+    subghz_raw_analyzer_collect_ready(instance);
+
+    FURI_LOG_I(
+        TAG,
+        "End, %lums of signal in %lums",
+        (uint32_t)(instance->read_time / 1000),
+        furi_get_tick() - start);
+    if(end) {
+        instance->finished = true;
+        if(instance->callback_end) instance->callback_end(instance->context_end);
+    }
+
+    return 0;
+}
+
+SubGhzRawAnalyzer* subghz_raw_analyzer_alloc(SubGhzEnvironment* environment, size_t thread_count) {
+    furi_check(environment);
+    furi_check(thread_count > 0 && thread_count <= SUBGHZ_RAW_ANALYZER_THREADS_MAX);
+
+    SubGhzRawAnalyzer* instance = malloc(sizeof(SubGhzRawAnalyzer));
+    instance->thread =
+        furi_thread_alloc_ex("SubGhzRawAnalyzer", 4096, subghz_raw_analyzer_thread, instance);
+    instance->reader = subghz_file_encoder_worker_alloc();
+
+    instance->slice_count = thread_count;
+    instance->slices = malloc(sizeof(SubGhzRawAnalyzerSlice) * thread_count);
+    instance->slice_done = furi_semaphore_alloc(thread_count, 0);
+    for(size_t i = 0; i < thread_count; i++) {
+        SubGhzRawAnalyzerSlice* slice = &instance->slices[i];
+        slice->analyzer = instance;
+        slice->index = i;
+        slice->thread = furi_thread_alloc_ex(
+            "SubGhzRawDecoder", 3072, subghz_raw_analyzer_slice_thread, slice);
+        slice->receiver = subghz_receiver_alloc_init_slice(environment, i, thread_count);
+        subghz_receiver_set_rx_callback(
+            slice->receiver, subghz_raw_analyzer_slice_rx_callback, slice);
+        SubGhzRawAnalyzerResultArray_init(slice->results);
+    }
+
+    instance->output = subghz_receiver_alloc_init(environment);
+    SubGhzRawAnalyzerResultArray_init(instance->results);
+    instance->protocol_name = furi_string_alloc();
+
+    instance->lock = furi_mutex_alloc(FuriMutexTypeNormal);
+    SubGhzRawAnalyzerResultArray_init(instance->pending);
+    SubGhzRawAnalyzerResultArray_init(instance->processing);
+
+    subghz_raw_analyzer_set_filter(instance, SubGhzProtocolFlag_Decodable);
+
+    return instance;
+}
+
+void subghz_raw_analyzer_free(SubGhzRawAnalyzer* instance) {
+    furi_check(instance);
+    furi_check(!instance->running);
+
+    for(size_t i = 0; i < instance->slice_count; i++) {
+        SubGhzRawAnalyzerSlice* slice = &instance->slices[i];
+        furi_thread_free(slice->thread);
+        subghz_receiver_free(slice->receiver);
+        SubGhzRawAnalyzerResultArray_clear(slice->results);
+    }
+    free(instance->slices);
+    furi_semaphore_free(instance->slice_done);
+
+    subghz_receiver_free(instance->output);
+    SubGhzRawAnalyzerResultArray_clear(instance->results);
+    furi_string_free(instance->protocol_name);
+
+    subghz_raw_analyzer_results_free(instance->pending);
+    SubGhzRawAnalyzerResultArray_clear(instance->pending);
+    SubGhzRawAnalyzerResultArray_clear(instance->processing);
+    furi_mutex_free(instance->lock);
+
+    subghz_file_encoder_worker_free(instance->reader);
+    furi_thread_free(instance->thread);
+    free(instance);
+}
+
+void subghz_raw_analyzer_set_filter(SubGhzRawAnalyzer* instance, SubGhzProtocolFlag filter) {
+    furi_check(instance);
+    for(size_t i = 0; i < instance->slice_count; i++) {
+        subghz_receiver_set_filter(instance->slices[i].receiver, filter);
+    }
+}
+
+void subghz_raw_analyzer_set_ignore_filter(
+    SubGhzRawAnalyzer* instance,
+    SubGhzProtocolFilter ignore_filter) {
+    furi_check(instance);
+    for(size_t i = 0; i < instance->slice_count; i++) {
+        subghz_receiver_set_ignore_filter(instance->slices[i].receiver, ignore_filter);
+    }
+}
+
+void subghz_raw_analyzer_set_rx_callback(
+    SubGhzRawAnalyzer* instance,
+    SubGhzReceiverCallback callback,
+    void* context) {
+    furi_check(instance);
+    instance->callback = callback;
+    instance->context = context;
+}
+
+void subghz_raw_analyzer_set_end_callback(
+    SubGhzRawAnalyzer* instance,
+    SubGhzRawAnalyzerCallbackEnd callback,
+    void* context) {
+    furi_check(instance);
+    instance->callback_end = callback;
+    instance->context_end = context;
+}
+
+void subghz_raw_analyzer_set_results_callback(
+    SubGhzRawAnalyzer* instance,
+    SubGhzRawAnalyzerCallbackResults callback,
+    void* context) {
+    furi_check(instance);
+    furi_check(!instance->running);
+    instance->callback_results = callback;
+    instance->context_results = context;
+}
+
+bool subghz_raw_analyzer_start(
+    SubGhzRawAnalyzer* instance,
+    const char* file_path,
+    SubGhzRadioPreset* preset) {
+    furi_check(instance);
+    furi_check(file_path);
+    furi_check(preset);
+    furi_check(!instance->running);
+
+    if(!subghz_file_encoder_worker_start(instance->reader, file_path, NULL)) return false;
+
+    instance->preset = preset;
+    instance->read_time = 0;
+    instance->result_time = 0;
+    instance->chunk_pending = false;
+    instance->finished = false;
+    instance->paused = false;
+    instance->running = true;
+
+    for(size_t i = 0; i < instance->slice_count; i++) {
+        subghz_receiver_reset(instance->slices[i].receiver);
+        furi_thread_start(instance->slices[i].thread);
+    }
+    furi_thread_start(instance->thread);
+
+    return true;
+}
+
+void subghz_raw_analyzer_stop(SubGhzRawAnalyzer* instance) {
+    furi_check(instance);
+    furi_check(instance->running);
+
+    instance->running = false;
+    furi_thread_join(instance->thread);
+    subghz_raw_analyzer_results_free(instance->pending);
+
+    for(size_t i = 0; i < instance->slice_count; i++) {
+        furi_thread_flags_set(
+            furi_thread_get_id(instance->slices[i].thread), SUBGHZ_RAW_ANALYZER_FLAG_EXIT);
+        furi_thread_join(instance->slices[i].thread);
+    }
+
+    if(subghz_file_encoder_worker_is_running(instance->reader)) {
+        subghz_file_encoder_worker_stop(instance->reader);
+    }
+}
+
+bool subghz_raw_analyzer_is_running(SubGhzRawAnalyzer* instance) {
+    furi_check(instance);
+    return instance->running;
+}
+
+bool subghz_raw_analyzer_is_finished(SubGhzRawAnalyzer* instance) {
+    furi_check(instance);
+    return instance->finished;
+}
+
+void subghz_raw_analyzer_pause(SubGhzRawAnalyzer* instance, bool pause) {
+    furi_check(instance);
+    // Results being reported are finished before the lock is released
+    furi_check(furi_mutex_acquire(instance->lock, FuriWaitForever) == FuriStatusOk);
+    instance->paused = pause;
+    furi_check(furi_mutex_release(instance->lock) == FuriStatusOk);
+}
+
+void subghz_raw_analyzer_process_results(SubGhzRawAnalyzer* instance) {
+    furi_check(instance);
+    furi_check(furi_mutex_acquire(instance->lock, FuriWaitForever) == FuriStatusOk);
+    SubGhzRawAnalyzerResultArray_swap(instance->processing, instance->pending);
+    furi_check(furi_mutex_release(instance->lock) == FuriStatusOk);
+
+    subghz_raw_analyzer_report(instance, instance->processing);
+}
+
+void subghz_raw_analyzer_get_text_progress(SubGhzRawAnalyzer* instance, FuriString* output) {
+    furi_check(instance);
+    furi_check(output);
+    if(instance->finished) {
+        furi_string_set(output, "100%");
+    } else {
+        subghz_file_encoder_worker_get_text_progress(instance->reader, output);
+    }
+}
+
+uint32_t subghz_raw_analyzer_get_time(SubGhzRawAnalyzer* instance) {
+    furi_check(instance);
+    return instance->result_time / 1000;
+}
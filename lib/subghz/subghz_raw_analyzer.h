@@ -0,0 +1,155 @@
+/**
+ * @file subghz_raw_analyzer.h
+ * Background decoding of Sub-GHz RAW files
+ *
+ * The file is read once into chunks of samples shared by the decode threads.
+ * Every decode thread owns a slice of the protocol decoders and feeds the same
+ * chunk to it, while the next chunk is being read. Decoded signals of a chunk
+ * are reported in the order of their time in the recording, through a full
+ * receiver owned by the analyzer, from the analyzer thread. With a results
+ * callback set, they are kept until the owner reports them from its own thread
+ * with subghz_raw_analyzer_process_results.
+ */
+#pragma once
+
+#include "receiver.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct SubGhzRawAnalyzer SubGhzRawAnalyzer;
+
+typedef void (*SubGhzRawAnalyzerCallbackEnd)(void* context);
+
+typedef void (*SubGhzRawAnalyzerCallbackResults)(void* context);
+
+/**
+ * Allocate SubGhzRawAnalyzer
+ * @param environment SubGhzEnvironment instance, shared by the decode threads
+ * @param thread_count number of decode threads, the decoders are split between them
+ * @return SubGhzRawAnalyzer*
+ */
+SubGhzRawAnalyzer* subghz_raw_analyzer_alloc(SubGhzEnvironment* environment, size_t thread_count);
+
+/**
+ * Free SubGhzRawAnalyzer
+ * @param instance SubGhzRawAnalyzer instance
+ */
+void subghz_raw_analyzer_free(SubGhzRawAnalyzer* instance);
+
+/**
+ * Set protocol filter of the decoders
+ * @param instance SubGhzRawAnalyzer instance
+ * @param filter SubGhzProtocolFlag filter
+ */
+void subghz_raw_analyzer_set_filter(SubGhzRawAnalyzer* instance, SubGhzProtocolFlag filter);
+
+/**
+ * Set protocol ignore filter of the decoders
+ * @param instance SubGhzRawAnalyzer instance
+ * @param ignore_filter SubGhzProtocolFilter ignore filter
+ */
+void subghz_raw_analyzer_set_ignore_filter(
+    SubGhzRawAnalyzer* instance,
+    SubGhzProtocolFilter ignore_filter);
+
+/**
+ * Set callback of decoded signals, called from the analyzer thread, or from
+ * subghz_raw_analyzer_process_results if a results callback is set. The
+ * callback must not pause the analyzer
+ * @param instance SubGhzRawAnalyzer instance
+ * @param callback SubGhzReceiverCallback callback
+ * @param context callback context
+ */
+void subghz_raw_analyzer_set_rx_callback(
+    SubGhzRawAnalyzer* instance,
+    SubGhzReceiverCallback callback,
+    void* context);
+
+/**
+ * Set callback of the end of file, called from the analyzer thread
+ * @param instance SubGhzRawAnalyzer instance
+ * @param callback SubGhzRawAnalyzerCallbackEnd callback
+ * @param context callback context
+ */
+void subghz_raw_analyzer_set_end_callback(
+    SubGhzRawAnalyzer* instance,
+    SubGhzRawAnalyzerCallbackEnd callback,
+    void* context);
+
+/**
+ * Set callback of decoded signals waiting for subghz_raw_analyzer_process_results,
+ * called from the analyzer thread. Decoding waits until they are processed
+ * @param instance SubGhzRawAnalyzer instance
+ * @param callback SubGhzRawAnalyzerCallbackResults callback
+ * @param context callback context
+ */
+void subghz_raw_analyzer_set_results_callback(
+    SubGhzRawAnalyzer* instance,
+    SubGhzRawAnalyzerCallbackResults callback,
+    void* context);
+
+/**
+ * Report decoded signals waiting since the results callback, through the rx
+ * callback from the calling thread
+ * @param instance SubGhzRawAnalyzer instance
+ */
+void subghz_raw_analyzer_process_results(SubGhzRawAnalyzer* instance);
+
+/**
+ * Start decoding of a RAW file
+ * @param instance SubGhzRawAnalyzer instance
+ * @param file_path RAW file path
+ * @param preset preset saved with decoded signals, must stay valid until stop
+ * @return true on success
+ */
+bool subghz_raw_analyzer_start(
+    SubGhzRawAnalyzer* instance,
+    const char* file_path,
+    SubGhzRadioPreset* preset);
+
+/**
+ * Stop decoding, cancels it if the file is not finished yet
+ * @param instance SubGhzRawAnalyzer instance
+ */
+void subghz_raw_analyzer_stop(SubGhzRawAnalyzer* instance);
+
+/**
+ * Check if decoding is started
+ * @param instance SubGhzRawAnalyzer instance
+ * @return true if started and not stopped yet
+ */
+bool subghz_raw_analyzer_is_running(SubGhzRawAnalyzer* instance);
+
+/**
+ * Check if the whole file is decoded
+ * @param instance SubGhzRawAnalyzer instance
+ * @return true if finished
+ */
+bool subghz_raw_analyzer_is_finished(SubGhzRawAnalyzer* instance);
+
+/**
+ * Pause or resume decoding, signals being reported are finished on return
+ * @param instance SubGhzRawAnalyzer instance
+ * @param pause true to pause
+ */
+void subghz_raw_analyzer_pause(SubGhzRawAnalyzer* instance, bool pause);
+
+/**
+ * Get a description of the progress
+ * @param instance SubGhzRawAnalyzer instance
+ * @param output output string
+ */
+void subghz_raw_analyzer_get_text_progress(SubGhzRawAnalyzer* instance, FuriString* output);
+
+/**
+ * Get time of the signal being reported, valid in the rx callback
+ * @param instance SubGhzRawAnalyzer instance
+ * @return time from the start of recording, ms
+ */
+uint32_t subghz_raw_analyzer_get_time(SubGhzRawAnalyzer* instance);
+
+#ifdef __cplusplus
+}
+#endif
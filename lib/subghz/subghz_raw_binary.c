@@ -0,0 +1,535 @@
+#include "subghz_raw_binary.h"
+
+#include <toolbox/varint.h>
+#include <toolbox/strint.h>
+#include <toolbox/stream/buffered_file_stream.h>
+
+#include <furi.h>
+#include <ctype.h>
+
+#define TAG "SubGhzRawBinary"
+
+#define SUBGHZ_RAW_BINARY_BLOCK_MAGIC  (0x4252) // "RB"
+#define SUBGHZ_RAW_BINARY_FOOTER_MAGIC (0x58494252) // "RBIX"
+
+#define SUBGHZ_RAW_BINARY_SAMPLE_SIZE_MAX 5
+#define SUBGHZ_RAW_BINARY_BLOCK_SIZE_MAX \
+    (SUBGHZ_RAW_BINARY_BLOCK_SAMPLES * SUBGHZ_RAW_BINARY_SAMPLE_SIZE_MAX)
+
+// Index is decimated when full, so memory use does not depend on recording length
+#define SUBGHZ_RAW_BINARY_INDEX_MAX 128
+
+#define SUBGHZ_RAW_BINARY_TEXT_KEY "RAW_Data"
+
+typedef struct FURI_PACKED {
+    uint16_t magic;
+    uint16_t count;
+    uint16_t size;
+    uint16_t reserved;
+    uint32_t duration; /**< Sum of sample durations, us */
+} SubGhzRawBinaryBlockHeader;
+
+typedef struct FURI_PACKED {
+    uint32_t offset; /**< Block offset from the container start */
+    uint64_t time; /**< Block start time, us */
+} SubGhzRawBinaryIndexEntry;
+
+typedef struct FURI_PACKED {
+    uint32_t index_offset; /**< Index offset from the container start */
+    uint16_t index_count;
+    uint16_t index_stride; /**< Blocks per index entry */
+    uint32_t duration; /**< Total duration, ms */
+    uint32_t magic;
+} SubGhzRawBinaryFooter;
+
+struct SubGhzRawBinaryWriter {
+    Stream* stream;
+    size_t start;
+
+    uint8_t block[SUBGHZ_RAW_BINARY_BLOCK_SIZE_MAX];
+    SubGhzRawBinaryBlockHeader header;
+    uint64_t time;
+    uint32_t block_count;
+
+    SubGhzRawBinaryIndexEntry index[SUBGHZ_RAW_BINARY_INDEX_MAX];
+    uint16_t index_count;
+    uint16_t index_stride;
+};
+
+struct SubGhzRawBinaryReader {
+    Stream* stream;
+    size_t start;
+    size_t end;
+
+    uint8_t block[SUBGHZ_RAW_BINARY_BLOCK_SIZE_MAX];
+    SubGhzRawBinaryBlockHeader header;
+    size_t block_position;
+    uint16_t block_sample;
+    uint64_t time;
+
+    SubGhzRawBinaryIndexEntry* index;
+    SubGhzRawBinaryFooter footer;
+};
+
+static inline uint32_t subghz_raw_binary_sample_duration(int32_t sample) {
+    return (sample < 0) ? -(uint32_t)sample : (uint32_t)sample;
+}
+
+SubGhzRawBinaryWriter* subghz_raw_binary_writer_alloc(Stream* stream) {
+    furi_check(stream);
+
+    SubGhzRawBinaryWriter* instance = malloc(sizeof(SubGhzRawBinaryWriter));
+    instance->stream = stream;
+    instance->start = stream_tell(stream);
+    instance->header.magic = SUBGHZ_RAW_BINARY_BLOCK_MAGIC;
+    instance->index_stride = 1;
+
+    return instance;
+}
+
+void subghz_raw_binary_writer_free(SubGhzRawBinaryWriter* instance) {
+    furi_check(instance);
+    free(instance);
+}
+
+static bool subghz_raw_binary_writer_flush(SubGhzRawBinaryWriter* instance) {
+    if(!instance->header.count) return true;
+
+    if((instance->block_count % instance->index_stride) == 0) {
+        if(instance->index_count == SUBGHZ_RAW_BINARY_INDEX_MAX) {
+            // Keep every other entry and double the stride
+            for(size_t i = 0; i < SUBGHZ_RAW_BINARY_INDEX_MAX / 2; i++) {
+                instance->index[i] = instance->index[i * 2];
+            }
+            instance->index_count = SUBGHZ_RAW_BINARY_INDEX_MAX / 2;
+            instance->index_stride *= 2;
+        }
+
+        if((instance->block_count % instance->index_stride) == 0) {
+            SubGhzRawBinaryIndexEntry* entry = &instance->index[instance->index_count++];
+            entry->offset = stream_tell(instance->stream) - instance->start;
+            entry->time = instance->time;
+        }
+    }
+
+    bool success = false;
+    do {
+        if(stream_write(instance->stream, (uint8_t*)&instance->header, sizeof(instance->header)) !=
+           sizeof(instance->header))
+            break;
+        if(stream_write(instance->stream, instance->block, instance->header.size) !=
+           instance->header.size)
+            break;
+        success = true;
+    } while(false);
+
+    instance->time += instance->header.duration;
+    instance->block_count++;
+    instance->header.count = 0;
+    instance->header.size = 0;
+    instance->header.duration = 0;
+
+    return success;
+}
+
+bool subghz_raw_binary_writer_add(
+    SubGhzRawBinaryWriter* instance,
+    const int32_t* samples,
+    size_t count) {
+    furi_check(instance);
+    furi_check(samples);
+
+    for(size_t i = 0; i < count; i++) {
+        if(samples[i] <= INT32_MIN / 2) {
+            FURI_LOG_E(TAG, "Sample out of range: %ld", samples[i]);
+            return false;
+        }
+
+        SubGhzRawBinaryBlockHeader* header = &instance->header;
+        header->size += varint_int32_pack(samples[i], &instance->block[header->size]);
+        header->count++;
+
+        const uint32_t duration = subghz_raw_binary_sample_duration(samples[i]);
+        if(UINT32_MAX - header->duration < duration) {
+            header->duration = UINT32_MAX;
+        } else {
+            header->duration += duration;
+        }
+
+        if(header->count == SUBGHZ_RAW_BINARY_BLOCK_SAMPLES) {
+            if(!subghz_raw_binary_writer_flush(instance)) return false;
+        }
+    }
+
+    return true;
+}
+
+bool subghz_raw_binary_writer_finish(SubGhzRawBinaryWriter* instance) {
+    furi_check(instance);
+
+    bool success = false;
+    do {
+        if(!subghz_raw_binary_writer_flush(instance)) break;
+
+        SubGhzRawBinaryFooter footer = {
+            .index_offset = stream_tell(instance->stream) - instance->start,
+            .index_count = instance->index_count,
+            .index_stride = instance->index_stride,
+            .duration = instance->time / 1000,
+            .magic = SUBGHZ_RAW_BINARY_FOOTER_MAGIC,
+        };
+
+        const size_t index_size = instance->index_count * sizeof(SubGhzRawBinaryIndexEntry);
+        if(stream_write(instance->stream, (uint8_t*)instance->index, index_size) != index_size)
+            break;
+        if(stream_write(instance->stream, (uint8_t*)&footer, sizeof(footer)) != sizeof(footer))
+            break;
+
+        success = true;
+    } while(false);
+
+    return success;
+}
+
+SubGhzRawBinaryReader* subghz_raw_binary_reader_alloc(Stream* stream) {
+    furi_check(stream);
+
+    SubGhzRawBinaryReader* instance = malloc(sizeof(SubGhzRawBinaryReader));
+    instance->stream = stream;
+    instance->start = stream_tell(stream);
+    instance->end = stream_size(stream);
+
+    do {
+        SubGhzRawBinaryFooter* footer = &instance->footer;
+        if(instance->end - instance->start < sizeof(SubGhzRawBinaryFooter)) break;
+        if(!stream_seek(stream, instance->end - sizeof(*footer), StreamOffsetFromStart)) break;
+        if(stream_read(stream, (uint8_t*)footer, sizeof(*footer)) != sizeof(*footer)) break;
+
+        const size_t index_size = footer->index_count * sizeof(SubGhzRawBinaryIndexEntry);
+        if((footer->magic != SUBGHZ_RAW_BINARY_FOOTER_MAGIC) ||
+           (instance->start + footer->index_offset + index_size + sizeof(*footer) !=
+            instance->end)) {
+            FURI_LOG_W(TAG, "No index, sequential access only");
+            memset(footer, 0, sizeof(*footer));
+            break;
+        }
+
+        instance->end = instance->start + footer->index_offset;
+        if(index_size) {
+            instance->index = malloc(index_size);
+            if(!stream_seek(stream, instance->end, StreamOffsetFromStart) ||
+               stream_read(stream, (uint8_t*)instance->index, index_size) != index_size) {
+                FURI_LOG_E(TAG, "Index read error");
+                free(instance->index);
+                instance->index = NULL;
+                footer->index_count = 0;
+            }
+        }
+    } while(false);
+
+    stream_seek(stream, instance->start, StreamOffsetFromStart);
+
+    return instance;
+}
+
+void subghz_raw_binary_reader_free(SubGhzRawBinaryReader* instance) {
+    furi_check(instance);
+    free(instance->index);
+    free(instance);
+}
+
+// Current header is kept if the next one is invalid
+static bool subghz_raw_binary_reader_read_header(SubGhzRawBinaryReader* instance) {
+    SubGhzRawBinaryBlockHeader header;
+    const size_t position = stream_tell(instance->stream);
+
+    if(position + sizeof(header) > instance->end) return false;
+    if(stream_read(instance->stream, (uint8_t*)&header, sizeof(header)) != sizeof(header))
+        return false;
+    if((header.magic != SUBGHZ_RAW_BINARY_BLOCK_MAGIC) ||
+       (header.size > SUBGHZ_RAW_BINARY_BLOCK_SIZE_MAX) ||
+       (header.count > SUBGHZ_RAW_BINARY_BLOCK_SAMPLES) ||
+       (position + sizeof(header) + header.size > instance->end)) {
+        FURI_LOG_E(TAG, "Invalid block at %zu", position);
+        return false;
+    }
+
+    instance->header = header;
+    return true;
+}
+
+static bool subghz_raw_binary_reader_load_block(SubGhzRawBinaryReader* instance) {
+    if(!subghz_raw_binary_reader_read_header(instance)) return false;
+    if(stream_read(instance->stream, instance->block, instance->header.size) !=
+       instance->header.size) {
+        // Nothing left to unpack
+        instance->header.count = 0;
+        instance->block_sample = 0;
+        return false;
+    }
+
+    instance->block_position = 0;
+    instance->block_sample = 0;
+    return true;
+}
+
+// Sample running past the block end means a corrupt block, which ends the data
+static bool subghz_raw_binary_reader_unpack(
+    SubGhzRawBinaryReader* instance,
+    int32_t* sample,
+    size_t* sample_size) {
+    const size_t left = MIN(
+        instance->header.size - instance->block_position, SUBGHZ_RAW_BINARY_SAMPLE_SIZE_MAX);
+    *sample_size = varint_int32_unpack(sample, &instance->block[instance->block_position], left);
+    if(*sample_size > left) {
+        FURI_LOG_E(TAG, "Corrupt block at sample %u", instance->block_sample);
+        return false;
+    }
+
+    return true;
+}
+
+static bool subghz_raw_binary_reader_next(SubGhzRawBinaryReader* instance, int32_t* sample) {
+    while(instance->block_sample == instance->header.count) {
+        if(!subghz_raw_binary_reader_load_block(instance)) return false;
+    }
+
+    size_t sample_size;
+    if(!subghz_raw_binary_reader_unpack(instance, sample, &sample_size)) return false;
+    instance->block_position += sample_size;
+    instance->block_sample++;
+    instance->time += subghz_raw_binary_sample_duration(*sample);
+
+    return true;
+}
+
+size_t subghz_raw_binary_reader_read(
+    SubGhzRawBinaryReader* instance,
+    int32_t* samples,
+    size_t count) {
+    furi_check(instance);
+    furi_check(samples);
+
+    size_t read = 0;
+    while(read < count && subghz_raw_binary_reader_next(instance, &samples[read])) {
+        read++;
+    }
+
+    return read;
+}
+
+bool subghz_raw_binary_reader_seek(SubGhzRawBinaryReader* instance, uint32_t time_ms) {
+    furi_check(instance);
+
+    const uint64_t target = (uint64_t)time_ms * 1000;
+    size_t offset = 0;
+    uint64_t time = 0;
+
+    // Last index entry starting before the target
+    for(size_t i = 0; i < instance->footer.index_count; i++) {
+        if(instance->index[i].time > target) break;
+        offset = instance->index[i].offset;
+        time = instance->index[i].time;
+    }
+
+    if(!stream_seek(instance->stream, instance->start + offset, StreamOffsetFromStart))
+        return false;
+
+    instance->time = time;
+    instance->header.count = 0;
+    instance->block_sample = 0;
+
+    // Skip whole blocks using their headers
+    while(true) {
+        const size_t position = stream_tell(instance->stream);
+        if(!subghz_raw_binary_reader_read_header(instance)) return false;
+        if(instance->time + instance->header.duration > target) {
+            stream_seek(instance->stream, position, StreamOffsetFromStart);
+            break;
+        }
+        instance->time += instance->header.duration;
+        stream_seek(instance->stream, instance->header.size, StreamOffsetFromCurrent);
+    }
+
+    // Skip samples inside of the block
+    if(!subghz_raw_binary_reader_load_block(instance)) return false;
+    while(instance->block_sample < instance->header.count) {
+        int32_t sample = 0;
+        size_t sample_size;
+        if(!subghz_raw_binary_reader_unpack(instance, &sample, &sample_size)) return false;
+        const uint32_t duration = subghz_raw_binary_sample_duration(sample);
+        if(instance->time + duration > target) break;
+
+        instance->block_position += sample_size;
+        instance->block_sample++;
+        instance->time += duration;
+    }
+
+    return true;
+}
+
+uint32_t subghz_raw_binary_reader_get_time(SubGhzRawBinaryReader* instance) {
+    furi_check(instance);
+    return instance->time / 1000;
+}
+
+uint32_t subghz_raw_binary_reader_get_duration(SubGhzRawBinaryReader* instance) {
+    furi_check(instance);
+    return instance->footer.duration;
+}
+
+static bool subghz_raw_binary_line_has_key(FuriString* line, const char* key) {
+    const size_t key_length = strlen(key);
+    return (furi_string_size(line) > key_length) &&
+           (strncmp(furi_string_get_cstr(line), key, key_length) == 0) &&
+           (furi_string_get_char(line, key_length) == ':');
+}
+
+static bool subghz_raw_binary_line_is_empty(FuriString* line) {
+    for(size_t i = 0; i < furi_string_size(line); i++) {
+        if(!isspace((unsigned char)furi_string_get_char(line, i))) return false;
+    }
+    return true;
+}
+
+bool subghz_raw_binary_from_text(
+    Storage* storage,
+    const char* text_path,
+    const char* binary_path) {
+    furi_check(storage);
+    furi_check(text_path);
+    furi_check(binary_path);
+
+    Stream* src = buffered_file_stream_alloc(storage);
+    Stream* dst = buffered_file_stream_alloc(storage);
+    FuriString* line = furi_string_alloc();
+    SubGhzRawBinaryWriter* writer = NULL;
+    int32_t* samples = malloc(SUBGHZ_RAW_BINARY_BLOCK_SAMPLES * sizeof(int32_t));
+    bool success = false;
+
+    do {
+        if(!buffered_file_stream_open(src, text_path, FSAM_READ, FSOM_OPEN_EXISTING)) break;
+        if(!buffered_file_stream_open(dst, binary_path, FSAM_WRITE, FSOM_CREATE_ALWAYS)) break;
+
+        // Copy header as is
+        bool has_data = false;
+        while(stream_read_line(src, line)) {
+            if(subghz_raw_binary_line_has_key(line, SUBGHZ_RAW_BINARY_TEXT_KEY)) {
+                has_data = true;
+                break;
+            }
+            if(subghz_raw_binary_line_has_key(line, SUBGHZ_RAW_BINARY_KEY)) break;
+            if(stream_write_string(dst, line) != furi_string_size(line)) break;
+        }
+        if(!has_data) {
+            FURI_LOG_E(TAG, "No text RAW data");
+            break;
+        }
+
+        stream_write_format(dst, "%s: %u\n", SUBGHZ_RAW_BINARY_KEY, SUBGHZ_RAW_BINARY_VERSION);
+        writer = subghz_raw_binary_writer_alloc(dst);
+
+        bool data_valid = true;
+        do {
+            if(subghz_raw_binary_line_is_empty(line)) continue;
+            if(!subghz_raw_binary_line_has_key(line, SUBGHZ_RAW_BINARY_TEXT_KEY)) {
+                FURI_LOG_E(TAG, "Unexpected line: %s", furi_string_get_cstr(line));
+                data_valid = false;
+                break;
+            }
+
+            char* str = (char*)furi_string_get_cstr(line) + strlen(SUBGHZ_RAW_BINARY_TEXT_KEY) + 1;
+            size_t count = 0;
+            int32_t sample;
+            while(strint_to_int32(str, &str, &sample, 10) == StrintParseNoError) {
+                samples[count++] = sample;
+                if(count == SUBGHZ_RAW_BINARY_BLOCK_SAMPLES) {
+                    data_valid = subghz_raw_binary_writer_add(writer, samples, count);
+                    count = 0;
+                    if(!data_valid) break;
+                }
+                if(*str == ',') str++;
+            }
+            if(data_valid && count) {
+                data_valid = subghz_raw_binary_writer_add(writer, samples, count);
+            }
+        } while(data_valid && stream_read_line(src, line));
+
+        if(!data_valid) break;
+        if(!subghz_raw_binary_writer_finish(writer)) break;
+
+        success = true;
+    } while(false);
+
+    if(writer) subghz_raw_binary_writer_free(writer);
+    free(samples);
+    furi_string_free(line);
+    buffered_file_stream_close(dst);
+    buffered_file_stream_close(src);
+    stream_free(dst);
+    stream_free(src);
+
+    return success;
+}
+
+bool subghz_raw_binary_to_text(Storage* storage, const char* binary_path, const char* text_path) {
+    furi_check(storage);
+    furi_check(binary_path);
+    furi_check(text_path);
+
+    Stream* src = buffered_file_stream_alloc(storage);
+    Stream* dst = buffered_file_stream_alloc(storage);
+    FuriString* line = furi_string_alloc();
+    SubGhzRawBinaryReader* reader = NULL;
+    int32_t* samples = malloc(SUBGHZ_RAW_BINARY_BLOCK_SAMPLES * sizeof(int32_t));
+    bool success = false;
+
+    do {
+        if(!buffered_file_stream_open(src, binary_path, FSAM_READ, FSOM_OPEN_EXISTING)) break;
+        if(!buffered_file_stream_open(dst, text_path, FSAM_WRITE, FSOM_CREATE_ALWAYS)) break;
+
+        // Copy header as is
+        bool has_data = false;
+        while(stream_read_line(src, line)) {
+            if(subghz_raw_binary_line_has_key(line, SUBGHZ_RAW_BINARY_KEY)) {
+                has_data = true;
+                break;
+            }
+            if(stream_write_string(dst, line) != furi_string_size(line)) break;
+        }
+        if(!has_data) {
+            FURI_LOG_E(TAG, "No binary RAW data");
+            break;
+        }
+
+        reader = subghz_raw_binary_reader_alloc(src);
+
+        bool data_valid = true;
+        size_t count;
+        while((count = subghz_raw_binary_reader_read(
+                   reader, samples, SUBGHZ_RAW_BINARY_BLOCK_SAMPLES)) > 0) {
+            furi_string_set(line, SUBGHZ_RAW_BINARY_TEXT_KEY ":");
+            for(size_t i = 0; i < count; i++) {
+                furi_string_cat_printf(line, " %ld", samples[i]);
+            }
+            furi_string_push_back(line, '\n');
+            if(stream_write_string(dst, line) != furi_string_size(line)) {
+                data_valid = false;
+                break;
+            }
+        }
+
+        if(!data_valid) break;
+        success = true;
+    } while(false);
+
+    if(reader) subghz_raw_binary_reader_free(reader);
+    free(samples);
+    furi_string_free(line);
+    buffered_file_stream_close(dst);
+    buffered_file_stream_close(src);
+    stream_free(dst);
+    stream_free(src);
+
+    return success;
+}
@@ -0,0 +1,142 @@
+/**
+ * @file subghz_raw_binary.h
+ * Binary container for Sub-GHz RAW recordings
+ *
+ * Binary RAW files keep the usual text header of a RAW file (Filetype,
+ * Frequency, Preset, Protocol), followed by a `RAW_Binary: <version>` line
+ * instead of `RAW_Data:` lines. Everything after that line is the container:
+ *
+ * - blocks of up to SUBGHZ_RAW_BINARY_BLOCK_SAMPLES samples, each with a header
+ *   holding sample count, payload size and total block duration, and a payload
+ *   of zigzag varint signed durations (sign is the level, as in text files);
+ * - seek index, one entry per N blocks with block offset and start time;
+ * - footer with index location and total duration.
+ *
+ * Index and footer are written when the recording is finished. Files without
+ * them (e.g. recording was interrupted) are still readable sequentially.
+ */
+#pragma once
+
+#include <toolbox/stream/stream.h>
+#include <storage/storage.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SUBGHZ_RAW_BINARY_KEY     "RAW_Binary"
+#define SUBGHZ_RAW_BINARY_VERSION 1
+
+/** Maximum number of samples in a container block */
+#define SUBGHZ_RAW_BINARY_BLOCK_SAMPLES 512
+
+typedef struct SubGhzRawBinaryWriter SubGhzRawBinaryWriter;
+
+typedef struct SubGhzRawBinaryReader SubGhzRawBinaryReader;
+
+/**
+ * Allocate writer, container starts at the current stream position
+ * @param stream Stream opened for writing
+ * @return SubGhzRawBinaryWriter*
+ */
+SubGhzRawBinaryWriter* subghz_raw_binary_writer_alloc(Stream* stream);
+
+/**
+ * Free writer, does not finish the container
+ * @param instance SubGhzRawBinaryWriter instance
+ */
+void subghz_raw_binary_writer_free(SubGhzRawBinaryWriter* instance);
+
+/**
+ * Add samples to the container
+ * @param instance SubGhzRawBinaryWriter instance
+ * @param samples signed durations, from (INT32_MIN / 2 + 1) to INT32_MAX
+ * @param count number of samples
+ * @return true on success
+ */
+bool subghz_raw_binary_writer_add(
+    SubGhzRawBinaryWriter* instance,
+    const int32_t* samples,
+    size_t count);
+
+/**
+ * Write pending samples, seek index and footer
+ * @param instance SubGhzRawBinaryWriter instance
+ * @return true on success
+ */
+bool subghz_raw_binary_writer_finish(SubGhzRawBinaryWriter* instance);
+
+/**
+ * Allocate reader, container starts at the current stream position
+ * @param stream Stream opened for reading
+ * @return SubGhzRawBinaryReader*
+ */
+SubGhzRawBinaryReader* subghz_raw_binary_reader_alloc(Stream* stream);
+
+/**
+ * Free reader
+ * @param instance SubGhzRawBinaryReader instance
+ */
+void subghz_raw_binary_reader_free(SubGhzRawBinaryReader* instance);
+
+/**
+ * Read next samples
+ * @param instance SubGhzRawBinaryReader instance
+ * @param samples output buffer
+ * @param count maximum number of samples to read
+ * @return number of samples read, 0 at the end of data or on error
+ */
+size_t subghz_raw_binary_reader_read(
+    SubGhzRawBinaryReader* instance,
+    int32_t* samples,
+    size_t count);
+
+/**
+ * Move to the first sample ending after the given time
+ *
+ * Uses the seek index when present, otherwise skips blocks by their headers.
+ *
+ * @param instance SubGhzRawBinaryReader instance
+ * @param time_ms time from the start of recording, ms
+ * @return true on success, false if time is beyond the end of data
+ */
+bool subghz_raw_binary_reader_seek(SubGhzRawBinaryReader* instance, uint32_t time_ms);
+
+/**
+ * Get time of the current position
+ * @param instance SubGhzRawBinaryReader instance
+ * @return time from the start of recording, ms
+ */
+uint32_t subghz_raw_binary_reader_get_time(SubGhzRawBinaryReader* instance);
+
+/**
+ * Get total recording duration
+ * @param instance SubGhzRawBinaryReader instance
+ * @return duration in ms, 0 if the container has no footer
+ */
+uint32_t subghz_raw_binary_reader_get_duration(SubGhzRawBinaryReader* instance);
+
+/**
+ * Convert text RAW file to binary one, keeping the header
+ * @param storage Storage instance
+ * @param text_path source text RAW file
+ * @param binary_path destination file
+ * @return true on success
+ */
+bool subghz_raw_binary_from_text(
+    Storage* storage,
+    const char* text_path,
+    const char* binary_path);
+
+/**
+ * Convert binary RAW file to text one, keeping the header
+ * @param storage Storage instance
+ * @param binary_path source binary RAW file
+ * @param text_path destination file
+ * @return true on success
+ */
+bool subghz_raw_binary_to_text(Storage* storage, const char* binary_path, const char* text_path);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,12 +1,17 @@
 #include "subghz_worker.h"
 
 #include <furi.h>
+#include <toolbox/zone_profiler.h>
 
 #define TAG "SubGhzWorker"
 
+#define SUBGHZ_WORKER_RING_SIZE  4096
+/** Durations handled per wakeup of the worker thread */
+#define SUBGHZ_WORKER_BATCH_SIZE 64
+
 struct SubGhzWorker {
     FuriThread* thread;
-    FuriStreamBuffer* stream;
+    FuriSpscRing* ring;
 
     volatile bool running;
     volatile bool overrun;
@@ -27,15 +32,16 @@ struct SubGhzWorker {
  */
 void subghz_worker_rx_callback(bool level, uint32_t duration, void* context) {
     SubGhzWorker* instance = context;
+    const uint32_t zone_start = zone_profiler_begin();
 
     LevelDuration level_duration = level_duration_make(level, duration);
     if(instance->overrun) {
         instance->overrun = false;
         level_duration = level_duration_reset();
     }
-    size_t ret =
-        furi_stream_buffer_send(instance->stream, &level_duration, sizeof(LevelDuration), 0);
-    if(sizeof(LevelDuration) != ret) instance->overrun = true;
+    if(!furi_spsc_ring_push(instance->ring, &level_duration, 1)) instance->overrun = true;
+
+    zone_profiler_end(ZoneProfilerIdSubGhzRxIsr, zone_start);
 }
 
 /** Worker callback thread
@@ -46,11 +52,11 @@ void subghz_worker_rx_callback(bool level, uint32_t duration, void* context) {
 static int32_t subghz_worker_thread_callback(void* context) {
     SubGhzWorker* instance = context;
 
-    LevelDuration level_duration;
+    LevelDuration batch[SUBGHZ_WORKER_BATCH_SIZE];
     while(instance->running) {
-        int ret = furi_stream_buffer_receive(
-            instance->stream, &level_duration, sizeof(LevelDuration), 10);
-        if(ret == sizeof(LevelDuration)) {
+        size_t count = furi_spsc_ring_pop(instance->ring, batch, COUNT_OF(batch), 10);
+        for(size_t i = 0; i < count; i++) {
+            LevelDuration level_duration = batch[i];
             if(level_duration_is_reset(level_duration)) {
                 FURI_LOG_E(TAG, "Overrun buffer");
                 if(instance->overrun_callback) instance->overrun_callback(instance->context);
@@ -63,11 +69,13 @@ static int32_t subghz_worker_thread_callback(void* context) {
                     instance->filter_level_duration.duration += duration;
 
                 } else if(instance->filter_level_duration.level != level) {
+                    const uint32_t zone_start = zone_profiler_begin();
                     if(instance->pair_callback)
                         instance->pair_callback(
                             instance->context,
                             instance->filter_level_duration.level,
                             instance->filter_level_duration.duration);
+                    zone_profiler_end(ZoneProfilerIdSubGhzDecode, zone_start);
 
                     instance->filter_level_duration.duration = duration;
                     instance->filter_level_duration.level = level;
@@ -85,8 +93,7 @@ SubGhzWorker* subghz_worker_alloc(void) {
     instance->thread =
         furi_thread_alloc_ex("SubGhzWorker", 2048, subghz_worker_thread_callback, instance);
 
-    instance->stream =
-        furi_stream_buffer_alloc(sizeof(LevelDuration) * 4096, sizeof(LevelDuration));
+    instance->ring = furi_spsc_ring_alloc(sizeof(LevelDuration), SUBGHZ_WORKER_RING_SIZE);
 
     //setting default filter in us
     instance->filter_duration = 30;
@@ -97,7 +104,7 @@ SubGhzWorker* subghz_worker_alloc(void) {
 void subghz_worker_free(SubGhzWorker* instance) {
     furi_check(instance);
 
-    furi_stream_buffer_free(instance->stream);
+    furi_spsc_ring_free(instance->ring);
     furi_thread_free(instance->thread);
 
     free(instance);
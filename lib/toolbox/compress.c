@@ -1,6 +1,7 @@
 #include "compress.h"
 
 #include <furi.h>
+#include <furi_hal_cortex.h>
 #include <lib/heatshrink/heatshrink_encoder.h>
 #include <lib/heatshrink/heatshrink_decoder.h>
 #include <lib/uzlib/src/uzlib.h>
@@ -39,10 +40,30 @@ typedef struct {
 
 _Static_assert(sizeof(CompressHeader) == 4, "Incorrect CompressHeader size");
 
+/* Decoded icon frame, keyed by compressed data pointer */
+typedef struct CompressIconCacheEntry {
+    struct CompressIconCacheEntry* next;
+    const uint8_t* key;
+    uint32_t checksum; /* Of compressed data: same pointer may be reused for other RAM data */
+    uint16_t size;
+    uint8_t data[];
+} CompressIconCacheEntry;
+
+typedef struct {
+    CompressIconCacheEntry* head; /* Most recently used first */
+    size_t budget;
+    size_t used;
+    uint32_t hits;
+    uint32_t misses;
+    uint64_t hit_cycles;
+    uint64_t decode_cycles;
+} CompressIconCache;
+
 struct CompressIcon {
     heatshrink_decoder* decoder;
     uint8_t* buffer;
     size_t buffer_size;
+    CompressIconCache cache;
 };
 
 CompressIcon* compress_icon_alloc(size_t decode_buf_size) {
@@ -55,12 +76,133 @@ CompressIcon* compress_icon_alloc(size_t decode_buf_size) {
 
     instance->buffer_size = decode_buf_size + 4; /* To account for heatshrink's poller quirks */
     instance->buffer = malloc(instance->buffer_size);
+    memset(&instance->cache, 0, sizeof(CompressIconCache));
 
     return instance;
 }
 
+static size_t compress_icon_cache_entry_size(const CompressIconCacheEntry* entry) {
+    return sizeof(CompressIconCacheEntry) + entry->size;
+}
+
+static void compress_icon_cache_flush(CompressIconCache* cache) {
+    while(cache->head) {
+        CompressIconCacheEntry* entry = cache->head;
+        cache->head = entry->next;
+        free(entry);
+    }
+    cache->used = 0;
+}
+
+/* FNV-1a, a lot cheaper than decoding */
+static uint32_t compress_icon_cache_checksum(const uint8_t* data, size_t size) {
+    uint32_t hash = 2166136261u;
+    for(size_t i = 0; i < size; i++) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static CompressIconCacheEntry*
+    compress_icon_cache_find(CompressIconCache* cache, const uint8_t* key, uint32_t checksum) {
+    CompressIconCacheEntry* prev = NULL;
+    for(CompressIconCacheEntry* entry = cache->head; entry; entry = entry->next) {
+        if(entry->key == key) {
+            if(entry->checksum != checksum) {
+                /* Stale entry: memory was reused for another frame */
+                if(prev) {
+                    prev->next = entry->next;
+                } else {
+                    cache->head = entry->next;
+                }
+                cache->used -= compress_icon_cache_entry_size(entry);
+                free(entry);
+                return NULL;
+            }
+            /* Move to front */
+            if(prev) {
+                prev->next = entry->next;
+                entry->next = cache->head;
+                cache->head = entry;
+            }
+            return entry;
+        }
+        prev = entry;
+    }
+    return NULL;
+}
+
+static void compress_icon_cache_insert(
+    CompressIconCache* cache,
+    const uint8_t* key,
+    uint32_t checksum,
+    const uint8_t* data,
+    size_t size) {
+    size_t entry_size = sizeof(CompressIconCacheEntry) + size;
+    /* Big frames would flush everything else, e.g. fullscreen animations */
+    if(entry_size > cache->budget / 2) {
+        return;
+    }
+
+    /* Evict least recently used entries */
+    while(cache->used + entry_size > cache->budget) {
+        CompressIconCacheEntry** tail = &cache->head;
+        while((*tail)->next) {
+            tail = &(*tail)->next;
+        }
+        cache->used -= compress_icon_cache_entry_size(*tail);
+        free(*tail);
+        *tail = NULL;
+    }
+
+    CompressIconCacheEntry* entry = malloc(entry_size);
+    entry->key = key;
+    entry->checksum = checksum;
+    entry->size = size;
+    memcpy(entry->data, data, size);
+    entry->next = cache->head;
+    cache->head = entry;
+    cache->used += entry_size;
+}
+
+void compress_icon_set_cache_budget(CompressIcon* instance, size_t budget) {
+    furi_check(instance);
+    compress_icon_cache_flush(&instance->cache);
+    instance->cache.budget = budget;
+}
+
+void compress_icon_get_cache_stats(CompressIcon* instance, CompressIconCacheStats* stats) {
+    furi_check(instance);
+    furi_check(stats);
+
+    const CompressIconCache* cache = &instance->cache;
+    const uint32_t cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+    stats->hits = cache->hits;
+    stats->misses = cache->misses;
+    stats->budget = cache->budget;
+    stats->used = cache->used;
+    stats->hit_us = cache->hit_cycles / cycles_per_us;
+    stats->decode_us = cache->decode_cycles / cycles_per_us;
+    stats->saved_us = 0;
+    if(cache->misses) {
+        uint64_t hits_decode_cycles = cache->decode_cycles * cache->hits / cache->misses;
+        if(hits_decode_cycles > cache->hit_cycles) {
+            stats->saved_us = (hits_decode_cycles - cache->hit_cycles) / cycles_per_us;
+        }
+    }
+}
+
+void compress_icon_reset_cache_stats(CompressIcon* instance) {
+    furi_check(instance);
+    instance->cache.hits = 0;
+    instance->cache.misses = 0;
+    instance->cache.hit_cycles = 0;
+    instance->cache.decode_cycles = 0;
+}
+
 void compress_icon_free(CompressIcon* instance) {
     furi_check(instance);
+    compress_icon_cache_flush(&instance->cache);
     free(instance->buffer);
     heatshrink_decoder_free(instance->decoder);
     free(instance);
@@ -73,6 +215,22 @@ void compress_icon_decode(CompressIcon* instance, const uint8_t* icon_data, uint
 
     CompressHeader* header = (CompressHeader*)icon_data;
     if(header->is_compressed) {
+        CompressIconCache* cache = &instance->cache;
+        const uint32_t start = furi_hal_cortex_timer_get(0).start;
+        uint32_t checksum = 0;
+
+        if(cache->budget) {
+            checksum = compress_icon_cache_checksum(
+                icon_data, sizeof(CompressHeader) + header->compressed_buff_size);
+            CompressIconCacheEntry* entry = compress_icon_cache_find(cache, icon_data, checksum);
+            if(entry) {
+                *output = entry->data;
+                cache->hits++;
+                cache->hit_cycles += furi_hal_cortex_timer_get(0).start - start;
+                return;
+            }
+        }
+
         size_t decoded_size = 0;
         /* If decompression fails - check that decode_buf_size is large enough */
         furi_check(compress_decode_internal(
@@ -84,6 +242,13 @@ void compress_icon_decode(CompressIcon* instance, const uint8_t* icon_data, uint
             instance->buffer_size,
             &decoded_size));
         *output = instance->buffer;
+
+        if(cache->budget) {
+            compress_icon_cache_insert(
+                cache, icon_data, checksum, instance->buffer, decoded_size);
+            cache->misses++;
+            cache->decode_cycles += furi_hal_cortex_timer_get(0).start - start;
+        }
     } else {
         *output = (uint8_t*)&icon_data[1];
     }
@@ -419,6 +584,15 @@ _Static_assert(offsetof(gzip_decoder, uzlib) == 0, "Wrong layout");
 /* At end without specifying size, can be allocated at once with struct */
 _Static_assert(offsetof(gzip_decoder, dict) == sizeof(gzip_decoder), "Wrong layout");
 
+typedef struct {
+    uint32_t* offsets; /* NULL if stream has no seek index */
+    uint32_t segment_size;
+    uint32_t segment_count;
+    uint32_t segment;
+    size_t input_position; /* Compressed data read so far, relative to the first segment */
+    CompressSeekCallback seek_cb;
+} CompressSeekState;
+
 struct CompressStreamDecoder {
     size_t stream_position;
     size_t decode_buffer_size;
@@ -431,6 +605,7 @@ struct CompressStreamDecoder {
         heatshrink_decoder* heatshrink;
         gzip_decoder* gzip;
     } decoder;
+    CompressSeekState seek;
 };
 
 static int gzip_decoder_read_cb(struct uzlib_uncomp* uzlib) {
@@ -470,6 +645,7 @@ CompressStreamDecoder* compress_stream_decoder_alloc(
     furi_check(config);
 
     CompressStreamDecoder* instance = malloc(sizeof(CompressStreamDecoder));
+    memset(&instance->seek, 0, sizeof(CompressSeekState));
     instance->type = type;
     instance->stream_position = 0;
     instance->decode_buffer_position = 0;
@@ -517,6 +693,7 @@ void compress_stream_decoder_free(CompressStreamDecoder* instance) {
     } else if(instance->type == CompressTypeGzip) {
         free(instance->decoder.gzip);
     }
+    free(instance->seek.offsets);
     free(instance->decode_buffer);
     free(instance);
 }
@@ -542,6 +719,8 @@ static bool compress_decode_stream_chunk_heatshrink(
     bool can_read_more = true;
 
     do {
+        bool progress = false;
+
         do {
             size_t poll_size = 0;
             poll_res = heatshrink_decoder_poll(
@@ -552,21 +731,32 @@ static bool compress_decode_stream_chunk_heatshrink(
 
             decomp_chunk_size -= poll_size;
             decompressed_chunk += poll_size;
+            progress |= poll_size > 0;
         } while((poll_res == HSDR_POLL_MORE) && decomp_chunk_size);
 
         if(!decomp_chunk_size) {
             break;
         }
 
-        if(can_read_more && (sd->decode_buffer_position < sd->decode_buffer_size)) {
+        /* Segmented streams are read up to the end of the current segment only */
+        size_t read_limit = sd->decode_buffer_size - sd->decode_buffer_position;
+        if(sd->seek.offsets) {
+            read_limit = MIN(
+                read_limit, sd->seek.offsets[sd->seek.segment + 1] - sd->seek.input_position);
+            can_read_more &= read_limit > 0;
+        }
+
+        if(can_read_more && read_limit) {
             size_t read_size = sd->read_cb(
-                sd->read_context,
-                &sd->decode_buffer[sd->decode_buffer_position],
-                sd->decode_buffer_size - sd->decode_buffer_position);
+                sd->read_context, &sd->decode_buffer[sd->decode_buffer_position], read_limit);
             sd->decode_buffer_position += read_size;
+            sd->seek.input_position += read_size;
             can_read_more = read_size > 0;
+            progress |= read_size > 0;
         }
 
+        /* Decoder input was drained by polling */
+        can_sink_more = true;
         while(sd->decode_buffer_position && can_sink_more) {
             size_t sink_size = 0;
             sink_res = heatshrink_decoder_sink(
@@ -577,6 +767,7 @@ static bool compress_decode_stream_chunk_heatshrink(
                 break;
             }
             sd->decode_buffer_position -= sink_size;
+            progress |= sink_size > 0;
 
             /* If some data was left in the buffer, move it to the beginning */
             if(sink_size && sd->decode_buffer_position) {
@@ -584,6 +775,11 @@ static bool compress_decode_stream_chunk_heatshrink(
                     sd->decode_buffer, &sd->decode_buffer[sink_size], sd->decode_buffer_position);
             }
         }
+
+        /* Input is exhausted and nothing is left to decode */
+        if(!progress) {
+            break;
+        }
     } while(!failed);
 
     return decomp_chunk_size == 0;
@@ -619,6 +815,54 @@ static bool compress_decode_stream_chunk(
     return false;
 }
 
+/* Jump to the start of a segment of a segmented stream */
+static bool compress_stream_decoder_restart(CompressStreamDecoder* sd, uint32_t segment) {
+    if(segment >= sd->seek.segment_count) {
+        return false;
+    }
+    if(!sd->seek.seek_cb(sd->read_context, sd->seek.offsets[segment])) {
+        return false;
+    }
+
+    heatshrink_decoder_reset(sd->decoder.heatshrink);
+    sd->decode_buffer_position = 0;
+    sd->seek.segment = segment;
+    sd->seek.input_position = sd->seek.offsets[segment];
+    sd->stream_position = (size_t)segment * sd->seek.segment_size;
+
+    return true;
+}
+
+bool compress_stream_decoder_set_seek_index(
+    CompressStreamDecoder* instance,
+    const CompressSeekIndex* index,
+    CompressSeekCallback seek_cb) {
+    furi_check(instance);
+    furi_check(instance->type == CompressTypeHeatshrink);
+    furi_check(index);
+    furi_check(index->offsets);
+    furi_check(seek_cb);
+
+    if(!index->segment_size || !index->segment_count) {
+        return false;
+    }
+    for(uint32_t i = 0; i < index->segment_count; i++) {
+        if(index->offsets[i] > index->offsets[i + 1]) {
+            return false;
+        }
+    }
+
+    size_t offsets_size = sizeof(uint32_t) * (index->segment_count + 1);
+    free(instance->seek.offsets);
+    instance->seek.offsets = malloc(offsets_size);
+    memcpy(instance->seek.offsets, index->offsets, offsets_size);
+    instance->seek.segment_size = index->segment_size;
+    instance->seek.segment_count = index->segment_count;
+    instance->seek.seek_cb = seek_cb;
+
+    return compress_stream_decoder_restart(instance, 0);
+}
+
 bool compress_stream_decoder_read(
     CompressStreamDecoder* instance,
     uint8_t* data_out,
@@ -626,11 +870,34 @@ bool compress_stream_decoder_read(
     furi_check(instance);
     furi_check(data_out);
 
-    if(compress_decode_stream_chunk(instance, data_out, data_out_size)) {
-        instance->stream_position += data_out_size;
-        return true;
+    if(!instance->seek.offsets) {
+        if(compress_decode_stream_chunk(instance, data_out, data_out_size)) {
+            instance->stream_position += data_out_size;
+            return true;
+        }
+        return false;
     }
-    return false;
+
+    /* Segments are independent streams, decoder is restarted at each boundary */
+    while(data_out_size) {
+        size_t segment_end = (size_t)(instance->seek.segment + 1) * instance->seek.segment_size;
+        if(instance->stream_position == segment_end) {
+            if(!compress_stream_decoder_restart(instance, instance->seek.segment + 1)) {
+                return false;
+            }
+            continue;
+        }
+
+        size_t chunk_size = MIN(data_out_size, segment_end - instance->stream_position);
+        if(!compress_decode_stream_chunk(instance, data_out, chunk_size)) {
+            return false;
+        }
+        instance->stream_position += chunk_size;
+        data_out += chunk_size;
+        data_out_size -= chunk_size;
+    }
+
+    return true;
 }
 
 bool compress_stream_decoder_seek(CompressStreamDecoder* instance, size_t position) {
@@ -641,9 +908,20 @@ bool compress_stream_decoder_seek(CompressStreamDecoder* instance, size_t positi
         return true;
     }
 
-    /* Check if requested position is ahead of current position 
-       we can't rewind the input stream */
-    furi_check(position > instance->stream_position);
+    if(instance->seek.offsets) {
+        /* Jump to the nearest restart point, unless it is faster to keep decoding */
+        uint32_t segment =
+            MIN(position / instance->seek.segment_size, instance->seek.segment_count - 1);
+        if(segment != instance->seek.segment || position < instance->stream_position) {
+            if(!compress_stream_decoder_restart(instance, segment)) {
+                return false;
+            }
+        }
+    } else {
+        /* Check if requested position is ahead of current position 
+           we can't rewind the input stream */
+        furi_check(position > instance->stream_position);
+    }
 
     /* Read and discard data up to requested position */
     uint8_t* dummy_buffer = malloc(instance->decode_buffer_size);
@@ -672,6 +950,11 @@ size_t compress_stream_decoder_tell(CompressStreamDecoder* instance) {
 bool compress_stream_decoder_rewind(CompressStreamDecoder* instance) {
     furi_check(instance);
 
+    /* Segmented stream repositions input by itself */
+    if(instance->seek.offsets) {
+        return compress_stream_decoder_restart(instance, 0);
+    }
+
     /* Reset decoder and read buffer */
     if(instance->type == CompressTypeHeatshrink) {
         heatshrink_decoder_reset(instance->decoder.heatshrink);
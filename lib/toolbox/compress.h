@@ -31,10 +31,47 @@ CompressIcon* compress_icon_alloc(size_t decode_buf_size);
  */
 void compress_icon_free(CompressIcon* instance);
 
+/** Icon decode cache statistics */
+typedef struct {
+    uint32_t hits; /**< Frames served from cache */
+    uint32_t misses; /**< Frames decoded */
+    size_t budget; /**< RAM budget, bytes */
+    size_t used; /**< RAM used by cached frames, bytes */
+    uint32_t hit_us; /**< Time spent serving hits */
+    uint32_t decode_us; /**< Time spent decoding misses */
+    uint32_t saved_us; /**< Estimated decode time saved by hits */
+} CompressIconCacheStats;
+
+/** Set RAM budget of decoded icon cache
+ *
+ * Decoded frames are kept in LRU order, keyed by compressed data pointer and
+ * validated against compressed data checksum, so that frames living in RAM
+ * can be freed and replaced. Frames bigger than half of the budget are not
+ * cached. Existing cache content is dropped.
+ *
+ * @param      instance  The Compress Icon instance
+ * @param[in]  budget    RAM budget in bytes, 0 disables the cache
+ */
+void compress_icon_set_cache_budget(CompressIcon* instance, size_t budget);
+
+/** Get decoded icon cache statistics
+ *
+ * @param      instance  The Compress Icon instance
+ * @param[out] stats     statistics
+ */
+void compress_icon_get_cache_stats(CompressIcon* instance, CompressIconCacheStats* stats);
+
+/** Reset decoded icon cache hit/miss counters and timings
+ *
+ * @param      instance  The Compress Icon instance
+ */
+void compress_icon_reset_cache_stats(CompressIcon* instance);
+
 /** Decompress icon
  *
  * @warning    output pointer set by this function is valid till next
- *             `compress_icon_decode` or `compress_icon_free` call
+ *             `compress_icon_decode`, `compress_icon_set_cache_budget` or
+ *             `compress_icon_free` call
  *
  * @param      instance   The Compress Icon instance
  * @param      icon_data  pointer to icon data.
@@ -195,13 +232,50 @@ bool compress_stream_decoder_read(
     uint8_t* data_out,
     size_t data_out_size);
 
+/** Seek callback for input (compressed) data
+ *
+ * @param context user context
+ * @param position position in compressed data, relative to the start of the first segment
+ *
+ * @return true on success
+ */
+typedef bool (*CompressSeekCallback)(void* context, size_t position);
+
+/** Restart point index of a segmented heatshrink stream
+ *
+ * Segmented stream is a concatenation of independent heatshrink streams,
+ * each one holding segment_size bytes of uncompressed data (last one may be
+ * shorter). Decoding can start at the beginning of any segment.
+ */
+typedef struct {
+    uint32_t segment_size; /**< Uncompressed size of a segment */
+    uint32_t segment_count; /**< Number of segments */
+    const uint32_t* offsets; /**< segment_count + 1 compressed offsets, the last one is the end */
+} CompressSeekIndex;
+
+/** Enable random access for a segmented heatshrink stream
+ *
+ * @param      instance  The CompressStreamDecoder instance, at the stream start
+ * @param[in]  index     Seek index, copied
+ * @param      seek_cb   The seek callback for input data, called with read context
+ *
+ * @return     true on success, false if index is invalid
+ */
+bool compress_stream_decoder_set_seek_index(
+    CompressStreamDecoder* instance,
+    const CompressSeekIndex* index,
+    CompressSeekCallback seek_cb);
+
 /** Seek to position in uncompressed data stream
+ *
+ * With seek index, jumps to the nearest restart point and decodes the rest
+ * of the way, in any direction.
  *
  * @param      instance   The CompressStreamDecoder instance
  * @param[in]  position   The position
  * 
  * @return     true on success
- * @warning    Backward seeking is not supported
+ * @warning    Backward seeking is not supported without seek index
  */
 bool compress_stream_decoder_seek(CompressStreamDecoder* instance, size_t position);
 
@@ -214,7 +288,8 @@ bool compress_stream_decoder_seek(CompressStreamDecoder* instance, size_t positi
 size_t compress_stream_decoder_tell(CompressStreamDecoder* instance);
 
 /** Reset stream decoder to the beginning
- * @warning    Read callback must be repositioned by caller separately
+ * @warning    Read callback must be repositioned by caller separately, unless
+ *             seek index is set
  *
  * @param      instance  The CompressStreamDecoder instance
  *
@@ -0,0 +1,633 @@
+#include "dir_index.h"
+#include "stream/buffered_file_stream.h"
+
+#include <furi.h>
+#include <strings.h>
+
+#define TAG "DirIndex"
+
+#define DIR_INDEX_MAGIC   (0x58444944) // "DIDX"
+#define DIR_INDEX_VERSION (1)
+
+#define DIR_INDEX_FLAG_DIRS_FIRST (1 << 0)
+#define DIR_INDEX_RECORD_FLAG_DIR (1 << 0)
+
+// Rebuild selects the next smallest entries in passes over the directory,
+// these limit how many of them are kept in RAM during a single pass
+#define DIR_INDEX_REBUILD_ENTRIES_MAX  256
+#define DIR_INDEX_REBUILD_NAMES_BUDGET (8 * 1024)
+
+// Longer journals are not worth merging, the index is rebuilt instead
+#define DIR_INDEX_JOURNAL_ENTRIES_MAX 128
+
+typedef struct FURI_PACKED {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t flags;
+    uint16_t reserved;
+    uint32_t count;
+    uint32_t checksum;
+} DirIndexHeader;
+
+typedef struct {
+    uint8_t op;
+    uint8_t flags;
+    char* name;
+} DirIndexEntry;
+
+typedef struct {
+    DirIndexEntry* entries;
+    size_t count;
+    size_t names_size;
+    bool full;
+} DirIndexSelection;
+
+struct DirIndex {
+    Storage* storage;
+    Stream* stream;
+    FuriString* path;
+    FuriString* file_path;
+    bool dirs_first;
+    char name_buffer[UINT8_MAX + 1];
+};
+
+bool dir_index_is_service_file(const char* name) {
+    return strcmp(name, DIR_INDEX_FILE_NAME) == 0 ||
+           strcmp(name, DIR_INDEX_JOURNAL_FILE_NAME) == 0 ||
+           strcmp(name, DIR_INDEX_TEMP_FILE_NAME) == 0 ||
+           strcmp(name, DIR_INDEX_PENDING_JOURNAL_FILE_NAME) == 0;
+}
+
+uint32_t dir_index_checksum_add(uint32_t checksum, const char* name, bool is_dir) {
+    // FNV-1a of every entry, summed up so the order of entries doesn't matter
+    uint32_t hash = 2166136261UL;
+    for(; *name; name++) {
+        hash ^= (uint8_t)*name;
+        hash *= 16777619UL;
+    }
+    hash ^= is_dir ? DIR_INDEX_RECORD_FLAG_DIR : 0;
+    hash *= 16777619UL;
+    return checksum + hash;
+}
+
+size_t dir_index_journal_record_encode(
+    uint8_t* buffer,
+    DirIndexJournalOp op,
+    bool is_dir,
+    const char* name) {
+    size_t name_len = strlen(name);
+    if(name_len > UINT8_MAX) return 0;
+
+    buffer[0] = op;
+    buffer[1] = is_dir ? DIR_INDEX_RECORD_FLAG_DIR : 0;
+    buffer[2] = name_len;
+    memcpy(&buffer[3], name, name_len);
+    return name_len + 3;
+}
+
+DirIndex* dir_index_alloc(Storage* storage) {
+    furi_check(storage);
+
+    DirIndex* dir_index = malloc(sizeof(DirIndex));
+    dir_index->storage = storage;
+    dir_index->stream = buffered_file_stream_alloc(storage);
+    dir_index->path = furi_string_alloc();
+    dir_index->file_path = furi_string_alloc();
+    return dir_index;
+}
+
+void dir_index_free(DirIndex* dir_index) {
+    furi_check(dir_index);
+
+    buffered_file_stream_close(dir_index->stream);
+    stream_free(dir_index->stream);
+    furi_string_free(dir_index->path);
+    furi_string_free(dir_index->file_path);
+    free(dir_index);
+}
+
+static const char* dir_index_file_path(DirIndex* dir_index, const char* name) {
+    furi_string_printf(dir_index->file_path, "%s/%s", furi_string_get_cstr(dir_index->path), name);
+    return furi_string_get_cstr(dir_index->file_path);
+}
+
+static int dir_index_entry_cmp(
+    DirIndex* dir_index,
+    uint8_t a_flags,
+    const char* a_name,
+    uint8_t b_flags,
+    const char* b_name) {
+    if(dir_index->dirs_first) {
+        bool a_is_dir = a_flags & DIR_INDEX_RECORD_FLAG_DIR;
+        bool b_is_dir = b_flags & DIR_INDEX_RECORD_FLAG_DIR;
+        if(a_is_dir != b_is_dir) {
+            return a_is_dir ? -1 : 1;
+        }
+    }
+    return strcasecmp(a_name, b_name);
+}
+
+static bool dir_index_record_write(
+    Stream* stream,
+    uint8_t flags,
+    const char* name,
+    uint32_t* count,
+    uint32_t* checksum) {
+    size_t name_len = strlen(name);
+    if(name_len > UINT8_MAX) return false;
+
+    uint8_t head[2] = {flags, name_len};
+    if(stream_write(stream, head, sizeof(head)) != sizeof(head)) return false;
+    if(stream_write(stream, (const uint8_t*)name, name_len) != name_len) return false;
+
+    (*count)++;
+    *checksum = dir_index_checksum_add(*checksum, name, flags & DIR_INDEX_RECORD_FLAG_DIR);
+    return true;
+}
+
+static bool dir_index_record_read(DirIndex* dir_index, Stream* stream, uint8_t* flags) {
+    uint8_t head[2];
+    if(stream_read(stream, head, sizeof(head)) != sizeof(head)) return false;
+    if(stream_read(stream, (uint8_t*)dir_index->name_buffer, head[1]) != head[1]) return false;
+
+    dir_index->name_buffer[head[1]] = '\0';
+    *flags = head[0];
+    return true;
+}
+
+static bool dir_index_header_read(Stream* stream, DirIndexHeader* header) {
+    if(!stream_rewind(stream)) return false;
+    if(stream_read(stream, (uint8_t*)header, sizeof(DirIndexHeader)) != sizeof(DirIndexHeader))
+        return false;
+    return header->magic == DIR_INDEX_MAGIC && header->version == DIR_INDEX_VERSION;
+}
+
+static bool dir_index_header_write(
+    DirIndex* dir_index,
+    Stream* stream,
+    uint32_t count,
+    uint32_t checksum) {
+    DirIndexHeader header = {
+        .magic = DIR_INDEX_MAGIC,
+        .version = DIR_INDEX_VERSION,
+        .flags = dir_index->dirs_first ? DIR_INDEX_FLAG_DIRS_FIRST : 0,
+        .count = count,
+        .checksum = checksum,
+    };
+    if(!stream_rewind(stream)) return false;
+    return stream_write(stream, (const uint8_t*)&header, sizeof(header)) == sizeof(header);
+}
+
+static bool dir_index_load_header(DirIndex* dir_index, DirIndexHeader* header) {
+    bool loaded = false;
+
+    if(buffered_file_stream_open(
+           dir_index->stream,
+           dir_index_file_path(dir_index, DIR_INDEX_FILE_NAME),
+           FSAM_READ,
+           FSOM_OPEN_EXISTING)) {
+        loaded = dir_index_header_read(dir_index->stream, header);
+    }
+    buffered_file_stream_close(dir_index->stream);
+
+    if(loaded) {
+        uint8_t flags = dir_index->dirs_first ? DIR_INDEX_FLAG_DIRS_FIRST : 0;
+        loaded = header->flags == flags;
+    }
+
+    return loaded;
+}
+
+// Replace index with the freshly written temporary file
+static bool dir_index_commit(DirIndex* dir_index) {
+    storage_common_remove(dir_index->storage, dir_index_file_path(dir_index, DIR_INDEX_FILE_NAME));
+
+    FuriString* temp_path =
+        furi_string_alloc_set(dir_index_file_path(dir_index, DIR_INDEX_TEMP_FILE_NAME));
+    FS_Error error = storage_common_rename(
+        dir_index->storage,
+        furi_string_get_cstr(temp_path),
+        dir_index_file_path(dir_index, DIR_INDEX_FILE_NAME));
+    furi_string_free(temp_path);
+
+    return error == FSE_OK;
+}
+
+static void dir_index_selection_free_entry(DirIndexSelection* selection, size_t idx) {
+    selection->names_size -= strlen(selection->entries[idx].name) + 1;
+    free(selection->entries[idx].name);
+}
+
+static void dir_index_selection_reset(DirIndexSelection* selection) {
+    for(size_t i = 0; i < selection->count; i++) {
+        free(selection->entries[i].name);
+    }
+    selection->count = 0;
+    selection->names_size = 0;
+    selection->full = false;
+}
+
+// Keep the smallest entries seen so far, within entries and names budget
+static void dir_index_selection_insert(
+    DirIndex* dir_index,
+    DirIndexSelection* selection,
+    uint8_t flags,
+    const char* name) {
+    if(selection->full && selection->count) {
+        const DirIndexEntry* largest = &selection->entries[selection->count - 1];
+        if(dir_index_entry_cmp(dir_index, flags, name, largest->flags, largest->name) > 0) {
+            return;
+        }
+    }
+
+    // Find insert position
+    size_t low = 0;
+    size_t high = selection->count;
+    while(low < high) {
+        size_t mid = (low + high) / 2;
+        const DirIndexEntry* entry = &selection->entries[mid];
+        if(dir_index_entry_cmp(dir_index, flags, name, entry->flags, entry->name) > 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    if(selection->count == DIR_INDEX_REBUILD_ENTRIES_MAX) {
+        dir_index_selection_free_entry(selection, --selection->count);
+        selection->full = true;
+        if(low > selection->count) return;
+    }
+
+    memmove(
+        &selection->entries[low + 1],
+        &selection->entries[low],
+        (selection->count - low) * sizeof(DirIndexEntry));
+    selection->entries[low].flags = flags;
+    selection->entries[low].name = strdup(name);
+    selection->names_size += strlen(name) + 1;
+    selection->count++;
+
+    while(selection->names_size > DIR_INDEX_REBUILD_NAMES_BUDGET && selection->count > 1) {
+        dir_index_selection_free_entry(selection, --selection->count);
+        selection->full = true;
+    }
+}
+
+static bool dir_index_rebuild(DirIndex* dir_index) {
+    bool success = false;
+
+    File* dir = storage_file_alloc(dir_index->storage);
+    StorageDirEntry* dir_entries = malloc(sizeof(StorageDirEntry) * STORAGE_DIR_READ_BATCH_SIZE);
+    DirIndexSelection selection = {
+        .entries = malloc(sizeof(DirIndexEntry) * DIR_INDEX_REBUILD_ENTRIES_MAX),
+    };
+    DirIndexEntry last = {0};
+    uint32_t count = 0;
+    uint32_t checksum = 0;
+    uint32_t passes = 0;
+
+    storage_common_remove(
+        dir_index->storage, dir_index_file_path(dir_index, DIR_INDEX_JOURNAL_FILE_NAME));
+    storage_common_remove(
+        dir_index->storage, dir_index_file_path(dir_index, DIR_INDEX_PENDING_JOURNAL_FILE_NAME));
+
+    do {
+        if(!buffered_file_stream_open(
+               dir_index->stream,
+               dir_index_file_path(dir_index, DIR_INDEX_TEMP_FILE_NAME),
+               FSAM_WRITE,
+               FSOM_CREATE_ALWAYS))
+            break;
+        if(!dir_index_header_write(dir_index, dir_index->stream, 0, 0)) break;
+
+        bool pass_ok = true;
+        while(pass_ok) {
+            passes++;
+            if(!storage_dir_open(dir, furi_string_get_cstr(dir_index->path))) {
+                pass_ok = false;
+                break;
+            }
+
+            size_t entries_cnt;
+            do {
+                entries_cnt =
+                    storage_dir_read_batch(dir, dir_entries, STORAGE_DIR_READ_BATCH_SIZE);
+                for(size_t i = 0; i < entries_cnt; i++) {
+                    const char* name = dir_entries[i].name;
+                    uint8_t flags = file_info_is_dir(&dir_entries[i].fileinfo) ?
+                                        DIR_INDEX_RECORD_FLAG_DIR :
+                                        0;
+                    if(last.name &&
+                       dir_index_entry_cmp(dir_index, flags, name, last.flags, last.name) <= 0) {
+                        continue;
+                    }
+                    dir_index_selection_insert(dir_index, &selection, flags, name);
+                }
+            } while(entries_cnt == STORAGE_DIR_READ_BATCH_SIZE);
+
+            pass_ok = storage_file_get_error(dir) == FSE_NOT_EXIST;
+            storage_dir_close(dir);
+            if(!pass_ok || selection.count == 0) break;
+
+            for(size_t i = 0; i < selection.count && pass_ok; i++) {
+                pass_ok = dir_index_record_write(
+                    dir_index->stream,
+                    selection.entries[i].flags,
+                    selection.entries[i].name,
+                    &count,
+                    &checksum);
+            }
+
+            // Everything left fit into a single pass
+            if(!selection.full) break;
+
+            // Next pass continues right after the largest selected entry
+            free(last.name);
+            last = selection.entries[--selection.count];
+            dir_index_selection_reset(&selection);
+        }
+        if(!pass_ok) break;
+
+        if(!dir_index_header_write(dir_index, dir_index->stream, count, checksum)) break;
+        if(!buffered_file_stream_close(dir_index->stream)) break;
+
+        success = dir_index_commit(dir_index);
+    } while(false);
+
+    buffered_file_stream_close(dir_index->stream);
+
+    FURI_LOG_I(
+        TAG,
+        "Rebuilt %s: %lu entries in %lu passes, %s",
+        furi_string_get_cstr(dir_index->path),
+        count,
+        passes,
+        success ? "ok" : "failed");
+
+    free(last.name);
+    dir_index_selection_reset(&selection);
+    free(selection.entries);
+    free(dir_entries);
+    storage_file_free(dir);
+
+    return success;
+}
+
+static int dir_index_journal_name_cmp(const void* a, const void* b) {
+    return strcasecmp(((const DirIndexEntry*)a)->name, ((const DirIndexEntry*)b)->name);
+}
+
+// Index order with directories first, qsort has no context so it is a separate comparator
+static int dir_index_journal_dirs_first_cmp(const void* a, const void* b) {
+    bool a_is_dir = ((const DirIndexEntry*)a)->flags & DIR_INDEX_RECORD_FLAG_DIR;
+    bool b_is_dir = ((const DirIndexEntry*)b)->flags & DIR_INDEX_RECORD_FLAG_DIR;
+    if(a_is_dir != b_is_dir) {
+        return a_is_dir ? -1 : 1;
+    }
+    return dir_index_journal_name_cmp(a, b);
+}
+
+// Load pending journal, keeping only the last operation for every name
+static bool dir_index_journal_load(DirIndex* dir_index, DirIndexEntry* entries, size_t* count) {
+    bool success = false;
+    *count = 0;
+
+    do {
+        if(!buffered_file_stream_open(
+               dir_index->stream,
+               dir_index_file_path(dir_index, DIR_INDEX_PENDING_JOURNAL_FILE_NAME),
+               FSAM_READ,
+               FSOM_OPEN_EXISTING))
+            break;
+
+        bool overflow = false;
+        uint8_t head[3];
+        while(stream_read(dir_index->stream, head, sizeof(head)) == sizeof(head)) {
+            if(stream_read(dir_index->stream, (uint8_t*)dir_index->name_buffer, head[2]) !=
+               head[2])
+                break;
+            dir_index->name_buffer[head[2]] = '\0';
+
+            size_t idx = 0;
+            while(idx < *count && strcasecmp(entries[idx].name, dir_index->name_buffer) != 0) {
+                idx++;
+            }
+            if(idx == *count) {
+                if(*count == DIR_INDEX_JOURNAL_ENTRIES_MAX) {
+                    overflow = true;
+                    break;
+                }
+                entries[idx].name = strdup(dir_index->name_buffer);
+                (*count)++;
+            } else if(strcmp(entries[idx].name, dir_index->name_buffer) != 0) {
+                // Case only rename, keep the latest spelling
+                free(entries[idx].name);
+                entries[idx].name = strdup(dir_index->name_buffer);
+            }
+            entries[idx].op = head[0];
+            entries[idx].flags = head[1];
+        }
+
+        success = !overflow;
+    } while(false);
+
+    buffered_file_stream_close(dir_index->stream);
+    return success;
+}
+
+static bool dir_index_journal_merge(DirIndex* dir_index, DirIndexEntry* touched, size_t count) {
+    bool success = false;
+
+    // Touched names for lookups, added entries in index order for merging
+    DirIndexEntry* added = malloc(sizeof(DirIndexEntry) * (count ? count : 1));
+    size_t added_count = 0;
+    for(size_t i = 0; i < count; i++) {
+        if(touched[i].op == DirIndexJournalOpAdd) {
+            added[added_count++] = touched[i];
+        }
+    }
+    qsort(touched, count, sizeof(DirIndexEntry), dir_index_journal_name_cmp);
+    qsort(
+        added,
+        added_count,
+        sizeof(DirIndexEntry),
+        dir_index->dirs_first ? dir_index_journal_dirs_first_cmp : dir_index_journal_name_cmp);
+
+    Stream* output = buffered_file_stream_alloc(dir_index->storage);
+    uint32_t out_count = 0;
+    uint32_t out_checksum = 0;
+
+    do {
+        DirIndexHeader header;
+        if(!buffered_file_stream_open(
+               dir_index->stream,
+               dir_index_file_path(dir_index, DIR_INDEX_FILE_NAME),
+               FSAM_READ,
+               FSOM_OPEN_EXISTING))
+            break;
+        if(!dir_index_header_read(dir_index->stream, &header)) break;
+
+        if(!buffered_file_stream_open(
+               output,
+               dir_index_file_path(dir_index, DIR_INDEX_TEMP_FILE_NAME),
+               FSAM_WRITE,
+               FSOM_CREATE_ALWAYS))
+            break;
+        if(!dir_index_header_write(dir_index, output, 0, 0)) break;
+
+        bool write_ok = true;
+        size_t added_idx = 0;
+        uint8_t flags;
+        for(uint32_t i = 0; i < header.count && write_ok; i++) {
+            if(!dir_index_record_read(dir_index, dir_index->stream, &flags)) {
+                write_ok = false;
+                break;
+            }
+
+            DirIndexEntry key = {.name = dir_index->name_buffer};
+            if(bsearch(&key, touched, count, sizeof(DirIndexEntry), dir_index_journal_name_cmp)) {
+                continue;
+            }
+
+            while(write_ok && added_idx < added_count &&
+                  dir_index_entry_cmp(
+                      dir_index,
+                      added[added_idx].flags,
+                      added[added_idx].name,
+                      flags,
+                      dir_index->name_buffer) < 0) {
+                write_ok = dir_index_record_write(
+                    output,
+                    added[added_idx].flags,
+                    added[added_idx].name,
+                    &out_count,
+                    &out_checksum);
+                added_idx++;
+            }
+
+            if(write_ok) {
+                write_ok = dir_index_record_write(
+                    output, flags, dir_index->name_buffer, &out_count, &out_checksum);
+            }
+        }
+
+        while(write_ok && added_idx < added_count) {
+            write_ok = dir_index_record_write(
+                output, added[added_idx].flags, added[added_idx].name, &out_count, &out_checksum);
+            added_idx++;
+        }
+        if(!write_ok) break;
+
+        if(!dir_index_header_write(dir_index, output, out_count, out_checksum)) break;
+        if(!buffered_file_stream_close(output)) break;
+        buffered_file_stream_close(dir_index->stream);
+
+        success = dir_index_commit(dir_index);
+    } while(false);
+
+    buffered_file_stream_close(output);
+    buffered_file_stream_close(dir_index->stream);
+    stream_free(output);
+    free(added);
+
+    return success;
+}
+
+// Merge journaled changes into the index, returns false if the index must be rebuilt
+static bool dir_index_journal_apply(DirIndex* dir_index) {
+    Storage* storage = dir_index->storage;
+
+    FuriString* pending_path =
+        furi_string_alloc_set(dir_index_file_path(dir_index, DIR_INDEX_PENDING_JOURNAL_FILE_NAME));
+    const char* pending = furi_string_get_cstr(pending_path);
+
+    // Journal is moved aside first, so that changes made in the meantime go into a new one
+    if(!storage_file_exists(storage, pending)) {
+        const char* journal = dir_index_file_path(dir_index, DIR_INDEX_JOURNAL_FILE_NAME);
+        if(!storage_file_exists(storage, journal) ||
+           storage_common_rename(storage, journal, pending) != FSE_OK) {
+            furi_string_free(pending_path);
+            return storage_file_exists(storage, journal) == false;
+        }
+    }
+
+    DirIndexEntry* entries = malloc(sizeof(DirIndexEntry) * DIR_INDEX_JOURNAL_ENTRIES_MAX);
+    size_t count = 0;
+
+    bool success = dir_index_journal_load(dir_index, entries, &count) &&
+                   dir_index_journal_merge(dir_index, entries, count);
+    if(success) {
+        storage_common_remove(storage, pending);
+    }
+
+    for(size_t i = 0; i < count; i++) {
+        free(entries[i].name);
+    }
+    free(entries);
+    furi_string_free(pending_path);
+
+    return success;
+}
+
+bool dir_index_open(
+    DirIndex* dir_index,
+    const char* path,
+    bool dirs_first,
+    uint32_t count,
+    uint32_t checksum) {
+    furi_check(dir_index);
+    furi_check(path);
+
+    dir_index_close(dir_index);
+    furi_string_set(dir_index->path, path);
+    dir_index->dirs_first = dirs_first;
+
+    DirIndexHeader header;
+    bool valid = dir_index_load_header(dir_index, &header) && dir_index_journal_apply(dir_index) &&
+                 dir_index_load_header(dir_index, &header) && header.count == count &&
+                 header.checksum == checksum;
+
+    if(!valid) {
+        valid = dir_index_rebuild(dir_index);
+    }
+
+    if(valid) {
+        valid = buffered_file_stream_open(
+                    dir_index->stream,
+                    dir_index_file_path(dir_index, DIR_INDEX_FILE_NAME),
+                    FSAM_READ,
+                    FSOM_OPEN_EXISTING) &&
+                dir_index_header_read(dir_index->stream, &header);
+    }
+
+    if(!valid) {
+        dir_index_close(dir_index);
+    }
+
+    return valid;
+}
+
+bool dir_index_read(DirIndex* dir_index, FuriString* name, bool* is_dir) {
+    furi_check(dir_index);
+    furi_check(name);
+
+    uint8_t flags;
+    if(!dir_index_record_read(dir_index, dir_index->stream, &flags)) return false;
+
+    furi_string_set(name, dir_index->name_buffer);
+    if(is_dir) {
+        *is_dir = flags & DIR_INDEX_RECORD_FLAG_DIR;
+    }
+    return true;
+}
+
+bool dir_index_rewind(DirIndex* dir_index) {
+    furi_check(dir_index);
+    return stream_seek(dir_index->stream, sizeof(DirIndexHeader), StreamOffsetFromStart);
+}
+
+void dir_index_close(DirIndex* dir_index) {
+    furi_check(dir_index);
+    buffered_file_stream_close(dir_index->stream);
+}
@@ -0,0 +1,128 @@
+/**
+ * @file dir_index.h
+ * Persistent sorted directory index
+ *
+ * Keeps a sorted list of directory entries in a hidden file inside of the
+ * directory itself, so that huge folders can be paged through in sorted order
+ * with constant memory.
+ *
+ * The storage service appends every create, remove and rename happening in an
+ * indexed directory to a journal file next to the index, and the journal is
+ * merged into the index on the next open. Changes made behind the storage
+ * service back (e.g. by a PC) are caught by validating the entry count and an
+ * order independent checksum of entry names, which the caller computes while
+ * scanning the directory anyway. Directory modification time can't be used
+ * for that: FAT does not update it when directory contents change.
+ */
+#pragma once
+#include <storage/storage.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define DIR_INDEX_FILE_NAME                 ".dirindex"
+#define DIR_INDEX_JOURNAL_FILE_NAME         ".dirindex.log"
+#define DIR_INDEX_TEMP_FILE_NAME            ".dirindex.tmp"
+#define DIR_INDEX_PENDING_JOURNAL_FILE_NAME ".dirindex.plog"
+
+/** Maximum size of an encoded journal record */
+#define DIR_INDEX_JOURNAL_RECORD_SIZE_MAX (3 + 255)
+
+typedef struct DirIndex DirIndex;
+
+typedef enum {
+    DirIndexJournalOpAdd = '+', /**< Entry was created */
+    DirIndexJournalOpRemove = '-', /**< Entry was removed */
+} DirIndexJournalOp;
+
+/**
+ * Check if the name belongs to one of index service files, the storage
+ * service excludes them from directory listings
+ * @param name entry name
+ * @return true if it's a service file
+ */
+bool dir_index_is_service_file(const char* name);
+
+/**
+ * Add directory entry to an order independent checksum
+ * @param checksum checksum accumulated so far, start with 0
+ * @param name entry name
+ * @param is_dir entry is a directory
+ * @return updated checksum
+ */
+uint32_t dir_index_checksum_add(uint32_t checksum, const char* name, bool is_dir);
+
+/**
+ * Encode a journal record
+ * @param buffer output buffer, at least DIR_INDEX_JOURNAL_RECORD_SIZE_MAX bytes
+ * @param op operation
+ * @param is_dir entry is a directory
+ * @param name entry name
+ * @return encoded record size, 0 if the name is too long
+ */
+size_t dir_index_journal_record_encode(
+    uint8_t* buffer,
+    DirIndexJournalOp op,
+    bool is_dir,
+    const char* name);
+
+/**
+ * Allocate DirIndex
+ * @param storage
+ * @return DirIndex*
+ */
+DirIndex* dir_index_alloc(Storage* storage);
+
+/**
+ * Free DirIndex
+ * @param dir_index
+ */
+void dir_index_free(DirIndex* dir_index);
+
+/**
+ * Open index of a directory for reading
+ *
+ * Merges pending journal into the index, then validates it against the
+ * directory state provided by the caller. Missing, outdated or invalid index
+ * is rebuilt, which takes a few passes over the directory.
+ *
+ * @param dir_index
+ * @param path directory path
+ * @param dirs_first sort directories before files
+ * @param count number of entries in the directory, excluding service files
+ * @param checksum dir_index_checksum_add() of all entries, excluding service files
+ * @return true if the index is ready to be read
+ */
+bool dir_index_open(
+    DirIndex* dir_index,
+    const char* path,
+    bool dirs_first,
+    uint32_t count,
+    uint32_t checksum);
+
+/**
+ * Read next entry in sorted order
+ * @param dir_index
+ * @param name entry name
+ * @param is_dir entry is a directory
+ * @return true if an entry was read, false at the end of the index
+ */
+bool dir_index_read(DirIndex* dir_index, FuriString* name, bool* is_dir);
+
+/**
+ * Move back to the first entry
+ * @param dir_index
+ * @return true on success
+ */
+bool dir_index_rewind(DirIndex* dir_index);
+
+/**
+ * Close index
+ * @param dir_index
+ */
+void dir_index_close(DirIndex* dir_index);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,8 +1,6 @@
 #include "dir_walk.h"
 #include <m-list.h>
 
-#define MAX_NAME_LEN 254
-
 LIST_DEF(DirIndexList, uint32_t);
 
 struct DirWalk {
@@ -15,6 +13,10 @@ struct DirWalk {
     void* filter_context;
     const char** recurse_filter;
     size_t recurse_filter_count;
+    StorageDirEntry* entries;
+    size_t entries_cnt;
+    size_t entry_idx;
+    FS_Error entries_error;
 };
 
 DirWalk* dir_walk_alloc(Storage* storage) {
@@ -28,6 +30,10 @@ DirWalk* dir_walk_alloc(Storage* storage) {
     dir_walk->filter_cb = NULL;
     dir_walk->recurse_filter = NULL;
     dir_walk->recurse_filter_count = 0;
+    dir_walk->entries = malloc(sizeof(StorageDirEntry) * STORAGE_DIR_READ_BATCH_SIZE);
+    dir_walk->entries_cnt = 0;
+    dir_walk->entry_idx = 0;
+    dir_walk->entries_error = FSE_OK;
     return dir_walk;
 }
 
@@ -37,6 +43,7 @@ void dir_walk_free(DirWalk* dir_walk) {
     storage_file_free(dir_walk->file);
     furi_string_free(dir_walk->path);
     DirIndexList_clear(dir_walk->index_list);
+    free(dir_walk->entries);
     free(dir_walk);
 }
 
@@ -56,11 +63,49 @@ void dir_walk_set_recurse_filter(DirWalk* dir_walk, const char** array, size_t c
     dir_walk->recurse_filter_count = count;
 }
 
+static void dir_walk_entries_reset(DirWalk* dir_walk) {
+    dir_walk->entries_cnt = 0;
+    dir_walk->entry_idx = 0;
+    dir_walk->entries_error = FSE_OK;
+}
+
+static bool dir_walk_dir_open(DirWalk* dir_walk, const char* path) {
+    dir_walk_entries_reset(dir_walk);
+    return storage_dir_open(dir_walk->file, path);
+}
+
+static FS_Error dir_walk_read_entry(DirWalk* dir_walk, StorageDirEntry** entry) {
+    if(dir_walk->entry_idx == dir_walk->entries_cnt) {
+        if(dir_walk->entries_error != FSE_OK) {
+            return dir_walk->entries_error;
+        }
+
+        dir_walk->entries_cnt = storage_dir_read_batch(
+            dir_walk->file, dir_walk->entries, STORAGE_DIR_READ_BATCH_SIZE);
+        dir_walk->entry_idx = 0;
+
+        if(dir_walk->entries_cnt < STORAGE_DIR_READ_BATCH_SIZE) {
+            // Short batch: remember why reading stopped, report it once buffered entries are consumed
+            dir_walk->entries_error = storage_file_get_error(dir_walk->file);
+            if(dir_walk->entries_error == FSE_OK) {
+                dir_walk->entries_error = FSE_NOT_EXIST;
+            }
+        }
+
+        if(dir_walk->entries_cnt == 0) {
+            return dir_walk->entries_error;
+        }
+    }
+
+    *entry = &dir_walk->entries[dir_walk->entry_idx++];
+    return FSE_OK;
+}
+
 bool dir_walk_open(DirWalk* dir_walk, const char* path) {
     furi_check(dir_walk);
     furi_string_set(dir_walk->path, path);
     dir_walk->current_index = 0;
-    return storage_dir_open(dir_walk->file, path);
+    return dir_walk_dir_open(dir_walk, path);
 }
 
 static bool dir_walk_filter(DirWalk* dir_walk, const char* name, FileInfo* fileinfo) {
@@ -74,18 +119,19 @@ static bool dir_walk_filter(DirWalk* dir_walk, const char* name, FileInfo* filei
 static DirWalkResult
     dir_walk_iter(DirWalk* dir_walk, FuriString* return_path, FileInfo* fileinfo) {
     DirWalkResult result = DirWalkError;
-    char* name = malloc(MAX_NAME_LEN);
-    FileInfo info;
+    StorageDirEntry* entry = NULL;
     bool end = false;
 
     while(!end) {
-        storage_dir_read(dir_walk->file, &info, name, MAX_NAME_LEN);
+        FS_Error error = dir_walk_read_entry(dir_walk, &entry);
 
-        if(storage_file_get_error(dir_walk->file) == FSE_OK) {
+        if(error == FSE_OK) {
+            const char* name = entry->name;
+            FileInfo* info = &entry->fileinfo;
             result = DirWalkOK;
             dir_walk->current_index++;
 
-            if(dir_walk_filter(dir_walk, name, &info)) {
+            if(dir_walk_filter(dir_walk, name, info)) {
                 if(return_path != NULL) {
                     furi_string_printf( //-V576
                         return_path,
@@ -95,13 +141,13 @@ static DirWalkResult
                 }
 
                 if(fileinfo != NULL) {
-                    memcpy(fileinfo, &info, sizeof(FileInfo));
+                    memcpy(fileinfo, info, sizeof(FileInfo));
                 }
 
                 end = true;
             }
 
-            if(file_info_is_dir(&info) && dir_walk->recursive) {
+            if(file_info_is_dir(info) && dir_walk->recursive) {
                 furi_string_cat_printf(dir_walk->path, "/%s", name);
 
                 bool filter = false;
@@ -124,10 +170,10 @@ static DirWalkResult
                     DirIndexList_push_back(dir_walk->index_list, dir_walk->current_index);
                     dir_walk->current_index = 0;
                     storage_dir_close(dir_walk->file);
-                    storage_dir_open(dir_walk->file, furi_string_get_cstr(dir_walk->path));
+                    dir_walk_dir_open(dir_walk, furi_string_get_cstr(dir_walk->path));
                 }
             }
-        } else if(storage_file_get_error(dir_walk->file) == FSE_NOT_EXIST) {
+        } else if(error == FSE_NOT_EXIST) {
             if(DirIndexList_size(dir_walk->index_list) == 0) {
                 // last
                 result = DirWalkLast;
@@ -145,7 +191,7 @@ static DirWalkResult
                     furi_string_left(dir_walk->path, last_char);
                 }
 
-                storage_dir_open(dir_walk->file, furi_string_get_cstr(dir_walk->path));
+                dir_walk_dir_open(dir_walk, furi_string_get_cstr(dir_walk->path));
 
                 // rewind
                 while(true) {
@@ -154,7 +200,7 @@ static DirWalkResult
                         break;
                     }
 
-                    if(!storage_dir_read(dir_walk->file, &info, name, MAX_NAME_LEN)) {
+                    if(dir_walk_read_entry(dir_walk, &entry) != FSE_OK) {
                         result = DirWalkError;
                         end = true;
                         break;
@@ -169,7 +215,6 @@ static DirWalkResult
         }
     }
 
-    free(name);
     return result;
 }
 
@@ -192,4 +237,5 @@ void dir_walk_close(DirWalk* dir_walk) {
     DirIndexList_reset(dir_walk->index_list);
     furi_string_reset(dir_walk->path);
     dir_walk->current_index = 0;
+    dir_walk_entries_reset(dir_walk);
 }
@@ -84,11 +84,16 @@ typedef struct {
     } config;
     File* stream;
     CompressStreamDecoder* decoder;
+    bool seekable;
 } CompressedStream;
 
 /* HSDS 'heatshrink data stream' header magic */
 static const uint32_t HEATSHRINK_MAGIC = 0x53445348;
 
+/* Version 1 streams are plain, version 2 streams are segmented and end with a seek index */
+#define HEATSHRINK_VERSION           1
+#define HEATSHRINK_VERSION_SEGMENTED 2
+
 typedef struct {
     uint32_t magic;
     uint8_t version;
@@ -97,6 +102,17 @@ typedef struct {
 } FURI_PACKED HeatshrinkStreamHeader;
 _Static_assert(sizeof(HeatshrinkStreamHeader) == 7, "Invalid HeatshrinkStreamHeader size");
 
+/* HSIX 'heatshrink index' footer magic */
+static const uint32_t HEATSHRINK_INDEX_MAGIC = 0x58495348;
+
+/* Seek index footer: preceded by segment_count + 1 segment offsets */
+typedef struct {
+    uint32_t segment_size;
+    uint32_t segment_count;
+    uint32_t magic;
+} FURI_PACKED HeatshrinkStreamIndexFooter;
+_Static_assert(sizeof(HeatshrinkStreamIndexFooter) == 12, "Invalid index footer size");
+
 static int mtar_compressed_file_close(void* stream) {
     CompressedStream* compressed_stream = stream;
     if(compressed_stream) {
@@ -118,7 +134,9 @@ static int mtar_compressed_file_read(void* stream, void* data, unsigned size) {
 static int mtar_compressed_file_seek(void* stream, unsigned offset) {
     CompressedStream* compressed_stream = stream;
     bool success = false;
-    if(offset == 0 && compress_stream_decoder_tell(compressed_stream->decoder) != 0) {
+    if(compressed_stream->seekable) {
+        success = compress_stream_decoder_seek(compressed_stream->decoder, offset);
+    } else if(offset == 0 && compress_stream_decoder_tell(compressed_stream->decoder) != 0) {
         uint32_t rewind_offset =
             compressed_stream->type == CompressTypeHeatshrink ? sizeof(HeatshrinkStreamHeader) : 0;
         success = storage_file_seek(compressed_stream->stream, rewind_offset, true) &&
@@ -152,6 +170,45 @@ static int32_t file_read_cb(void* context, uint8_t* buffer, size_t buffer_size)
     return storage_file_read(file, buffer, buffer_size);
 }
 
+static bool file_seek_cb(void* context, size_t position) {
+    File* file = context;
+    return storage_file_seek(file, sizeof(HeatshrinkStreamHeader) + position, true);
+}
+
+/* Load seek index from the end of segmented heatshrink stream */
+static bool tar_archive_set_seek_index(CompressStreamDecoder* decoder, File* stream) {
+    bool success = false;
+    uint64_t size = storage_file_size(stream);
+    HeatshrinkStreamIndexFooter footer;
+    uint32_t* offsets = NULL;
+
+    do {
+        if(size < sizeof(HeatshrinkStreamHeader) + sizeof(footer)) break;
+        if(!storage_file_seek(stream, size - sizeof(footer), true)) break;
+        if(storage_file_read(stream, &footer, sizeof(footer)) != sizeof(footer)) break;
+        if(footer.magic != HEATSHRINK_INDEX_MAGIC) break;
+
+        // Corrupt footer must not wrap the offsets size
+        const uint64_t offsets_max =
+            (size - sizeof(HeatshrinkStreamHeader) - sizeof(footer)) / sizeof(uint32_t);
+        if(footer.segment_count >= offsets_max) break;
+        size_t offsets_size = sizeof(uint32_t) * (footer.segment_count + 1);
+        offsets = malloc(offsets_size);
+        if(!storage_file_seek(stream, size - sizeof(footer) - offsets_size, true)) break;
+        if(storage_file_read(stream, offsets, offsets_size) != offsets_size) break;
+
+        CompressSeekIndex index = {
+            .segment_size = footer.segment_size,
+            .segment_count = footer.segment_count,
+            .offsets = offsets,
+        };
+        success = compress_stream_decoder_set_seek_index(decoder, &index, file_seek_cb);
+    } while(false);
+
+    free(offsets);
+    return success;
+}
+
 bool tar_archive_open(TarArchive* archive, const char* path, TarOpenMode mode) {
     furi_check(archive);
     FS_AccessMode access_mode;
@@ -193,18 +250,24 @@ bool tar_archive_open(TarArchive* archive, const char* path, TarOpenMode mode) {
 
     CompressedStream* compressed_stream = malloc(sizeof(CompressedStream));
     compressed_stream->stream = stream;
+    compressed_stream->seekable = false;
+    uint8_t heatshrink_version = 0;
 
     if(mode == TarOpenModeReadHeatshrink) {
         /* Read and validate stream header */
         HeatshrinkStreamHeader header;
         if(storage_file_read(stream, &header, sizeof(HeatshrinkStreamHeader)) !=
                sizeof(HeatshrinkStreamHeader) ||
-           header.magic != HEATSHRINK_MAGIC) {
+           header.magic != HEATSHRINK_MAGIC ||
+           (header.version != HEATSHRINK_VERSION &&
+            header.version != HEATSHRINK_VERSION_SEGMENTED)) {
+            FURI_LOG_E(TAG, "Unsupported heatshrink stream");
             storage_file_close(stream);
             free(compressed_stream);
             return false;
         }
 
+        heatshrink_version = header.version;
         compressed_stream->type = CompressTypeHeatshrink;
         compressed_stream->config.heatshrink.window_sz2 = header.window_sz2;
         compressed_stream->config.heatshrink.lookahead_sz2 = header.lookahead_sz2;
@@ -224,6 +287,17 @@ bool tar_archive_open(TarArchive* archive, const char* path, TarOpenMode mode) {
         return false;
     }
 
+    if(heatshrink_version == HEATSHRINK_VERSION_SEGMENTED) {
+        if(!tar_archive_set_seek_index(compressed_stream->decoder, stream)) {
+            FURI_LOG_E(TAG, "Invalid seek index");
+            compress_stream_decoder_free(compressed_stream->decoder);
+            storage_file_close(stream);
+            free(compressed_stream);
+            return false;
+        }
+        compressed_stream->seekable = true;
+    }
+
     mtar_init(&archive->tar, mtar_access, &compressed_ops, compressed_stream);
 
     return true;
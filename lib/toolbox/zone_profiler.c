@@ -0,0 +1,119 @@
+#include "zone_profiler.h"
+
+#include <furi.h>
+#include <stm32wbxx.h>
+
+/* Durations under 2^ZONE_PROFILER_HISTOGRAM_SHIFT cycles go to bucket 0 */
+#define ZONE_PROFILER_HISTOGRAM_SHIFT 6
+
+typedef struct {
+    uint32_t count;
+    uint32_t min_inverted; /* Kept as ~min, so zeroed means no samples and max logic applies */
+    uint32_t max;
+    uint32_t total_low;
+    uint32_t total_high; /* Carry of total_low, added by the update that wrapped it */
+    uint32_t histogram[ZONE_PROFILER_HISTOGRAM_SIZE];
+} ZoneProfilerZone;
+
+static const char* const zone_profiler_names[ZoneProfilerIdNum] = {
+    [ZoneProfilerIdNfcListenerRx] = "NFC listener RX",
+    [ZoneProfilerIdNfcPoller] = "NFC poller",
+    [ZoneProfilerIdSubGhzRxIsr] = "SubGhz RX ISR",
+    [ZoneProfilerIdSubGhzDecode] = "SubGhz decode",
+    [ZoneProfilerIdInfraredRxIsr] = "IR RX ISR",
+    [ZoneProfilerIdInfraredDecode] = "IR decode",
+    [ZoneProfilerIdInfraredTxIsr] = "IR TX ISR",
+    [ZoneProfilerIdGuiRedraw] = "Gui redraw",
+    [ZoneProfilerIdGuiCommit] = "Gui commit",
+};
+
+static ZoneProfilerZone zone_profiler_zones[ZoneProfilerIdNum] = {0};
+static volatile bool zone_profiler_enabled = false;
+
+static inline void zone_profiler_store_max(uint32_t* value, uint32_t cycles) {
+    uint32_t current = __atomic_load_n(value, __ATOMIC_RELAXED);
+    while(cycles > current) {
+        // Failed exchange reloads current, retry only while still larger
+        if(__atomic_compare_exchange_n(
+               value, &current, cycles, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            break;
+        }
+    }
+}
+
+void zone_profiler_set_enabled(bool enabled) {
+    zone_profiler_enabled = enabled;
+}
+
+bool zone_profiler_is_enabled(void) {
+    return zone_profiler_enabled;
+}
+
+void zone_profiler_reset(void) {
+    // Updates running meanwhile may land in either the old or the new numbers
+    for(size_t i = 0; i < ZoneProfilerIdNum; i++) {
+        ZoneProfilerZone* zone = &zone_profiler_zones[i];
+        __atomic_store_n(&zone->count, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&zone->min_inverted, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&zone->max, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&zone->total_high, 0, __ATOMIC_RELAXED);
+        __atomic_store_n(&zone->total_low, 0, __ATOMIC_RELAXED);
+        for(size_t bucket = 0; bucket < ZONE_PROFILER_HISTOGRAM_SIZE; bucket++) {
+            __atomic_store_n(&zone->histogram[bucket], 0, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+uint32_t zone_profiler_begin(void) {
+    if(!zone_profiler_enabled) return 0;
+    // 0 means disabled, a start exactly at 0 is one cycle late
+    return DWT->CYCCNT | 1;
+}
+
+void zone_profiler_end(ZoneProfilerId zone_id, uint32_t start) {
+    const uint32_t cycles = DWT->CYCCNT - start;
+    if(!start || !zone_profiler_enabled) return;
+    furi_check(zone_id < ZoneProfilerIdNum);
+
+    ZoneProfilerZone* zone = &zone_profiler_zones[zone_id];
+    __atomic_fetch_add(&zone->count, 1, __ATOMIC_RELAXED);
+    const uint32_t total = __atomic_fetch_add(&zone->total_low, cycles, __ATOMIC_RELAXED);
+    if(total + cycles < total) __atomic_fetch_add(&zone->total_high, 1, __ATOMIC_RELAXED);
+    zone_profiler_store_max(&zone->min_inverted, ~cycles);
+    zone_profiler_store_max(&zone->max, cycles);
+
+    const uint32_t bits = 32 - __builtin_clz(cycles | 1);
+    size_t bucket = 0;
+    if(bits > ZONE_PROFILER_HISTOGRAM_SHIFT) {
+        bucket = MIN(bits - ZONE_PROFILER_HISTOGRAM_SHIFT, ZONE_PROFILER_HISTOGRAM_SIZE - 1U);
+    }
+    __atomic_fetch_add(&zone->histogram[bucket], 1, __ATOMIC_RELAXED);
+}
+
+void zone_profiler_get_stats(ZoneProfilerId zone_id, ZoneProfilerStats* stats) {
+    furi_check(zone_id < ZoneProfilerIdNum);
+    furi_check(stats);
+
+    const ZoneProfilerZone* zone = &zone_profiler_zones[zone_id];
+    stats->name = zone_profiler_names[zone_id];
+    stats->count = __atomic_load_n(&zone->count, __ATOMIC_RELAXED);
+    stats->min = stats->count ? ~__atomic_load_n(&zone->min_inverted, __ATOMIC_RELAXED) : 0;
+    stats->max = __atomic_load_n(&zone->max, __ATOMIC_RELAXED);
+
+    // Retry if a carry lands between the reads
+    uint32_t high, low;
+    do {
+        high = __atomic_load_n(&zone->total_high, __ATOMIC_RELAXED);
+        low = __atomic_load_n(&zone->total_low, __ATOMIC_RELAXED);
+    } while(high != __atomic_load_n(&zone->total_high, __ATOMIC_RELAXED));
+    stats->total = ((uint64_t)high << 32) | low;
+
+    for(size_t bucket = 0; bucket < ZONE_PROFILER_HISTOGRAM_SIZE; bucket++) {
+        stats->histogram[bucket] = __atomic_load_n(&zone->histogram[bucket], __ATOMIC_RELAXED);
+    }
+}
+
+uint32_t zone_profiler_get_bucket_start(size_t bucket) {
+    furi_check(bucket < ZONE_PROFILER_HISTOGRAM_SIZE);
+    return bucket ? (1UL << (bucket + ZONE_PROFILER_HISTOGRAM_SHIFT - 1)) : 0;
+}
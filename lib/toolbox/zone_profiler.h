@@ -0,0 +1,101 @@
+/**
+ * @file zone_profiler.h
+ * Cycle accurate profiler for hot paths.
+ *
+ * Zones are listed in ZoneProfilerId and timed with the DWT cycle counter.
+ * Statistics are updated with atomic operations only, so zones can be used
+ * in interrupts and in threads at the same time. While the profiler is
+ * disabled, zone_profiler_begin and zone_profiler_end return right away.
+ *
+ * ```c
+ * const uint32_t start = zone_profiler_begin();
+ * do_work();
+ * zone_profiler_end(ZoneProfilerIdSomething, start);
+ * ```
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Profiled zones, add new ones before ZoneProfilerIdNum */
+typedef enum {
+    ZoneProfilerIdNfcListenerRx, /**< NFC listener frame handling, from RX end to response */
+    ZoneProfilerIdNfcPoller, /**< NFC poller protocol callback */
+    ZoneProfilerIdSubGhzRxIsr, /**< Sub-GHz capture interrupt */
+    ZoneProfilerIdSubGhzDecode, /**< Sub-GHz level and duration pair decoding */
+    ZoneProfilerIdInfraredRxIsr, /**< Infrared capture interrupt */
+    ZoneProfilerIdInfraredDecode, /**< Infrared timing decoding */
+    ZoneProfilerIdInfraredTxIsr, /**< Infrared transmit buffer refill interrupt */
+    ZoneProfilerIdGuiRedraw, /**< Gui frame drawing */
+    ZoneProfilerIdGuiCommit, /**< Gui frame buffer transfer to the display */
+
+    ZoneProfilerIdNum,
+} ZoneProfilerId;
+
+/** Number of histogram buckets. Bucket 0 counts durations under 64 cycles,
+ * bucket N counts durations from 2^(N+5) cycles, the last one has no limit */
+#define ZONE_PROFILER_HISTOGRAM_SIZE 16
+
+/** Zone statistics, durations in CPU cycles */
+typedef struct {
+    const char* name;
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+    uint32_t histogram[ZONE_PROFILER_HISTOGRAM_SIZE];
+} ZoneProfilerStats;
+
+/** Enable or disable the profiler
+ *
+ * @param      enabled  true to enable
+ */
+void zone_profiler_set_enabled(bool enabled);
+
+/** Check if the profiler is enabled
+ *
+ * @return     true if enabled
+ */
+bool zone_profiler_is_enabled(void);
+
+/** Clear statistics of all zones
+ */
+void zone_profiler_reset(void);
+
+/** Enter a zone, safe to call from interrupts
+ *
+ * @return     start timestamp for zone_profiler_end, 0 if disabled
+ */
+uint32_t zone_profiler_begin(void);
+
+/** Leave a zone and account its duration, safe to call from interrupts
+ *
+ * @param      zone   zone id
+ * @param      start  timestamp returned by zone_profiler_begin, 0 is ignored
+ */
+void zone_profiler_end(ZoneProfilerId zone, uint32_t start);
+
+/** Get zone statistics
+ *
+ * @param      zone   zone id
+ * @param      stats  output statistics
+ */
+void zone_profiler_get_stats(ZoneProfilerId zone, ZoneProfilerStats* stats);
+
+/** Get the shortest duration counted by a histogram bucket
+ *
+ * @param      bucket  bucket index
+ *
+ * @return     duration in CPU cycles
+ */
+uint32_t zone_profiler_get_bucket_start(size_t bucket);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,17 +1,21 @@
 import struct
 
+import heatshrink2
+
 
 class HeatshrinkDataStreamHeader:
     MAGIC = 0x53445348
     VERSION = 1
+    VERSION_SEGMENTED = 2
 
-    def __init__(self, window_size, lookahead_size):
+    def __init__(self, window_size, lookahead_size, version=VERSION):
         self.window_size = window_size
         self.lookahead_size = lookahead_size
+        self.version = version
 
     def pack(self):
         return struct.pack(
-            "<IBBB", self.MAGIC, self.VERSION, self.window_size, self.lookahead_size
+            "<IBBB", self.MAGIC, self.version, self.window_size, self.lookahead_size
         )
 
     @staticmethod
@@ -21,6 +25,102 @@ class HeatshrinkDataStreamHeader:
         magic, version, window_size, lookahead_size = struct.unpack("<IBBB", data)
         if magic != HeatshrinkDataStreamHeader.MAGIC:
             raise ValueError("Invalid magic number")
-        if version != HeatshrinkDataStreamHeader.VERSION:
+        if version not in (
+            HeatshrinkDataStreamHeader.VERSION,
+            HeatshrinkDataStreamHeader.VERSION_SEGMENTED,
+        ):
             raise ValueError("Invalid version")
-        return HeatshrinkDataStreamHeader(window_size, lookahead_size)
+        return HeatshrinkDataStreamHeader(window_size, lookahead_size, version)
+
+
+class HeatshrinkDataStreamIndex:
+    """Seek index footer of a segmented stream.
+
+    Segmented stream is a concatenation of independent heatshrink streams,
+    each holding segment_size bytes of uncompressed data, so that decoding
+    can start at any segment. Footer holds compressed offset of every
+    segment and of the data end, followed by segment size, segment count
+    and magic.
+    """
+
+    MAGIC = 0x58495348
+    FOOTER_FORMAT = "<III"
+
+    def __init__(self, segment_size, offsets):
+        self.segment_size = segment_size
+        self.offsets = offsets
+
+    def pack(self):
+        segment_count = len(self.offsets) - 1
+        return struct.pack(f"<{len(self.offsets)}I", *self.offsets) + struct.pack(
+            self.FOOTER_FORMAT, self.segment_size, segment_count, self.MAGIC
+        )
+
+    @staticmethod
+    def unpack(data):
+        """Parse index from the end of stream data, returns index and data size"""
+        footer_size = struct.calcsize(HeatshrinkDataStreamIndex.FOOTER_FORMAT)
+        if len(data) < footer_size:
+            raise ValueError("Invalid index length")
+        segment_size, segment_count, magic = struct.unpack(
+            HeatshrinkDataStreamIndex.FOOTER_FORMAT, data[-footer_size:]
+        )
+        if magic != HeatshrinkDataStreamIndex.MAGIC:
+            raise ValueError("Invalid index magic number")
+        offsets_size = 4 * (segment_count + 1)
+        index_start = len(data) - footer_size - offsets_size
+        if index_start < 0:
+            raise ValueError("Invalid index length")
+        offsets = struct.unpack(
+            f"<{segment_count + 1}I", data[index_start : len(data) - footer_size]
+        )
+        return HeatshrinkDataStreamIndex(segment_size, list(offsets)), index_start
+
+
+def heatshrink_stream_compress(data, window_sz2, lookahead_sz2, segment_size=None):
+    """Compress data into a stream with header, segmented if segment_size is set"""
+    if not segment_size:
+        header = HeatshrinkDataStreamHeader(window_sz2, lookahead_sz2)
+        return header.pack() + heatshrink2.compress(
+            data, window_sz2=window_sz2, lookahead_sz2=lookahead_sz2
+        )
+
+    header = HeatshrinkDataStreamHeader(
+        window_sz2, lookahead_sz2, HeatshrinkDataStreamHeader.VERSION_SEGMENTED
+    )
+    segments = []
+    offsets = [0]
+    for start in range(0, max(len(data), 1), segment_size):
+        segment = heatshrink2.compress(
+            data[start : start + segment_size],
+            window_sz2=window_sz2,
+            lookahead_sz2=lookahead_sz2,
+        )
+        segments.append(segment)
+        offsets.append(offsets[-1] + len(segment))
+    index = HeatshrinkDataStreamIndex(segment_size, offsets)
+    return header.pack() + b"".join(segments) + index.pack()
+
+
+def heatshrink_stream_decompress(stream):
+    """Decompress stream with header, returns header and data"""
+    header = HeatshrinkDataStreamHeader.unpack(stream[:7])
+    compressed = stream[7:]
+
+    if header.version == HeatshrinkDataStreamHeader.VERSION:
+        return header, heatshrink2.decompress(
+            compressed,
+            window_sz2=header.window_size,
+            lookahead_sz2=header.lookahead_size,
+        )
+
+    index, _ = HeatshrinkDataStreamIndex.unpack(compressed)
+    data = b"".join(
+        heatshrink2.decompress(
+            compressed[start:end],
+            window_sz2=header.window_size,
+            lookahead_sz2=header.lookahead_size,
+        )
+        for start, end in zip(index.offsets, index.offsets[1:])
+    )
+    return header, data
@@ -2,9 +2,7 @@ import io
 import gzip
 import tarfile
 
-import heatshrink2
-
-from .heatshrink_stream import HeatshrinkDataStreamHeader
+from .heatshrink_stream import heatshrink_stream_compress
 
 FLIPPER_TAR_FORMAT = tarfile.USTAR_FORMAT
 
@@ -29,6 +27,7 @@ def compress_tree_tarball(
     filter=tar_sanitizer_filter,
     hs_window=13,
     hs_lookahead=6,
+    hs_segment_size=None,
     gz_level=9,
 ):
     plain_tar = io.BytesIO()
@@ -42,11 +41,10 @@ def compress_tree_tarball(
     src_data = plain_tar.read()
 
     if output_name.endswith(TAR_HEATSHRINK_EXTENSION):
-        compressed = heatshrink2.compress(
-            src_data, window_sz2=hs_window, lookahead_sz2=hs_lookahead
+        # With hs_segment_size set, stream gets a seek index for random access
+        compressed = heatshrink_stream_compress(
+            src_data, hs_window, hs_lookahead, hs_segment_size
         )
-        header = HeatshrinkDataStreamHeader(hs_window, hs_lookahead)
-        compressed = header.pack() + compressed
 
     elif output_name.endswith(TAR_GZIP_EXTENSION):
         compressed = gzip.compress(src_data, compresslevel=gz_level, mtime=0)
@@ -303,6 +303,27 @@ class FlipperStorage:
         self.read.until(self.CLI_PROMPT)
         return filedata
 
+    def read_file_stream(self, filename: str):
+        """Receive file from Flipper in one go with `storage read`"""
+        self.send_and_wait_eol(f'storage read "{filename}"\r')
+        answer = self.read.until(self.CLI_EOL)
+        if self.has_error(answer):
+            last_error = self.get_error(answer)
+            self.read.until(self.CLI_PROMPT)
+            raise FlipperStorageException.from_error_code(filename, last_error)
+        size = int(answer.split(b": ")[1])
+
+        # Data may already be buffered while looking for the size line
+        filedata = bytearray(self.read.buffer[:size])
+        del self.read.buffer[:size]
+        while len(filedata) < size:
+            data = self.port.read(size - len(filedata))
+            if not data:
+                raise FlipperStorageException(f"Timeout reading '{filename}'")
+            filedata.extend(data)
+        self.read.until(self.CLI_PROMPT)
+        return filedata
+
     def receive_file(self, filename_from: str, filename_to: str):
         """Receive file from Flipper to local storage"""
         with open(filename_to, "wb") as file:
@@ -0,0 +1,158 @@
+#!/usr/bin/env python3
+
+import bisect
+import re
+import sys
+
+from elftools.elf.elffile import ELFFile
+from flipper.app import App
+from flipper.storage import FlipperStorage
+from flipper.utils.cdc import resolve_port
+
+# Must match cli_command_heap_trace_dump in applications/services/cli/cli_commands.c
+RECORD = re.compile(r"^0x([0-9A-Fa-f]{8}) +(\d+) +0x([0-9A-Fa-f]{8})\s*$")
+SUMMARY = re.compile(r"^Live: (\d+) blocks, (\d+) bytes, lost: (\d+)")
+
+
+class SymbolTable:
+    def __init__(self, elf_path):
+        functions = {}
+        with open(elf_path, "rb") as f:
+            elf = ELFFile(f)
+            symtab = elf.get_section_by_name(".symtab")
+            if symtab is None:
+                raise ValueError(f"{elf_path} has no symbol table")
+            for symbol in symtab.iter_symbols():
+                if symbol["st_info"]["type"] != "STT_FUNC" or not symbol["st_value"]:
+                    continue
+                # Thumb bit is set in function addresses
+                start = symbol["st_value"] & ~1
+                functions[start] = (symbol.name, symbol["st_size"])
+        self.starts = sorted(functions)
+        self.functions = [functions[start] for start in self.starts]
+
+    def resolve(self, address):
+        """Return (function, offset) for a return address, None if not in the ELF"""
+        # Return address points after the call, look up the call itself
+        address = (address & ~1) - 1
+        index = bisect.bisect_right(self.starts, address) - 1
+        if index < 0:
+            return None
+        name, size = self.functions[index]
+        offset = address - self.starts[index]
+        if size and offset >= size:
+            return None
+        return name, offset + 1
+
+
+class Function:
+    def __init__(self, name):
+        self.name = name
+        self.blocks = 0
+        self.bytes = 0
+        self.sites = {}
+
+    def add(self, site, size):
+        self.blocks += 1
+        self.bytes += size
+        blocks, total = self.sites.get(site, (0, 0))
+        self.sites[site] = (blocks + 1, total + size)
+
+
+def parse_dump(lines):
+    records = []
+    summary = None
+    for line in lines:
+        if match := RECORD.match(line):
+            records.append((int(match[1], 16), int(match[2]), int(match[3], 16)))
+        elif match := SUMMARY.match(line):
+            summary = tuple(int(value) for value in match.groups())
+    return records, summary
+
+
+def aggregate(symbols, records):
+    functions = {}
+    for caller, size, _ in records:
+        resolved = symbols.resolve(caller)
+        if resolved:
+            name, offset = resolved
+            site = f"{name}+0x{offset:x}"
+        else:
+            # Apps are loaded to RAM and are not in the firmware ELF
+            name = "[unknown]"
+            site = f"0x{caller:08x}"
+        function = functions.setdefault(name, Function(name))
+        function.add(site, size)
+    return sorted(functions.values(), key=lambda function: function.bytes, reverse=True)
+
+
+class Main(App):
+    def init(self):
+        self.parser.add_argument("elf", help="Firmware ELF the trace was taken on")
+        self.parser.add_argument(
+            "-s", "--sites", action="store_true", help="List call sites of every function"
+        )
+        self.parser.add_argument(
+            "-c",
+            "--collapsed",
+            action="store_true",
+            help="Print function;site bytes lines for flamegraph.pl",
+        )
+        self.subparsers = self.parser.add_subparsers(help="sub-command help")
+
+        self.parser_file = self.subparsers.add_parser("file", help="Symbolize saved dump")
+        self.parser_file.add_argument("input", help="Output of heap_trace dump, - for stdin")
+        self.parser_file.set_defaults(func=self.symbolize_file)
+
+        self.parser_serial = self.subparsers.add_parser("serial", help="Dump from device")
+        self.parser_serial.add_argument("-p", "--port", help="CDC Port", default="auto")
+        self.parser_serial.set_defaults(func=self.symbolize_serial)
+
+    def report(self, lines):
+        records, summary = parse_dump(lines)
+        if not records:
+            self.logger.error("No records, is the trace started with <heap_trace start>?")
+            return 1
+
+        functions = aggregate(SymbolTable(self.args.elf), records)
+        if self.args.collapsed:
+            for function in functions:
+                for site, (_, total) in function.sites.items():
+                    print(f"{function.name};{site} {total}")
+            return 0
+
+        total = sum(function.bytes for function in functions)
+        print(f"{'bytes':>8} {'%':>5} {'blocks':>6}  function")
+        for function in functions:
+            share = function.bytes * 100 / total if total else 0
+            print(f"{function.bytes:>8} {share:>5.1f} {function.blocks:>6}  {function.name}")
+            if self.args.sites:
+                sites = sorted(function.sites.items(), key=lambda item: item[1][1], reverse=True)
+                for site, (blocks, site_bytes) in sites:
+                    print(f"{site_bytes:>8} {'':>5} {blocks:>6}    {site}")
+        print(f"Total: {total} bytes in {len(records)} blocks")
+        if summary:
+            live, _, lost = summary
+            if live > len(records):
+                self.logger.warning(f"Dump has {len(records)} of {live} live blocks")
+            if lost:
+                self.logger.warning(f"{lost} allocations were not recorded, table was full")
+        return 0
+
+    def symbolize_file(self):
+        if self.args.input == "-":
+            return self.report(sys.stdin.read().splitlines())
+        with open(self.args.input) as f:
+            return self.report(f.read().splitlines())
+
+    def symbolize_serial(self):
+        if not (port := resolve_port(self.logger, self.args.port)):
+            self.logger.error("Is Flipper connected via USB and not in DFU mode?")
+            return 1
+        with FlipperStorage(port) as flipper:
+            data = flipper.send_and_wait_prompt("heap_trace dump\r")
+        return self.report(data.decode("ascii", errors="replace").splitlines())
+
+
+if __name__ == "__main__":
+    Main()()
@@ -0,0 +1,165 @@
+#!/usr/bin/env python3
+
+import glob
+import os
+import select
+import struct
+import sys
+import termios
+import time
+
+from flipper.app import App
+
+# Must match targets/furi_hal_include/furi_hal_usb_hid.h
+HID_VID_DEFAULT = 0x046D
+HID_PID_DEFAULT = 0xC529
+REPORT_ID_KEYBOARD = 1
+KEYBOARD_REPORT = struct.Struct("<BBB6B")
+
+
+class Capture:
+    def __init__(self):
+        self.previous = ()
+        self.reports = 0
+        self.keys = 0
+        self.first = None
+        self.last = None
+        self.batches = {}
+
+    def feed(self, data, timestamp):
+        if len(data) != KEYBOARD_REPORT.size or data[0] != REPORT_ID_KEYBOARD:
+            return
+        _, _, _, *keys = KEYBOARD_REPORT.unpack(data)
+        self.reports += 1
+        # Keys pressed by this report, in which order the host types them is not known here
+        pressed = [key for key in keys if key and key not in self.previous]
+        self.previous = keys
+        if not pressed:
+            return
+        if self.first is None:
+            self.first = timestamp
+        self.last = timestamp
+        self.keys += len(pressed)
+        self.batches[len(pressed)] = self.batches.get(len(pressed), 0) + 1
+
+    def summary(self):
+        elapsed = (self.last - self.first) if self.keys > 1 else 0
+        lines = [
+            f"Reports: {self.reports}, keys: {self.keys}, time: {elapsed * 1000:.1f}ms",
+        ]
+        if elapsed:
+            lines.append(
+                f"Throughput: {self.keys / elapsed:.0f} keys/s, "
+                f"{self.reports / elapsed:.0f} reports/s, "
+                f"{self.keys / max(self.reports, 1) * 2:.2f} keys per report pair"
+            )
+        batches = ", ".join(f"{size}: {n}" for size, n in sorted(self.batches.items()))
+        lines.append(f"Keys per pressing report: {batches}")
+        return "\n".join(lines)
+
+
+class TextSink:
+    """Text the host typed into this terminal, with echo and line editing off"""
+
+    def __init__(self, fd):
+        self.fd = fd
+        self.text = bytearray()
+        self.saved = termios.tcgetattr(fd)
+        attrs = termios.tcgetattr(fd)
+        attrs[3] &= ~(termios.ICANON | termios.ECHO | termios.IEXTEN)
+        attrs[6][termios.VMIN] = 1
+        attrs[6][termios.VTIME] = 0
+        termios.tcsetattr(fd, termios.TCSANOW, attrs)
+
+    def feed(self):
+        self.text += os.read(self.fd, 4096)
+
+    def close(self):
+        termios.tcsetattr(self.fd, termios.TCSANOW, self.saved)
+
+
+class Main(App):
+    def init(self):
+        self.parser.add_argument("--device", help="hidraw device, found by VID and PID if not set")
+        self.parser.add_argument(
+            "--vid", type=lambda x: int(x, 16), default=HID_VID_DEFAULT, help="USB VID"
+        )
+        self.parser.add_argument(
+            "--pid", type=lambda x: int(x, 16), default=HID_PID_DEFAULT, help="USB PID"
+        )
+        self.parser.add_argument(
+            "-t", "--timeout", type=float, default=2.0, help="Seconds without keys to stop"
+        )
+        self.parser.add_argument(
+            "-e",
+            "--expect",
+            help="File with the text the script types, compared with what this terminal receives",
+        )
+        self.parser.set_defaults(func=self.capture)
+
+    def find_device(self):
+        hid_id = f"HID_ID=0003:{self.args.vid:08X}:{self.args.pid:08X}"
+        for uevent in sorted(glob.glob("/sys/class/hidraw/hidraw*/device/uevent")):
+            with open(uevent) as f:
+                if hid_id in f.read().split("\n"):
+                    return "/dev/" + uevent.split("/")[4]
+        return None
+
+    def capture(self):
+        device = self.args.device or self.find_device()
+        if not device:
+            self.logger.error(
+                f"No hidraw device {self.args.vid:04x}:{self.args.pid:04x}, is BadKB running?"
+            )
+            return 1
+        # Reports only tell what was sent, the text is checked as the host typed it
+        sink = None
+        if self.args.expect:
+            if not sys.stdin.isatty():
+                self.logger.error("Text check reads the typed text from the terminal")
+                return 1
+            sink = TextSink(sys.stdin.fileno())
+            self.logger.info(f"Capturing {device}, keep this terminal focused, start the script")
+        else:
+            self.logger.info(f"Capturing {device}, focus a scratch window, start the script")
+        capture = Capture()
+        fd = os.open(device, os.O_RDONLY)
+        try:
+            inputs = [fd, sink.fd] if sink else [fd]
+            while True:
+                timeout = self.args.timeout if capture.keys else None
+                ready, _, _ = select.select(inputs, [], [], timeout)
+                if not ready:
+                    break
+                if fd in ready:
+                    capture.feed(os.read(fd, 64), time.monotonic())
+                if sink and sink.fd in ready:
+                    sink.feed()
+        except KeyboardInterrupt:
+            pass
+        finally:
+            os.close(fd)
+            if sink:
+                sink.close()
+
+        print(capture.summary())
+        if sink:
+            with open(self.args.expect, newline="") as f:
+                expected = f.read()
+            typed = sink.text.decode(errors="replace").replace("\r", "\n")
+            if typed != expected:
+                mismatch = next(
+                    (i for i, (a, b) in enumerate(zip(typed, expected)) if a != b),
+                    min(len(typed), len(expected)),
+                )
+                self.logger.error(
+                    f"Typed text differs at {mismatch}: "
+                    f"{typed[mismatch:mismatch + 16]!r} != {expected[mismatch:mismatch + 16]!r}"
+                )
+                return 1
+            self.logger.info("Typed text matches")
+        return 0
+
+
+if __name__ == "__main__":
+    Main()()
@@ -1,8 +1,12 @@
 #!/usr/bin/env python3
 
-import heatshrink2 as hs
 from flipper.app import App
-from flipper.assets.heatshrink_stream import HeatshrinkDataStreamHeader
+from flipper.assets.heatshrink_stream import (
+    HeatshrinkDataStreamHeader,
+    HeatshrinkDataStreamIndex,
+    heatshrink_stream_compress,
+    heatshrink_stream_decompress,
+)
 from flipper.assets.tarball import compress_tree_tarball
 
 
@@ -28,6 +32,13 @@ class HSWrapper(App):
             type=int,
             default=self.DEFAULT_LOOKAHEAD,
         )
+        self.parser_compress.add_argument(
+            "-s",
+            "--segment",
+            help="segment size, adds restart points and seek index",
+            type=int,
+            default=None,
+        )
         self.parser_compress.add_argument("file", help="file to compress")
         self.parser_compress.add_argument(
             "-o", "--output", help="output file", required=True
@@ -64,6 +75,13 @@ class HSWrapper(App):
             type=int,
             default=self.DEFAULT_LOOKAHEAD,
         )
+        self.parser_tar.add_argument(
+            "-s",
+            "--segment",
+            help="segment size, adds restart points and seek index",
+            type=int,
+            default=None,
+        )
         self.parser_tar.set_defaults(func=self.tar)
 
     def compress(self):
@@ -72,13 +90,11 @@ class HSWrapper(App):
         with open(args.file, "rb") as f:
             data = f.read()
 
-        compressed = hs.compress(
-            data, window_sz2=args.window, lookahead_sz2=args.lookahead
+        compressed = heatshrink_stream_compress(
+            data, args.window, args.lookahead, args.segment
         )
 
         with open(args.output, "wb") as f:
-            header = HeatshrinkDataStreamHeader(args.window, args.lookahead)
-            f.write(header.pack())
             f.write(compressed)
 
         self.logger.info(
@@ -91,17 +107,11 @@ class HSWrapper(App):
         args = self.args
 
         with open(args.file, "rb") as f:
-            header = HeatshrinkDataStreamHeader.unpack(f.read(7))
             compressed = f.read()
 
+        header, data = heatshrink_stream_decompress(compressed)
         self.logger.info(
-            f"Decompressing with window size {header.window_size} and lookahead size {header.lookahead_size}"
-        )
-
-        data = hs.decompress(
-            compressed,
-            window_sz2=header.window_size,
-            lookahead_sz2=header.lookahead_size,
+            f"Decompressed with window size {header.window_size} and lookahead size {header.lookahead_size}"
         )
 
         with open(args.output, "wb") as f:
@@ -115,7 +125,11 @@ class HSWrapper(App):
 
         try:
             with open(args.file, "rb") as f:
-                header = HeatshrinkDataStreamHeader.unpack(f.read(7))
+                stream = f.read()
+            header = HeatshrinkDataStreamHeader.unpack(stream[:7])
+            index = None
+            if header.version == HeatshrinkDataStreamHeader.VERSION_SEGMENTED:
+                index, _ = HeatshrinkDataStreamIndex.unpack(stream[7:])
         except Exception as e:
             self.logger.error(f"Error: {e}")
             return 1
@@ -123,6 +137,10 @@ class HSWrapper(App):
         self.logger.info(
             f"Window size: {header.window_size}, lookahead size: {header.lookahead_size}"
         )
+        if index:
+            self.logger.info(
+                f"Segment size: {index.segment_size}, segments: {len(index.offsets) - 1}"
+            )
 
         return 0
 
@@ -130,7 +148,11 @@ class HSWrapper(App):
         args = self.args
 
         orig_size, compressed_size = compress_tree_tarball(
-            args.dir, args.output, hs_window=args.window, hs_lookahead=args.lookahead
+            args.dir,
+            args.output,
+            hs_window=args.window,
+            hs_lookahead=args.lookahead,
+            hs_segment_size=args.segment,
         )
 
         self.logger.info(
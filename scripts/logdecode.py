@@ -0,0 +1,216 @@
+#!/usr/bin/env python3
+
+import re
+import struct
+import sys
+
+import serial
+from elftools.elf.elffile import ELFFile
+from flipper.app import App
+from flipper.utils.cdc import resolve_port
+
+# Must match furi/core/log.c
+FRAME_MAGIC = b"\xfe\xff"
+HEADER = struct.Struct("<HBBIII")
+RECORD_MAX = 128
+LEVEL_TRUNCATED = 0x80
+
+LEVELS = {
+    2: ("E", "31"),
+    3: ("W", "33"),
+    4: ("I", "32"),
+    5: ("D", "34"),
+    6: ("T", "35"),
+}
+
+CONVERSION = re.compile(r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d*))?(hh|h|ll|l|L|j|z|t)?(.)")
+
+
+class StringTable:
+    def __init__(self, elf_path):
+        self.sections = []
+        self.cache = {}
+        with open(elf_path, "rb") as f:
+            elf = ELFFile(f)
+            for section in elf.iter_sections():
+                if section["sh_type"] != "SHT_PROGBITS" or not section["sh_addr"]:
+                    continue
+                self.sections.append((section["sh_addr"], section.data()))
+
+    def get(self, address):
+        if address in self.cache:
+            return self.cache[address]
+        string = None
+        for start, data in self.sections:
+            if start <= address < start + len(data):
+                offset = address - start
+                end = data.find(b"\0", offset)
+                string = data[offset:end].decode("utf-8", errors="replace")
+                break
+        self.cache[address] = string
+        return string
+
+
+class ArgumentReader:
+    def __init__(self, data):
+        self.data = data
+        self.offset = 0
+
+    def take(self, fmt):
+        size = struct.calcsize(fmt)
+        if self.offset + size > len(self.data):
+            raise EOFError
+        (value,) = struct.unpack_from(fmt, self.data, self.offset)
+        self.offset += size
+        return value
+
+    def take_string(self):
+        length = self.take("<B")
+        if self.offset + length > len(self.data):
+            raise EOFError
+        string = self.data[self.offset : self.offset + length]
+        # Length byte and characters are padded to 4 bytes
+        self.offset += ((1 + length + 3) & ~3) - 1
+        return string.decode("utf-8", errors="replace")
+
+
+def format_record(format, args):
+    # Arguments are read in the order of firmware furi_log_deferred_encode
+    reader = ArgumentReader(args)
+    output = []
+    position = 0
+    for match in CONVERSION.finditer(format):
+        output.append(format[position : match.start()])
+        position = match.end()
+        flags, width, precision, length, conversion = match.groups()
+        try:
+            if conversion == "%":
+                output.append("%")
+                continue
+            if width == "*":
+                width = str(reader.take("<i"))
+            if precision == "*":
+                precision = str(reader.take("<i"))
+            spec = "%" + flags + (width or "") + ("." + precision if precision else "")
+            wide = length in ("ll", "j")
+            if conversion in "di":
+                output.append((spec + "d") % reader.take("<q" if wide else "<i"))
+            elif conversion in "uoxX":
+                value = reader.take("<Q" if wide else "<I")
+                output.append((spec + conversion.replace("u", "d")) % value)
+            elif conversion == "c":
+                output.append((spec + "c") % chr(reader.take("<I") & 0xFF))
+            elif conversion in "pn":
+                output.append("0x%08x" % reader.take("<I"))
+            elif conversion in "fFeEgGaA":
+                value = reader.take("<d")
+                output.append((spec + conversion.replace("a", "e").replace("A", "E")) % value)
+            elif conversion == "s":
+                output.append((spec + "s") % reader.take_string())
+            else:
+                output.append(format[match.start() :])
+                return "".join(output)
+        except EOFError:
+            output.append("<?>")
+            position = match.end()
+    output.append(format[position:])
+    return "".join(output)
+
+
+class Decoder:
+    def __init__(self, strings, output):
+        self.strings = strings
+        self.output = output
+        self.buffer = bytearray()
+
+    def text(self, data):
+        self.output.write(data.decode("utf-8", errors="replace"))
+
+    def record(self, header, args):
+        _, level, dropped, tick, tag, format = header
+        if dropped:
+            self.output.write(f"[{dropped} records dropped]\r\n")
+        letter, color = LEVELS.get(level & ~LEVEL_TRUNCATED, (" ", "0"))
+        tag = self.strings.get(tag) or f"0x{tag:08x}"
+        format_string = self.strings.get(format)
+        if format_string is None:
+            message = f"<format 0x{format:08x}>"
+        else:
+            message = format_record(format_string, args)
+        if level & LEVEL_TRUNCATED:
+            message += " <truncated>"
+        self.output.write(f"{tick} \033[0;{color}m[{letter}][{tag}] \033[0m{message}\r\n")
+
+    def feed(self, data):
+        self.buffer += data
+        while True:
+            start = self.buffer.find(FRAME_MAGIC)
+            if start < 0:
+                # Magic may be split between reads
+                keep = 1 if self.buffer.endswith(FRAME_MAGIC[:1]) else 0
+                self.text(bytes(self.buffer[: len(self.buffer) - keep]))
+                del self.buffer[: len(self.buffer) - keep]
+                break
+            self.text(bytes(self.buffer[:start]))
+            del self.buffer[:start]
+            frame_start = len(FRAME_MAGIC)
+            if len(self.buffer) < frame_start + HEADER.size:
+                break
+            header = HEADER.unpack_from(self.buffer, frame_start)
+            size = header[0]
+            if size < HEADER.size or size > RECORD_MAX or size % 4:
+                # Not a frame, keep it as text
+                self.text(bytes(self.buffer[:1]))
+                del self.buffer[:1]
+                continue
+            if len(self.buffer) < frame_start + size:
+                break
+            args = bytes(self.buffer[frame_start + HEADER.size : frame_start + size])
+            del self.buffer[: frame_start + size]
+            self.record(header, args)
+        self.output.flush()
+
+
+class Main(App):
+    def init(self):
+        self.parser.add_argument("elf", help="Firmware ELF the log was captured from")
+        self.subparsers = self.parser.add_subparsers(help="sub-command help")
+
+        self.parser_file = self.subparsers.add_parser("file", help="Decode captured log")
+        self.parser_file.add_argument("input", help="Captured binary log, - for stdin")
+        self.parser_file.set_defaults(func=self.decode_file)
+
+        self.parser_serial = self.subparsers.add_parser("serial", help="Decode live log")
+        self.parser_serial.add_argument("-p", "--port", help="CDC Port", default="auto")
+        self.parser_serial.add_argument("level", nargs="?", default="", help="Log level")
+        self.parser_serial.set_defaults(func=self.decode_serial)
+
+    def decode_file(self):
+        decoder = Decoder(StringTable(self.args.elf), sys.stdout)
+        if self.args.input == "-":
+            stream = sys.stdin.buffer
+        else:
+            stream = open(self.args.input, "rb")
+        with stream:
+            while data := stream.read(4096):
+                decoder.feed(data)
+        return 0
+
+    def decode_serial(self):
+        if not (port := resolve_port(self.logger, self.args.port)):
+            self.logger.error("Is Flipper connected via USB and not in DFU mode?")
+            return 1
+        decoder = Decoder(StringTable(self.args.elf), sys.stdout)
+        with serial.Serial(port, 230400, timeout=0.1) as flipper:
+            flipper.write(f"log deferred {self.args.level}\r".encode("ascii"))
+            try:
+                while True:
+                    decoder.feed(flipper.read(4096))
+            except KeyboardInterrupt:
+                # Ctrl+C stops the log command
+                flipper.write(b"\x03")
+        return 0
+
+
+if __name__ == "__main__":
+    Main()()
@@ -0,0 +1,250 @@
+#!/usr/bin/env python3
+
+import sys
+
+from flipper.app import App
+from flipper.storage import FlipperStorage
+from flipper.utils.cdc import resolve_port
+
+# Must match cli_command_sched_dump in applications/services/cli/cli_commands.c
+# and furi/core/thread_trace.h
+HISTOGRAM_SHIFT = 8
+UNTRACKED = 0xFF
+WAKER_ISR = 0xFE
+EVENT_READY, EVENT_RUNNING, EVENT_PREEMPTED, EVENT_BLOCKED = range(4)
+
+
+def bucket_start(bucket):
+    return (1 << (bucket + HISTOGRAM_SHIFT - 1)) if bucket else 0
+
+
+class Thread:
+    def __init__(self, fields, histogram_size):
+        self.index = int(fields[0])
+        self.switches, self.preemptions = int(fields[1]), int(fields[2])
+        self.run, self.isr = int(fields[3]), int(fields[4])
+        self.latency_max, self.latency_total = int(fields[5]), int(fields[6])
+        self.histogram = [int(value) for value in fields[7 : 7 + histogram_size]]
+        self.exited = fields[7 + histogram_size] == "1"
+        self.name = ",".join(fields[8 + histogram_size :])
+        self.blocked = {}
+
+    def latency_percentile(self, fraction):
+        """Upper bound of the bucket holding the given fraction of wakeups, in cycles"""
+        target = sum(self.histogram) * fraction
+        seen = 0
+        for bucket, count in enumerate(self.histogram):
+            seen += count
+            if count and seen >= target:
+                if bucket + 1 < len(self.histogram):
+                    return bucket_start(bucket + 1)
+                return self.latency_max
+        return self.latency_max
+
+
+class Trace:
+    def __init__(self, lines):
+        self.cycles_per_us = None
+        self.cycles = self.events_total = self.untracked = 0
+        self.reasons = {}
+        self.threads = {}
+        self.events = []
+        histogram_size = 0
+        for line in lines:
+            fields = line.strip().split(",")
+            try:
+                if fields[0] == "sched":
+                    self.cycles_per_us, histogram_size = int(fields[1]), int(fields[2])
+                    self.cycles, self.events_total, self.untracked = map(int, fields[3:6])
+                elif fields[0] == "reason":
+                    self.reasons[int(fields[1])] = ",".join(fields[2:])
+                elif fields[0] == "thread" and histogram_size:
+                    thread = Thread(fields[1:], histogram_size)
+                    self.threads[thread.index] = thread
+                elif fields[0] == "block":
+                    index, reason, count, cycles = map(int, fields[1:5])
+                    self.threads[index].blocked[reason] = (count, cycles)
+                elif fields[0] == "event":
+                    self.events.append(tuple(map(int, fields[1:5])))
+            except (ValueError, IndexError, KeyError):
+                continue
+
+    def ms(self, cycles):
+        return cycles / self.cycles_per_us / 1000
+
+    def us(self, cycles):
+        return cycles / self.cycles_per_us
+
+    def name(self, index):
+        if index == WAKER_ISR:
+            return "[interrupt]"
+        if index in self.threads:
+            return self.threads[index].name
+        return "[untracked]"
+
+    def reason(self, reason):
+        return self.reasons.get(reason, str(reason))
+
+    def timeline(self):
+        """Yield (time, type, thread, arg) with times unwrapped from the 32-bit counter"""
+        if not self.events:
+            return
+        now = 0
+        previous = self.events[0][0]
+        for time, event_type, thread, arg in self.events:
+            now += (time - previous) & 0xFFFFFFFF
+            previous = time
+            yield now, event_type, thread, arg
+
+    def analyze(self):
+        """Blocked time by waker and ready time by the thread running instead"""
+        blocked_since = {}
+        ready_since = {}
+        wakers = {}
+        starvers = {}
+        running, running_since = None, None
+
+        def end_slice(now):
+            # Threads kept waiting while the running one had the CPU
+            if running is None or running == UNTRACKED:
+                return
+            for victim, since in ready_since.items():
+                if victim != running:
+                    overlap = now - max(since, running_since)
+                    if overlap > 0:
+                        key = (victim, running)
+                        starvers[key] = starvers.get(key, 0) + overlap
+
+        for now, event_type, thread, arg in self.timeline():
+            if event_type == EVENT_RUNNING:
+                end_slice(now)
+                running, running_since = thread, now
+                ready_since.pop(thread, None)
+            elif event_type in (EVENT_PREEMPTED, EVENT_BLOCKED):
+                end_slice(now)
+                running = None
+                if event_type == EVENT_PREEMPTED:
+                    ready_since[thread] = now
+                else:
+                    blocked_since[thread] = (now, arg)
+            elif event_type == EVENT_READY:
+                if thread in blocked_since:
+                    since, reason = blocked_since.pop(thread)
+                    key = (thread, reason, arg)
+                    count, total = wakers.get(key, (0, 0))
+                    wakers[key] = (count + 1, total + now - since)
+                ready_since.setdefault(thread, now)
+        return wakers, starvers
+
+    def window(self):
+        timeline = list(self.timeline())
+        return timeline[-1][0] if timeline else 0
+
+    def print_threads(self, output, details):
+        output.write(
+            f"Traced for {self.ms(self.cycles) / 1000:.1f}s, {len(self.threads)} threads, "
+            f"{self.events_total} switches and wakeups, {self.untracked} untracked switches\n\n"
+        )
+        output.write(
+            f"{'Thread':<17} {'CPU %':>6} {'ISR %':>6} {'Switches':>9} {'Preempted':>9} "
+            f"{'Avg us':>9} {'p99 us':>9} {'Max us':>9}  Blocked most on\n"
+        )
+        threads = sorted(self.threads.values(), key=lambda thread: thread.run, reverse=True)
+        for thread in threads:
+            wakeups = sum(thread.histogram)
+            average = thread.latency_total / wakeups if wakeups else 0
+            blocked = ""
+            if thread.blocked:
+                reason, (_, cycles) = max(thread.blocked.items(), key=lambda item: item[1][1])
+                blocked = f"{self.reason(reason)} {cycles * 100 / self.cycles:.1f}%"
+            name = thread.name + ("*" if thread.exited else "")
+            output.write(
+                f"{name:<17} {thread.run * 100 / self.cycles:>6.2f} "
+                f"{thread.isr * 100 / thread.run if thread.run else 0:>6.2f} "
+                f"{thread.switches:>9} {thread.preemptions:>9} {self.us(average):>9.1f} "
+                f"{self.us(thread.latency_percentile(0.99)):>9.1f} "
+                f"{self.us(thread.latency_max):>9.1f}  {blocked}\n"
+            )
+            if details:
+                for reason, (count, cycles) in sorted(
+                    thread.blocked.items(), key=lambda item: item[1][1], reverse=True
+                ):
+                    waited = self.ms(cycles)
+                    output.write(
+                        f"  {self.reason(reason):<15} {count:>9} waits {waited:>11.1f}ms\n"
+                    )
+        output.write("* exited\n")
+
+    def print_analysis(self, output, top):
+        wakers, starvers = self.analyze()
+        window = self.window()
+        output.write(f"\nLast {self.ms(window):.1f}ms of events, {len(self.events)} events\n")
+
+        output.write("\nLongest waits, by what the thread waited for and who woke it up\n")
+        ranked = sorted(wakers.items(), key=lambda item: item[1][1], reverse=True)
+        for (thread, reason, waker), (count, cycles) in ranked[:top]:
+            output.write(
+                f"  {self.name(thread):<16} {self.ms(cycles):>10.1f}ms {count:>7} waits on "
+                f"{self.reason(reason)}, woken by {self.name(waker)}\n"
+            )
+
+        output.write("\nReady but not running, by the thread running instead\n")
+        ranked = sorted(starvers.items(), key=lambda item: item[1], reverse=True)
+        for (victim, culprit), cycles in ranked[:top]:
+            output.write(
+                f"  {self.name(victim):<16} {self.ms(cycles):>10.2f}ms "
+                f"behind {self.name(culprit)}\n"
+            )
+
+
+class Main(App):
+    def init(self):
+        self.parser.add_argument(
+            "-b", "--blocked", action="store_true", help="List blocked time of every reason"
+        )
+        self.parser.add_argument(
+            "-t", "--top", type=int, default=10, help="Entries of event analysis tables"
+        )
+        self.subparsers = self.parser.add_subparsers(help="sub-command help")
+
+        self.parser_file = self.subparsers.add_parser("file", help="Analyze saved dump")
+        self.parser_file.add_argument("input", help="Output of sched dump, - for stdin")
+        self.parser_file.set_defaults(func=self.analyze_file)
+
+        self.parser_serial = self.subparsers.add_parser("serial", help="Dump from device")
+        self.parser_serial.add_argument("-p", "--port", help="CDC Port", default="auto")
+        self.parser_serial.set_defaults(func=self.analyze_serial)
+
+    def report(self, lines):
+        trace = Trace(lines)
+        if not trace.cycles_per_us or not trace.threads:
+            self.logger.error("No threads, is the trace started with <sched start>?")
+            return 1
+
+        trace.print_threads(sys.stdout, self.args.blocked)
+        if trace.events:
+            trace.print_analysis(sys.stdout, self.args.top)
+        if trace.events_total > len(trace.events):
+            self.logger.info(
+                f"Ring kept {len(trace.events)} of {trace.events_total} events, "
+                "start with a larger ring to analyze a longer window"
+            )
+        return 0
+
+    def analyze_file(self):
+        if self.args.input == "-":
+            return self.report(sys.stdin.read().splitlines())
+        with open(self.args.input) as f:
+            return self.report(f.read().splitlines())
+
+    def analyze_serial(self):
+        if not (port := resolve_port(self.logger, self.args.port)):
+            self.logger.error("Is Flipper connected via USB and not in DFU mode?")
+            return 1
+        with FlipperStorage(port) as flipper:
+            data = flipper.send_and_wait_prompt("sched dump\r")
+        return self.report(data.decode("ascii", errors="replace").splitlines())
+
+
+if __name__ == "__main__":
+    Main()()
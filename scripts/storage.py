@@ -4,6 +4,7 @@ import binascii
 import filecmp
 import os
 import tempfile
+import time
 
 from flipper.app import App
 from flipper.storage import FlipperStorage, FlipperStorageOperations
@@ -83,6 +84,23 @@ class Main(App):
         )
         self.parser_stress.set_defaults(func=self.stress)
 
+        self.parser_benchmark = self.subparsers.add_parser(
+            "benchmark", help="Measure transfer speed"
+        )
+        self.parser_benchmark.add_argument(
+            "-s",
+            "--chunk-size",
+            type=int,
+            nargs="+",
+            default=[512, 4096, 8192],
+            help="Chunk sizes in bytes",
+        )
+        self.parser_benchmark.add_argument("flipper_path", help="Flipper path")
+        self.parser_benchmark.add_argument(
+            "file_size", type=int, help="Test file size in bytes"
+        )
+        self.parser_benchmark.set_defaults(func=self.benchmark)
+
     def _get_port(self):
         if not (port := resolve_port(self.logger, self.args.port)):
             raise Exception("Failed to resolve port")
@@ -180,6 +198,47 @@ class Main(App):
                     os.unlink(receive_file_name)
                     self.args.count -= 1
 
+    @WrapStorageOp
+    def benchmark(self):
+        data = os.urandom(self.args.file_size)
+        results = []
+
+        with tempfile.TemporaryDirectory() as tmpdirname:
+            send_file_name = os.path.join(tmpdirname, "send")
+            with open(send_file_name, "wb") as fout:
+                fout.write(data)
+
+            with FlipperStorage(self._get_port()) as storage:
+                if storage.exist(self.args.flipper_path):
+                    self.logger.error("File exists, remove it first")
+                    return
+                try:
+                    for chunk_size in self.args.chunk_size:
+                        storage.chunk_size = chunk_size
+                        timings = []
+                        for transfer in (
+                            lambda: storage.send_file(
+                                send_file_name, self.args.flipper_path
+                            ),
+                            lambda: storage.read_file(self.args.flipper_path),
+                            lambda: storage.read_file_stream(self.args.flipper_path),
+                        ):
+                            start = time.monotonic()
+                            received = transfer()
+                            timings.append(time.monotonic() - start)
+                            if received is not None and received != data:
+                                raise Exception(f"Data mismatch, {chunk_size}b chunks")
+                        results.append((chunk_size, *timings))
+                finally:
+                    if storage.exist(self.args.flipper_path):
+                        storage.remove(self.args.flipper_path)
+
+        size = self.args.file_size / (1024 * 1024)
+        print(f"{'chunk':>8} {'write_chunk':>14} {'read_chunks':>14} {'read':>14}")
+        for chunk_size, *timings in results:
+            speeds = " ".join(f"{size / t:>9.3f} MB/s" for t in timings)
+            print(f"{chunk_size:>8} {speeds}")
+
 
 if __name__ == "__main__":
     Main()()
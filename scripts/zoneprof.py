@@ -0,0 +1,177 @@
+#!/usr/bin/env python3
+
+import csv
+import sys
+
+import serial
+from flipper.app import App
+from flipper.utils.cdc import resolve_port
+
+# Must match cli_command_profiler_stream in applications/services/cli/cli_commands.c
+HEADER_PREFIX = "profiler,"
+ZONE_PREFIX = "zone,"
+# Must match lib/toolbox/zone_profiler.c
+HISTOGRAM_SHIFT = 6
+
+
+def bucket_start(bucket):
+    return (1 << (bucket + HISTOGRAM_SHIFT - 1)) if bucket else 0
+
+
+class Sample:
+    def __init__(self, fields, histogram_size):
+        self.tick = int(fields[0])
+        self.zone = int(fields[1])
+        self.count, self.min, self.max, self.total = (int(value) for value in fields[2:6])
+        self.histogram = [int(value) for value in fields[6 : 6 + histogram_size]]
+        self.name = ",".join(fields[6 + histogram_size :])
+
+    def percentile(self, fraction):
+        """Upper bound of the bucket holding the given fraction of calls, in cycles"""
+        target = self.count * fraction
+        seen = 0
+        for bucket, calls in enumerate(self.histogram):
+            seen += calls
+            if calls and seen >= target:
+                if bucket + 1 < len(self.histogram):
+                    return bucket_start(bucket + 1)
+                return self.max
+        return self.max
+
+
+class Profile:
+    def __init__(self):
+        self.cycles_per_us = None
+        self.histogram_size = None
+        self.zones = {}
+
+    def feed_line(self, line):
+        """Return the sample parsed from the line, None for other output"""
+        line = line.strip()
+        if line.startswith(HEADER_PREFIX):
+            fields = line[len(HEADER_PREFIX) :].split(",")
+            self.cycles_per_us = int(fields[0])
+            self.histogram_size = int(fields[1])
+        elif line.startswith(ZONE_PREFIX) and self.histogram_size:
+            try:
+                sample = Sample(line[len(ZONE_PREFIX) :].split(","), self.histogram_size)
+            except ValueError:
+                return None
+            previous = self.zones.get(sample.zone)
+            self.zones[sample.zone] = sample
+            return sample, previous
+        return None
+
+    def us(self, cycles):
+        return cycles / self.cycles_per_us
+
+    def print_summary(self, output):
+        output.write(
+            f"{'Zone':<16} {'Calls':>10} {'Min us':>9} {'Avg us':>9} "
+            f"{'p50 us':>9} {'p99 us':>9} {'Max us':>9}\n"
+        )
+        for sample in sorted(self.zones.values(), key=lambda sample: sample.zone):
+            average = sample.total / sample.count if sample.count else 0
+            output.write(
+                f"{sample.name:<16} {sample.count:>10} {self.us(sample.min):>9.2f} "
+                f"{self.us(average):>9.2f} {self.us(sample.percentile(0.5)):>9.2f} "
+                f"{self.us(sample.percentile(0.99)):>9.2f} {self.us(sample.max):>9.2f}\n"
+            )
+
+    def print_histograms(self, output, width=50):
+        for sample in sorted(self.zones.values(), key=lambda sample: sample.zone):
+            if not sample.count:
+                continue
+            output.write(f"\n{sample.name}, {sample.count} calls\n")
+            peak = max(sample.histogram)
+            for bucket, calls in enumerate(sample.histogram):
+                if not calls:
+                    continue
+                bar = "#" * max(1, calls * width // peak)
+                start = self.us(bucket_start(bucket))
+                output.write(f"  >={start:>10.2f}us {calls:>10} {bar}\n")
+
+
+class Main(App):
+    def init(self):
+        self.subparsers = self.parser.add_subparsers(help="sub-command help")
+
+        self.parser_file = self.subparsers.add_parser("file", help="Summarize saved stream")
+        self.parser_file.add_argument("input", help="Output of profiler stream, - for stdin")
+        self.parser_file.set_defaults(func=self.summarize_file)
+
+        self.parser_serial = self.subparsers.add_parser("serial", help="Live view from device")
+        self.parser_serial.add_argument("-p", "--port", help="CDC Port", default="auto")
+        self.parser_serial.add_argument(
+            "-i", "--interval", type=int, default=1000, help="Sample interval, ms"
+        )
+        self.parser_serial.add_argument("--csv", help="Write per-interval rows to a CSV file")
+        self.parser_serial.set_defaults(func=self.stream_serial)
+
+    def summarize_file(self):
+        profile = Profile()
+        stream = sys.stdin if self.args.input == "-" else open(self.args.input)
+        with stream:
+            for line in stream:
+                profile.feed_line(line)
+        if not profile.zones:
+            self.logger.error("No zone samples, capture the output of <profiler stream>")
+            return 1
+        profile.print_summary(sys.stdout)
+        profile.print_histograms(sys.stdout)
+        return 0
+
+    def stream_serial(self):
+        if not (port := resolve_port(self.logger, self.args.port)):
+            self.logger.error("Is Flipper connected via USB and not in DFU mode?")
+            return 1
+
+        profile = Profile()
+        csv_file = open(self.args.csv, "w", newline="") if self.args.csv else None
+        writer = csv.writer(csv_file) if csv_file else None
+        if writer:
+            writer.writerow(["tick", "zone", "calls", "avg_us", "min_us", "max_us"])
+
+        buffer = ""
+        with serial.Serial(port, 230400, timeout=0.1) as flipper:
+            flipper.write(f"profiler stream {self.args.interval}\r".encode("ascii"))
+            try:
+                while True:
+                    buffer += flipper.read(4096).decode("ascii", errors="replace")
+                    *lines, buffer = buffer.split("\n")
+                    for line in lines:
+                        if not (parsed := profile.feed_line(line)):
+                            continue
+                        sample, previous = parsed
+                        if previous and writer:
+                            calls = sample.count - previous.count
+                            cycles = sample.total - previous.total
+                            average = profile.us(cycles / calls) if calls > 0 else 0
+                            writer.writerow(
+                                [
+                                    sample.tick,
+                                    sample.name,
+                                    calls,
+                                    f"{average:.2f}",
+                                    f"{profile.us(sample.min):.2f}",
+                                    f"{profile.us(sample.max):.2f}",
+                                ]
+                            )
+                        if sample.zone == len(profile.zones) - 1:
+                            # Last zone of the interval, redraw
+                            sys.stdout.write("\033[2J\033[H")
+                            profile.print_summary(sys.stdout)
+                            sys.stdout.flush()
+            except KeyboardInterrupt:
+                # Ctrl+C stops the profiler command
+                flipper.write(b"\x03")
+            finally:
+                if csv_file:
+                    csv_file.close()
+
+        profile.print_histograms(sys.stdout)
+        return 0
+
+
+if __name__ == "__main__":
+    Main()()
@@ -297,6 +297,43 @@ bool furi_hal_hid_kb_release(uint16_t button) {
     return hid_send_report(ReportIdKeyboard);
 }
 
+bool furi_hal_hid_kb_press_multiple(const uint16_t* buttons, size_t count) {
+    furi_check(buttons);
+    for(size_t i = 0; i < count; i++) {
+        uint8_t key = buttons[i] & 0xFF;
+        uint8_t free_nb = HID_KB_MAX_KEYS;
+        bool pressed = false;
+        for(uint8_t key_nb = 0; key_nb < HID_KB_MAX_KEYS; key_nb++) {
+            if(hid_report.keyboard.boot.btn[key_nb] == key) {
+                pressed = true;
+                break;
+            }
+            if(hid_report.keyboard.boot.btn[key_nb] == 0 && free_nb == HID_KB_MAX_KEYS) {
+                free_nb = key_nb;
+            }
+        }
+        if(key != 0 && !pressed && free_nb < HID_KB_MAX_KEYS) {
+            hid_report.keyboard.boot.btn[free_nb] = key;
+        }
+        hid_report.keyboard.boot.mods |= (buttons[i] >> 8);
+    }
+    return hid_send_report(ReportIdKeyboard);
+}
+
+bool furi_hal_hid_kb_release_multiple(const uint16_t* buttons, size_t count) {
+    furi_check(buttons);
+    for(size_t i = 0; i < count; i++) {
+        for(uint8_t key_nb = 0; key_nb < HID_KB_MAX_KEYS; key_nb++) {
+            if(hid_report.keyboard.boot.btn[key_nb] == (buttons[i] & 0xFF)) {
+                hid_report.keyboard.boot.btn[key_nb] = 0;
+                break;
+            }
+        }
+        hid_report.keyboard.boot.mods &= ~(buttons[i] >> 8);
+    }
+    return hid_send_report(ReportIdKeyboard);
+}
+
 bool furi_hal_hid_kb_release_all(void) {
     for(uint8_t key_nb = 0; key_nb < HID_KB_MAX_KEYS; key_nb++) {
         hid_report.keyboard.boot.btn[key_nb] = 0;
@@ -135,14 +135,63 @@ standard names. */
 #define vPortSVCHandler    SVC_Handler
 #define xPortPendSVHandler PendSV_Handler
 
-#define traceTASK_SWITCHED_IN()                                          \
-    extern void furi_hal_mpu_set_stack_protection(uint32_t* stack);      \
-    furi_hal_mpu_set_stack_protection((uint32_t*)pxCurrentTCB->pxStack); \
+/* Scheduler trace hooks, see furi/core/thread_trace.h */
+extern volatile uint32_t furi_thread_trace_enabled;
+extern void furi_thread_trace_hook_switched_in(void* task);
+extern void furi_thread_trace_hook_switched_out(void* task, uint32_t ready);
+extern void furi_thread_trace_hook_ready(void* task);
+extern void furi_thread_trace_hook_created(void* task);
+extern void furi_thread_trace_hook_deleted(void* task);
+extern void furi_thread_trace_hook_suspended(void* task);
+extern void furi_thread_trace_hook_block_on_delay(void);
+extern void furi_thread_trace_hook_block_on_event_group(void);
+extern void furi_thread_trace_hook_block_on_queue(uint32_t queue_type, uint32_t send);
+extern void furi_thread_trace_hook_block_on_notify(uint32_t index);
+
+#define FURI_THREAD_TRACE_HOOK(hook)        \
+    do {                                    \
+        if(furi_thread_trace_enabled) hook; \
+    } while(0)
+
+#define traceTASK_SWITCHED_IN()                                               \
+    extern void furi_hal_mpu_set_stack_protection(uint32_t* stack);           \
+    furi_hal_mpu_set_stack_protection((uint32_t*)pxCurrentTCB->pxStack);      \
+    FURI_THREAD_TRACE_HOOK(furi_thread_trace_hook_switched_in(pxCurrentTCB)); \
     errno = pxCurrentTCB->iTaskErrno
 //  ^^^^^   acquire errno directly from TCB because FreeRTOS assigns its `FreeRTOS_errno' _after_ our hook is called
 
+// Preempted threads are still in a ready list, blocked ones are already removed from it
 // referencing `FreeRTOS_errno' here   vvvvv    because FreeRTOS calls our hook _before_ copying the value into the TCB, hence a manual write to the TCB would get overwritten
-#define traceTASK_SWITCHED_OUT() FreeRTOS_errno = errno
+#define traceTASK_SWITCHED_OUT()                                  \
+    FURI_THREAD_TRACE_HOOK(furi_thread_trace_hook_switched_out(   \
+        pxCurrentTCB,                                             \
+        listLIST_ITEM_CONTAINER(&pxCurrentTCB->xStateListItem) == \
+            &pxReadyTasksLists[pxCurrentTCB->uxPriority]));       \
+    FreeRTOS_errno = errno
+
+#define traceMOVED_TASK_TO_READY_STATE(pxTCB) \
+    FURI_THREAD_TRACE_HOOK(furi_thread_trace_hook_ready(pxTCB))
+#define traceTASK_CREATE(pxNewTCB) \
+    FURI_THREAD_TRACE_HOOK(furi_thread_trace_hook_created(pxNewTCB))
+#define traceTASK_DELETE(pxTCB)  FURI_THREAD_TRACE_HOOK(furi_thread_trace_hook_deleted(pxTCB))
+#define traceTASK_SUSPEND(pxTCB) FURI_THREAD_TRACE_HOOK(furi_thread_trace_hook_suspended(pxTCB))
+#define traceTASK_DELAY()        FURI_THREAD_TRACE_HOOK(furi_thread_trace_hook_block_on_delay())
+#define traceTASK_DELAY_UNTIL(xTimeToWake) \
+    FURI_THREAD_TRACE_HOOK(furi_thread_trace_hook_block_on_delay())
+#define traceBLOCKING_ON_QUEUE_RECEIVE(pxQueue) \
+    FURI_THREAD_TRACE_HOOK(furi_thread_trace_hook_block_on_queue(pxQueue->ucQueueType, 0))
+#define traceBLOCKING_ON_QUEUE_PEEK(pxQueue) \
+    FURI_THREAD_TRACE_HOOK(furi_thread_trace_hook_block_on_queue(pxQueue->ucQueueType, 0))
+#define traceBLOCKING_ON_QUEUE_SEND(pxQueue) \
+    FURI_THREAD_TRACE_HOOK(furi_thread_trace_hook_block_on_queue(pxQueue->ucQueueType, 1))
+#define traceEVENT_GROUP_WAIT_BITS_BLOCK(xEventGroup, uxBitsToWaitFor) \
+    FURI_THREAD_TRACE_HOOK(furi_thread_trace_hook_block_on_event_group())
+#define traceEVENT_GROUP_SYNC_BLOCK(xEventGroup, uxBitsToSet, uxBitsToWaitFor) \
+    FURI_THREAD_TRACE_HOOK(furi_thread_trace_hook_block_on_event_group())
+#define traceTASK_NOTIFY_TAKE_BLOCK(uxIndexToWait) \
+    FURI_THREAD_TRACE_HOOK(furi_thread_trace_hook_block_on_notify(uxIndexToWait))
+#define traceTASK_NOTIFY_WAIT_BLOCK(uxIndexToWait) \
+    FURI_THREAD_TRACE_HOOK(furi_thread_trace_hook_block_on_notify(uxIndexToWait))
 
 /* Normal assert() semantics without relying on the provision of an assert.h
 header file. */
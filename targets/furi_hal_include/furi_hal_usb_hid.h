@@ -5,6 +5,8 @@
 #include "hid_usage_consumer.h"
 #include "hid_usage_led.h"
 
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -228,6 +230,23 @@ bool furi_hal_hid_kb_press(uint16_t button);
  */
 bool furi_hal_hid_kb_release(uint16_t button);
 
+/** Set several keys to pressed state and send one HID report
+ *
+ * Keys already pressed are left as they are, keys that do not fit in the
+ * report are not pressed. Modifiers of all keys are applied to the report.
+ *
+ * @param      buttons  key codes
+ * @param      count    number of key codes
+ */
+bool furi_hal_hid_kb_press_multiple(const uint16_t* buttons, size_t count);
+
+/** Set several keys to released state and send one HID report
+ *
+ * @param      buttons  key codes
+ * @param      count    number of key codes
+ */
+bool furi_hal_hid_kb_release_multiple(const uint16_t* buttons, size_t count);
+
 /** Clear all pressed keys and send HID report
  *
  */